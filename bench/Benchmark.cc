@@ -0,0 +1,523 @@
+#include "Benchmark.h"
+
+#include "elke_core/elke_configuration.h"
+#include "elke_core/math/simd_dispatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#include <unistd.h>
+
+namespace elke::bench
+{
+
+// ###################################################################
+State::State(const uint64_t max_iterations, const int64_t arg, const bool has_arg)
+  : m_max_iterations(max_iterations), m_arg(arg), m_has_arg(has_arg)
+{
+}
+
+// ###################################################################
+State::Iterator State::begin()
+{
+  startTiming();
+  return {this, m_max_iterations};
+}
+
+// ###################################################################
+void State::startTiming()
+{
+  m_timing = true;
+  m_cpu_start = std::clock();
+  m_real_start = std::chrono::steady_clock::now();
+}
+
+// ###################################################################
+void State::finishTiming()
+{
+  if (not m_timing) return;
+  const auto real_stop = std::chrono::steady_clock::now();
+  const auto cpu_stop = std::clock();
+  m_real_seconds +=
+    std::chrono::duration<double>(real_stop - m_real_start).count();
+  m_cpu_seconds += static_cast<double>(cpu_stop - m_cpu_start) / CLOCKS_PER_SEC;
+  m_timing = false;
+}
+
+// ###################################################################
+void State::pauseTiming() { finishTiming(); }
+
+// ###################################################################
+void State::resumeTiming() { startTiming(); }
+
+// ###################################################################
+void State::skipWithError(const std::string& message) { m_error = message; }
+
+namespace
+{
+
+std::vector<BenchmarkEntry>& registry()
+{
+  static std::vector<BenchmarkEntry> benchmarks;
+  return benchmarks;
+}
+
+/**A single reported row, an iteration run or an aggregate.*/
+struct Result
+{
+  std::string m_name;
+  std::string m_run_name;
+  std::string m_aggregate_name; ///< Empty for iteration runs
+  uint64_t m_iterations = 0;
+  double m_real_ns = 0.0; ///< Per iteration
+  double m_cpu_ns = 0.0;  ///< Per iteration
+  double m_items_per_second = 0.0;
+  double m_bytes_per_second = 0.0;
+  std::string m_label;
+  std::string m_error;
+};
+
+struct Options
+{
+  std::string m_filter = ".";
+  std::string m_format = "console";
+  std::string m_out;
+  std::string m_out_format = "json";
+  double m_min_time = 0.5;
+  int m_repetitions = 1;
+  bool m_list = false;
+};
+
+// ###################################################################
+/**Runs one benchmark instance, growing the iteration count until the
+ * measured time reaches the minimum time.*/
+Result runOnce(const BenchmarkEntry& entry,
+               const std::string& run_name,
+               const int64_t arg,
+               const bool has_arg,
+               const double min_time)
+{
+  Result result;
+  result.m_name = run_name;
+  result.m_run_name = run_name;
+
+  const uint64_t max_iterations = 1000000000;
+  uint64_t iterations = 1;
+  while (true)
+  {
+    State state(iterations, arg, has_arg);
+    entry.m_function(state);
+
+    if (not state.error().empty())
+    {
+      result.m_error = state.error();
+      return result;
+    }
+
+    const double seconds = state.realSeconds();
+    if (seconds >= min_time or iterations >= max_iterations)
+    {
+      const double n = static_cast<double>(iterations);
+      result.m_iterations = iterations;
+      result.m_real_ns = seconds * 1.0e9 / n;
+      result.m_cpu_ns = state.cpuSeconds() * 1.0e9 / n;
+      if (seconds > 0.0)
+      {
+        result.m_items_per_second =
+          static_cast<double>(state.itemsProcessed()) / seconds;
+        result.m_bytes_per_second =
+          static_cast<double>(state.bytesProcessed()) / seconds;
+      }
+      result.m_label = state.label();
+      return result;
+    }
+
+    // Same growth policy as Google Benchmark: aim 40% past the minimum time,
+    // at most 10x per step.
+    double multiplier = min_time * 1.4 / std::max(seconds, 1.0e-9);
+    if (seconds / min_time > 0.1) multiplier = std::min(multiplier, 10.0);
+    multiplier = std::clamp(multiplier, 2.0, 10.0);
+    iterations = std::min(
+      max_iterations,
+      std::max(iterations + 1,
+               static_cast<uint64_t>(static_cast<double>(iterations) *
+                                     multiplier)));
+  }
+}
+
+// ###################################################################
+/**Mean, median and standard deviation over repetitions.*/
+std::vector<Result> aggregates(const std::vector<Result>& runs)
+{
+  if (runs.size() < 2) return {};
+
+  auto statistic = [&runs](const std::string& name, auto reduce)
+  {
+    Result aggregate = runs.front();
+    aggregate.m_name = runs.front().m_run_name + "_" + name;
+    aggregate.m_aggregate_name = name;
+    std::vector<double> values;
+    for (auto member : {&Result::m_real_ns,
+                        &Result::m_cpu_ns,
+                        &Result::m_items_per_second,
+                        &Result::m_bytes_per_second})
+    {
+      values.clear();
+      for (const auto& run : runs)
+        values.push_back(run.*member);
+      aggregate.*member = reduce(values);
+    }
+    return aggregate;
+  };
+
+  auto mean = [](std::vector<double>& v)
+  {
+    double sum = 0.0;
+    for (double x : v)
+      sum += x;
+    return sum / static_cast<double>(v.size());
+  };
+  auto median = [](std::vector<double>& v)
+  {
+    std::sort(v.begin(), v.end());
+    const size_t n = v.size();
+    return n % 2 == 1 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+  };
+  auto stddev = [&mean](std::vector<double>& v)
+  {
+    const double m = mean(v);
+    double sum = 0.0;
+    for (double x : v)
+      sum += (x - m) * (x - m);
+    return std::sqrt(sum / static_cast<double>(v.size() - 1));
+  };
+
+  return {statistic("mean", mean),
+          statistic("median", median),
+          statistic("stddev", stddev)};
+}
+
+// ###################################################################
+std::string jsonEscape(const std::string& input)
+{
+  std::string output;
+  for (const char c : input)
+  {
+    switch (c)
+    {
+      case '"': output += "\\\""; break;
+      case '\\': output += "\\\\"; break;
+      case '\n': output += "\\n"; break;
+      case '\t': output += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          output += buffer;
+        }
+        else
+          output += c;
+    }
+  }
+  return output;
+}
+
+// ###################################################################
+std::string humanReadable(const double value)
+{
+  const char* suffixes[] = {"", "k", "M", "G", "T"};
+  double scaled = value;
+  size_t s = 0;
+  while (scaled >= 1000.0 and s < 4)
+  {
+    scaled /= 1000.0;
+    ++s;
+  }
+  std::ostringstream out;
+  out << std::setprecision(4) << scaled << suffixes[s];
+  return out.str();
+}
+
+// ###################################################################
+void reportConsole(std::ostream& out, const std::vector<Result>& results)
+{
+  size_t name_width = 10;
+  for (const auto& result : results)
+    name_width = std::max(name_width, result.m_name.size() + 2);
+
+  out << std::left << std::setw(static_cast<int>(name_width)) << "Benchmark"
+      << std::right << std::setw(15) << "Time" << std::setw(15) << "CPU"
+      << std::setw(12) << "Iterations" << "  UserCounters...\n";
+  out << std::string(name_width + 42 + 17, '-') << "\n";
+
+  for (const auto& result : results)
+  {
+    out << std::left << std::setw(static_cast<int>(name_width))
+        << result.m_name << std::right;
+    if (not result.m_error.empty())
+    {
+      out << "ERROR: " << result.m_error << "\n";
+      continue;
+    }
+    out << std::fixed << std::setprecision(1) << std::setw(12)
+        << result.m_real_ns << " ns" << std::setw(12) << result.m_cpu_ns
+        << " ns" << std::setw(12) << result.m_iterations;
+    out.unsetf(std::ios::floatfield);
+    if (result.m_items_per_second > 0.0)
+      out << "  items_per_second=" << humanReadable(result.m_items_per_second)
+          << "/s";
+    if (result.m_bytes_per_second > 0.0)
+      out << "  bytes_per_second=" << humanReadable(result.m_bytes_per_second)
+          << "/s";
+    if (not result.m_label.empty()) out << "  " << result.m_label;
+    out << "\n";
+  }
+}
+
+// ###################################################################
+std::string currentDate()
+{
+  const std::time_t now = std::time(nullptr);
+  char buffer[64];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S%z",
+                std::localtime(&now));
+  return buffer;
+}
+
+// ###################################################################
+void reportJSON(std::ostream& out,
+                const std::vector<Result>& results,
+                const std::string& executable)
+{
+  char host_name[256] = "unknown";
+  gethostname(host_name, sizeof(host_name) - 1);
+
+#ifdef NDEBUG
+  const char* build_type = "release";
+#else
+  const char* build_type = "debug";
+#endif
+
+  out << "{\n";
+  out << "  \"context\": {\n";
+  out << "    \"date\": \"" << currentDate() << "\",\n";
+  out << "    \"host_name\": \"" << jsonEscape(host_name) << "\",\n";
+  out << "    \"executable\": \"" << jsonEscape(executable) << "\",\n";
+  out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+  out << "    \"library_build_type\": \"" << build_type << "\",\n";
+  out << "    \"elke_version\": \"" << PROJECT_VERSION << "\",\n";
+  out << "    \"simd_instruction_set\": \""
+      << math::SIMDInstructionSetName(math::activeSIMDInstructionSet())
+      << "\"\n";
+  out << "  },\n";
+  out << "  \"benchmarks\": [";
+
+  out << std::setprecision(std::numeric_limits<double>::max_digits10);
+  for (size_t r = 0; r < results.size(); ++r)
+  {
+    const auto& result = results[r];
+    out << (r == 0 ? "\n" : ",\n") << "    {\n";
+    out << "      \"name\": \"" << jsonEscape(result.m_name) << "\",\n";
+    out << "      \"run_name\": \"" << jsonEscape(result.m_run_name) << "\",\n";
+    if (result.m_aggregate_name.empty())
+      out << "      \"run_type\": \"iteration\",\n";
+    else
+      out << "      \"run_type\": \"aggregate\",\n"
+          << "      \"aggregate_name\": \"" << result.m_aggregate_name
+          << "\",\n";
+    if (not result.m_error.empty())
+    {
+      out << "      \"error_occurred\": true,\n";
+      out << "      \"error_message\": \"" << jsonEscape(result.m_error)
+          << "\"\n    }";
+      continue;
+    }
+    out << "      \"iterations\": " << result.m_iterations << ",\n";
+    out << "      \"real_time\": " << result.m_real_ns << ",\n";
+    out << "      \"cpu_time\": " << result.m_cpu_ns << ",\n";
+    out << "      \"time_unit\": \"ns\"";
+    if (result.m_items_per_second > 0.0)
+      out << ",\n      \"items_per_second\": " << result.m_items_per_second;
+    if (result.m_bytes_per_second > 0.0)
+      out << ",\n      \"bytes_per_second\": " << result.m_bytes_per_second;
+    if (not result.m_label.empty())
+      out << ",\n      \"label\": \"" << jsonEscape(result.m_label) << "\"";
+    out << "\n    }";
+  }
+  out << "\n  ]\n}\n";
+}
+
+// ###################################################################
+void report(std::ostream& out,
+            const std::string& format,
+            const std::vector<Result>& results,
+            const std::string& executable)
+{
+  if (format == "json") reportJSON(out, results, executable);
+  else reportConsole(out, results);
+}
+
+// ###################################################################
+void printUsage(const char* executable)
+{
+  std::cout
+    << "Usage: " << executable << " [options]\n"
+    << "  --benchmark_filter=<regex>      Run benchmarks matching regex\n"
+    << "  --benchmark_list_tests          List benchmarks and exit\n"
+    << "  --benchmark_min_time=<seconds>  Minimum time per benchmark "
+       "(default 0.5)\n"
+    << "  --benchmark_repetitions=<n>     Repeat and report aggregates\n"
+    << "  --benchmark_format=<console|json>\n"
+    << "  --benchmark_out=<file>          Also write results to file\n"
+    << "  --benchmark_out_format=<console|json> (default json)\n";
+}
+
+} // namespace
+
+// ###################################################################
+char registerBenchmark(const std::string& name,
+                       const BenchmarkFunction function,
+                       std::vector<int64_t> args /*={}*/)
+{
+  registry().push_back({name, function, std::move(args)});
+  return 0;
+}
+
+// ###################################################################
+const std::vector<BenchmarkEntry>& registeredBenchmarks() { return registry(); }
+
+// ###################################################################
+int runBenchmarks(const int argc, char** argv)
+{
+  //============================================= Parse options
+  Options options;
+  for (int a = 1; a < argc; ++a)
+  {
+    const std::string argument(argv[a]);
+    auto value_of = [&argument](const std::string& key, std::string& value)
+    {
+      const std::string prefix = "--" + key + "=";
+      if (argument.rfind(prefix, 0) != 0) return false;
+      value = argument.substr(prefix.size());
+      return true;
+    };
+
+    std::string value;
+    if (value_of("benchmark_filter", value)) options.m_filter = value;
+    else if (value_of("benchmark_format", value)) options.m_format = value;
+    else if (value_of("benchmark_out", value)) options.m_out = value;
+    else if (value_of("benchmark_out_format", value))
+      options.m_out_format = value;
+    else if (value_of("benchmark_min_time", value))
+    {
+      // Google Benchmark accepts a trailing "s"
+      if (not value.empty() and value.back() == 's') value.pop_back();
+      options.m_min_time = std::stod(value);
+    }
+    else if (value_of("benchmark_repetitions", value))
+      options.m_repetitions = std::max(1, std::stoi(value));
+    else if (argument == "--benchmark_list_tests")
+      options.m_list = true;
+    else if (argument == "--help" or argument == "-h")
+    {
+      printUsage(argv[0]);
+      return 0;
+    }
+    else if (argument.rfind("--benchmark_", 0) == 0)
+    {
+      std::cerr << "Unrecognized option " << argument << "\n";
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  for (const auto& format : {options.m_format, options.m_out_format})
+    if (format != "console" and format != "json")
+    {
+      std::cerr << "Unsupported benchmark format \"" << format << "\"\n";
+      return 1;
+    }
+
+  //============================================= Expand and filter
+  struct Instance
+  {
+    const BenchmarkEntry* m_entry;
+    std::string m_run_name;
+    int64_t m_arg;
+    bool m_has_arg;
+  };
+  std::vector<Instance> instances;
+  const std::regex filter(options.m_filter);
+  for (const auto& entry : registry())
+  {
+    if (entry.m_args.empty())
+      instances.push_back({&entry, entry.m_name, 0, false});
+    for (const int64_t arg : entry.m_args)
+      instances.push_back(
+        {&entry, entry.m_name + "/" + std::to_string(arg), arg, true});
+  }
+  instances.erase(std::remove_if(instances.begin(), instances.end(),
+                                 [&filter](const Instance& instance)
+                                 {
+                                   return not std::regex_search(
+                                     instance.m_run_name, filter);
+                                 }),
+                  instances.end());
+
+  if (options.m_list)
+  {
+    for (const auto& instance : instances)
+      std::cout << instance.m_run_name << "\n";
+    return 0;
+  }
+
+  //============================================= Run
+  // Log output of the code under test goes to stderr so that it does not mix
+  // with a report written to stdout.
+  std::ostream report_stream(std::cout.rdbuf());
+  std::cout.rdbuf(std::cerr.rdbuf());
+
+  std::vector<Result> results;
+  for (const auto& instance : instances)
+  {
+    std::vector<Result> runs;
+    for (int r = 0; r < options.m_repetitions; ++r)
+      runs.push_back(runOnce(*instance.m_entry,
+                             instance.m_run_name,
+                             instance.m_arg,
+                             instance.m_has_arg,
+                             options.m_min_time));
+    results.insert(results.end(), runs.begin(), runs.end());
+    const auto stats = aggregates(runs);
+    results.insert(results.end(), stats.begin(), stats.end());
+  }
+
+  std::cout.rdbuf(report_stream.rdbuf());
+
+  //============================================= Report
+  report(std::cout, options.m_format, results, argv[0]);
+  if (not options.m_out.empty())
+  {
+    std::ofstream file(options.m_out);
+    if (not file.is_open())
+    {
+      std::cerr << "Failed to open \"" << options.m_out << "\"\n";
+      return 1;
+    }
+    report(file, options.m_out_format, results, argv[0]);
+  }
+
+  for (const auto& result : results)
+    if (not result.m_error.empty()) return 1;
+
+  return 0;
+}
+
+} // namespace elke::bench
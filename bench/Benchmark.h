@@ -0,0 +1,157 @@
+#ifndef ELKE_BENCH_BENCHMARK_H
+#define ELKE_BENCH_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**A small, dependency-free microbenchmark harness modeled on Google
+ * Benchmark. A benchmark is a function taking a `State&` that runs the timed
+ * region inside `for (auto _ : state)`:
+ * ```c++
+ * void BM_ScalarValueFromInt(elke::bench::State& state)
+ * {
+ *   for (auto _ : state)
+ *     elke::bench::doNotOptimize(elke::ScalarValue(12));
+ * }
+ * elkeBenchmark(BM_ScalarValueFromInt);
+ * elkeBenchmarkArgs(BM_DataTreeBuild, 1000, 100000); // state.arg()
+ * ```
+ * The runner picks the iteration count so that each benchmark runs for at
+ * least `--benchmark_min_time` seconds and writes the results in the Google
+ * Benchmark JSON schema so that existing comparison tooling can be used.*/
+namespace elke::bench
+{
+
+/**Prevents the compiler from optimizing away the computation of `value`.*/
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) or defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+/**Forces pending memory writes to be considered observable.*/
+inline void clobberMemory()
+{
+#if defined(__GNUC__) or defined(__clang__)
+  asm volatile("" : : : "memory");
+#endif
+}
+
+/**Per-run state handed to a benchmark function.*/
+class State
+{
+public:
+  State(uint64_t max_iterations, int64_t arg, bool has_arg);
+
+  /**Benchmark argument, see elkeBenchmarkArgs.*/
+  int64_t arg() const { return m_arg; }
+  bool hasArg() const { return m_has_arg; }
+
+  /**Number of iterations the timed loop executes.*/
+  uint64_t iterations() const { return m_max_iterations; }
+
+  /**Excludes setup work inside the loop from the measurement.*/
+  void pauseTiming();
+  void resumeTiming();
+
+  /**Reports throughput. Values are totals over all iterations.*/
+  void setItemsProcessed(int64_t items) { m_items_processed = items; }
+  void setBytesProcessed(int64_t bytes) { m_bytes_processed = bytes; }
+
+  /**Free-form label printed next to the result.*/
+  void setLabel(const std::string& label) { m_label = label; }
+
+  /**Aborts the benchmark with an error message.*/
+  void skipWithError(const std::string& message);
+
+  // Results, read by the runner.
+  double realSeconds() const { return m_real_seconds; }
+  double cpuSeconds() const { return m_cpu_seconds; }
+  int64_t itemsProcessed() const { return m_items_processed; }
+  int64_t bytesProcessed() const { return m_bytes_processed; }
+  const std::string& label() const { return m_label; }
+  const std::string& error() const { return m_error; }
+
+  // The range-for protocol. The loop variable is unused.
+  struct Iterator
+  {
+    State* m_state;
+    uint64_t m_remaining;
+
+    bool operator!=(const Iterator&) const
+    {
+      if (m_remaining != 0) return true;
+      m_state->finishTiming();
+      return false;
+    }
+    void operator++() { --m_remaining; }
+    int operator*() const { return 0; }
+  };
+  Iterator begin();
+  Iterator end() { return {this, 0}; }
+
+private:
+  void startTiming();
+  void finishTiming();
+
+  uint64_t m_max_iterations;
+  int64_t m_arg;
+  bool m_has_arg;
+
+  bool m_timing = false;
+  std::chrono::steady_clock::time_point m_real_start;
+  std::clock_t m_cpu_start = 0;
+  double m_real_seconds = 0.0;
+  double m_cpu_seconds = 0.0;
+
+  int64_t m_items_processed = 0;
+  int64_t m_bytes_processed = 0;
+  std::string m_label;
+  std::string m_error;
+};
+
+using BenchmarkFunction = void (*)(State&);
+
+/**A registered benchmark, instantiated once per argument.*/
+struct BenchmarkEntry
+{
+  std::string m_name;
+  BenchmarkFunction m_function;
+  std::vector<int64_t> m_args;
+};
+
+/**Registers a benchmark. Used via the macros below.*/
+char registerBenchmark(const std::string& name,
+                       BenchmarkFunction function,
+                       std::vector<int64_t> args = {});
+
+/**Returns all registered benchmarks.*/
+const std::vector<BenchmarkEntry>& registeredBenchmarks();
+
+/**Parses the `--benchmark_*` arguments, runs the matching benchmarks and
+ * reports. Returns a process exit code.*/
+int runBenchmarks(int argc, char** argv);
+
+} // namespace elke::bench
+
+#define elkeBenchmarkJoin2(a, b) a##b
+#define elkeBenchmarkJoin(a, b) elkeBenchmarkJoin2(a, b)
+
+#define elkeBenchmark(function)                                                \
+  static char elkeBenchmarkJoin(bench_reg_, __COUNTER__) =                     \
+    elke::bench::registerBenchmark(#function, function)
+
+#define elkeBenchmarkArgs(function, ...)                                       \
+  static char elkeBenchmarkJoin(bench_reg_, __COUNTER__) =                     \
+    elke::bench::registerBenchmark(#function, function, {__VA_ARGS__})
+
+#endif // ELKE_BENCH_BENCHMARK_H
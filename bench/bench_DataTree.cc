@@ -0,0 +1,191 @@
+#include "Benchmark.h"
+#include "bench_utils.h"
+
+#include "elke_core/data_types/DataTree.h"
+#include "elke_core/data_types/DataTreeTraversal.h"
+#include "elke_core/data_types/DataTreeYAML.h"
+#include "elke_core/input/YAMLInput.h"
+#include "elke_core/FrameworkCore.h"
+
+#include <limits>
+
+namespace
+{
+using elke::bench::doNotOptimize;
+using elke::bench::State;
+using elke::DataTree;
+
+/**Flat map with `n` scalar children.*/
+DataTree makeFlatTree(const size_t n)
+{
+  DataTree tree("root");
+  tree.setGrossType(elke::DataGrossType::MAP);
+  for (size_t i = 0; i < n; ++i)
+  {
+    auto child = std::make_shared<DataTree>("child_" + std::to_string(i));
+    child->setGrossType(elke::DataGrossType::SCALAR);
+    child->setValue(elke::ScalarValue(static_cast<int64_t>(i)));
+    tree.addChild(child);
+  }
+  return tree;
+}
+
+/**Parses a generated deck with about `num_nodes` nodes.*/
+DataTree parseGeneratedDeck(const size_t num_nodes)
+{
+  auto& logger = elke::FrameworkCore::getInstance().getLogger();
+  const auto file_name = elke::bench::writeTemporaryFile(
+    "elke_bench_deck_" + std::to_string(num_nodes) + ".yaml",
+    elke::bench::generateYAMLDeck(num_nodes));
+
+  elke::YAMLInput parser(logger);
+  return parser.parseInputFile(file_name);
+}
+
+/**Number of nodes in `tree`, including itself.*/
+size_t countNodes(const DataTree& tree)
+{
+  return elke::data_tree_traversal::countNodesUpTo(
+    tree, std::numeric_limits<size_t>::max());
+}
+
+// ###################################################################
+void BM_DataTree_Build(State& state)
+{
+  const auto n = static_cast<size_t>(state.arg());
+  for (auto _ : state)
+    doNotOptimize(makeFlatTree(n));
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+elkeBenchmarkArgs(BM_DataTree_Build, 100, 10000);
+
+// ###################################################################
+void BM_DataTree_ChildLookup(State& state)
+{
+  const auto n = static_cast<size_t>(state.arg());
+  const auto tree = makeFlatTree(n);
+  std::vector<std::string> names;
+  for (size_t i = 0; i < n; i += std::max<size_t>(1, n / 64))
+    names.push_back("child_" + std::to_string(i));
+
+  size_t k = 0;
+  for (auto _ : state)
+  {
+    doNotOptimize(tree.child(names[k]));
+    k = (k + 1) % names.size();
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmarkArgs(BM_DataTree_ChildLookup, 10, 100, 10000);
+
+// ###################################################################
+void BM_DataTree_Copy(State& state)
+{
+  const auto tree = parseGeneratedDeck(static_cast<size_t>(state.arg()));
+  const size_t num_nodes = countNodes(tree);
+  for (auto _ : state)
+  {
+    DataTree copy(tree);
+    doNotOptimize(copy);
+  }
+  state.setItemsProcessed(
+    static_cast<int64_t>(state.iterations() * num_nodes));
+}
+elkeBenchmarkArgs(BM_DataTree_Copy, 10000);
+
+// ###################################################################
+void BM_DataTree_ToStringAsYAML(State& state)
+{
+  const auto tree = parseGeneratedDeck(static_cast<size_t>(state.arg()));
+  size_t bytes = 0;
+  for (auto _ : state)
+  {
+    const auto yaml = tree.toStringAsYAML("");
+    bytes += yaml.size();
+    doNotOptimize(yaml);
+  }
+  state.setBytesProcessed(static_cast<int64_t>(bytes));
+}
+elkeBenchmarkArgs(BM_DataTree_ToStringAsYAML, 1000, 100000);
+
+// ###################################################################
+/**Chunked emission as done for --echo-input-data, without the logger.*/
+void BM_DataTree_EmitYAMLChunked(State& state)
+{
+  const auto tree = parseGeneratedDeck(static_cast<size_t>(state.arg()));
+  size_t bytes = 0;
+  for (auto _ : state)
+  {
+    elke::DataTreeYAMLEmitter emitter([&](const std::string_view chunk)
+                                      { bytes += chunk.size(); });
+    emitter.emit(tree, "", {"type"});
+  }
+  state.setBytesProcessed(static_cast<int64_t>(bytes));
+}
+elkeBenchmarkArgs(BM_DataTree_EmitYAMLChunked, 1000, 100000);
+
+// ###################################################################
+void BM_DataTree_TraverseWithCallback(State& state)
+{
+  auto tree = parseGeneratedDeck(static_cast<size_t>(state.arg()));
+  const size_t num_nodes = countNodes(tree);
+  for (auto _ : state)
+  {
+    size_t num_scalars = 0;
+    tree.traverseWithCallback("",
+                              [&](const std::string&, DataTree& node)
+                              {
+                                if (node.grossType() ==
+                                    elke::DataGrossType::SCALAR)
+                                  ++num_scalars;
+                              });
+    doNotOptimize(num_scalars);
+  }
+  state.setItemsProcessed(
+    static_cast<int64_t>(state.iterations() * num_nodes));
+}
+elkeBenchmarkArgs(BM_DataTree_TraverseWithCallback, 100000);
+
+// ###################################################################
+void BM_DataTree_ForEachNode(State& state)
+{
+  auto tree = parseGeneratedDeck(static_cast<size_t>(state.arg()));
+  const size_t num_nodes = countNodes(tree);
+  for (auto _ : state)
+  {
+    size_t num_scalars = 0;
+    elke::forEachDataTreeNode(tree,
+                              [&](DataTree& node)
+                              {
+                                if (node.grossType() ==
+                                    elke::DataGrossType::SCALAR)
+                                  ++num_scalars;
+                              });
+    doNotOptimize(num_scalars);
+  }
+  state.setItemsProcessed(
+    static_cast<int64_t>(state.iterations() * num_nodes));
+}
+elkeBenchmarkArgs(BM_DataTree_ForEachNode, 100000);
+
+// ###################################################################
+void BM_DataTree_ParallelReduce(State& state)
+{
+  const auto tree = parseGeneratedDeck(static_cast<size_t>(state.arg()));
+  const size_t num_nodes = countNodes(tree);
+  for (auto _ : state)
+  {
+    const size_t num_scalars = elke::parallelTransformReduceDataTree(
+      tree,
+      size_t{0},
+      [](const DataTree& node) -> size_t
+      { return node.grossType() == elke::DataGrossType::SCALAR ? 1 : 0; },
+      [](const size_t a, const size_t b) { return a + b; });
+    doNotOptimize(num_scalars);
+  }
+  state.setItemsProcessed(
+    static_cast<int64_t>(state.iterations() * num_nodes));
+}
+elkeBenchmarkArgs(BM_DataTree_ParallelReduce, 100000);
+
+} // namespace
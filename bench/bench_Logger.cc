@@ -0,0 +1,70 @@
+#include "Benchmark.h"
+
+#include "elke_core/output/Logger.h"
+
+namespace
+{
+using elke::bench::State;
+
+/**Redirects std::cout into a null buffer for the lifetime of the object so
+ * that the measurement covers formatting and the log-stream machinery rather
+ * than the terminal.*/
+class SilencedCout
+{
+  struct NullBuffer final : std::streambuf
+  {
+    int overflow(const int c) override { return c; }
+    std::streamsize xsputn(const char*, const std::streamsize n) override
+    {
+      return n;
+    }
+  } m_buffer;
+  std::streambuf* m_original;
+
+public:
+  SilencedCout() : m_original(std::cout.rdbuf(&m_buffer)) {}
+  ~SilencedCout() { std::cout.rdbuf(m_original); }
+};
+
+// ###################################################################
+void BM_Logger_Log(State& state)
+{
+  elke::Logger logger(/*verbosity=*/1, /*rank=*/0);
+  logger.setColorSuppression(true);
+  SilencedCout silence;
+
+  int64_t i = 0;
+  for (auto _ : state)
+    logger.log() << "Processing item " << ++i << " of the input deck.";
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_Logger_Log);
+
+// ###################################################################
+void BM_Logger_Warn(State& state)
+{
+  elke::Logger logger(/*verbosity=*/1, /*rank=*/0);
+  SilencedCout silence;
+
+  for (auto _ : state)
+    logger.warn() << "Parameter \"scale\" is deprecated.";
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_Logger_Warn);
+
+// ###################################################################
+/**Messages above the verbosity level are discarded; this is the cost of a
+ * disabled debug message.*/
+void BM_Logger_Suppressed(State& state)
+{
+  elke::Logger logger(/*verbosity=*/1, /*rank=*/0);
+  SilencedCout silence;
+
+  int64_t i = 0;
+  for (auto _ : state)
+    logger.log(elke::LogVerbosity::LEVEL_3) << "Debug value " << ++i;
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_Logger_Suppressed);
+
+} // namespace
@@ -0,0 +1,310 @@
+#include "Benchmark.h"
+#include "bench_utils.h"
+
+#include "elke_core/input/YAMLInput.h"
+#include "elke_core/parameters2/ParameterProgram.h"
+#include "elke_core/FrameworkCore.h"
+
+namespace
+{
+using elke::bench::doNotOptimize;
+using elke::bench::State;
+using elke::ParameterTree;
+
+/**Same specification as the test-suite's TestSyntaxBlock.*/
+ParameterTree makeSpecification()
+{
+  auto params = ParameterTree("TestSyntaxBlock", "No description");
+
+  params.addOptionalParameter("scale", "The scale", 2.0);
+  params.addOptionalParameter("offset", "The offset", 2.0);
+  params.addOptionalParameter("scale2", "The scale", 1.0);
+  params.addRequiredParameter<int>("optionA", "Description.");
+  params.addOptionalParameter("components",
+                              "A list of components to instantiate",
+                              elke::GenericParameterMap());
+
+  return params;
+}
+
+// ###################################################################
+/**Validates the TestSyntaxBlock of a generated deck with `arg` nodes.*/
+void BM_ParameterTree_ProcessSpecification(State& state)
+{
+  auto& logger = elke::FrameworkCore::getInstance().getLogger();
+  const auto num_nodes = static_cast<size_t>(state.arg());
+  const auto file_name = elke::bench::writeTemporaryFile(
+    "elke_bench_deck_" + std::to_string(num_nodes) + ".yaml",
+    elke::bench::generateYAMLDeck(num_nodes));
+
+  elke::YAMLInput parser(logger);
+  const auto data_tree = parser.parseInputFile(file_name);
+  const auto& block = data_tree.child("TestSyntaxBlock");
+
+  auto params = makeSpecification();
+  for (auto _ : state)
+  {
+    elke::ParameterDiagnostics diagnostics;
+    params.processSpecification(diagnostics, block);
+    if (diagnostics.hasErrors())
+    {
+      state.skipWithError(diagnostics.errorsAsString());
+      break;
+    }
+    doNotOptimize(diagnostics);
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmarkArgs(BM_ParameterTree_ProcessSpecification, 1000, 100000);
+
+// ###################################################################
+void BM_ParameterTree_BuildSpecification(State& state)
+{
+  for (auto _ : state)
+    doNotOptimize(makeSpecification());
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_ParameterTree_BuildSpecification);
+
+// ###################################################################
+/**Reports 100 misspelled parameter names against a block with `arg`
+ * parameters, exercising the "Did you mean" suggestions.*/
+void BM_ParameterTree_InvalidNameSuggestions(State& state)
+{
+  const auto num_parameters = static_cast<size_t>(state.arg());
+  constexpr size_t num_invalid = 100;
+
+  auto params = ParameterTree("LargeBlock", "No description");
+  for (size_t i = 0; i < num_parameters; ++i)
+    params.addOptionalParameter(
+      "parameter_" + std::to_string(i), "A parameter", 1.0);
+
+  elke::DataTree block("LargeBlock");
+  block.setGrossType(elke::DataGrossType::MAP);
+  block.setTag("address", "LargeBlock");
+  block.setTag("mark", "bench");
+  for (size_t i = 0; i < num_invalid; ++i)
+  {
+    auto child = std::make_shared<elke::DataTree>(
+      "paramter_" + std::to_string(i % num_parameters));
+    child->setGrossType(elke::DataGrossType::SCALAR);
+    child->setValue(elke::ScalarValue(1.0));
+    block.addChild(child);
+  }
+
+  for (auto _ : state)
+  {
+    elke::ParameterDiagnostics diagnostics;
+    params.processSpecification(diagnostics, block);
+    doNotOptimize(diagnostics);
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations() * num_invalid));
+}
+elkeBenchmarkArgs(BM_ParameterTree_InvalidNameSuggestions, 10, 300);
+
+// ###################################################################
+/**Checks an integer array of `arg` string entries, i.e., one error per
+ * entry. The errors are recorded but not formatted.*/
+void BM_ParameterTree_ManyErrors(State& state)
+{
+  const auto num_entries = static_cast<size_t>(state.arg());
+
+  auto params = ParameterTree("Block", "No description");
+  params.addOptionalParameter("values", "Values", std::vector<int>{});
+
+  elke::DataTree block("Block");
+  block.setGrossType(elke::DataGrossType::MAP);
+  block.setTag("address", "Block");
+  block.setTag("mark", "bench");
+  auto values = std::make_shared<elke::DataTree>("values");
+  values->setGrossType(elke::DataGrossType::SEQUENCE);
+  for (size_t i = 0; i < num_entries; ++i)
+  {
+    auto entry = std::make_shared<elke::DataTree>(std::to_string(i));
+    entry->setGrossType(elke::DataGrossType::SCALAR);
+    entry->setValue(elke::ScalarValue("not a number"));
+    values->addChild(entry);
+  }
+  block.addChild(values);
+
+  for (auto _ : state)
+  {
+    elke::ParameterDiagnostics diagnostics;
+    params.processSpecification(diagnostics, block);
+    doNotOptimize(diagnostics);
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations() * num_entries));
+}
+elkeBenchmarkArgs(BM_ParameterTree_ManyErrors, 1000, 100000);
+
+// ###################################################################
+/**A block with `num_parameters` parameters, cycling through floats,
+ * integers, strings, booleans and integer arrays.*/
+ParameterTree makeLargeSpecification(const size_t num_parameters)
+{
+  auto params = ParameterTree("LargeBlock", "No description");
+  for (size_t i = 0; i < num_parameters; ++i)
+  {
+    const std::string name = "parameter_" + std::to_string(i);
+    switch (i % 5)
+    {
+      // clang-format off
+      case 0: params.addOptionalParameter(name, "", 1.0); break;
+      case 1: params.addRequiredParameter<int>(name, ""); break;
+      case 2: params.addOptionalParameter(name, "", std::string{}); break;
+      case 3: params.addOptionalParameter(name, "", false); break;
+      default: params.addOptionalParameter(name, "", std::vector<int>{}); break;
+      // clang-format on
+    }
+  }
+  return params;
+}
+
+/**Valid data for makeLargeSpecification, in reverse order of declaration
+ * and with 16 entries per array.*/
+elke::DataTree makeLargeBlock(const size_t num_parameters)
+{
+  elke::DataTree block("LargeBlock");
+  block.setGrossType(elke::DataGrossType::MAP);
+  block.setTag("address", "LargeBlock");
+  block.setTag("mark", "bench");
+
+  auto add_scalar = [](elke::DataTree& tree,
+                       const std::string& name,
+                       const elke::ScalarValue& value)
+  {
+    auto child = std::make_shared<elke::DataTree>(name);
+    child->setGrossType(elke::DataGrossType::SCALAR);
+    child->setValue(value);
+    tree.addChild(child);
+  };
+
+  for (size_t i = num_parameters; i-- > 0;)
+  {
+    const std::string name = "parameter_" + std::to_string(i);
+    switch (i % 5)
+    {
+      // clang-format off
+      case 0: add_scalar(block, name, elke::ScalarValue(0.5)); break;
+      case 1: add_scalar(block, name, elke::ScalarValue(int64_t(1))); break;
+      case 2: add_scalar(block, name, elke::ScalarValue("value")); break;
+      case 3: add_scalar(block, name, elke::ScalarValue(true)); break;
+      // clang-format on
+      default:
+      {
+        auto values = std::make_shared<elke::DataTree>(name);
+        values->setGrossType(elke::DataGrossType::SEQUENCE);
+        for (int64_t j = 0; j < 16; ++j)
+          add_scalar(*values, std::to_string(j), elke::ScalarValue(j));
+        block.addChild(values);
+      }
+    }
+  }
+  return block;
+}
+
+// ###################################################################
+/**Validates a block of `arg` parameters with processSpecification, the
+ * baseline for BM_ParameterProgram_Validate.*/
+void BM_ParameterTree_ProcessLargeSpecification(State& state)
+{
+  const auto num_parameters = static_cast<size_t>(state.arg());
+  auto params = makeLargeSpecification(num_parameters);
+  const auto block = makeLargeBlock(num_parameters);
+
+  for (auto _ : state)
+  {
+    elke::ParameterDiagnostics diagnostics;
+    params.processSpecification(diagnostics, block);
+    doNotOptimize(diagnostics);
+  }
+  state.setItemsProcessed(
+    static_cast<int64_t>(state.iterations() * num_parameters));
+}
+elkeBenchmarkArgs(BM_ParameterTree_ProcessLargeSpecification, 100, 10000);
+
+// ###################################################################
+/**Validates the same blocks as BM_ParameterTree_ProcessLargeSpecification
+ * with a compiled ParameterProgram.*/
+void BM_ParameterProgram_Validate(State& state)
+{
+  const auto num_parameters = static_cast<size_t>(state.arg());
+  const auto params = makeLargeSpecification(num_parameters);
+  const auto block = makeLargeBlock(num_parameters);
+  const elke::ParameterProgram program(params);
+
+  for (auto _ : state)
+  {
+    elke::ParameterDiagnostics diagnostics;
+    program.validate(diagnostics, block);
+    if (diagnostics.hasErrors())
+    {
+      state.skipWithError(diagnostics.errorsAsString());
+      break;
+    }
+    doNotOptimize(diagnostics);
+  }
+  state.setItemsProcessed(
+    static_cast<int64_t>(state.iterations() * num_parameters));
+}
+elkeBenchmarkArgs(BM_ParameterProgram_Validate, 100, 10000);
+
+// ###################################################################
+void BM_ParameterProgram_Compile(State& state)
+{
+  const auto num_parameters = static_cast<size_t>(state.arg());
+  const auto params = makeLargeSpecification(num_parameters);
+
+  for (auto _ : state)
+    doNotOptimize(elke::ParameterProgram(params));
+  state.setItemsProcessed(
+    static_cast<int64_t>(state.iterations() * num_parameters));
+}
+elkeBenchmarkArgs(BM_ParameterProgram_Compile, 100, 10000);
+
+// ###################################################################
+/**Checks `arg` packed values with RangeCheck::passes, i.e., the batch
+ * path without a DataTree.*/
+void BM_RangeCheck_Packed(State& state)
+{
+  const auto num_values = static_cast<size_t>(state.arg());
+  std::vector<double> values(num_values);
+  for (size_t i = 0; i < num_values; ++i)
+    values[i] = static_cast<double>(i % 1000) / 1000.0;
+
+  const elke::param_checks::RangeCheck check(0.0, 1.0);
+  for (auto _ : state)
+    doNotOptimize(check.passes(values.data(), values.size()));
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations() * num_values));
+}
+elkeBenchmarkArgs(BM_RangeCheck_Packed, 1000, 1000000);
+
+// ###################################################################
+/**Checks an array of `arg` floats with RangeCheck::performCheck, which
+ * packs the entries first.*/
+void BM_RangeCheck_Array(State& state)
+{
+  const auto num_values = static_cast<size_t>(state.arg());
+  elke::DataTree values("values");
+  values.setGrossType(elke::DataGrossType::SEQUENCE);
+  for (size_t i = 0; i < num_values; ++i)
+  {
+    auto entry = std::make_shared<elke::DataTree>(std::to_string(i));
+    entry->setGrossType(elke::DataGrossType::SCALAR);
+    entry->setValue(elke::ScalarValue(static_cast<double>(i % 1000) / 1000.0));
+    values.addChild(entry);
+  }
+
+  const elke::param_checks::RangeCheck check(0.0, 1.0);
+  const elke::ParameterValidationContext context(/*assignment_flag=*/false);
+  const std::string name = "values";
+  for (auto _ : state)
+  {
+    elke::ParameterDiagnostics diagnostics;
+    doNotOptimize(check.performCheck(diagnostics, values, context, name));
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations() * num_values));
+}
+elkeBenchmarkArgs(BM_RangeCheck_Array, 1000, 1000000);
+
+} // namespace
@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+
+#include "elke_core/data_types/ScalarValue.h"
+
+namespace
+{
+using elke::bench::doNotOptimize;
+using elke::bench::State;
+using elke::ScalarType;
+using elke::ScalarValue;
+
+// ###################################################################
+void BM_ScalarValue_ConstructInteger(State& state)
+{
+  int64_t i = 0;
+  for (auto _ : state)
+    doNotOptimize(ScalarValue(++i));
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_ScalarValue_ConstructInteger);
+
+// ###################################################################
+void BM_ScalarValue_ConstructFloat(State& state)
+{
+  double x = 0.0;
+  for (auto _ : state)
+    doNotOptimize(ScalarValue(x += 0.5));
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_ScalarValue_ConstructFloat);
+
+// ###################################################################
+void BM_ScalarValue_ConstructString(State& state)
+{
+  const std::string text = "a_moderately_long_parameter_value";
+  for (auto _ : state)
+    doNotOptimize(ScalarValue(text));
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_ScalarValue_ConstructString);
+
+// ###################################################################
+void BM_ScalarValue_Copy(State& state)
+{
+  const ScalarValue value(std::string("copy me"));
+  for (auto _ : state)
+  {
+    ScalarValue copy(value);
+    doNotOptimize(copy);
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_ScalarValue_Copy);
+
+// ###################################################################
+void BM_ScalarValue_StringToFloat(State& state)
+{
+  const ScalarValue value("1.2345e-3");
+  for (auto _ : state)
+    doNotOptimize(value.convertedToType(ScalarType::FLOAT));
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_ScalarValue_StringToFloat);
+
+// ###################################################################
+void BM_ScalarValue_StringToInteger(State& state)
+{
+  const ScalarValue value("123456");
+  for (auto _ : state)
+    doNotOptimize(value.convertedToType(ScalarType::INTEGER));
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_ScalarValue_StringToInteger);
+
+// ###################################################################
+void BM_ScalarValue_IsConvertible(State& state)
+{
+  const ScalarValue value("not a number");
+  for (auto _ : state)
+    doNotOptimize(value.isConvertibleToType(ScalarType::FLOAT));
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_ScalarValue_IsConvertible);
+
+// ###################################################################
+void BM_ScalarValue_FloatToString(State& state)
+{
+  const ScalarValue value(3.14159265358979);
+  for (auto _ : state)
+    doNotOptimize(value.convertToString());
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_ScalarValue_FloatToString);
+
+} // namespace
@@ -0,0 +1,221 @@
+#include "Benchmark.h"
+
+#include "elke_core/math/TensorRank2Dim3Array.h"
+#include "elke_core/math/Vec3Expr.h"
+#include "elke_core/math/simd_dispatch.h"
+
+namespace
+{
+using elke::bench::clobberMemory;
+using elke::bench::doNotOptimize;
+using elke::bench::State;
+using elke::math::Vec3;
+
+/**Copy of the previous Vec3 implementation (hand-written copy operations and
+ * allocating list constructors), kept as the benchmark reference.*/
+struct LegacyVec3
+{
+  double x;
+  double y;
+  double z;
+
+  LegacyVec3() { x = 0.0; y = 0.0; z = 0.0; }
+  LegacyVec3(double a, double b, double c) { x = a; y = b; z = c; }
+  LegacyVec3(std::initializer_list<double> list)
+  {
+    x = 0.0; y = 0.0; z = 0.0;
+    if (not empty(list))
+    {
+      std::vector<double> vec = list;
+      for (size_t i = 0; ((i < 3) and (i < vec.size())); ++i)
+      {
+        if (i == 0) x = vec[i];
+        if (i == 1) y = vec[i];
+        if (i == 2) z = vec[i];
+      }
+    }
+  }
+  LegacyVec3(const LegacyVec3& that)
+  {
+    this->x = that.x;
+    this->y = that.y;
+    this->z = that.z;
+  }
+  LegacyVec3& operator=(const LegacyVec3& that)
+  {
+    this->x = that.x;
+    this->y = that.y;
+    this->z = that.z;
+    return *this;
+  }
+  LegacyVec3 operator+(const LegacyVec3& that) const
+  {
+    LegacyVec3 newVector;
+    newVector.x = this->x + that.x;
+    newVector.y = this->y + that.y;
+    newVector.z = this->z + that.z;
+    return newVector;
+  }
+  LegacyVec3 operator-(const LegacyVec3& that) const
+  {
+    LegacyVec3 newVector;
+    newVector.x = this->x - that.x;
+    newVector.y = this->y - that.y;
+    newVector.z = this->z - that.z;
+    return newVector;
+  }
+  LegacyVec3 operator*(const double value) const
+  {
+    LegacyVec3 newVector;
+    newVector.x = this->x * value;
+    newVector.y = this->y * value;
+    newVector.z = this->z * value;
+    return newVector;
+  }
+};
+
+template <class V>
+std::vector<V> makeVectors(size_t n)
+{
+  std::vector<V> vectors;
+  vectors.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    vectors.push_back(V{0.1 * i, 1.0 - 0.2 * i, 0.3 + i});
+  return vectors;
+}
+
+//=============================================== Vec3 vs. previous Vec3
+// ###################################################################
+template <class V>
+void BM_Vec3_ListConstruct(State& state)
+{
+  double x = 0.0;
+  for (auto _ : state)
+  {
+    const V v{x += 1.0, 1.0, 2.0};
+    doNotOptimize(v);
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+elkeBenchmark(BM_Vec3_ListConstruct<LegacyVec3>);
+elkeBenchmark(BM_Vec3_ListConstruct<Vec3>);
+
+// ###################################################################
+template <class V>
+void BM_Vec3_CopyArray(State& state)
+{
+  const auto n = static_cast<size_t>(state.arg());
+  const auto vectors = makeVectors<V>(n);
+  for (auto _ : state)
+  {
+    std::vector<V> copy(vectors);
+    doNotOptimize(copy.data());
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+elkeBenchmarkArgs(BM_Vec3_CopyArray<LegacyVec3>, 4096);
+elkeBenchmarkArgs(BM_Vec3_CopyArray<Vec3>, 4096);
+
+// ###################################################################
+/**w_i = a_i + b_i*s - c_i over an array.*/
+template <class V>
+void BM_Vec3_Chain(State& state)
+{
+  const size_t n = 4096;
+  const auto in = makeVectors<V>(n + 2);
+  std::vector<V> out(n);
+  const double s = 0.5;
+  for (auto _ : state)
+  {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = in[i] + in[i + 1] * s - in[i + 2];
+    clobberMemory();
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+elkeBenchmark(BM_Vec3_Chain<LegacyVec3>);
+elkeBenchmark(BM_Vec3_Chain<Vec3>);
+
+// ###################################################################
+void BM_Vec3_ChainLazy(State& state)
+{
+  using namespace elke::math::expr;
+  const size_t n = 4096;
+  const auto in = makeVectors<Vec3>(n + 2);
+  std::vector<Vec3> out(n);
+  const double s = 0.5;
+  for (auto _ : state)
+  {
+    for (size_t i = 0; i < n; ++i)
+      out[i] = lazy(in[i]) + lazy(in[i + 1]) * s - lazy(in[i + 2]);
+    clobberMemory();
+  }
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+elkeBenchmark(BM_Vec3_ChainLazy);
+
+//=============================================== Batch kernels
+/**Runs `body` with the given instruction set active.*/
+template <class F>
+void withInstructionSet(State& state, F&& body)
+{
+  using namespace elke::math;
+  const auto requested = static_cast<SIMDInstructionSet>(state.arg());
+  if (requested > detectSIMDInstructionSet())
+  {
+    state.skipWithError("Instruction set not supported by this CPU.");
+    return;
+  }
+  setActiveSIMDInstructionSet(requested);
+  state.setLabel(SIMDInstructionSetName(requested));
+  body();
+  setActiveSIMDInstructionSet(detectSIMDInstructionSet());
+}
+
+// ###################################################################
+/**Argument: 0=SCALAR, 1=AVX2.*/
+void BM_Vec3Array_Cross(State& state)
+{
+  withInstructionSet(state,
+                     [&state]
+                     {
+                       const size_t n = 4096;
+                       const elke::math::Vec3Array a(makeVectors<Vec3>(n));
+                       elke::math::Vec3Array out;
+                       for (auto _ : state)
+                       {
+                         elke::math::cross(a, a, out);
+                         clobberMemory();
+                       }
+                       state.setItemsProcessed(
+                         static_cast<int64_t>(state.iterations() * n));
+                     });
+}
+elkeBenchmarkArgs(BM_Vec3Array_Cross, 0, 1);
+
+// ###################################################################
+/**Argument: 0=SCALAR, 1=AVX2.*/
+void BM_TensorRank2Dim3Array_Inverse(State& state)
+{
+  withInstructionSet(
+    state,
+    [&state]
+    {
+      using namespace elke::math;
+      const size_t n = 4096;
+      TensorRank2Dim3Array a(n);
+      for (size_t i = 0; i < n; ++i)
+        a.set(i,
+              TensorRank2Dim3(4.0 + i, 1.0, 0.5, 1.0, 3.0, 0.25, 0.5, 0.25, 2.0));
+      TensorRank2Dim3Array out;
+      for (auto _ : state)
+      {
+        inverse(a, out);
+        clobberMemory();
+      }
+      state.setItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+    });
+}
+elkeBenchmarkArgs(BM_TensorRank2Dim3Array_Inverse, 0, 1);
+
+} // namespace
@@ -0,0 +1,32 @@
+#include "Benchmark.h"
+#include "bench_utils.h"
+
+#include "elke_core/input/YAMLInput.h"
+#include "elke_core/FrameworkCore.h"
+
+namespace
+{
+using elke::bench::doNotOptimize;
+using elke::bench::State;
+
+// ###################################################################
+/**Parses a generated deck of `arg` nodes from disk into a DataTree.*/
+void BM_YAMLInput_ParseDeck(State& state)
+{
+  auto& logger = elke::FrameworkCore::getInstance().getLogger();
+  const auto num_nodes = static_cast<size_t>(state.arg());
+  const auto deck = elke::bench::generateYAMLDeck(num_nodes);
+  const auto file_name = elke::bench::writeTemporaryFile(
+    "elke_bench_deck_" + std::to_string(num_nodes) + ".yaml", deck);
+
+  elke::YAMLInput parser(logger);
+  for (auto _ : state)
+    doNotOptimize(parser.parseInputFile(file_name));
+
+  const auto iterations = static_cast<int64_t>(state.iterations());
+  state.setBytesProcessed(iterations * static_cast<int64_t>(deck.size()));
+  state.setItemsProcessed(iterations * static_cast<int64_t>(num_nodes));
+}
+elkeBenchmarkArgs(BM_YAMLInput_ParseDeck, 1000, 10000, 100000);
+
+} // namespace
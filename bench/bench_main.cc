@@ -0,0 +1,11 @@
+#include "Benchmark.h"
+
+#include "elke_core/FrameworkCore.h"
+
+/**Entry point of elke_bench. The framework core is initialized (MPI, logger)
+ * but not executed; all `--benchmark_*` arguments go to the harness.*/
+int main(const int argc, char** argv)
+{
+  elke::FrameworkCore::initialize(argc, argv);
+  return elke::bench::runBenchmarks(argc, argv);
+}
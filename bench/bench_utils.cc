@@ -0,0 +1,50 @@
+#include "bench_utils.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace elke::bench
+{
+
+// ###################################################################
+std::string generateYAMLDeck(const size_t num_nodes)
+{
+  // Each component contributes 10 nodes: the component map, 5 scalars, and a
+  // 3-entry sequence plus the sequence node itself.
+  const size_t nodes_per_component = 10;
+  const size_t num_components =
+    std::max<size_t>(1, num_nodes / nodes_per_component);
+
+  std::ostringstream deck;
+  deck << "TestSyntaxBlock:\n";
+  deck << "  scale: 1.0\n";
+  deck << "  offset: 1.0\n";
+  deck << "  optionA: 12\n";
+  deck << "  components:\n";
+  for (size_t c = 0; c < num_components; ++c)
+  {
+    deck << "    component_" << c << ":\n";
+    deck << "      type: \"Component\"\n";
+    deck << "      id: " << c << "\n";
+    deck << "      weight: " << 0.5 + static_cast<double>(c) * 1.0e-3 << "\n";
+    deck << "      active: " << (c % 2 == 0 ? "true" : "false") << "\n";
+    deck << "      label: comp" << c << "\n";
+    deck << "      bounds: [" << c << ", " << c + 1 << ", 1.5e-3]\n";
+  }
+
+  return deck.str();
+}
+
+// ###################################################################
+std::string writeTemporaryFile(const std::string& stem,
+                               const std::string& content)
+{
+  const auto path = std::filesystem::temp_directory_path() / stem;
+  std::ofstream file(path, std::ios::binary);
+  file << content;
+
+  return path.string();
+}
+
+} // namespace elke::bench
@@ -0,0 +1,22 @@
+#ifndef ELKE_BENCH_BENCH_UTILS_H
+#define ELKE_BENCH_BENCH_UTILS_H
+
+#include <string>
+
+namespace elke::bench
+{
+
+/**Generates a TestSyntaxBlock-style YAML deck with approximately `num_nodes`
+ * data-tree nodes. The bulk of the nodes sit in the `components` map, each
+ * component mixing strings, integers, floats, booleans and a short
+ * sequence.*/
+std::string generateYAMLDeck(size_t num_nodes);
+
+/**Writes `content` to a file in the temporary directory and returns the
+ * file's path. Files with the same `stem` are overwritten.*/
+std::string writeTemporaryFile(const std::string& stem,
+                               const std::string& content);
+
+} // namespace elke::bench
+
+#endif // ELKE_BENCH_BENCH_UTILS_H
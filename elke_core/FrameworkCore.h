@@ -9,6 +9,7 @@
 #include "elke_core/registration/registration.h"
 #include "elke_core/input/InputProcessor.h"
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -76,6 +77,11 @@ private:
   /**Executes a named task by notifying all subscribers.*/
   void executeTask(const std::string& task_name) const;
 
+  /**Runs `work` and then executes the named task. The wall time of `work` is
+   * logged at verbosity level 2.*/
+  void executeTimedTask(const std::string& task_name,
+                        const std::function<void()>& work) const;
+
 public:
   /**Forcibly quits execution by throwing `std::runtime_error`.*/
   static void forcedQuit(const std::string& reason = "");
@@ -4,6 +4,9 @@
 
 #include "cpptrace/cpptrace.hpp"
 
+#include <chrono>
+#include <iomanip>
+
 namespace elke
 {
 
@@ -73,11 +76,12 @@ int FrameworkCore::execute()
     core.respondToFrameworkCoreCLAs();
     core.executeTask("respond_to_CLAs");
 
-    core.m_input_processor.parseInputFiles();
-    core.executeTask("input_parsing");
+    core.executeTimedTask("input_parsing",
+                          [&core] { core.m_input_processor.parseInputFiles(); });
 
-    core.m_input_processor.checkInputDataForSyntaxBlocks();
-    core.executeTask("input_checking");
+    core.executeTimedTask(
+      "input_checking",
+      [&core] { core.m_input_processor.checkInputDataForSyntaxBlocks(); });
   }
   catch (const std::exception& exception_object)
   {
@@ -107,6 +111,22 @@ void FrameworkCore::executeTask(const std::string& task_name) const
   }
 }
 
+// ###################################################################
+void FrameworkCore::executeTimedTask(const std::string& task_name,
+                                     const std::function<void()>& work) const
+{
+  const auto start = std::chrono::steady_clock::now();
+  work();
+  const auto stop = std::chrono::steady_clock::now();
+
+  const double seconds = std::chrono::duration<double>(stop - start).count();
+  getLogger().log(LogVerbosity::LEVEL_2)
+    << "Task \"" << task_name << "\" took " << std::fixed
+    << std::setprecision(6) << seconds << " s";
+
+  executeTask(task_name);
+}
+
 // ###################################################################
 void FrameworkCore::forcedQuit(const std::string& reason /*=""*/)
 {
@@ -74,6 +74,42 @@ void FrameworkCore::registerFrameworkCoreSpecificCLI()
                                         /*only_one_allowed=*/true,
                                         /*requires_value=*/false);
 
+  const auto cli8 = CommandLineArgument(
+    "lazy-input",
+    "",
+    "Turns on/off lazy parsing of input files. Blocks of the input are then "
+    "only converted to data-trees when they are used, but are still checked "
+    "for syntax errors and duplicate keys.",
+    /*default_value=*/ScalarValue(false),
+    /*only_one_allowed=*/true,
+    /*requires_value=*/true);
+
+  const auto cli9 = CommandLineArgument(
+    "input-cache-dir",
+    "",
+    "Directory of the parsed-input cache. Input files whose content has "
+    "already been parsed are then loaded from the cache.",
+    /*default_value=*/ScalarValue(""),
+    /*only_one_allowed=*/true,
+    /*requires_value=*/true);
+
+  const auto cli10 = CommandLineArgument(
+    "no-input-cache",
+    "",
+    "Disables the parsed-input cache, even if --input-cache-dir is given.",
+    /*default_value=*/ScalarValue(false),
+    /*only_one_allowed=*/true,
+    /*requires_value=*/false);
+
+  const auto cli11 = CommandLineArgument(
+    "dedup-input",
+    "",
+    "Turns on/off the deduplication of input files. Identical subtrees, e.g., "
+    "repeated component definitions, are then stored once.",
+    /*default_value=*/ScalarValue(false),
+    /*only_one_allowed=*/true,
+    /*requires_value=*/true);
+
   m_CLI.registerNewCLA(cli0);
   m_CLI.registerNewCLA(cli1);
   m_CLI.registerNewCLA(cli2);
@@ -82,6 +118,10 @@ void FrameworkCore::registerFrameworkCoreSpecificCLI()
   m_CLI.registerNewCLA(cli5);
   m_CLI.registerNewCLA(cli6);
   m_CLI.registerNewCLA(cli7);
+  m_CLI.registerNewCLA(cli8);
+  m_CLI.registerNewCLA(cli9);
+  m_CLI.registerNewCLA(cli10);
+  m_CLI.registerNewCLA(cli11);
 }
 
 // ###################################################################
@@ -106,7 +146,7 @@ void FrameworkCore::respondToFrameworkCoreCLAs()
     {
       const auto command = basic_command.getValue<std::string>();
       logger.log() << command << "\n";
-      const auto& words = string_utils::splitString(command);
+      const auto words = string_utils::splitStringView(command);
 
       if (not words.empty() and words[0] == "call")
         this->basicCommandCall(command);
@@ -117,7 +157,7 @@ void FrameworkCore::respondToFrameworkCoreCLAs()
           "Command Line Argument --basic/-b processes "
           "only commands that start with 'call'."
           " Unknown command '" +
-          words[0] + "'.";
+          std::string(words.empty() ? "" : words[0]) + "'.";
         logger.errorAllRanks() << error_message;
         elke::Abort("CLA processing.");
       }
@@ -154,6 +194,38 @@ void FrameworkCore::respondToFrameworkCoreCLAs()
     this->m_input_processor.setEchoInputData(value);
   } // if (supplied_clas.has("echo-input-data"))
 
+  if (supplied_clas.has("lazy-input"))
+  {
+    const auto& input_CLA = supplied_clas.getCLAbyName("lazy-input");
+    const auto& inputs = input_CLA.m_values_assigned;
+
+    const bool value = inputs.front().getValue<std::string>() == "true";
+
+    this->m_input_processor.setLazyInput(value);
+  } // if (supplied_clas.has("lazy-input"))
+
+  if (supplied_clas.has("dedup-input"))
+  {
+    const auto& input_CLA = supplied_clas.getCLAbyName("dedup-input");
+    const auto& inputs = input_CLA.m_values_assigned;
+
+    const bool value = inputs.front().getValue<std::string>() == "true";
+
+    this->m_input_processor.setDeduplicateInput(value);
+  } // if (supplied_clas.has("dedup-input"))
+
+  if (supplied_clas.has("input-cache-dir"))
+  {
+    const auto& input_CLA = supplied_clas.getCLAbyName("input-cache-dir");
+    const auto& inputs = input_CLA.m_values_assigned;
+
+    this->m_input_processor.setInputCacheDirectory(
+      inputs.front().getValue<std::string>());
+  } // if (supplied_clas.has("input-cache-dir"))
+
+  if (supplied_clas.has("no-input-cache"))
+    this->m_input_processor.setUseInputCache(false);
+
   if (supplied_clas.has("stop_after_input_parsing"))
     m_task_at_which_to_stop = "input_parsing";
 }
@@ -162,7 +234,7 @@ void FrameworkCore::respondToFrameworkCoreCLAs()
 void FrameworkCore::basicCommandCall(const std::string& command_string) const
 {
   auto& logger = this->getLogger();
-  const auto& words = elke::string_utils::splitString(command_string);
+  const auto words = elke::string_utils::splitStringView(command_string);
 
   //=================================== Check sufficient words
   if (words.size() < 2)
@@ -196,8 +268,8 @@ void FrameworkCore::basicCommandCall(const std::string& command_string) const
   }
   if (!function_found)
   {
-    throw std::runtime_error("Registered Nullary function '" + function_name +
-                             "' not found.");
+    throw std::runtime_error("Registered Nullary function '" +
+                             std::string(function_name) + "' not found.");
   }
 }
 
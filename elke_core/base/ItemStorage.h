@@ -1,46 +1,246 @@
 #ifndef ELK_E_ITEMSTORAGE_H
 #define ELK_E_ITEMSTORAGE_H
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace elke
 {
 
-/**An ItemStorage is a templated class that handles the storage of items.*/
+/**An ItemStorage is a templated class that handles the storage of items.
+ *
+ * The storage is a sharded slot-map. An item is addressed by a handle that
+ * packs a shard index, a slot index and a generation counter:
+ * ```
+ * bit  0.. 2  shard      (8 shards)
+ * bit  3..22  slot       (1M slots per shard)
+ * bit 23..30  generation (1..255, never 0)
+ * ```
+ * The layout keeps every handle a positive 31-bit value so that it survives
+ * the round trip through the `int` handles of the C API. Handle 0 is never
+ * issued.
+ *
+ * - Lookups are O(1) and take no storage lock. Slots live in fixed-size
+ *   chunks that never move, the generation of a slot is atomic and the item
+ *   pointer is read with the atomic shared_ptr accessors.
+ * - Deposits and releases lock only the shard they touch. Deposits are
+ *   spread over the shards round-robin so concurrent writers rarely contend.
+ * - Releasing an item bumps the generation of its slot, which invalidates all
+ *   outstanding handles to it, and returns the slot for reuse. A slot whose
+ *   generation is exhausted is retired instead of reused so that a stale
+ *   handle can never alias a new item.
+ */
 template <class T>
 class ItemStorage
 {
-  size_t m_next_item_id = 1;
-  std::map<size_t, std::shared_ptr<T>> m_items;
+  static constexpr uint32_t SHARD_BITS = 3;
+  static constexpr uint32_t SLOT_BITS = 20;
+  static constexpr uint32_t GENERATION_BITS = 8;
+
+  static constexpr uint32_t NUM_SHARDS = 1u << SHARD_BITS;
+  static constexpr uint32_t MAX_SLOTS = 1u << SLOT_BITS;
+  static constexpr uint32_t MAX_GENERATION = (1u << GENERATION_BITS) - 1;
+
+  static constexpr uint32_t CHUNK_BITS = 10;
+  static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+  static constexpr uint32_t NUM_CHUNKS = MAX_SLOTS / CHUNK_SIZE;
+
+  /**A single storage slot.*/
+  struct Slot
+  {
+    std::atomic<uint32_t> m_generation = 1;
+    std::shared_ptr<T> m_item;
+  };
+
+  /**A shard owns its own chunks, free-list and writer lock.*/
+  struct Shard
+  {
+    std::mutex m_writer_mutex;
+    std::array<std::atomic<Slot*>, NUM_CHUNKS> m_chunks{};
+    uint32_t m_num_slots_used = 0;
+    std::vector<uint32_t> m_free_slots;
+
+    ~Shard()
+    {
+      for (auto& chunk : m_chunks)
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+  };
+
+  std::array<Shard, NUM_SHARDS> m_shards;
+  std::atomic<uint32_t> m_next_shard = 0;
+  std::atomic<size_t> m_num_items = 0;
 
 public:
-  /**Deposits an item into the stack.*/
+  ItemStorage() = default;
+  ItemStorage(const ItemStorage&) = delete;
+  ItemStorage& operator=(const ItemStorage&) = delete;
+
+  /**Deposits an item into the storage and returns its handle.*/
   size_t depositItem(std::shared_ptr<T> item)
   {
-    m_items.insert(std::make_pair(m_next_item_id, item));
-    return m_next_item_id++;
+    const uint32_t shard_id =
+      m_next_shard.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+    auto& shard = m_shards[shard_id];
+
+    std::lock_guard<std::mutex> lock(shard.m_writer_mutex);
+
+    uint32_t slot_id;
+    if (not shard.m_free_slots.empty())
+    {
+      slot_id = shard.m_free_slots.back();
+      shard.m_free_slots.pop_back();
+    }
+    else
+    {
+      if (shard.m_num_slots_used == MAX_SLOTS)
+        throw std::logic_error("ItemStorage capacity exhausted.");
+
+      slot_id = shard.m_num_slots_used++;
+      auto& chunk = shard.m_chunks[slot_id >> CHUNK_BITS];
+      if (chunk.load(std::memory_order_relaxed) == nullptr)
+        chunk.store(new Slot[CHUNK_SIZE], std::memory_order_release);
+    }
+
+    Slot& slot = slotReference(shard, slot_id);
+    std::atomic_store(&slot.m_item, std::move(item));
+    m_num_items.fetch_add(1, std::memory_order_relaxed);
+
+    const uint32_t generation =
+      slot.m_generation.load(std::memory_order_relaxed);
+
+    return makeHandle(shard_id, slot_id, generation);
+  }
+
+  /**Removes an item from the storage. All handles to the item become invalid
+   * and the slot is made available for reuse.*/
+  void releaseItem(size_t item_id)
+  {
+    const auto [shard_id, slot_id, generation] = splitHandle(item_id);
+    auto& shard = m_shards[shard_id];
+
+    std::lock_guard<std::mutex> lock(shard.m_writer_mutex);
+
+    Slot* slot_ptr = findSlot(item_id);
+    if (slot_ptr == nullptr or
+        std::atomic_load(&slot_ptr->m_item) == nullptr)
+      throwNotInStack(item_id);
+
+    Slot& slot = *slot_ptr;
+    // Bump the generation first so that readers stop accepting the handle
+    // before the item goes away.
+    slot.m_generation.store(generation + 1, std::memory_order_release);
+    std::atomic_store(&slot.m_item, std::shared_ptr<T>(nullptr));
+    m_num_items.fetch_sub(1, std::memory_order_relaxed);
+
+    if (generation + 1 <= MAX_GENERATION)
+      shard.m_free_slots.push_back(slot_id);
   }
 
+  /**Determines whether the handle refers to a live item.*/
+  bool hasItem(size_t item_id) const { return lookUp(item_id) != nullptr; }
+
+  /**Returns the number of live items.*/
+  size_t size() const { return m_num_items.load(std::memory_order_relaxed); }
+
   /**Obtains the smart pointer for an item from the stack.*/
-  std::shared_ptr<T> getItemSharedPtr(size_t item_id)
+  std::shared_ptr<T> getItemSharedPtr(size_t item_id) const
   {
-    auto find_result = m_items.find(item_id);
-    if (find_result == m_items.end())
-      throw std::logic_error("Item-id " + std::to_string(item_id) +
-                             " not in stack.");
+    auto item = lookUp(item_id);
+    if (item == nullptr) throwNotInStack(item_id);
 
-    return find_result->second;
+    return item;
   }
-  /**Obtains a reference to an item from the stack.*/
-  T& getItemReference(size_t item_id)
+
+  /**Obtains a reference to an item from the stack. The reference is only
+   * valid for as long as the item is not released.*/
+  T& getItemReference(size_t item_id) const
   {
-    auto find_result = m_items.find(item_id);
-    if (find_result == m_items.end())
-      throw std::logic_error("Item-id " + std::to_string(item_id) +
-                             " not in stack.");
+    const auto item = lookUp(item_id);
+    if (item == nullptr) throwNotInStack(item_id);
 
-    return *find_result->second;
+    return *item;
+  }
+
+private:
+  /**Packs the handle components.*/
+  static size_t
+  makeHandle(uint32_t shard_id, uint32_t slot_id, uint32_t generation)
+  {
+    return (static_cast<size_t>(generation) << (SHARD_BITS + SLOT_BITS)) |
+           (static_cast<size_t>(slot_id) << SHARD_BITS) |
+           static_cast<size_t>(shard_id);
+  }
+
+  struct HandleParts
+  {
+    uint32_t m_shard_id;
+    uint32_t m_slot_id;
+    uint32_t m_generation;
+  };
+
+  /**Unpacks the handle components.*/
+  static HandleParts splitHandle(size_t item_id)
+  {
+    return {static_cast<uint32_t>(item_id & (NUM_SHARDS - 1)),
+            static_cast<uint32_t>((item_id >> SHARD_BITS) & (MAX_SLOTS - 1)),
+            static_cast<uint32_t>(item_id >> (SHARD_BITS + SLOT_BITS))};
+  }
+
+  static Slot& slotReference(const Shard& shard, uint32_t slot_id)
+  {
+    Slot* chunk =
+      shard.m_chunks[slot_id >> CHUNK_BITS].load(std::memory_order_acquire);
+    return chunk[slot_id & (CHUNK_SIZE - 1)];
+  }
+
+  /**Returns the slot addressed by the handle if the generation matches,
+   * otherwise nullptr.*/
+  Slot* findSlot(size_t item_id) const
+  {
+    const auto [shard_id, slot_id, generation] = splitHandle(item_id);
+    if (generation == 0 or generation > MAX_GENERATION) return nullptr;
+
+    const auto& shard = m_shards[shard_id];
+    Slot* chunk =
+      shard.m_chunks[slot_id >> CHUNK_BITS].load(std::memory_order_acquire);
+    if (chunk == nullptr) return nullptr;
+
+    Slot& slot = chunk[slot_id & (CHUNK_SIZE - 1)];
+    if (slot.m_generation.load(std::memory_order_acquire) != generation)
+      return nullptr;
+
+    return &slot;
+  }
+
+  /**Lock-free lookup of an item. Returns nullptr for stale or unknown
+   * handles.*/
+  std::shared_ptr<T> lookUp(size_t item_id) const
+  {
+    Slot* slot_ptr = findSlot(item_id);
+    if (slot_ptr == nullptr) return nullptr;
+
+    auto item = std::atomic_load(&slot_ptr->m_item);
+
+    // The slot may have been released between the generation check and the
+    // load.
+    const auto generation = splitHandle(item_id).m_generation;
+    if (slot_ptr->m_generation.load(std::memory_order_acquire) != generation)
+      return nullptr;
+
+    return item;
+  }
+
+  [[noreturn]] static void throwNotInStack(size_t item_id)
+  {
+    throw std::logic_error("Item-id " + std::to_string(item_id) +
+                           " not in stack.");
   }
 };
 
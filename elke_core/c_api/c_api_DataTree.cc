@@ -2,6 +2,8 @@
 
 #include "elke_core/FrameworkCore.h"
 #include "elke_core/data_types/DataTree.h"
+#include "elke_core/data_types/DataTreeQuery.h"
+#include "elke_core/data_types/DataTreeYAML.h"
 #include "elke_core/base/Warehouse.h"
 
 #include <string>
@@ -33,6 +35,22 @@ int elke_DataTree_makeNew(int& errorCode, const char* c_str)
   }
 }
 
+//===================================================================
+void elke_DataTree_release(int& errorCode, const int handle)
+{
+  errorCode = 0;
+  try
+  {
+    auto& warehouse = elke::FrameworkCore::getInstance().warehouse();
+    warehouse.DataTreeStorage().releaseItem(static_cast<size_t>(handle));
+  }
+  catch (std::exception& e)
+  {
+    errorCode = 1;
+    std::cout << e.what();
+  }
+}
+
 void elke_DataTree_setType(int& errorCode,
                            const int root_handle,
                            const char* address,
@@ -91,7 +109,7 @@ void elke_DataTree_printYAMLString(int& errorCode, const int handle)
 
     const elke::DataTree& tree =
       stack.getItemReference(static_cast<size_t>(handle));
-    std::cout << tree.toStringAsYAML("");
+    elke::writeDataTreeYAML(tree, std::cout);
   }
   catch (std::exception& e)
   {
@@ -100,6 +118,54 @@ void elke_DataTree_printYAMLString(int& errorCode, const int handle)
   }
 }
 
+//===================================================================
+int elke_DataTree_countQueryMatches(int& errorCode,
+                                    const int handle,
+                                    const char* query)
+{
+  errorCode = 0;
+  try
+  {
+    auto& warehouse = elke::FrameworkCore::getInstance().warehouse();
+    auto& stack = warehouse.DataTreeStorage();
+
+    const elke::DataTree& tree =
+      stack.getItemReference(static_cast<size_t>(handle));
+    const auto matches = elke::DataTreeQuery(query).run(tree);
+
+    return static_cast<int>(matches.size());
+  }
+  catch (std::exception& e)
+  {
+    errorCode = 1;
+    std::cout << e.what() << std::endl;
+    return 0;
+  }
+}
+
+//===================================================================
+void elke_DataTree_printQueryMatchesYAML(int& errorCode,
+                                         const int handle,
+                                         const char* query)
+{
+  errorCode = 0;
+  try
+  {
+    auto& warehouse = elke::FrameworkCore::getInstance().warehouse();
+    auto& stack = warehouse.DataTreeStorage();
+
+    const elke::DataTree& tree =
+      stack.getItemReference(static_cast<size_t>(handle));
+    for (const elke::DataTree* match : elke::DataTreeQuery(query).run(tree))
+      elke::writeDataTreeYAML(*match, std::cout);
+  }
+  catch (std::exception& e)
+  {
+    errorCode = 1;
+    std::cout << e.what() << std::endl;
+  }
+}
+
 //===================================================================
 void elke_DataTree_addSubTree(int& errorCode,
                               const int handle,
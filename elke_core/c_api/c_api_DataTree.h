@@ -14,6 +14,10 @@ extern "C" void elke_DataTree_addSubTree(int& errorCode,
                                          const char* address,
                                          const char* name);
 
+/**Removes the data-tree from the warehouse. The handle, and any copies of it,
+ * become invalid.*/
+extern "C" void elke_DataTree_release(int& errorCode, int handle);
+
 extern "C" void elke_DataTree_printYAMLString(int& errorCode, int handle);
 
 /**Given a handle to the data-tree, adds an integer-value to the subtree at the
@@ -49,4 +53,17 @@ extern "C" void elke_DataTree_setType(int& errorCode,
                                       const char* address,
                                       const int type_id);
 
+/**Given a handle to the data-tree, returns the number of subtrees matching
+ * a path query such as "components/[0]/initial_conditions". The path is
+ * relative to the tree, see elke::DataTreeQuery for the syntax.*/
+extern "C" int elke_DataTree_countQueryMatches(int& errorCode,
+                                               int handle,
+                                               const char* query);
+
+/**Given a handle to the data-tree, prints every subtree matching a path
+ * query in YAML format.*/
+extern "C" void elke_DataTree_printQueryMatchesYAML(int& errorCode,
+                                                    int handle,
+                                                    const char* query);
+
 #endif // ELK_E_C_API_H
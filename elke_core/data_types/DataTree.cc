@@ -1,7 +1,9 @@
 #include "DataTree.h"
+#include "DataTreeYAML.h"
 
+#include <algorithm>
+#include <stdexcept>
 #include <utility>
-#include <sstream>
 
 namespace elke
 {
@@ -11,12 +13,56 @@ DataTree::DataTree(std::string name) : m_name(std::move(name))
   m_tags["address"] = m_name;
 }
 
+/**Copy constructor. Shares the children with `other` until either tree
+ * modifies them. Lazy trees are materialized before being copied.*/
+DataTree::DataTree(const DataTree& other)
+  : m_name(other.m_name),
+    m_gross_type(other.m_gross_type),
+    m_tags(other.m_tags),
+    m_source(other.m_source),
+    m_source_offset(other.m_source_offset),
+    m_value(other.m_value)
+{
+  other.materialize();
+  m_children = other.m_children;
+  m_child_name_index = std::atomic_load(&other.m_child_name_index);
+  if (other.m_hash_valid.load(std::memory_order_acquire))
+  {
+    m_hash_low.store(other.m_hash_low.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    m_hash_high.store(other.m_hash_high.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+    m_hash_valid.store(true, std::memory_order_release);
+  }
+}
+
+/**Copy assignment. Shares the children with `other` until either tree
+ * modifies them. Lazy trees are materialized before being copied.*/
+DataTree& DataTree::operator=(const DataTree& other)
+{
+  if (this == &other) return *this;
+  other.materialize();
+  m_name = other.m_name;
+  m_gross_type = other.m_gross_type;
+  m_tags = other.m_tags;
+  m_source = other.m_source;
+  m_source_offset = other.m_source_offset;
+  m_value = other.m_value;
+  m_children = other.m_children;
+  m_lazy_children = nullptr;
+  invalidateHash();
+  std::atomic_store(&m_child_name_index,
+                    std::atomic_load(&other.m_child_name_index));
+  return *this;
+}
+
 /**Returns the general type of the data-tree.*/
 DataGrossType DataTree::grossType() const { return m_gross_type; }
 
 /**Sets the data-tree type.*/
 void DataTree::setGrossType(const DataGrossType type)
 {
+  invalidateHash();
   m_tags["type"] = DataGrossTypeName(type);
   m_gross_type = type;
 }
@@ -25,7 +71,11 @@ void DataTree::setGrossType(const DataGrossType type)
 const std::string& DataTree::name() const { return m_name; }
 
 /**Assigns a new name.*/
-void DataTree::rename(const std::string& new_name) { m_name = new_name; }
+void DataTree::rename(const std::string& new_name)
+{
+  invalidateHash();
+  m_name = new_name;
+}
 
 /**Returns a constant reference to the values.*/
 const ScalarValue& DataTree::value() const { return m_value; }
@@ -37,6 +87,7 @@ void DataTree::setValue(const ScalarValue& value)
     throw std::runtime_error(
       "Attempting to add value to DataTree " + m_name +
       " which has not been designated as a DataTreeType::Scalar");
+  invalidateHash();
   m_value = value;
 
   m_tags["type"] = m_value.typeString();
@@ -54,6 +105,8 @@ void DataTree::addChild(const DataTreePtr& child,
       "Attempting to add child to DataTree " + m_name +
       " which is not designated as either a SEQUENCE or a MAP.");
 
+  auto& children = this->detachChildren();
+
   //========================= Establish the current tree's address
   const auto address_tag_find = m_tags.find("address");
 
@@ -66,7 +119,7 @@ void DataTree::addChild(const DataTreePtr& child,
   if (prevent_duplicate)
   {
     bool duplicate_found = false;
-    for (const auto& sibling : m_children)
+    for (const auto& sibling : children)
       if (sibling->name() == child->name())
       {
         duplicate_found = true;
@@ -82,13 +135,13 @@ void DataTree::addChild(const DataTreePtr& child,
   auto child_tag = address_tag + "/" + child->name();
   if (this->m_gross_type == DataGrossType::SEQUENCE)
   {
-    const size_t id = m_children.size();
+    const size_t id = children.size();
     child_tag = address_tag + "/" + std::to_string(id);
   }
   child->setTag("address", child_tag);
 
   //========================= Add the child
-  m_children.push_back(child);
+  children.push_back(child);
 }
 
 // ###################################################################
@@ -97,15 +150,130 @@ void DataTree::setTag(const std::string& tag_name, const std::string& tag_value)
   m_tags[tag_name] = tag_value;
 }
 
+void DataTree::setSourceMark(std::shared_ptr<const DataTreeSource> source,
+                             const uint32_t offset)
+{
+  m_tags.erase("mark");
+  m_source = std::move(source);
+  m_source_offset = offset;
+}
+
 std::string DataTree::getTag(const std::string& tag_name) const
 {
   const auto find_result = m_tags.find(tag_name);
 
   if (find_result != m_tags.end()) return find_result->second;
 
+  if (m_source != nullptr and tag_name == "mark")
+    return m_source->markAt(m_source_offset);
+
   return {};
 }
 
+bool DataTree::hasTag(const std::string& tag_name) const
+{
+  return m_tags.find(tag_name) != m_tags.end() or
+         (m_source != nullptr and tag_name == "mark");
+}
+
+size_t DataTree::numTags() const
+{
+  const bool has_source_mark =
+    m_source != nullptr and m_tags.find("mark") == m_tags.end();
+  return m_tags.size() + (has_source_mark ? 1 : 0);
+}
+
+/**Returns all the tags, including a mark set with setSourceMark.*/
+std::map<std::string, std::string> DataTree::tags() const
+{
+  std::map<std::string, std::string> tags;
+  forEachTag([&tags](const std::string& tag_name, const std::string& tag_value)
+             { tags.emplace(tag_name, tag_value); });
+  return tags;
+}
+
+// ###################################################################
+/**Returns a 128-bit hash over the gross-type and value of this tree and
+ * the names and hashes of its children, in order. Lengths and type codes
+ * are hashed along with the data so that different trees cannot produce
+ * the same byte sequence.*/
+hash_utils::Hash128 DataTree::structuralHash() const
+{
+  if (m_hash_valid.load(std::memory_order_acquire))
+    return {m_hash_low.load(std::memory_order_relaxed),
+            m_hash_high.load(std::memory_order_relaxed)};
+
+  std::string bytes;
+  auto appendInteger = [&bytes](const uint64_t integer)
+  { bytes.append(reinterpret_cast<const char*>(&integer), sizeof(integer)); };
+  auto appendString = [&](const std::string& string)
+  {
+    appendInteger(string.size());
+    bytes.append(string);
+  };
+
+  appendInteger(static_cast<uint64_t>(m_gross_type));
+  if (m_gross_type == DataGrossType::SCALAR)
+  {
+    appendInteger(static_cast<uint64_t>(m_value.type()));
+    switch (m_value.type())
+    {
+      case ScalarType::STRING:
+        appendString(m_value.getValue<std::string>());
+        break;
+      case ScalarType::BOOL:
+        appendInteger(m_value.getValue<bool>() ? 1 : 0);
+        break;
+      case ScalarType::INTEGER:
+        appendInteger(static_cast<uint64_t>(m_value.getValue<int64_t>()));
+        break;
+      case ScalarType::FLOAT:
+      {
+        const double value = m_value.getValue<double>();
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+      }
+      break;
+      case ScalarType::VOID:
+      default:
+        break;
+    }
+  }
+
+  const auto& children = this->childList();
+  appendInteger(children.size());
+  for (const auto& child_ptr : children)
+  {
+    appendString(child_ptr->name());
+    const auto child_hash = child_ptr->structuralHash();
+    appendInteger(child_hash.m_low);
+    appendInteger(child_hash.m_high);
+  }
+
+  const auto hash = hash_utils::hash128(bytes);
+  m_hash_low.store(hash.m_low, std::memory_order_relaxed);
+  m_hash_high.store(hash.m_high, std::memory_order_relaxed);
+  m_hash_valid.store(true, std::memory_order_release);
+  return hash;
+}
+
+// ###################################################################
+/**Determines, from the structural hashes, whether `other` has the same
+ * gross-type, value and children as this tree.*/
+bool DataTree::structurallyEquals(const DataTree& other) const
+{
+  return this == &other or structuralHash() == other.structuralHash();
+}
+
+// ###################################################################
+/**Clears the cached structural hash and child name index.*/
+void DataTree::invalidateHash()
+{
+  m_hash_valid.store(false, std::memory_order_release);
+  if (std::atomic_load(&m_child_name_index))
+    std::atomic_store(&m_child_name_index,
+                      std::shared_ptr<const ChildNameIndex>());
+}
+
 // ###################################################################
 /**Traverses the tree and calls a callback function at each node.*/
 void DataTree::traverseWithCallback(const std::string& running_address,
@@ -120,7 +288,7 @@ void DataTree::traverseWithCallback(const std::string& running_address,
   if (m_gross_type == DataGrossType::SEQUENCE)
   {
     size_t id = 0;
-    for (const auto& child : m_children)
+    for (const auto& child : this->detachChildren())
     {
       child->traverseWithCallback(
         current_address, function, std::to_string(id));
@@ -128,7 +296,7 @@ void DataTree::traverseWithCallback(const std::string& running_address,
     }
   }
   else if (m_gross_type == DataGrossType::MAP)
-    for (const auto& child : m_children)
+    for (const auto& child : this->detachChildren())
       child->traverseWithCallback(current_address, function);
 }
 
@@ -165,70 +333,9 @@ std::string DataTree::toStringAsYAML(
   const std::string& indent,
   const std::vector<std::string>& tags_to_print /*={}*/) const
 {
-  // Every parent is responsible for indenting its own children.
-  const auto child_indent = indent + std::string(2, ' ');
-
-  std::stringstream yaml;
-
-  const std::string node_title = m_name.empty() ? "" : m_name + ":";
-
-  yaml << node_title;
-
-  auto appendTags = [&]
-  {
-    yaml << " # ";
-    for (const auto& tag : tags_to_print)
-    {
-      const auto tag_value = m_tags.find(tag);
-
-      if (tag_value != m_tags.end())
-        yaml << tag << "=" << tag_value->second << " ";
-    }
-  };
-
-  switch (this->grossType())
-  {
-    case DataGrossType::NO_DATA:
-      yaml << " null";
-      appendTags();
-      yaml << "\n";
-      break;
-
-    case DataGrossType::SCALAR:
-    {
-      if (m_value.type() == ScalarType::STRING)
-        yaml << " " << "\"" + m_value.convertToString() + "\"";
-      else
-        yaml << " " << m_value.convertToString();
-      appendTags();
-      yaml << "\n";
-    }
-    break;
-
-    case DataGrossType::SEQUENCE:
-      appendTags();
-      yaml << "\n";
-      for (const auto& child : m_children)
-      {
-        yaml << child_indent << "-";
-        yaml << child->toStringAsYAML(child_indent, tags_to_print);
-      }
-
-      break;
-
-    case DataGrossType::MAP:
-      appendTags();
-      yaml << "\n";
-      for (const auto& child : m_children)
-      {
-        yaml << child_indent;
-        yaml << child->toStringAsYAML(indent + std::string(2, ' '),
-                                      tags_to_print);
-      }
-      break;
-  }
-
-  return yaml.str();
+  std::string yaml;
+  DataTreeYAMLEmitter(yaml).emit(*this, indent, tags_to_print);
+  return yaml;
 }
 
 // ###################################################################
@@ -237,10 +344,11 @@ std::string DataTree::toStringAsYAML(
  */
 DataTree& DataTree::child(const std::string& child_name)
 {
-  if (m_children.empty())
+  const auto& children = this->detachChildren();
+  if (children.empty())
     throw std::logic_error("Child '" + child_name + "' not found");
 
-  for (const auto& child : m_children)
+  for (const auto& child : children)
     if (child->name() == child_name) return *child;
 
   throw std::logic_error("Child '" + child_name + "' not found");
@@ -252,38 +360,70 @@ DataTree& DataTree::child(const std::string& child_name)
  */
 const DataTree& DataTree::child(const std::string& child_name) const
 {
-  if (m_children.empty())
+  const auto& children = this->childList();
+  if (children.empty())
     throw std::logic_error("Child '" + child_name + "' not found");
 
-  for (const auto& child : m_children)
+  for (const auto& child : children)
     if (child->name() == child_name) return *child;
 
   throw std::logic_error("Child '" + child_name + "' not found");
 }
 
+// ###################################################################
+/**Returns a reference to the child at `index`.*/
+DataTree& DataTree::childAt(const size_t index)
+{
+  const auto& children = this->detachChildren();
+  if (index >= children.size())
+    throw std::out_of_range("Child " + std::to_string(index) +
+                            " not found in DataTree " + getTag("address"));
+  return *children[index];
+}
+
+// ###################################################################
+/**Returns a const reference to the child at `index`.*/
+const DataTree& DataTree::childAt(const size_t index) const
+{
+  const auto& children = this->childList();
+  if (index >= children.size())
+    throw std::out_of_range("Child " + std::to_string(index) +
+                            " not found in DataTree " + getTag("address"));
+  return *children[index];
+}
+
 // ###################################################################
 /**Determines if the data tree has the named child*/
 bool DataTree::hasChild(const std::string& child_name) const
 {
-  if (m_children.empty()) return false;
-
-  for (const auto& child : m_children) // NOLINT(*-use-anyofallof)
+  for (const auto& child : this->childList()) // NOLINT(*-use-anyofallof)
     if (child->name() == child_name) return true;
 
   return false;
 }
 
 // ###################################################################
-/**Returns the list of children*/
-std::vector<DataTree::DataTreePtr>& DataTree::children() { return m_children; }
+/**Returns the list of children, for modification.*/
+std::vector<DataTree::DataTreePtr>& DataTree::children()
+{
+  return this->detachChildren();
+}
+
+// ###################################################################
+/**Returns the number of children.*/
+size_t DataTree::numChildren() const
+{
+  return this->childList().size();
+}
 
 // ###################################################################
 /**Returns the list of children*/
 std::vector<DataTree::DataTreeConstPtr> DataTree::constChildren() const
 {
+  const auto& children = this->childList();
   std::vector<DataTreeConstPtr> const_children;
-  const_children.reserve(m_children.size());
-  for (const auto& child_ptr : m_children)
+  const_children.reserve(children.size());
+  for (const auto& child_ptr : children)
     const_children.push_back(child_ptr);
   return const_children;
 }
@@ -292,13 +432,143 @@ std::vector<DataTree::DataTreeConstPtr> DataTree::constChildren() const
 /**Makes a vector of all the children's gross-types.*/
 std::vector<DataGrossType> DataTree::makeChildrenGrossTypesList() const
 {
+  const auto& children = this->childList();
   std::vector<DataGrossType> types;
-  types.reserve(m_children.size());
-  for (const auto& child_ptr : m_children)
+  types.reserve(children.size());
+  for (const auto& child_ptr : children)
     types.push_back(child_ptr->grossType());
 
   return types;
 }
 
+// ###################################################################
+/**Replaces the children of this tree with those of `other`, which must be
+ * structurally equal. The structural hash is unchanged.*/
+void DataTree::shareChildrenWith(const DataTree& other)
+{
+  if (this == &other) return;
+  if (not structurallyEquals(other))
+    throw std::logic_error("DataTree " + getTag("address") +
+                           " cannot share the children of DataTree " +
+                           other.getTag("address") +
+                           " since their structures differ.");
+
+  const auto hash = structuralHash();
+  other.materialize();
+  m_children = other.m_children;
+  m_lazy_children = nullptr;
+  std::atomic_store(&m_child_name_index,
+                    std::atomic_load(&other.m_child_name_index));
+
+  m_hash_low.store(hash.m_low, std::memory_order_relaxed);
+  m_hash_high.store(hash.m_high, std::memory_order_relaxed);
+  m_hash_valid.store(true, std::memory_order_release);
+}
+
+// ###################################################################
+/**Defers building the children of this tree until they are first
+ * accessed.*/
+void DataTree::setMaterializer(DataTreeMaterializer materializer)
+{
+  if (not(m_gross_type == DataGrossType::SEQUENCE or
+          m_gross_type == DataGrossType::MAP))
+    throw std::runtime_error(
+      "Attempting to defer the children of DataTree " + m_name +
+      " which is not designated as either a SEQUENCE or a MAP.");
+
+  invalidateHash();
+  m_lazy_children = std::make_shared<LazyChildren>();
+  m_lazy_children->m_materializer = std::move(materializer);
+}
+
+// ###################################################################
+/**Returns false if the children of this tree are still pending.*/
+bool DataTree::isMaterialized() const
+{
+  const auto lazy_children = m_lazy_children;
+  return lazy_children == nullptr or lazy_children->m_done.load();
+}
+
+// ###################################################################
+/**Builds pending children, if any. Thread safe.*/
+void DataTree::materialize() const
+{
+  const auto lazy_children = m_lazy_children;
+  if (lazy_children == nullptr or lazy_children->m_done.load()) return;
+
+  std::call_once(lazy_children->m_once,
+                 [&]
+                 {
+                   DataTree staging(m_name);
+                   staging.m_gross_type = m_gross_type;
+                   staging.m_tags = m_tags;
+                   staging.m_source = m_source;
+                   staging.m_source_offset = m_source_offset;
+
+                   lazy_children->m_materializer(staging);
+
+                   if (staging.m_gross_type != m_gross_type)
+                     throw std::logic_error(
+                       "Lazily parsed DataTree " + getTag("address") +
+                       " changed its gross-type when materialized.");
+
+                   m_children = std::move(staging.m_children);
+                   lazy_children->m_materializer = nullptr;
+                   lazy_children->m_done.store(true);
+                 });
+}
+
+// ###################################################################
+/**Returns the children, materializing them if needed.*/
+const DataTree::ChildList& DataTree::childList() const
+{
+  static const ChildList no_children;
+
+  this->materialize();
+  return m_children ? *m_children : no_children;
+}
+
+// ###################################################################
+/**Returns the index of the children's names, building it if needed.
+ * Concurrent builds are identical and the first one stored is used.*/
+std::shared_ptr<const DataTree::ChildNameIndex> DataTree::childNameIndex() const
+{
+  auto index = std::atomic_load(&m_child_name_index);
+  if (index) return index;
+
+  const auto& children = this->childList();
+  auto built = std::make_shared<ChildNameIndex>();
+  built->reserve(children.size());
+  for (size_t i = 0; i < children.size(); ++i)
+    built->push_back({hash_utils::fnv1a64(children[i]->name()), i});
+  std::sort(built->begin(), built->end());
+
+  std::shared_ptr<const ChildNameIndex> published = std::move(built);
+  if (std::atomic_compare_exchange_strong(
+        &m_child_name_index, &index, published))
+    return published;
+  return index;
+}
+
+// ###################################################################
+/**Returns the children for modification, copying them first if the list
+ * is shared with a copy of this tree. The copies share their own children,
+ * so only the path being modified is ever copied.*/
+DataTree::ChildList& DataTree::detachChildren()
+{
+  this->materialize();
+  invalidateHash();
+  if (m_children == nullptr) m_children = std::make_shared<ChildList>();
+  else if (m_children.use_count() > 1)
+  {
+    auto own_children = std::make_shared<ChildList>();
+    own_children->reserve(m_children->size());
+    for (const auto& child_ptr : *m_children)
+      own_children->push_back(std::make_shared<DataTree>(*child_ptr));
+    m_children = std::move(own_children);
+  }
+
+  return *m_children;
+}
 
-} // namespace elke
\ No newline at end of file
+} // namespace elke
@@ -3,11 +3,18 @@
 
 #include "ScalarValue.h"
 #include "DataGrossType.h"
+#include "DataTreeSource.h"
+#include "elke_core/utilities/hash_utils.h"
 
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 
 /**What is a data tree? Well if you google JSON format... that is a data tree.
  *Requirements:
@@ -57,10 +64,40 @@ namespace elke
  * Tags:\n
  * Tags are super useful for shuttling metadata from source files. Examples
  * - `DataTree::setTag("mark")` can be used to mark the file location (i.e.
- *   file-name, line-number and column-number).
+ *   file-name, line-number and column-number). Parsers that know the byte
+ *   offset of a node can use `DataTree::setSourceMark` instead, which only
+ *   formats the mark when it is read.
  * - `DataTree::setTag("address")` can be used to find the address of a "leaf"
  *   within a hierarchy, e.g., `Input.yaml/systems/sub_object1/scale`. Useful
  *   for printing errors.
+ *
+ * Copies:\n
+ * Copying a DataTree is cheap and the copy is independent. The children of
+ * a copy are shared with the original until either of them is modified
+ * through a non-const accessor (`child`, `children`, `addChild`,
+ * `traverseWithCallback`, etc.), at which point that tree copies its list
+ * of children, and only the children it reaches that way are copied in
+ * turn. Const access never copies.
+ *
+ * Hashes:\n
+ * `DataTree::structuralHash` is a 128-bit hash of a tree's gross-type,
+ * value and, recursively, its children's names, gross-types and values.
+ * The tree's own name and the tags are left out, so that identical
+ * subtrees under different keys (e.g., two component definitions) have the
+ * same hash, and trees can be compared in O(1) once it is known.
+ * Each node caches its hash and its own modifiers, as well as non-const
+ * access to its children, clear it. A node that is modified through a
+ * pointer kept from when it was added to its parent cannot clear the
+ * parent's hash, so trees should be complete before they are hashed. The
+ * same holds for the index of the children's names that nodes with many
+ * children build for `forEachChildNamed`.
+ *
+ * Lazy trees:\n
+ * A parser can defer building the children of a MAP or SEQUENCE with
+ * `DataTree::setMaterializer`. The children are then built the first time
+ * anything looks at them (`child`, `children`, `constChildren`,
+ * `toStringAsYAML`, etc.), so that sections of an input that are never
+ * used only cost the parser's scan.
  */
 class DataTree
 {
@@ -69,28 +106,75 @@ class DataTree
     std::function<void(const std::string&, DataTree&)>;
   using DataTreePtr = std::shared_ptr<DataTree>;
   using DataTreeConstPtr = std::shared_ptr<const DataTree>;
+  using ChildList = std::vector<DataTreePtr>;
+
+public:
+  /**Function that adds the children to a lazily parsed tree. It receives a
+   * tree with the same name, gross-type and tags.*/
+  using DataTreeMaterializer = std::function<void(DataTree&)>;
+
+private:
+  /**Pending children of a lazy tree. Held by pointer so that the tree stays
+   * copyable; copies are materialized first and never share it.*/
+  struct LazyChildren
+  {
+    std::once_flag m_once;
+    std::atomic<bool> m_done = false;
+    DataTreeMaterializer m_materializer;
+  };
 
   /// Name of the element
   std::string m_name;
   /// Gross-type
   DataGrossType m_gross_type = DataGrossType::NO_DATA;
   std::map<std::string, std::string> m_tags;
+  /// Source of the "mark" tag when it is not stored, see setSourceMark.
+  std::shared_ptr<const DataTreeSource> m_source;
+  uint32_t m_source_offset = 0;
   ScalarValue m_value;
-  std::vector<DataTreePtr> m_children;
+  /// Shared between copies until modified, see detachChildren. Null when
+  /// there are no children. Mutable since lazy trees fill it on first
+  /// (possibly const) access.
+  mutable std::shared_ptr<ChildList> m_children;
+  std::shared_ptr<LazyChildren> m_lazy_children;
+  /// Cached structural hash. Atomic since concurrent const accesses may
+  /// fill it; they store the same value.
+  mutable std::atomic<bool> m_hash_valid = false;
+  mutable std::atomic<uint64_t> m_hash_low = 0;
+  mutable std::atomic<uint64_t> m_hash_high = 0;
+
+  /**Entry of the child name index: the hash of a child's name and the
+   * child's position.*/
+  struct ChildNameEntry
+  {
+    uint64_t m_hash = 0;
+    size_t m_position = 0;
+
+    bool operator<(const ChildNameEntry& other) const
+    {
+      return m_hash < other.m_hash or
+             (m_hash == other.m_hash and m_position < other.m_position);
+    }
+  };
+  using ChildNameIndex = std::vector<ChildNameEntry>;
+  /// Trees with fewer children are searched by name without an index.
+  static constexpr size_t MIN_INDEXED_CHILDREN = 32;
+  /// The children sorted by the hashes of their names, see
+  /// forEachChildNamed. Built on first use, cleared with the hash and
+  /// shared with copies like the children. Accessed atomically.
+  mutable std::shared_ptr<const ChildNameIndex> m_child_name_index;
 
 public:
   /**Constructor requiring the name.*/
   explicit DataTree(std::string name);
 
-  /**Copy constructor.*/
-  DataTree(const DataTree& other)
-    : m_name(other.m_name),
-      m_gross_type(other.m_gross_type),
-      m_tags(other.m_tags),
-      m_value(other.m_value),
-      m_children(other.m_children)
-  {
-  }
+  /**Copy constructor. Shares the children with `other` until either tree
+   * modifies them. Lazy trees are materialized before being copied.*/
+  DataTree(const DataTree& other);
+
+  /**Copy assignment. Shares the children with `other` until either tree
+   * modifies them. Lazy trees are materialized before being copied.*/
+  DataTree& operator=(const DataTree& other);
 
   /**Returns the name assigned to this tree.*/
   const std::string& name() const;
@@ -116,10 +200,61 @@ public:
   /**Set address tag*/
   void setTag(const std::string& tag_name, const std::string& tag_value);
 
+  /**Sets the "mark" tag to the position at byte `offset` of `source`. The
+   * mark is formatted each time it is read, by getTag or tags, and a mark
+   * set with setTag takes precedence.*/
+  void setSourceMark(std::shared_ptr<const DataTreeSource> source,
+                     uint32_t offset);
+
   /**Gets a tag.*/
   std::string getTag(const std::string& tag_name) const;
 
-  /**Traverses the tree and calls a callback function at each node.*/
+  /**Returns true if the tree has the named tag, including a mark set with
+   * setSourceMark.*/
+  bool hasTag(const std::string& tag_name) const;
+
+  /**Returns the number of tags, including a mark set with setSourceMark.*/
+  size_t numTags() const;
+
+  /**Returns a copy of all the tags, including a mark set with
+   * setSourceMark. Prefer forEachTag, which copies nothing.*/
+  std::map<std::string, std::string> tags() const;
+
+  /**Calls `function(tag_name, tag_value)` for every tag, in order of name
+   * like `tags`. A mark set with setSourceMark is formatted only here.*/
+  template <typename F>
+  void forEachTag(F&& function) const
+  {
+    static const std::string mark_name = "mark";
+    bool source_mark_pending = m_source != nullptr and
+                               m_tags.find(mark_name) == m_tags.end();
+    auto emitSourceMark = [&]()
+    {
+      const std::string mark = m_source->markAt(m_source_offset);
+      function(mark_name, mark);
+      source_mark_pending = false;
+    };
+    for (const auto& [tag_name, tag_value] : m_tags)
+    {
+      if (source_mark_pending and tag_name > mark_name) emitSourceMark();
+      function(tag_name, tag_value);
+    }
+    if (source_mark_pending) emitSourceMark();
+  }
+
+  /**Returns a 128-bit hash over the gross-type and value of this tree and
+   * the names and hashes of its children, in order. The tree's own name
+   * and the tags are not included. Computed on first use and cached.*/
+  hash_utils::Hash128 structuralHash() const;
+
+  /**Determines, from the structural hashes, whether `other` has the same
+   * gross-type, value and children as this tree, whatever the names of the
+   * two trees.*/
+  bool structurallyEquals(const DataTree& other) const;
+
+  /**Traverses the tree and calls a callback function at each node. See
+   * DataTreeTraversal.h for traversals without the address strings and
+   * std::function calls, and for parallel traversals.*/
   void traverseWithCallback(const std::string& running_address,
                             const DataTreeTraverseFunction& function,
                             const std::string& name_override = "");
@@ -132,25 +267,123 @@ public:
    * the name is not found std::logic_error is thrown.*/
   const DataTree& child(const std::string& child_name) const;
 
+  /**Returns a reference to the child at `index`, in order of addition
+   * (i.e., sequence entry `index`). Throws std::out_of_range if there is no
+   * such child.*/
+  DataTree& childAt(size_t index);
+
+  /**Returns a const reference to the child at `index`. Throws
+   * std::out_of_range if there is no such child.*/
+  const DataTree& childAt(size_t index) const;
+
   /**Determines if the data tree has the named child*/
   bool hasChild(const std::string& child_name) const;
 
   /**Returns the number of children.*/
-  size_t numChildren() const { return m_children.size(); }
+  size_t numChildren() const;
 
-  /**Returns the list of children*/
+  /**Returns the list of children, for modification. Unshares them first if
+   * they are shared with a copy.*/
   std::vector<DataTreePtr>& children();
 
   /**Returns the list of children*/
   std::vector<DataTreeConstPtr> constChildren() const;
 
+  /**Calls `function(child)` for every child, in order, without building a
+   * list like `constChildren` does.*/
+  template <typename F>
+  void forEachChild(F&& function) const
+  {
+    for (const auto& child_ptr : this->childList())
+      function(static_cast<const DataTree&>(*child_ptr));
+  }
+
+  /**Calls `function(child)` for every child, in order. Unshares the
+   * children first if they are shared with a copy.*/
+  template <typename F>
+  void forEachChild(F&& function)
+  {
+    for (const auto& child_ptr : this->detachChildren())
+      function(*child_ptr);
+  }
+
+  /**Calls `function(child)` for every child named `child_name`, in order.
+   * Trees with many children find them in an index of the names, built on
+   * first use, instead of comparing every name.*/
+  template <typename F>
+  void forEachChildNamed(const std::string_view child_name, F&& function) const
+  {
+    const auto& children = this->childList();
+    if (children.size() < MIN_INDEXED_CHILDREN)
+    {
+      for (const auto& child_ptr : children)
+        if (child_ptr->name() == child_name)
+          function(static_cast<const DataTree&>(*child_ptr));
+      return;
+    }
+
+    const auto index = this->childNameIndex();
+    const uint64_t hash = hash_utils::fnv1a64(child_name);
+    auto entry =
+      std::lower_bound(index->begin(), index->end(), ChildNameEntry{hash, 0});
+    for (; entry != index->end() and entry->m_hash == hash; ++entry)
+    {
+      const DataTree& child = *children[entry->m_position];
+      if (child.name() == child_name) function(child);
+    }
+  }
+
+  /**Calls `function(child)` for every child named `child_name`, in order.
+   * Unshares the children first if they are shared with a copy. Since that
+   * drops the name index, the names are compared one by one.*/
+  template <typename F>
+  void forEachChildNamed(const std::string_view child_name, F&& function)
+  {
+    for (const auto& child_ptr : this->detachChildren())
+      if (child_ptr->name() == child_name) function(*child_ptr);
+  }
+
   /**Makes a vector of all the children's gross-types.*/
   std::vector<DataGrossType> makeChildrenGrossTypesList() const;
 
-  /**Produces a string in YAML format of the entire tree.*/
+  /**Replaces the children of this tree with those of `other`, which must be
+   * structurally equal (see structurallyEquals). The two trees then share
+   * their children like copies do, e.g., to store repeated subtrees once.
+   * Throws std::logic_error if the trees are not structurally equal.*/
+  void shareChildrenWith(const DataTree& other);
+
+  /**Defers building the children of this tree until they are first
+   * accessed. The gross-type must already be MAP or SEQUENCE. Errors thrown
+   * by the materializer propagate to the accessing call.*/
+  void setMaterializer(DataTreeMaterializer materializer);
+
+  /**Returns false if the children of this tree are still pending.*/
+  bool isMaterialized() const;
+
+  /**Produces a string in YAML format of the entire tree. To write large
+   * trees without building the string, see DataTreeYAMLEmitter.*/
   std::string
   toStringAsYAML(const std::string& indent,
                  const std::vector<std::string>& tags_to_print = {}) const;
+
+private:
+  /**Builds pending children, if any. Thread safe.*/
+  void materialize() const;
+
+  /**Clears the cached structural hash and child name index, called before
+   * any modification.*/
+  void invalidateHash();
+
+  /**Returns the children, materializing them if needed.*/
+  const ChildList& childList() const;
+
+  /**Returns the child name index, building it if needed. Thread safe.*/
+  std::shared_ptr<const ChildNameIndex> childNameIndex() const;
+
+  /**Returns the children for modification. If the list is shared with a
+   * copy of this tree, this tree first takes its own list holding copies of
+   * the children, which in turn still share theirs.*/
+  ChildList& detachChildren();
 };
 
 } // namespace elke
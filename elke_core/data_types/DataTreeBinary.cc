@@ -0,0 +1,235 @@
+#include "DataTreeBinary.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace elke
+{
+
+namespace
+{
+// ###################################################################
+void writeVarint(uint64_t value, std::string& buffer)
+{
+  while (value >= 0x80)
+  {
+    buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+void writeFixed64(uint64_t value, std::string& buffer)
+{
+  for (int i = 0; i < 8; ++i, value >>= 8)
+    buffer.push_back(static_cast<char>(value & 0xFF));
+}
+
+void writeString(const std::string& value, std::string& buffer)
+{
+  writeVarint(value.size(), buffer);
+  buffer.append(value);
+}
+
+// ###################################################################
+void writeScalarValue(const ScalarValue& value, std::string& buffer)
+{
+  buffer.push_back(static_cast<char>(value.type()));
+  switch (value.type())
+  {
+    case ScalarType::VOID:
+      break;
+    case ScalarType::STRING:
+      writeString(value.getValue<std::string>(), buffer);
+      break;
+    case ScalarType::BOOL:
+      buffer.push_back(value.getValue<bool>() ? 1 : 0);
+      break;
+    case ScalarType::INTEGER:
+      writeFixed64(static_cast<uint64_t>(value.getValue<int64_t>()), buffer);
+      break;
+    case ScalarType::FLOAT:
+    {
+      const double float_value = value.getValue<double>();
+      uint64_t bits = 0;
+      std::memcpy(&bits, &float_value, sizeof(bits));
+      writeFixed64(bits, buffer);
+    }
+    break;
+  }
+}
+
+// ###################################################################
+/**Sequential reader over a binary tree. Reads past the end, or of invalid
+ * values, clear m_ok and return defaults so that callers only need to check
+ * once per node.*/
+class BinaryReader
+{
+public:
+  explicit BinaryReader(const std::string_view data) : m_data(data) {}
+
+  bool ok() const { return m_ok; }
+  bool atEnd() const { return m_position == m_data.size(); }
+
+  uint8_t readByte()
+  {
+    if (m_position >= m_data.size()) return fail();
+    return static_cast<uint8_t>(m_data[m_position++]);
+  }
+
+  uint64_t readVarint()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+      const uint8_t byte = readByte();
+      value |= uint64_t{byte & 0x7Fu} << shift;
+      if ((byte & 0x80) == 0) return value;
+    }
+    return fail();
+  }
+
+  uint64_t readFixed64()
+  {
+    if (m_data.size() - m_position < 8) return fail();
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i)
+      value = (value << 8) | static_cast<uint8_t>(m_data[m_position + i]);
+    m_position += 8;
+    return value;
+  }
+
+  std::string readString()
+  {
+    const uint64_t size = readVarint();
+    if (size > m_data.size() - m_position)
+    {
+      fail();
+      return {};
+    }
+    std::string value(m_data.substr(m_position, size));
+    m_position += size;
+    return value;
+  }
+
+  /**Counts must be plausible for the remaining bytes, every entry taking at
+   * least one byte. Protects against huge allocations from corrupt data.*/
+  uint64_t readCount()
+  {
+    const uint64_t count = readVarint();
+    if (count > m_data.size() - m_position) return fail();
+    return count;
+  }
+
+  uint8_t fail()
+  {
+    m_ok = false;
+    m_position = m_data.size();
+    return 0;
+  }
+
+private:
+  std::string_view m_data;
+  size_t m_position = 0;
+  bool m_ok = true;
+};
+
+// ###################################################################
+ScalarValue readScalarValue(BinaryReader& reader)
+{
+  switch (reader.readByte())
+  {
+    case static_cast<uint8_t>(ScalarType::VOID):
+      return ScalarValue();
+    case static_cast<uint8_t>(ScalarType::STRING):
+      return ScalarValue(reader.readString());
+    case static_cast<uint8_t>(ScalarType::BOOL):
+      return ScalarValue(reader.readByte() != 0);
+    case static_cast<uint8_t>(ScalarType::INTEGER):
+      return ScalarValue(static_cast<int64_t>(reader.readFixed64()));
+    case static_cast<uint8_t>(ScalarType::FLOAT):
+    {
+      const uint64_t bits = reader.readFixed64();
+      double value = 0.0;
+      std::memcpy(&value, &bits, sizeof(value));
+      return ScalarValue(value);
+    }
+    default:
+      reader.fail();
+      return ScalarValue();
+  }
+}
+
+// ###################################################################
+/**Reads a node and its children. The node is added to `parent` before its
+ * stored tags are applied, so that the stored address wins over the one
+ * addChild assigns.*/
+std::shared_ptr<DataTree> readNode(BinaryReader& reader, DataTree* parent)
+{
+  auto tree = std::make_shared<DataTree>(reader.readString());
+
+  const uint8_t gross_type = reader.readByte();
+  if (gross_type > static_cast<uint8_t>(DataGrossType::MAP)) reader.fail();
+  if (not reader.ok()) return nullptr;
+
+  // setGrossType and setValue add a "type" tag. NO_DATA trees may never
+  // have had one, so the stored tags are the reference.
+  if (gross_type != static_cast<uint8_t>(DataGrossType::NO_DATA))
+    tree->setGrossType(static_cast<DataGrossType>(gross_type));
+  if (tree->grossType() == DataGrossType::SCALAR)
+    tree->setValue(readScalarValue(reader));
+
+  if (parent != nullptr) parent->addChild(tree);
+
+  const uint64_t num_tags = reader.readCount();
+  for (uint64_t t = 0; t < num_tags and reader.ok(); ++t)
+  {
+    const std::string tag_name = reader.readString();
+    tree->setTag(tag_name, reader.readString());
+  }
+
+  const uint64_t num_children = reader.readCount();
+  if (num_children > 0 and tree->grossType() != DataGrossType::MAP and
+      tree->grossType() != DataGrossType::SEQUENCE)
+    reader.fail();
+
+  for (uint64_t c = 0; c < num_children and reader.ok(); ++c)
+    if (readNode(reader, tree.get()) == nullptr) reader.fail();
+
+  return reader.ok() ? tree : nullptr;
+}
+} // namespace
+
+// ###################################################################
+void writeDataTreeBinary(const DataTree& tree, std::string& buffer)
+{
+  writeString(tree.name(), buffer);
+  buffer.push_back(static_cast<char>(tree.grossType()));
+  if (tree.grossType() == DataGrossType::SCALAR)
+    writeScalarValue(tree.value(), buffer);
+
+  writeVarint(tree.numTags(), buffer);
+  tree.forEachTag(
+    [&buffer](const std::string& tag_name, const std::string& tag_value)
+    {
+      writeString(tag_name, buffer);
+      writeString(tag_value, buffer);
+    });
+
+  const auto children = tree.constChildren();
+  writeVarint(children.size(), buffer);
+  for (const auto& child_ptr : children)
+    writeDataTreeBinary(*child_ptr, buffer);
+}
+
+// ###################################################################
+std::shared_ptr<DataTree> readDataTreeBinary(const std::string_view data)
+{
+  BinaryReader reader(data);
+  auto tree = readNode(reader, nullptr);
+
+  if (tree == nullptr or not reader.atEnd()) return nullptr;
+  return tree;
+}
+
+} // namespace elke
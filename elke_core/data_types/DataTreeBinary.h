@@ -0,0 +1,30 @@
+#ifndef ELKE_CORE_DATA_TYPES_DATATREEBINARY_H
+#define ELKE_CORE_DATA_TYPES_DATATREEBINARY_H
+
+#include "DataTree.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace elke
+{
+
+/**Appends a compact binary form of `tree` to `buffer`. Everything that
+ * makes up the tree is stored: names, gross-types, scalar values with their
+ * types, all tags and, recursively, the children. Lazy trees are
+ * materialized first.
+ *
+ * The format is portable (little-endian, lengths as LEB128 varints) but has
+ * no header or versioning of its own; users such as the InputCache add
+ * those.*/
+void writeDataTreeBinary(const DataTree& tree, std::string& buffer);
+
+/**Rebuilds a tree written by writeDataTreeBinary. The result is identical
+ * to the original, tags included. Returns nullptr if `data` is truncated,
+ * malformed or has trailing bytes.*/
+std::shared_ptr<DataTree> readDataTreeBinary(std::string_view data);
+
+} // namespace elke
+
+#endif // ELKE_CORE_DATA_TYPES_DATATREEBINARY_H
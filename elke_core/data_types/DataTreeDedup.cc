@@ -0,0 +1,92 @@
+#include "DataTreeDedup.h"
+
+#include "elke_core/utilities/hash_utils.h"
+
+namespace elke
+{
+
+// ###################################################################
+void DataTreeMarkTable::addMark(const std::string& address,
+                                const std::string& mark)
+{
+  m_marks[address] = mark;
+}
+
+// ###################################################################
+std::string DataTreeMarkTable::mark(const std::string& address) const
+{
+  const auto find_result = m_marks.find(address);
+  return find_result == m_marks.end() ? std::string() : find_result->second;
+}
+
+// ###################################################################
+std::string DataTreeMarkTable::markOf(const DataTree& node,
+                                      const std::string& address) const
+{
+  const auto find_result = m_marks.find(address);
+  return find_result == m_marks.end() ? node.getTag("mark")
+                                      : find_result->second;
+}
+
+// ###################################################################
+size_t DataTreeMarkTable::size() const { return m_marks.size(); }
+
+namespace
+{
+using CanonicalTrees = std::unordered_map<hash_utils::Hash128,
+                                          const DataTree*,
+                                          hash_utils::Hash128Hasher>;
+
+/**Records the marks of the descendants of `tree` and returns their
+ * number.*/
+size_t recordDescendantMarks(const DataTree& tree, DataTreeMarkTable& marks)
+{
+  size_t count = 0;
+  tree.forEachChild(
+    [&](const DataTree& child)
+    {
+      marks.addMark(child.getTag("address"), child.getTag("mark"));
+      count += 1 + recordDescendantMarks(child, marks);
+    });
+  return count;
+}
+
+/**Top-down, so that the largest repeated subtrees are found first and
+ * their insides are not visited again.*/
+void deduplicateChildren(DataTree& tree,
+                         CanonicalTrees& canonical_trees,
+                         DataTreeMarkTable& marks,
+                         size_t& num_nodes_saved)
+{
+  tree.forEachChild(
+    [&](DataTree& child)
+    {
+      if (child.numChildren() == 0) return;
+
+      const auto [canonical, inserted] =
+        canonical_trees.emplace(child.structuralHash(), &child);
+      if (inserted)
+      {
+        deduplicateChildren(child, canonical_trees, marks, num_nodes_saved);
+        return;
+      }
+
+      num_nodes_saved += recordDescendantMarks(child, marks);
+      child.shareChildrenWith(*canonical->second);
+    });
+}
+} // namespace
+
+// ###################################################################
+size_t deduplicateDataTree(DataTree& tree, DataTreeMarkTable& marks)
+{
+  // Hashes every subtree once, up front.
+  [[maybe_unused]] const auto root_hash = tree.structuralHash();
+
+  CanonicalTrees canonical_trees;
+  size_t num_nodes_saved = 0;
+  deduplicateChildren(tree, canonical_trees, marks, num_nodes_saved);
+  return num_nodes_saved;
+}
+
+} // namespace elke
@@ -0,0 +1,50 @@
+#ifndef ELKE_CORE_DATA_TYPES_DATATREEDEDUP_H
+#define ELKE_CORE_DATA_TYPES_DATATREEDEDUP_H
+
+#include "DataTree.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace elke
+{
+
+/**Marks (source locations) of nodes that deduplicateDataTree no longer
+ * stores, by their "address" tag. A shared node carries the tags of the
+ * occurrence it was first parsed from; this table keeps where every other
+ * occurrence came from.*/
+class DataTreeMarkTable
+{
+  std::unordered_map<std::string, std::string> m_marks;
+
+public:
+  /**Records the mark of the node at `address`.*/
+  void addMark(const std::string& address, const std::string& mark);
+
+  /**Returns the mark recorded for `address`, or an empty string.*/
+  std::string mark(const std::string& address) const;
+
+  /**Returns the mark of `node`, found at `address`: the recorded one if
+   * there is one, otherwise the node's own "mark" tag.*/
+  std::string markOf(const DataTree& node, const std::string& address) const;
+
+  /**Returns the number of recorded marks.*/
+  size_t size() const;
+};
+
+/**Hash-conses `tree`: MAP and SEQUENCE subtrees with the same structural
+ * hash (see DataTree::structuralHash) share one list of children, so that
+ * repeated definitions, e.g., the same material block in every component,
+ * or expanded YAML aliases, are stored once. Each occurrence keeps its own
+ * node, with its name and tags; the marks of the nodes below it that are
+ * no longer stored are added to `marks`.
+ *
+ * The tree stays fully usable. Shared children are copied on write like
+ * those of copied trees, so modifying one occurrence does not change the
+ * others. Lazy trees are materialized. Returns the number of nodes that are
+ * no longer stored.*/
+size_t deduplicateDataTree(DataTree& tree, DataTreeMarkTable& marks);
+
+} // namespace elke
+
+#endif // ELKE_CORE_DATA_TYPES_DATATREEDEDUP_H
@@ -0,0 +1,85 @@
+#include "DataTreeDiff.h"
+
+#include <algorithm>
+#include <map>
+
+namespace elke
+{
+
+namespace
+{
+void collectChangedSubtrees(const DataTree& before,
+                            const DataTree& after,
+                            std::vector<std::string>& addresses)
+{
+  if (before.structurallyEquals(after)) return;
+
+  const auto gross_type = after.grossType();
+  const bool is_container = gross_type == DataGrossType::MAP or
+                            gross_type == DataGrossType::SEQUENCE;
+  if (not is_container or before.grossType() != gross_type)
+  {
+    addresses.push_back(after.getTag("address"));
+    return;
+  }
+
+  const size_t num_reported = addresses.size();
+  const auto before_children = before.constChildren();
+  const auto after_children = after.constChildren();
+
+  if (gross_type == DataGrossType::SEQUENCE)
+  {
+    const size_t num_common =
+      std::min(before_children.size(), after_children.size());
+    for (size_t i = 0; i < num_common; ++i)
+    {
+      // Structural hashes leave out the tree's own name.
+      if (before_children[i]->name() != after_children[i]->name())
+        addresses.push_back(after_children[i]->getTag("address"));
+      else
+        collectChangedSubtrees(
+          *before_children[i], *after_children[i], addresses);
+    }
+    for (size_t i = num_common; i < before_children.size(); ++i)
+      addresses.push_back(before_children[i]->getTag("address"));
+    for (size_t i = num_common; i < after_children.size(); ++i)
+      addresses.push_back(after_children[i]->getTag("address"));
+  }
+  else
+  {
+    std::map<std::string, const DataTree*> unmatched_before;
+    for (const auto& child_ptr : before_children)
+      unmatched_before.emplace(child_ptr->name(), child_ptr.get());
+
+    for (const auto& child_ptr : after_children)
+    {
+      const auto match = unmatched_before.find(child_ptr->name());
+      if (match == unmatched_before.end())
+        addresses.push_back(child_ptr->getTag("address"));
+      else
+      {
+        collectChangedSubtrees(*match->second, *child_ptr, addresses);
+        unmatched_before.erase(match);
+      }
+    }
+    for (const auto& [name, child_ptr] : unmatched_before)
+      addresses.push_back(child_ptr->getTag("address"));
+  }
+
+  // The children match but the hashes do not, e.g., the children of a map
+  // were reordered.
+  if (addresses.size() == num_reported)
+    addresses.push_back(after.getTag("address"));
+}
+} // namespace
+
+// ###################################################################
+std::vector<std::string> findChangedSubtrees(const DataTree& before,
+                                             const DataTree& after)
+{
+  std::vector<std::string> addresses;
+  collectChangedSubtrees(before, after, addresses);
+  return addresses;
+}
+
+} // namespace elke
@@ -0,0 +1,26 @@
+#ifndef ELKE_CORE_DATA_TYPES_DATATREEDIFF_H
+#define ELKE_CORE_DATA_TYPES_DATATREEDIFF_H
+
+#include "DataTree.h"
+
+#include <string>
+#include <vector>
+
+namespace elke
+{
+
+/**Returns the addresses (the "address" tags) of the highest subtrees that
+ * differ between `before` and `after`. Subtrees with equal structural
+ * hashes are skipped without being walked, so that comparing two versions
+ * of a large input costs in proportion to what changed.
+ *
+ * MAP children are matched by name and SEQUENCE children by index. A
+ * subtree that only exists in `before` is reported with its address in
+ * `before`, all others with their address in `after`. The names of
+ * `before` and `after` themselves are not compared.*/
+std::vector<std::string> findChangedSubtrees(const DataTree& before,
+                                             const DataTree& after);
+
+} // namespace elke
+
+#endif // ELKE_CORE_DATA_TYPES_DATATREEDIFF_H
@@ -0,0 +1,160 @@
+#include "DataTreeQuery.h"
+
+#include "elke_core/utilities/string_utils.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace elke
+{
+
+namespace
+{
+/**Appends the children of `node` selected by `step` to `matches`.*/
+template <typename Tree>
+void applyStep(const DataTreeQuery::Step& step,
+               Tree& node,
+               std::vector<Tree*>& matches)
+{
+  switch (step.m_type)
+  {
+    case DataTreeQuery::StepType::NAME:
+      node.forEachChildNamed(step.m_name,
+                             [&](Tree& child) { matches.push_back(&child); });
+      break;
+    case DataTreeQuery::StepType::INDEX:
+      if (step.m_index < node.numChildren())
+        matches.push_back(&node.childAt(step.m_index));
+      break;
+    case DataTreeQuery::StepType::WILDCARD:
+      node.forEachChild([&](Tree& child) { matches.push_back(&child); });
+      break;
+  }
+}
+
+/**Runs the steps breadth first, one frontier per step. Since each frontier
+ * is in document order, and children are appended in order, so is the
+ * next.*/
+template <typename Tree>
+std::vector<Tree*> runSteps(const std::vector<DataTreeQuery::Step>& steps,
+                            Tree& tree)
+{
+  std::vector<Tree*> matches = {&tree};
+  std::vector<Tree*> next_matches;
+  for (const auto& step : steps)
+  {
+    next_matches.clear();
+    for (Tree* node : matches)
+      applyStep(step, *node, next_matches);
+    std::swap(matches, next_matches);
+    if (matches.empty()) break;
+  }
+
+  return matches;
+}
+
+/**Returns the first match of the steps from `step_index` on, starting at
+ * `node`. Searches depth first, in document order, so that it stops at the
+ * first match instead of evaluating all of them.*/
+template <typename Tree>
+Tree* findFirst(const std::vector<DataTreeQuery::Step>& steps,
+                const size_t step_index,
+                Tree& node)
+{
+  if (step_index == steps.size()) return &node;
+
+  const auto& step = steps[step_index];
+  Tree* found = nullptr;
+  switch (step.m_type)
+  {
+    case DataTreeQuery::StepType::NAME:
+      node.forEachChildNamed(
+        step.m_name,
+        [&](Tree& child)
+        {
+          if (not found) found = findFirst(steps, step_index + 1, child);
+        });
+      break;
+    case DataTreeQuery::StepType::INDEX:
+      if (step.m_index < node.numChildren())
+        found = findFirst(steps, step_index + 1, node.childAt(step.m_index));
+      break;
+    case DataTreeQuery::StepType::WILDCARD:
+      for (size_t i = 0; i < node.numChildren() and not found; ++i)
+        found = findFirst(steps, step_index + 1, node.childAt(i));
+      break;
+  }
+  return found;
+}
+} // namespace
+
+// ###################################################################
+DataTreeQuery::DataTreeQuery(const std::string_view path) : m_path(path)
+{
+  // Keeps the empty words between consecutive separators, but not a
+  // leading or trailing one.
+  const auto words = string_utils::splitStringView(path, "/", false);
+
+  m_steps.reserve(words.size());
+  for (const std::string_view word : words)
+  {
+    Step step;
+    if (word.empty())
+      throw std::invalid_argument("Empty step in DataTree query \"" + m_path +
+                                  "\"");
+    if (word == "*") step.m_type = StepType::WILDCARD;
+    else if (word.front() == '[' and word.back() == ']')
+    {
+      int64_t index = -1;
+      if (not string_utils::parseInt64(word.substr(1, word.size() - 2),
+                                       index) or
+          index < 0)
+        throw std::invalid_argument("Invalid index \"" + std::string(word) +
+                                    "\" in DataTree query \"" + m_path +
+                                    "\"");
+      step.m_type = StepType::INDEX;
+      step.m_index = static_cast<size_t>(index);
+    }
+    else
+    {
+      step.m_type = StepType::NAME;
+      step.m_name = word;
+    }
+    m_steps.push_back(std::move(step));
+  }
+}
+
+// ###################################################################
+const std::string& DataTreeQuery::path() const { return m_path; }
+
+// ###################################################################
+const std::vector<DataTreeQuery::Step>& DataTreeQuery::steps() const
+{
+  return m_steps;
+}
+
+// ###################################################################
+std::vector<const DataTree*> DataTreeQuery::run(const DataTree& tree) const
+{
+  return runSteps(m_steps, tree);
+}
+
+// ###################################################################
+std::vector<DataTree*> DataTreeQuery::run(DataTree& tree) const
+{
+  return runSteps(m_steps, tree);
+}
+
+// ###################################################################
+const DataTree* DataTreeQuery::first(const DataTree& tree) const
+{
+  return findFirst(m_steps, 0, tree);
+}
+
+// ###################################################################
+DataTree* DataTreeQuery::first(DataTree& tree) const
+{
+  return findFirst(m_steps, 0, tree);
+}
+
+} // namespace elke
@@ -0,0 +1,88 @@
+#ifndef ELKE_CORE_DATA_TYPES_DATATREEQUERY_H
+#define ELKE_CORE_DATA_TYPES_DATATREEQUERY_H
+
+#include "DataTree.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace elke
+{
+
+/**A path query over DataTrees, compiled once and run against any number of
+ * trees. A path is a list of steps separated by '/', each selecting
+ * children of the nodes matched so far:
+ * - `name`, the children with that name,
+ * - `*`, all children,
+ * - `[n]`, the child at index n, e.g., entry n of a SEQUENCE.
+ *
+ * Paths are relative to the tree the query runs on, so that the tree's own
+ * name is not part of them. For example, with `path` set to
+ * "components/ * /initial_conditions/pressure" (without the spaces, which
+ * only keep this comment open):
+ * ```c++
+ * const DataTreeQuery query(path);
+ * for (const DataTree* pressure : query.run(input_tree))
+ *   total += pressure->value().getValue<double>();
+ *
+ * const DataTree* block = DataTreeQuery("mesh/blocks/[3]").first(tree);
+ * ```
+ * Running a query builds no strings, and NAME steps on const trees use the
+ * child name index of nodes with many children (see
+ * DataTree::forEachChildNamed). Matches are returned in document
+ * order, as pointers into the tree, and are invalidated like references
+ * returned by DataTree::child. Running on a non-const tree unshares the
+ * children of every visited node (see DataTree), so prefer const trees when
+ * only reading.*/
+class DataTreeQuery
+{
+public:
+  enum class StepType
+  {
+    NAME,
+    INDEX,
+    WILDCARD
+  };
+
+  /**A compiled step.*/
+  struct Step
+  {
+    StepType m_type = StepType::WILDCARD;
+    std::string m_name; ///< For NAME steps
+    size_t m_index = 0; ///< For INDEX steps
+  };
+
+  /**Compiles `path`. Leading and trailing '/' are ignored, an empty path
+   * matches the tree itself. Throws std::invalid_argument for empty steps
+   * and malformed indices.*/
+  explicit DataTreeQuery(std::string_view path);
+
+  /**Returns the path the query was compiled from.*/
+  const std::string& path() const;
+
+  /**Returns the compiled steps.*/
+  const std::vector<Step>& steps() const;
+
+  /**Returns all nodes of `tree` that match the query.*/
+  std::vector<const DataTree*> run(const DataTree& tree) const;
+
+  /**Returns all nodes of `tree` that match the query, for modification.*/
+  std::vector<DataTree*> run(DataTree& tree) const;
+
+  /**Returns the first match, in document order, or nullptr. Searches depth
+   * first and stops at that match.*/
+  const DataTree* first(const DataTree& tree) const;
+
+  /**Returns the first match, in document order, or nullptr. Searches depth
+   * first and stops at that match.*/
+  DataTree* first(DataTree& tree) const;
+
+private:
+  std::string m_path;
+  std::vector<Step> m_steps;
+};
+
+} // namespace elke
+
+#endif // ELKE_CORE_DATA_TYPES_DATATREEQUERY_H
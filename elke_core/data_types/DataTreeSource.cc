@@ -0,0 +1,37 @@
+#include "DataTreeSource.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace elke
+{
+
+// ###################################################################
+DataTreeSource::DataTreeSource(std::string name, const std::string_view content)
+  : m_name(std::move(name))
+{
+  m_line_starts.push_back(0);
+  const char* const begin = content.data();
+  const char* const end = begin + content.size();
+  for (const char* p = begin; p < end; ++p)
+  {
+    p = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (p == nullptr) break;
+    m_line_starts.push_back(static_cast<uint32_t>(p - begin) + 1);
+  }
+}
+
+// ###################################################################
+std::string DataTreeSource::markAt(const uint32_t offset) const
+{
+  // The last line starting at or before the offset
+  const auto line_start =
+    std::upper_bound(m_line_starts.begin(), m_line_starts.end(), offset) - 1;
+  const size_t line = (line_start - m_line_starts.begin()) + 1;
+
+  return m_name + " line " + std::to_string(line) + ":" +
+         std::to_string(offset - *line_start + 1);
+}
+
+} // namespace elke
@@ -0,0 +1,36 @@
+#ifndef ELKE_CORE_DATA_TYPES_DATATREESOURCE_H
+#define ELKE_CORE_DATA_TYPES_DATATREESOURCE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace elke
+{
+
+/**What is kept of a parsed document to format the marks of its nodes: the
+ * source name and the offset at which each line starts. Parsers give each
+ * node a byte offset (see DataTree::setSourceMark) instead of a formatted
+ * mark, so that line and column are only worked out for the marks that are
+ * read, e.g., those of nodes that have a diagnostic.*/
+class DataTreeSource
+{
+  std::string m_name;
+  /// Offset of the first character of each line, line 1 first.
+  std::vector<uint32_t> m_line_starts;
+
+public:
+  /**Indexes the lines of `content`, which is not kept.*/
+  DataTreeSource(std::string name, std::string_view content);
+
+  /**Returns the source name.*/
+  const std::string& name() const { return m_name; }
+
+  /**Returns the mark of a byte offset, "name line L:C", both 1-based.*/
+  std::string markAt(uint32_t offset) const;
+};
+
+} // namespace elke
+
+#endif // ELKE_CORE_DATA_TYPES_DATATREESOURCE_H
@@ -0,0 +1,27 @@
+#include "DataTreeTraversal.h"
+
+namespace elke::data_tree_traversal
+{
+
+namespace
+{
+void countNodes(const DataTree& tree, const size_t limit, size_t& count)
+{
+  ++count;
+  tree.forEachChild(
+    [&](const DataTree& child)
+    {
+      if (count < limit) countNodes(child, limit, count);
+    });
+}
+} // namespace
+
+// ###################################################################
+size_t countNodesUpTo(const DataTree& tree, const size_t limit)
+{
+  size_t count = 0;
+  countNodes(tree, limit, count);
+  return count;
+}
+
+} // namespace elke::data_tree_traversal
@@ -0,0 +1,338 @@
+#ifndef ELKE_CORE_DATA_TYPES_DATATREETRAVERSAL_H
+#define ELKE_CORE_DATA_TYPES_DATATREETRAVERSAL_H
+
+#include "DataTree.h"
+
+#include "elke_core/utilities/WorkStealingPool.h"
+
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**Traversals of DataTrees that, unlike DataTree::traverseWithCallback,
+ * - take the visitor as a template parameter, so that it can be inlined
+ *   instead of being called through a std::function,
+ * - only build address strings if the visitor takes one,
+ * - can fan large subtrees out to a WorkStealingPool.
+ *
+ * Visitors are called in pre-order with either `(DataTree& node)` or
+ * `(const std::string& address, DataTree& node)`. Addresses have the form of
+ * traverseWithCallback's, e.g., "root/block/0/", with sequence entries named
+ * by their index.
+ *
+ * ```c++
+ * size_t num_scalars = 0;
+ * forEachDataTreeNode(tree, [&](DataTree& node)
+ *   { if (node.grossType() == DataGrossType::SCALAR) ++num_scalars; });
+ *
+ * // Deterministic, even for floating point sums.
+ * const double total = parallelTransformReduceDataTree(
+ *   tree, 0.0,
+ *   [](const DataTree& node) { return nodeWeight(node); },
+ *   [](double a, double b) { return a + b; });
+ * ```*/
+
+namespace elke
+{
+
+/**Options of the parallel traversals.*/
+struct DataTreeTraversalOptions
+{
+  /**Subtrees with at least this many nodes are handed to the pool as a
+   * task of their own, smaller sibling subtrees are grouped into tasks of
+   * about this many nodes.*/
+  size_t m_grain_size = 2048;
+  /**Pool to use. nullptr selects WorkStealingPool::getGlobalPool().*/
+  WorkStealingPool* m_pool = nullptr;
+};
+
+namespace data_tree_traversal
+{
+/**Counts the nodes of a subtree, stopping once `limit` is reached. Bounds
+ * the cost of deciding whether a subtree is worth a task.*/
+size_t countNodesUpTo(const DataTree& tree, size_t limit);
+
+template <typename F, typename Tree>
+constexpr bool TAKES_ADDRESS =
+  std::is_invocable_v<F&, const std::string&, Tree&>;
+
+/**Address of a child given the address of its parent.*/
+template <bool WITH_ADDRESS>
+std::string childAddress(const std::string& parent_address,
+                         const DataTree& parent,
+                         const DataTree& child,
+                         const size_t index)
+{
+  if constexpr (not WITH_ADDRESS) return {};
+  else if (parent.grossType() == DataGrossType::SEQUENCE)
+    return parent_address + std::to_string(index) + "/";
+  else
+    return parent_address + child.name() + "/";
+}
+
+template <bool WITH_ADDRESS, typename F, typename Tree>
+decltype(auto) visit(F& function, const std::string& address, Tree& tree)
+{
+  if constexpr (WITH_ADDRESS) return function(address, tree);
+  else return function(tree);
+}
+
+// ###################################################################
+template <bool WITH_ADDRESS, typename F>
+void forEachSerial(F& function, DataTree& tree, const std::string& address)
+{
+  visit<WITH_ADDRESS>(function, address, tree);
+
+  size_t index = 0;
+  tree.forEachChild(
+    [&](DataTree& child)
+    {
+      forEachSerial<WITH_ADDRESS>(
+        function,
+        child,
+        childAddress<WITH_ADDRESS>(address, tree, child, index++));
+    });
+}
+
+// ###################################################################
+/**Children of a node that are visited by one task, with their positions
+ * and addresses. Large subtrees get a batch of their own; runs of small
+ * siblings are collected until they add up to the grain size, so that wide
+ * nodes are split as well.*/
+template <typename Tree>
+struct ChildBatch
+{
+  std::vector<Tree*> m_children;
+  std::vector<size_t> m_indices;
+  std::vector<std::string> m_addresses;
+  size_t m_num_nodes = 0;
+
+  void add(Tree& child, const size_t index, std::string address, size_t size)
+  {
+    m_children.push_back(&child);
+    m_indices.push_back(index);
+    m_addresses.push_back(std::move(address));
+    m_num_nodes += size;
+  }
+};
+
+/**Splits the children of `tree` into batches and calls `run_batch(batch,
+ * is_large_subtree)` for each, with the batches that hold one large subtree
+ * marked. The last batch of small children may be below the grain size.*/
+template <bool WITH_ADDRESS, typename Tree, typename RunBatch>
+void forEachChildBatch(Tree& tree,
+                       const std::string& address,
+                       const size_t grain_size,
+                       RunBatch&& run_batch)
+{
+  ChildBatch<Tree> small_children;
+  size_t index = 0;
+  tree.forEachChild(
+    [&](Tree& child)
+    {
+      auto child_address =
+        childAddress<WITH_ADDRESS>(address, tree, child, index);
+      const size_t size = countNodesUpTo(child, grain_size);
+      if (size >= grain_size)
+      {
+        ChildBatch<Tree> large_child;
+        large_child.add(child, index, std::move(child_address), size);
+        run_batch(std::move(large_child), true);
+      }
+      else
+      {
+        small_children.add(child, index, std::move(child_address), size);
+        if (small_children.m_num_nodes >= grain_size)
+          run_batch(std::exchange(small_children, {}), false);
+      }
+      ++index;
+    });
+  if (not small_children.m_children.empty())
+    run_batch(std::move(small_children), false);
+}
+
+// ###################################################################
+template <bool WITH_ADDRESS, typename F>
+void forEachParallel(F& function,
+                     DataTree& tree,
+                     const std::string& address,
+                     const size_t grain_size,
+                     WorkStealingPool& pool)
+{
+  visit<WITH_ADDRESS>(function, address, tree);
+
+  TaskGroup group(pool);
+  forEachChildBatch<WITH_ADDRESS>(
+    tree,
+    address,
+    grain_size,
+    [&](ChildBatch<DataTree> batch, const bool is_large_subtree)
+    {
+      group.run(
+        [&function, &pool, grain_size, is_large_subtree,
+         batch = std::move(batch)]
+        {
+          for (size_t b = 0; b < batch.m_children.size(); ++b)
+            if (is_large_subtree)
+              forEachParallel<WITH_ADDRESS>(function,
+                                            *batch.m_children[b],
+                                            batch.m_addresses[b],
+                                            grain_size,
+                                            pool);
+            else
+              forEachSerial<WITH_ADDRESS>(
+                function, *batch.m_children[b], batch.m_addresses[b]);
+        });
+    });
+  group.wait();
+}
+
+// ###################################################################
+template <bool WITH_ADDRESS, typename T, typename Map, typename Reduce>
+T reduceSerial(Map& map,
+               Reduce& reduce,
+               const DataTree& tree,
+               const std::string& address)
+{
+  T result = visit<WITH_ADDRESS>(map, address, tree);
+
+  size_t index = 0;
+  tree.forEachChild(
+    [&](const DataTree& child)
+    {
+      const auto child_address =
+        childAddress<WITH_ADDRESS>(address, tree, child, index++);
+      result = reduce(std::move(result),
+                      reduceSerial<WITH_ADDRESS, T>(
+                        map, reduce, child, child_address));
+    });
+  return result;
+}
+
+// ###################################################################
+template <bool WITH_ADDRESS, typename T, typename Map, typename Reduce>
+T reduceParallel(Map& map,
+                 Reduce& reduce,
+                 const DataTree& tree,
+                 const std::string& address,
+                 const size_t grain_size,
+                 WorkStealingPool& pool)
+{
+  T result = visit<WITH_ADDRESS>(map, address, tree);
+
+  // Children's results are stored by position and combined in order once
+  // all are done, so that the result does not depend on the scheduling.
+  std::vector<std::optional<T>> child_results(tree.numChildren());
+  {
+    TaskGroup group(pool);
+    forEachChildBatch<WITH_ADDRESS>(
+      tree,
+      address,
+      grain_size,
+      [&](ChildBatch<const DataTree> batch, const bool is_large_subtree)
+      {
+        group.run(
+          [&map, &reduce, &child_results, &pool, grain_size,
+           is_large_subtree, batch = std::move(batch)]
+          {
+            for (size_t b = 0; b < batch.m_children.size(); ++b)
+              child_results[batch.m_indices[b]].emplace(
+                is_large_subtree
+                  ? reduceParallel<WITH_ADDRESS, T>(map,
+                                                    reduce,
+                                                    *batch.m_children[b],
+                                                    batch.m_addresses[b],
+                                                    grain_size,
+                                                    pool)
+                  : reduceSerial<WITH_ADDRESS, T>(map,
+                                                  reduce,
+                                                  *batch.m_children[b],
+                                                  batch.m_addresses[b]));
+          });
+      });
+    group.wait();
+  }
+
+  for (auto& child_result : child_results)
+    result = reduce(std::move(result), std::move(*child_result));
+  return result;
+}
+} // namespace data_tree_traversal
+
+// ###################################################################
+/**Calls `function` on every node of `tree` in pre-order, serially.*/
+template <typename F>
+void forEachDataTreeNode(DataTree& tree, F&& function)
+{
+  constexpr bool WITH_ADDRESS =
+    data_tree_traversal::TAKES_ADDRESS<std::remove_reference_t<F>, DataTree>;
+  data_tree_traversal::forEachSerial<WITH_ADDRESS>(
+    function, tree, WITH_ADDRESS ? tree.name() + "/" : std::string{});
+}
+
+// ###################################################################
+/**Calls `function` on every node of `tree`, visiting subtrees of at least
+ * `options.m_grain_size` nodes concurrently. The calls for different nodes
+ * may run concurrently and in any order, so `function` must be thread safe;
+ * each node is visited exactly once and a node is always visited before its
+ * children. Exceptions thrown by `function` are rethrown once all started
+ * work has finished.*/
+template <typename F>
+void parallelForEachDataTreeNode(DataTree& tree,
+                                 F&& function,
+                                 const DataTreeTraversalOptions& options = {})
+{
+  constexpr bool WITH_ADDRESS =
+    data_tree_traversal::TAKES_ADDRESS<std::remove_reference_t<F>, DataTree>;
+  auto& pool = options.m_pool != nullptr ? *options.m_pool
+                                         : WorkStealingPool::getGlobalPool();
+  const std::string address = WITH_ADDRESS ? tree.name() + "/" : "";
+
+  if (pool.numWorkers() == 0)
+    data_tree_traversal::forEachSerial<WITH_ADDRESS>(function, tree, address);
+  else
+    data_tree_traversal::forEachParallel<WITH_ADDRESS>(
+      function, tree, address, options.m_grain_size, pool);
+}
+
+// ###################################################################
+/**Maps every node of `tree` to a value and combines the values with
+ * `reduce`. The combination order is fixed by the tree: a node's value is
+ * reduced with its children's subtree results from first to last child,
+ * and the root's result with `init`, i.e., `reduce(init, ...)`. The result
+ * is therefore identical for every run and thread count, also for
+ * operations that are not associative, such as floating point sums. For
+ * associative operations it equals the serial pre-order fold.
+ *
+ * `map` is called as `map(const DataTree&)` or
+ * `map(const std::string& address, const DataTree&)` and, like `reduce`,
+ * may be called concurrently.*/
+template <typename T, typename Map, typename Reduce>
+T parallelTransformReduceDataTree(const DataTree& tree,
+                                  T init,
+                                  Map&& map,
+                                  Reduce&& reduce,
+                                  const DataTreeTraversalOptions& options = {})
+{
+  constexpr bool WITH_ADDRESS =
+    data_tree_traversal::TAKES_ADDRESS<std::remove_reference_t<Map>,
+                                       const DataTree>;
+  auto& pool = options.m_pool != nullptr ? *options.m_pool
+                                         : WorkStealingPool::getGlobalPool();
+  const std::string address = WITH_ADDRESS ? tree.name() + "/" : "";
+
+  T tree_result =
+    pool.numWorkers() == 0
+      ? data_tree_traversal::reduceSerial<WITH_ADDRESS, T>(
+          map, reduce, tree, address)
+      : data_tree_traversal::reduceParallel<WITH_ADDRESS, T>(
+          map, reduce, tree, address, options.m_grain_size, pool);
+
+  return reduce(std::move(init), std::move(tree_result));
+}
+
+} // namespace elke
+
+#endif // ELKE_CORE_DATA_TYPES_DATATREETRAVERSAL_H
@@ -0,0 +1,202 @@
+#include "DataTreeYAML.h"
+
+#include <charconv>
+#include <cstdio>
+#include <ostream>
+#include <utility>
+
+#if defined(__unix__) or defined(__APPLE__)
+#define ELKE_POSIX_WRITE_AVAILABLE
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace elke
+{
+
+// ###################################################################
+DataTreeYAMLEmitter::DataTreeYAMLEmitter(std::string& buffer)
+  : m_output(buffer)
+{
+}
+
+// ###################################################################
+DataTreeYAMLEmitter::DataTreeYAMLEmitter(YAMLChunkSink sink,
+                                         const size_t chunk_size)
+  : m_output(m_chunk), m_sink(std::move(sink)), m_chunk_size(chunk_size)
+{
+  m_chunk.reserve(chunk_size + 1024);
+}
+
+// ###################################################################
+DataTreeYAMLEmitter::~DataTreeYAMLEmitter() { flush(); }
+
+// ###################################################################
+void DataTreeYAMLEmitter::flush()
+{
+  if (m_sink and not m_chunk.empty())
+  {
+    m_sink(m_chunk);
+    m_chunk.clear();
+  }
+}
+
+// ###################################################################
+void DataTreeYAMLEmitter::emit(const DataTree& tree,
+                               const std::string& indent,
+                               const std::vector<std::string>& tags_to_print)
+{
+  m_indent = indent;
+  m_tags_to_print = &tags_to_print;
+  emitNode(tree);
+  m_tags_to_print = nullptr;
+}
+
+// ###################################################################
+/**Every parent is responsible for indenting its own children. Sequence
+ * entries follow a "-" on the same line.*/
+void DataTreeYAMLEmitter::emitNode(const DataTree& tree)
+{
+  if (not tree.name().empty())
+  {
+    m_output.append(tree.name());
+    m_output.push_back(':');
+  }
+
+  switch (tree.grossType())
+  {
+    case DataGrossType::NO_DATA:
+      m_output.append(" null");
+      emitTags(tree);
+      endLine();
+      break;
+
+    case DataGrossType::SCALAR:
+      m_output.push_back(' ');
+      emitScalar(tree.value());
+      emitTags(tree);
+      endLine();
+      break;
+
+    case DataGrossType::SEQUENCE:
+    case DataGrossType::MAP:
+    {
+      const bool is_sequence = tree.grossType() == DataGrossType::SEQUENCE;
+      emitTags(tree);
+      endLine();
+
+      m_indent.append(2, ' ');
+      tree.forEachChild(
+        [&](const DataTree& child)
+        {
+          m_output.append(m_indent);
+          if (is_sequence) m_output.push_back('-');
+          emitNode(child);
+        });
+      m_indent.resize(m_indent.size() - 2);
+    }
+    break;
+  }
+}
+
+// ###################################################################
+void DataTreeYAMLEmitter::emitTags(const DataTree& tree)
+{
+  m_output.append(" # ");
+  for (const auto& tag : *m_tags_to_print)
+  {
+    if (not tree.hasTag(tag)) continue;
+
+    m_output.append(tag);
+    m_output.push_back('=');
+    m_output.append(tree.getTag(tag));
+    m_output.push_back(' ');
+  }
+}
+
+// ###################################################################
+/**Same text as ScalarValue::convertToString, without the stringstream.*/
+void DataTreeYAMLEmitter::emitScalar(const ScalarValue& value)
+{
+  char digits[32];
+  switch (value.type())
+  {
+    case ScalarType::STRING:
+      m_output.push_back('"');
+      m_output.append(value.getValue<std::string>());
+      m_output.push_back('"');
+      break;
+    case ScalarType::BOOL:
+      m_output.append(value.getValue<bool>() ? "true" : "false");
+      break;
+    case ScalarType::INTEGER:
+    {
+      const auto result = std::to_chars(
+        digits, digits + sizeof(digits), value.getValue<int64_t>());
+      m_output.append(digits, result.ptr);
+    }
+    break;
+    case ScalarType::FLOAT:
+    {
+      // Default ostream formatting of doubles is "%g" with precision 6.
+      const int size =
+        std::snprintf(digits, sizeof(digits), "%g", value.getValue<double>());
+      m_output.append(digits, static_cast<size_t>(size));
+    }
+    break;
+    case ScalarType::VOID:
+    default:
+      m_output.append("NONE");
+      break;
+  }
+}
+
+// ###################################################################
+void DataTreeYAMLEmitter::endLine()
+{
+  m_output.push_back('\n');
+  if (m_sink and m_chunk.size() >= m_chunk_size) flush();
+}
+
+// ###################################################################
+void writeDataTreeYAML(const DataTree& tree,
+                       std::ostream& stream,
+                       const std::string& indent /*=""*/,
+                       const std::vector<std::string>& tags_to_print /*={}*/)
+{
+  DataTreeYAMLEmitter emitter(
+    [&stream](const std::string_view chunk)
+    { stream.write(chunk.data(), static_cast<std::streamsize>(chunk.size())); });
+  emitter.emit(tree, indent, tags_to_print);
+}
+
+// ###################################################################
+bool writeDataTreeYAML([[maybe_unused]] const DataTree& tree,
+                       [[maybe_unused]] const int file_descriptor,
+                       [[maybe_unused]] const std::string& indent /*=""*/,
+                       [[maybe_unused]] const std::vector<std::string>&
+                         tags_to_print /*={}*/)
+{
+#ifdef ELKE_POSIX_WRITE_AVAILABLE
+  bool write_failed = false;
+  DataTreeYAMLEmitter emitter(
+    [&](std::string_view chunk)
+    {
+      while (not chunk.empty() and not write_failed)
+      {
+        const ssize_t written =
+          ::write(file_descriptor, chunk.data(), chunk.size());
+        if (written < 0 and errno == EINTR) continue;
+        if (written <= 0) write_failed = true;
+        else chunk.remove_prefix(static_cast<size_t>(written));
+      }
+    });
+  emitter.emit(tree, indent, tags_to_print);
+  emitter.flush();
+  return not write_failed;
+#else
+  return false;
+#endif
+}
+
+} // namespace elke
@@ -0,0 +1,94 @@
+#ifndef ELKE_CORE_DATA_TYPES_DATATREEYAML_H
+#define ELKE_CORE_DATA_TYPES_DATATREEYAML_H
+
+#include "DataTree.h"
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace elke
+{
+
+/**Receives emitted YAML in chunks. Every chunk ends at a line boundary.*/
+using YAMLChunkSink = std::function<void(std::string_view)>;
+
+// ###################################################################
+/**Writes DataTrees as YAML in a single pass, in the format of
+ * DataTree::toStringAsYAML (which uses this class). All output goes into
+ * one buffer and the indentation is grown and shrunk in place, so that
+ * every byte is written once, whatever the depth of the tree.
+ *
+ * The emitter either appends to a caller's string or hands the output to a
+ * sink in chunks of whole lines, so that large trees can be written to a
+ * stream, file or logger without being held in memory:
+ * ```c++
+ * DataTreeYAMLEmitter emitter([&](std::string_view chunk)
+ *                             { logger.log() << chunk; });
+ * emitter.emit(tree, "", {"type"});
+ * ```*/
+class DataTreeYAMLEmitter
+{
+public:
+  /**Default size above which a chunk is handed to the sink.*/
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+  /**Appends all output to `buffer`.*/
+  explicit DataTreeYAMLEmitter(std::string& buffer);
+
+  /**Passes the output to `sink` once at least `chunk_size` bytes, ending
+   * with a complete line, are pending, and the rest on flush().*/
+  explicit DataTreeYAMLEmitter(YAMLChunkSink sink,
+                               size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  /**Flushes.*/
+  ~DataTreeYAMLEmitter();
+
+  DataTreeYAMLEmitter(const DataTreeYAMLEmitter&) = delete;
+  DataTreeYAMLEmitter& operator=(const DataTreeYAMLEmitter&) = delete;
+
+  /**Writes `tree`. `indent` is the indentation of the tree's own level; the
+   * tree's first line is not indented, the caller places it.*/
+  void emit(const DataTree& tree,
+            const std::string& indent,
+            const std::vector<std::string>& tags_to_print = {});
+
+  /**Hands pending output to the sink. Does nothing for buffer output.*/
+  void flush();
+
+private:
+  void emitNode(const DataTree& tree);
+  void emitTags(const DataTree& tree);
+  void emitScalar(const ScalarValue& value);
+  /**Called after each line.*/
+  void endLine();
+
+  std::string m_chunk;   ///< Pending output when writing to a sink
+  std::string& m_output; ///< Either the caller's buffer or m_chunk
+  YAMLChunkSink m_sink;
+  size_t m_chunk_size = 0;
+
+  // State of the current emit() call.
+  std::string m_indent;
+  const std::vector<std::string>* m_tags_to_print = nullptr;
+};
+
+/**Writes `tree` as YAML to `stream`, in chunks.*/
+void writeDataTreeYAML(const DataTree& tree,
+                       std::ostream& stream,
+                       const std::string& indent = "",
+                       const std::vector<std::string>& tags_to_print = {});
+
+/**Writes `tree` as YAML to the open file descriptor `file_descriptor`, in
+ * chunks. Returns false if a write fails. Only available on POSIX
+ * systems; elsewhere it always returns false.*/
+bool writeDataTreeYAML(const DataTree& tree,
+                       int file_descriptor,
+                       const std::string& indent = "",
+                       const std::vector<std::string>& tags_to_print = {});
+
+} // namespace elke
+
+#endif // ELKE_CORE_DATA_TYPES_DATATREEYAML_H
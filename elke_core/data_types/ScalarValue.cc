@@ -9,6 +9,17 @@
 namespace elke
 {
 
+namespace
+{
+/**Returns true if a float truncates to an int64_t, i.e., if it is finite and
+ * within the range of int64_t.*/
+bool truncatesToInt64(const double value)
+{
+  constexpr double int64_limit = 9223372036854775808.0; // 2^63
+  return value >= -int64_limit and value < int64_limit;
+}
+} // namespace
+
 /**Returns a string representation of ScalarType.
  * \param type The type to convert to a string.
  */
@@ -45,13 +56,17 @@ bool ScalarValue::isConvertibleToType(const ScalarType target_type) const
       // Sometimes a string can be converted to numbers
     case ScalarType::STRING:
     {
-      const auto string_value = std::any_cast<std::string>(m_value);
+      const auto& string_value = std::any_cast<const std::string&>(m_value);
       if (target_type == ScalarType::STRING) return true;
       if (target_type == ScalarType::BOOL)
         return string_value == "true" or string_value == "false";
 
-      if (target_type == ScalarType::INTEGER or
-          target_type == ScalarType::FLOAT)
+      if (target_type == ScalarType::INTEGER)
+      {
+        int64_t int_value;
+        return string_utils::parseNumberAsInt64(string_value, int_value);
+      }
+      if (target_type == ScalarType::FLOAT)
         return string_utils::isStringANumber(string_value);
 
       return false;
@@ -59,10 +74,13 @@ bool ScalarValue::isConvertibleToType(const ScalarType target_type) const
     }// case STRING
 
       // Bools, integers and floats can generally be converted to all others
-      // except void
+      // except void, but floats only to integers if they fit
     case ScalarType::BOOL:
     case ScalarType::INTEGER:
+      return target_type != ScalarType::VOID;
     case ScalarType::FLOAT:
+      if (target_type == ScalarType::INTEGER)
+        return truncatesToInt64(std::any_cast<double>(m_value));
       return target_type != ScalarType::VOID;
 
     default: return false;
@@ -73,100 +91,123 @@ bool ScalarValue::isConvertibleToType(const ScalarType target_type) const
 /**Returns a new scalar value of this value converted to the target type.*/
 ScalarValue ScalarValue::convertedToType(const ScalarType target_type) const
 {
+  ScalarValue converted;
+  if (tryConvertToType(target_type, converted)) return converted;
+
+  elkLogicalError("Conversion failed to target type " +
+                  scalarTypeStringName(target_type) + " for value " +
+                  this->convertToString() + " of type " + this->typeString() +
+                  ".");
+}
 
+/**Converts this value to the target type, validating it in the same pass.
+ * Returns false, leaving `converted` unchanged, if the value is not
+ * convertible.*/
+bool ScalarValue::tryConvertToType(const ScalarType target_type,
+                                   ScalarValue& converted) const
+{
   switch (m_scalar_type)
   {
     // clang-format off
     // Only a void can be converted to a void
     case ScalarType::VOID:
-      if (target_type == ScalarType::VOID) return *this;
-      break;
+      if (target_type != ScalarType::VOID) break;
+      converted = *this;
+      return true;
 
       // Sometimes a string can be converted to numbers
     case ScalarType::STRING:
     {
-      const auto string_value = std::any_cast<std::string>(m_value);
-      if (target_type == ScalarType::STRING) return *this;
+      const auto& string_value = std::any_cast<const std::string&>(m_value);
+      if (target_type == ScalarType::STRING)
+      {
+        converted = *this;
+        return true;
+      }
 
       if (target_type == ScalarType::BOOL)
       {
-        if (string_value == "true") return ScalarValue(true);
-        if (string_value == "false") return ScalarValue(false);
-        break;
+        if (string_value != "true" and string_value != "false") break;
+        converted = ScalarValue(string_value == "true");
+        return true;
       }
 
+      // Each string is validated and converted in a single parse. Strings
+      // holding a non-integer number convert to INTEGER by truncation, the
+      // same as a FLOAT value does.
       if (target_type == ScalarType::INTEGER)
       {
-        if (not string_utils::isStringANumber(string_value)) break;
-        const int64_t int_value = std::stoull(string_value);
-        return ScalarValue(int_value);
+        int64_t int_value;
+        if (not string_utils::parseNumberAsInt64(string_value, int_value))
+          break;
+        converted = ScalarValue(int_value);
+        return true;
       }
 
       if (target_type == ScalarType::FLOAT)
       {
-        if (not string_utils::isStringANumber(string_value)) break;
-        const double float_value = std::stod(string_value);
-        return ScalarValue(float_value);
+        double float_value;
+        if (not string_utils::parseDouble(string_value, float_value)) break;
+        converted = ScalarValue(float_value);
+        return true;
       }
 
       break;
     }// case STRING
 
       // Bools, integers and floats can generally be converted to all others
-      // except void
+      // except void, but floats only to integers if they fit
     case ScalarType::BOOL:
     {
       const auto bool_value = std::any_cast<bool>(m_value);
       if (target_type == ScalarType::VOID) break;
       if (target_type == ScalarType::STRING)
-        return bool_value ? ScalarValue("true") : ScalarValue("false");
-      if (target_type == ScalarType::BOOL) return *this;
+        converted = bool_value ? ScalarValue("true") : ScalarValue("false");
+      if (target_type == ScalarType::BOOL) converted = *this;
       if (target_type == ScalarType::INTEGER)
-        return bool_value ? ScalarValue(1) : ScalarValue(0);
+        converted = bool_value ? ScalarValue(1) : ScalarValue(0);
       if (target_type == ScalarType::FLOAT)
-        return bool_value ? ScalarValue(1.0) : ScalarValue(0.0);
+        converted = bool_value ? ScalarValue(1.0) : ScalarValue(0.0);
 
-      break;
+      return true;
     }
     case ScalarType::INTEGER:
     {
       const auto int_value = std::any_cast<int64_t>(m_value);
       if (target_type == ScalarType::VOID) break;
       if (target_type == ScalarType::STRING)
-        return ScalarValue(std::to_string(int_value));
-      if (target_type == ScalarType::INTEGER) return *this;
+        converted = ScalarValue(std::to_string(int_value));
+      if (target_type == ScalarType::INTEGER) converted = *this;
       if (target_type == ScalarType::FLOAT)
       {
         const double float_value = int_value;
-        return ScalarValue(float_value);
+        converted = ScalarValue(float_value);
       }
 
-      break;
+      return true;
     }
     case ScalarType::FLOAT:
     {
       const auto float_value = std::any_cast<double>(m_value);
       if (target_type == ScalarType::VOID) break;
       if (target_type == ScalarType::STRING)
-        return ScalarValue(std::to_string(float_value));
+        converted = ScalarValue(std::to_string(float_value));
       if (target_type == ScalarType::INTEGER)
       {
+        if (not truncatesToInt64(float_value)) break;
         const int64_t int_value = float_value;
-        return ScalarValue(int_value);
+        converted = ScalarValue(int_value);
       }
-      if (target_type == ScalarType::FLOAT) return *this;
+      if (target_type == ScalarType::FLOAT) converted = *this;
 
-      break;
+      return true;
     }
 
     default: break;
     // clang-format on
   } // switch (m_type)
 
-  elkLogicalError("Conversion failed to target type " +
-                  scalarTypeStringName(target_type) + " for value " +
-                  this->convertToString() + " of type " + this->typeString() +
-                  ".");
+  return false;
 }
 
 /**Converts the underlying value to a string using a stream operator.
@@ -134,9 +134,16 @@ public:
    */
   bool isConvertibleToType(ScalarType target_type) const;
 
-  /**Returns a new scalar value of this value converted to the target type.*/
+  /**Returns a new scalar value of this value converted to the target type.
+   * Throws if the value is not convertible.*/
   ScalarValue convertedToType(ScalarType target_type) const;
 
+  /**Converts this value to the target type, validating it in the same pass,
+   * e.g., parsing a string once. Returns false, leaving `converted`
+   * unchanged, if the value is not convertible, with the same rules as
+   * isConvertibleToType.*/
+  bool tryConvertToType(ScalarType target_type, ScalarValue& converted) const;
+
   /**Returns a const reference to the scalar value. Can throw
    * std::bad_any_cast.*/
   template <typename T>
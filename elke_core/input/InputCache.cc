@@ -0,0 +1,123 @@
+#include "InputCache.h"
+
+#include "elke_core/data_types/DataTreeBinary.h"
+#include "elke_core/elke_configuration.h"
+#include "elke_core/utilities/MappedFile.h"
+#include "elke_core/utilities/hash_utils.h"
+
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) or defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace elke
+{
+
+namespace
+{
+/**Bump when the layout of cache entries, or of writeDataTreeBinary,
+ * changes.*/
+constexpr int INPUT_CACHE_FORMAT_VERSION = 1;
+} // namespace
+
+// ###################################################################
+InputCache::InputCache(std::filesystem::path directory)
+  : m_directory(std::move(directory))
+{
+}
+
+// ###################################################################
+InputCache::Key InputCache::makeKey(const std::string_view content,
+                                    const std::string& source_name,
+                                    const std::string& parser_version)
+{
+  Key key;
+  key.m_content_hash = hash_utils::xxHash64(content);
+  key.m_content_size = content.size();
+  key.m_source_name = source_name;
+  key.m_parser_version = parser_version;
+  return key;
+}
+
+// ###################################################################
+std::string InputCache::makeHeader(const Key& key)
+{
+  return "elke-input-cache " + std::to_string(INPUT_CACHE_FORMAT_VERSION) +
+         "\nelke " + PROJECT_VERSION + "\nparser " + key.m_parser_version +
+         "\nsource " + key.m_source_name + "\ncontent " +
+         hash_utils::toHexString(key.m_content_hash) + " " +
+         std::to_string(key.m_content_size) + "\n";
+}
+
+// ###################################################################
+std::filesystem::path InputCache::entryPath(const Key& key) const
+{
+  // The name covers everything in the key, so that different files or
+  // parsers with the same content get separate entries.
+  const std::string identity =
+    key.m_parser_version + '\0' + key.m_source_name;
+  const uint64_t name_hash =
+    hash_utils::xxHash64(identity, key.m_content_hash);
+
+  return m_directory / (hash_utils::toHexString(name_hash) + ".edt");
+}
+
+// ###################################################################
+std::shared_ptr<DataTree> InputCache::load(const Key& key) const
+{
+  std::error_code error_code;
+  const auto path = entryPath(key);
+  if (not std::filesystem::is_regular_file(path, error_code)) return nullptr;
+
+  const MappedFile file(path);
+  if (not file.isOpen()) return nullptr;
+
+  const std::string header = makeHeader(key);
+  const std::string_view entry = file.view();
+  if (entry.substr(0, header.size()) != header) return nullptr;
+
+  return readDataTreeBinary(entry.substr(header.size()));
+}
+
+// ###################################################################
+bool InputCache::store(const Key& key, const DataTree& tree) const
+{
+  std::error_code error_code;
+  std::filesystem::create_directories(m_directory, error_code);
+  if (error_code) return false;
+
+  std::string entry = makeHeader(key);
+  writeDataTreeBinary(tree, entry);
+
+  const auto path = entryPath(key);
+  auto temporary_path = path;
+#if defined(__unix__) or defined(__APPLE__)
+  temporary_path += ".tmp" + std::to_string(::getpid());
+#else
+  temporary_path += ".tmp";
+#endif
+
+  {
+    std::ofstream out(temporary_path, std::ios::binary | std::ios::trunc);
+    out.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+    if (not out)
+    {
+      out.close();
+      std::filesystem::remove(temporary_path, error_code);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(temporary_path, path, error_code);
+  if (error_code)
+  {
+    std::filesystem::remove(temporary_path, error_code);
+    return false;
+  }
+  return true;
+}
+
+} // namespace elke
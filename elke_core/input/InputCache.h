@@ -0,0 +1,66 @@
+#ifndef ELKE_CORE_INPUT_INPUTCACHE_H
+#define ELKE_CORE_INPUT_INPUTCACHE_H
+
+#include "elke_core/data_types/DataTree.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace elke
+{
+
+/**On-disk cache of parsed input files. Entries are keyed on a hash of the
+ * file's content, so that restarting with unchanged inputs skips parsing.
+ *
+ * Each entry is one file in the cache directory, named after the key's
+ * hash, holding a short text header followed by the tree in the format of
+ * writeDataTreeBinary. The header repeats the full key together with the
+ * framework version and a cache format version. A load only succeeds if all
+ * of these match, so that entries written by another parser version, for
+ * another file name (which ends up in the tree's tags) or by a hash
+ * collision are ignored and later overwritten.*/
+class InputCache
+{
+public:
+  /**Identifies the tree a parser produces for an input.*/
+  struct Key
+  {
+    uint64_t m_content_hash = 0;
+    uint64_t m_content_size = 0;
+    std::string m_source_name;
+    /**See InputParser::version.*/
+    std::string m_parser_version;
+  };
+
+  explicit InputCache(std::filesystem::path directory);
+
+  /**Hashes `content` (xxHash64) and builds the key.*/
+  static Key makeKey(std::string_view content,
+                     const std::string& source_name,
+                     const std::string& parser_version);
+
+  /**Returns the cached tree for `key`, or nullptr if there is none or the
+   * entry does not match.*/
+  std::shared_ptr<DataTree> load(const Key& key) const;
+
+  /**Writes the entry for `key`, replacing any existing one. The entry is
+   * written to a temporary file first and renamed, so that concurrent runs
+   * never see partial entries. Returns false if the entry could not be
+   * written.*/
+  bool store(const Key& key, const DataTree& tree) const;
+
+  /**The file holding the entry for `key`.*/
+  std::filesystem::path entryPath(const Key& key) const;
+
+private:
+  static std::string makeHeader(const Key& key);
+
+  std::filesystem::path m_directory;
+};
+
+} // namespace elke
+
+#endif // ELKE_CORE_INPUT_INPUTCACHE_H
@@ -1,5 +1,7 @@
 #include "InputParser.h"
 
+#include "elke_core/utilities/MappedFile.h"
+
 namespace elke
 {
 
@@ -12,4 +14,35 @@ const std::vector<std::string>& InputParser::warnings() const
   return m_warnings;
 }
 
+// ###################################################################
+elke::DataTree InputParser::parseInputFile(const std::string& file_name)
+{
+  const MappedFile file(file_name);
+  if (not file.isOpen())
+  {
+    m_errors.emplace_back("Failed to open \"" + file_name + "\".\n");
+    return elke::DataTree("");
+  }
+  return this->parseInputContent(file.view(), file_name);
+}
+
+// ###################################################################
+std::string_view
+InputParser::skipWhitespaceAndComments(std::string_view text,
+                                       const std::string_view comment_prefix)
+{
+  while (true)
+  {
+    const size_t start = text.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) return {};
+    text.remove_prefix(start);
+
+    if (text.substr(0, comment_prefix.size()) != comment_prefix) return text;
+
+    const size_t line_end = text.find('\n');
+    if (line_end == std::string_view::npos) return {};
+    text.remove_prefix(line_end);
+  }
+}
+
 } // namespace elke
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 
 namespace elke
 {
@@ -17,12 +18,37 @@ protected:
   elke::Logger& m_logger;
   std::vector<std::string> m_warnings;
   std::vector<std::string> m_errors;
+  /**If set, parsers that support it defer building subtrees until they are
+   * accessed, see DataTree::setMaterializer.*/
+  bool m_lazy_parsing = false;
+
+  /**Returns `text` without leading whitespace and without leading lines
+   * that start with `comment_prefix`. Used by the content sniffers of
+   * derived parsers.*/
+  static std::string_view skipWhitespaceAndComments(
+    std::string_view text, std::string_view comment_prefix);
 
 public:
-  /**Reads an input file and produces a DataTree.*/
-  virtual elke::DataTree parseInputFile(std::string file_name) = 0;
+  /**Reads an input file and produces a DataTree. The file is memory mapped
+   * and its content handed to parseInputContent.*/
+  elke::DataTree parseInputFile(const std::string& file_name);
+
+  /**Parses input held in memory, e.g., a mapped file. `source_name` names
+   * the root of the tree and is used in messages.*/
+  virtual elke::DataTree parseInputContent(std::string_view content,
+                                           const std::string& source_name) = 0;
   virtual ~InputParser() = default;
 
+  /**Identifies the parser and the version of the trees it produces, e.g.,
+   * "YAMLInput 1". Parsed trees are cached under this version, so it must
+   * change whenever the tree produced for the same input changes. An empty
+   * string means the output cannot be cached, e.g., because it does not only
+   * depend on the file's content.*/
+  virtual std::string version() const = 0;
+
+  /**Turns on/off lazy parsing for parsers that support it.*/
+  void setLazyParsing(const bool value) { m_lazy_parsing = value; }
+
   const std::vector<std::string>& warnings() const;
   const std::vector<std::string>& errors() const;
 
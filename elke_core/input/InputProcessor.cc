@@ -1,14 +1,17 @@
 #include "InputProcessor.h"
 
-#include "YAMLInput.h"
+#include "InputCache.h"
+#include "InputParser.h"
+#include "elke_core/data_types/DataTreeYAML.h"
 #include "elke_core/output/elk_exceptions.h"
 #include "elke_core/output/Logger.h"
 #include "elke_core/registration/registration.h"
+#include "elke_core/utilities/MappedFile.h"
 #include "elke_core/utilities/string_utils.h"
 
 #include <sstream>
 #include <utility>
-#include <fstream>
+#include <algorithm>
 
 namespace elke
 {
@@ -46,38 +49,30 @@ void InputProcessor::parseInputFiles()
       continue;
     }
 
+    // The file is read once; echoing, format detection and parsing share
+    // the mapped bytes.
+    const MappedFile file(path);
+    if (not file.isOpen())
+    {
+      parsing_errors.push_back("Failed to open \"" + path.string() + "\"\n");
+      continue;
+    }
+
     // ReSharper disable once CppDFAConstantConditions
     if (m_echo_input)
     {
       // ReSharper disable once CppDFAUnreachableCode
-      std::ifstream file(path, std::ios::in);
-      if (file.is_open())
-      {
-        using iterator = std::istreambuf_iterator<char>;
-        const std::string content((iterator(file)), iterator());
-
-        m_logger_ptr->log() << "Input file echo for " << path.string() << ":\n"
-                            << content;
-      }
-      file.close();
+      m_logger_ptr->log() << "Input file echo for " << path.string() << ":\n"
+                          << file.view();
     }
 
-    const auto extension = path.extension();
-    std::unique_ptr<elke::InputParser> parser_ptr = nullptr;
-    if (extension == ".yaml")
-    {
-      parser_ptr = std::make_unique<YAMLInput>(*m_logger_ptr);
-    }
-    else
-    {
-      parsing_errors.emplace_back("No available input parser for extension " +
-                                  extension.string() + " of input file " +
-                                  path.string() + "\n");
-    }
+    const auto parser_ptr = createInputParser(path, file.view(), parsing_errors);
 
     if (parser_ptr != nullptr)
     {
-      elke::DataTree data_tree = parser_ptr->parseInputFile(path);
+      parser_ptr->setLazyParsing(m_lazy_input);
+      elke::DataTree data_tree =
+        parseWithInputCache(*parser_ptr, path, file.view());
       const auto& warnings = parser_ptr->warnings();
       const auto& errors = parser_ptr->errors();
 
@@ -89,13 +84,26 @@ void InputProcessor::parseInputFiles()
         for (const auto& error : errors)
           parsing_errors.push_back(error);
 
+      if (m_deduplicate_input and not m_lazy_input)
+      {
+        auto& marks = m_input_marks[path];
+        const size_t num_nodes_saved = deduplicateDataTree(data_tree, marks);
+        m_logger_ptr->log() << "Deduplicated " << num_nodes_saved
+                            << " nodes of \"" << path.string() << "\"\n";
+      }
+
       //
       // ReSharper disable once CppDFAConstantConditions
       if (m_echo_input_data)
       {
         // ReSharper disable once CppDFAUnreachableCode
-        m_logger_ptr->log() << "Input data echo for " << path.string() << ":\n"
-                            << data_tree.toStringAsYAML("", {"type"});
+        m_logger_ptr->log() << "Input data echo for " << path.string()
+                            << ":\n";
+        // Logged in chunks of whole lines, which gives the same output as
+        // logging the whole string without holding it.
+        DataTreeYAMLEmitter emitter([this](const std::string_view chunk)
+                                    { m_logger_ptr->log() << chunk; });
+        emitter.emit(data_tree, "", {"type"});
       }
 
       m_data_trees.insert(std::make_pair(path, data_tree));
@@ -127,12 +135,94 @@ void InputProcessor::parseInputFiles()
   this->consolidateBlocks();
 }
 
+// ###################################################################
+std::unique_ptr<elke::InputParser>
+InputProcessor::createInputParser(const std::filesystem::path& path,
+                                  const std::string_view content,
+                                  std::vector<std::string>& parsing_errors) const
+{
+  const auto& parser_register = StaticRegister::getInputParserRegister();
+  const std::string extension = path.extension().string();
+
+  //============================================= By extension
+  if (not extension.empty())
+  {
+    for (const auto& [parser_name, entry] : parser_register)
+      if (std::find(entry.m_extensions.begin(),
+                    entry.m_extensions.end(),
+                    extension) != entry.m_extensions.end())
+        return entry.m_constructor_function(*m_logger_ptr);
+
+    parsing_errors.emplace_back("No available input parser for extension " +
+                                extension + " of input file " + path.string() +
+                                "\n");
+    return nullptr;
+  }
+
+  //============================================= By content
+  constexpr size_t SNIFF_SIZE = 512;
+  const std::string_view head = content.substr(0, SNIFF_SIZE);
+
+  for (const auto& [parser_name, entry] : parser_register)
+    if (entry.m_sniff_function(head))
+      return entry.m_constructor_function(*m_logger_ptr);
+
+  parsing_errors.emplace_back("Input file " + path.string() +
+                              " has no extension and its format could not "
+                              "be determined from its content\n");
+  return nullptr;
+}
+
+// ###################################################################
+elke::DataTree
+InputProcessor::parseWithInputCache(elke::InputParser& parser,
+                                    const std::filesystem::path& path,
+                                    const std::string_view content) const
+{
+  const std::string parser_version = parser.version();
+  if (not m_use_input_cache or m_input_cache_directory.empty() or
+      parser_version.empty())
+    return parser.parseInputContent(content, path.string());
+
+  const InputCache input_cache(m_input_cache_directory);
+  const auto key = InputCache::makeKey(content, path.string(), parser_version);
+
+  if (const auto cached_tree = input_cache.load(key))
+  {
+    m_logger_ptr->log() << "Loaded \"" << path.string()
+                        << "\" from the input cache\n";
+    return *cached_tree;
+  }
+
+  elke::DataTree data_tree = parser.parseInputContent(content, path.string());
+
+  // Only clean parses are stored since a cache hit has no warnings to
+  // report. Lazy trees are not stored; that would parse every block.
+  if (parser.errors().empty() and parser.warnings().empty() and
+      not m_lazy_input)
+  {
+    if (input_cache.store(key, data_tree))
+      m_logger_ptr->log(LogVerbosity::LEVEL_2)
+        << "Stored \"" << path.string() << "\" in the input cache\n";
+    else
+      m_logger_ptr->warn() << "Failed to write the input cache entry "
+                           << input_cache.entryPath(key).string() << "\n";
+  }
+
+  return data_tree;
+}
+
 // ###################################################################
 void InputProcessor::consolidateBlocks()
 {
   // TODO: Implement properly
 
-  if (not m_data_trees.empty()) m_main_data_tree = m_data_trees.begin()->second;
+  if (m_data_trees.empty()) return;
+
+  const auto& [path, data_tree] = *m_data_trees.begin();
+  m_main_data_tree = data_tree;
+  const auto marks = m_input_marks.find(path);
+  if (marks != m_input_marks.end()) m_main_input_marks = &marks->second;
 }
 
 // ###################################################################
@@ -161,13 +251,18 @@ void InputProcessor::checkInputDataForSyntaxBlocks() const
         m_logger_ptr->log() << out_stream.str();
         auto block_parameters = block_reg_entry.m_parameter_function();
 
-        StatusStrings status_strings;
-        block_parameters.processSpecification(status_strings, *block_tree_ptr);
-
-        if (not status_strings.m_errors.empty())
-          warnings_and_errors_data.m_errors.push_back(status_strings.m_errors);
-        if (not status_strings.m_warnings.empty())
-          warnings_and_errors_data.m_warnings.push_back(status_strings.m_warnings);
+        // The diagnostics refer to block_parameters, so they are formatted
+        // before it goes out of scope.
+        ParameterDiagnostics diagnostics;
+        diagnostics.setMarkTable(m_main_input_marks);
+        block_parameters.processSpecification(diagnostics, *block_tree_ptr);
+
+        if (diagnostics.hasErrors())
+          warnings_and_errors_data.m_errors.push_back(
+            diagnostics.errorsAsString());
+        if (diagnostics.hasWarnings())
+          warnings_and_errors_data.m_warnings.push_back(
+            diagnostics.warningsAsString());
 
         block_processed = true;
         break;
@@ -4,14 +4,19 @@
 #include <vector>
 #include <filesystem>
 #include <map>
+#include <memory>
+#include <string>
+#include <string_view>
 
 #include "elke_core/data_types/DataTree.h"
+#include "elke_core/data_types/DataTreeDedup.h"
 #include "elke_core/utilities/general_utils.h"
 
 namespace elke
 {
 
 class InputParametersBlock;
+class InputParser;
 
 class Logger;
 
@@ -25,6 +30,15 @@ class InputProcessor
   elke::DataTree m_main_data_tree;
   bool m_echo_input = false;
   bool m_echo_input_data = false;
+  bool m_lazy_input = false;
+  bool m_deduplicate_input = false;
+  /// Marks of the deduplicated nodes of each input file, used to locate
+  /// the diagnostics of the checks.
+  std::map<std::filesystem::path, elke::DataTreeMarkTable> m_input_marks;
+  /// Marks of the file of m_main_data_tree, if it was deduplicated.
+  const elke::DataTreeMarkTable* m_main_input_marks = nullptr;
+  std::filesystem::path m_input_cache_directory;
+  bool m_use_input_cache = true;
 
 public:
   /**Protected constructor.*/
@@ -37,6 +51,20 @@ public:
   void parseInputFiles();
 
 private:
+  /**Creates the registered parser for the extension of `path` or, if the
+   * path has no extension, the first parser that recognizes the start of
+   * `content`. Returns nullptr and adds an error if no parser is found.*/
+  std::unique_ptr<elke::InputParser>
+  createInputParser(const std::filesystem::path& path,
+                    std::string_view content,
+                    std::vector<std::string>& parsing_errors) const;
+
+  /**Parses the content of a file, going through the input cache if it is
+   * enabled.*/
+  elke::DataTree parseWithInputCache(elke::InputParser& parser,
+                                     const std::filesystem::path& path,
+                                     std::string_view content) const;
+
   /**Consolidate blocks.*/
   void consolidateBlocks();
 
@@ -61,6 +89,19 @@ public:
   void setEchoInput(const bool value) { m_echo_input = value; }
   /**Turns on/off the echoing of the processed input files.*/
   void setEchoInputData(const bool value) { m_echo_input_data = value; }
+  /**Turns on/off lazy parsing of input files.*/
+  void setLazyInput(const bool value) { m_lazy_input = value; }
+  /**Turns on/off the deduplication of repeated subtrees of input files,
+   * see deduplicateDataTree. Not applied to lazily parsed files.*/
+  void setDeduplicateInput(const bool value) { m_deduplicate_input = value; }
+  /**Sets the directory of the parsed-input cache. The cache is only used
+   * if a directory is set.*/
+  void setInputCacheDirectory(const std::filesystem::path& directory)
+  {
+    m_input_cache_directory = directory;
+  }
+  /**Turns on/off the parsed-input cache, overriding the directory.*/
+  void setUseInputCache(const bool value) { m_use_input_cache = value; }
 };
 
 } // namespace elke
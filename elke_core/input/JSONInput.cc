@@ -0,0 +1,425 @@
+#include "JSONInput.h"
+#include "JSONStructuralIndex.h"
+
+#include "elke_core/output/Logger.h"
+#include "elke_core/registration/registration.h"
+#include "elke_core/utilities/string_utils.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace elke
+{
+
+namespace JSONInputHelpers
+{
+/**Nesting depth beyond which a document is rejected, to bound the
+ * recursion.*/
+constexpr size_t MAX_DEPTH = 1024;
+
+bool isTokenEnd(const char c)
+{
+  switch (c)
+  {
+    // clang-format off
+    case ' ': case '\t': case '\n': case '\r':
+    case '{': case '}': case '[': case ']': case ':': case ',':
+      return true;
+    default: return false;
+    // clang-format on
+  }
+}
+
+bool isDigit(const char c) { return c >= '0' and c <= '9'; }
+
+// ###################################################################
+/**Checks the JSON number grammar,
+ * `-?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?`, and reports whether the
+ * number has a fraction or exponent.*/
+bool isJSONNumber(const std::string_view token, bool& is_integer)
+{
+  size_t i = 0;
+  const size_t n = token.size();
+  auto digits = [&]()
+  {
+    const size_t start = i;
+    while (i < n and isDigit(token[i]))
+      ++i;
+    return i - start;
+  };
+
+  if (i < n and token[i] == '-') ++i;
+  if (i < n and token[i] == '0') ++i;
+  else if (digits() == 0) return false;
+
+  is_integer = true;
+  if (i < n and token[i] == '.')
+  {
+    ++i;
+    is_integer = false;
+    if (digits() == 0) return false;
+  }
+  if (i < n and (token[i] == 'e' or token[i] == 'E'))
+  {
+    ++i;
+    is_integer = false;
+    if (i < n and (token[i] == '+' or token[i] == '-')) ++i;
+    if (digits() == 0) return false;
+  }
+  return i == n;
+}
+
+// ###################################################################
+int hexValue(const char c)
+{
+  if (c >= '0' and c <= '9') return c - '0';
+  if (c >= 'a' and c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' and c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/**Appends a code point as UTF-8.*/
+void appendUTF8(std::string& out, const uint32_t code_point)
+{
+  if (code_point < 0x80)
+    out.push_back(static_cast<char>(code_point));
+  else if (code_point < 0x800)
+  {
+    out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+    out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  }
+  else if (code_point < 0x10000)
+  {
+    out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  }
+  else
+  {
+    out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  }
+}
+} // namespace JSONInputHelpers
+
+// ###################################################################
+JSONInput::JSONInput(Logger& logger) : InputParser(logger) {}
+
+// ###################################################################
+/**Parses a document held in memory.*/
+elke::DataTree JSONInput::parseInputContent(const std::string_view json,
+                                            const std::string& source_name)
+{
+  using json::STRUCTURAL_BLOCK_SIZE;
+  elke::DataTree data_tree("");
+  m_current_file_name = source_name;
+  m_logger.log() << "Reading JSON-file \"" << source_name << "\"\n";
+
+  //=================================== Pad with whitespace
+  m_size = json.size();
+  const size_t padded_size =
+    (m_size / STRUCTURAL_BLOCK_SIZE + 1) * STRUCTURAL_BLOCK_SIZE;
+  m_buffer.assign(padded_size, ' ');
+  std::copy(json.begin(), json.end(), m_buffer.begin());
+
+  m_next = 0;
+  m_source = std::make_shared<const DataTreeSource>(source_name, json);
+
+  //=================================== Stage 1: structural index
+  std::string error;
+  if (not json::buildStructuralIndex(m_buffer, m_size, m_structurals, error))
+  {
+    m_errors.emplace_back(source_name + ": " + error + "\n");
+    return data_tree;
+  }
+  if (m_structurals.empty())
+  {
+    m_errors.emplace_back(source_name + ": The document is empty.\n");
+    return data_tree;
+  }
+
+  //=================================== Stage 2: build the tree
+  DataTree root_tree(source_name);
+  try
+  {
+    this->parseValue(root_tree, 0);
+    if (m_next != m_structurals.size())
+      parseError(peekStructural(), "Unexpected content after the root value.");
+  }
+  catch (const std::exception& e)
+  {
+    m_errors.emplace_back(std::string(e.what()) + "\n");
+  }
+  data_tree = root_tree;
+
+  m_buffer.clear();
+  m_buffer.shrink_to_fit();
+  m_structurals.clear();
+  m_structurals.shrink_to_fit();
+  m_source = nullptr;
+  m_logger.log() << "Done reading JSON-file \"" << source_name << "\"\n";
+
+  return data_tree;
+}
+
+// ###################################################################
+/**Parses the value starting at the current structural index.*/
+void JSONInput::parseValue(elke::DataTree& tree, const size_t depth)
+{
+  if (m_next >= m_structurals.size())
+    parseError(static_cast<uint32_t>(m_size), "Expected a value.");
+  if (depth > JSONInputHelpers::MAX_DEPTH)
+    parseError(peekStructural(), "Maximum nesting depth exceeded.");
+
+  const uint32_t offset = nextStructural();
+  tree.setSourceMark(m_source, offset);
+
+  switch (m_buffer[offset])
+  {
+    case '{':
+      parseObject(tree, depth);
+      break;
+    case '[':
+      parseArray(tree, depth);
+      break;
+    case '}':
+    case ']':
+    case ':':
+    case ',':
+      parseError(offset,
+                 std::string("Expected a value, found '") + m_buffer[offset] +
+                   "'.");
+    default:
+      parseScalar(tree, offset);
+  }
+}
+
+// ###################################################################
+/**Parses the members of an object whose '{' has been consumed.*/
+void JSONInput::parseObject(elke::DataTree& tree, const size_t depth)
+{
+  tree.setGrossType(DataGrossType::MAP);
+
+  if (m_buffer[peekStructural()] == '}')
+  {
+    nextStructural();
+    return;
+  }
+
+  // Keys of the members added, viewing the names of the children, so that
+  // duplicates are found without comparing every sibling.
+  std::unordered_set<std::string_view> keys;
+  while (true)
+  {
+    const uint32_t key_offset = nextStructural();
+    if (m_buffer[key_offset] != '"')
+      parseError(key_offset, "Expected a string as object key.");
+    auto sub_node_ptr = std::make_shared<DataTree>(decodeString(key_offset));
+
+    const uint32_t colon_offset = nextStructural();
+    if (m_buffer[colon_offset] != ':')
+      parseError(colon_offset, "Expected ':' after object key.");
+
+    // Duplicates are reported but parsing continues, like YAMLInput.
+    if (keys.insert(sub_node_ptr->name()).second)
+      tree.addChild(sub_node_ptr, /*prevent_duplicate=*/false);
+    else
+      m_errors.emplace_back("Cannot add child named \"" + sub_node_ptr->name() +
+                            "\" to data-tree at \"" + tree.getTag("address") +
+                            "\"\n");
+    parseValue(*sub_node_ptr, depth + 1);
+
+    const uint32_t next_offset = nextStructural();
+    if (m_buffer[next_offset] == '}') return;
+    if (m_buffer[next_offset] != ',')
+      parseError(next_offset, "Expected ',' or '}' in object.");
+  }
+}
+
+// ###################################################################
+/**Parses the elements of an array whose '[' has been consumed.*/
+void JSONInput::parseArray(elke::DataTree& tree, const size_t depth)
+{
+  tree.setGrossType(DataGrossType::SEQUENCE);
+
+  if (m_buffer[peekStructural()] == ']')
+  {
+    nextStructural();
+    return;
+  }
+
+  while (true)
+  {
+    auto sub_node_ptr = std::make_shared<DataTree>("");
+    tree.addChild(sub_node_ptr);
+    parseValue(*sub_node_ptr, depth + 1);
+
+    const uint32_t next_offset = nextStructural();
+    if (m_buffer[next_offset] == ']') return;
+    if (m_buffer[next_offset] != ',')
+      parseError(next_offset, "Expected ',' or ']' in array.");
+  }
+}
+
+// ###################################################################
+/**Parses a string, number or literal starting at `offset`.*/
+void JSONInput::parseScalar(elke::DataTree& tree, const uint32_t offset)
+{
+  using namespace JSONInputHelpers;
+  tree.setGrossType(DataGrossType::SCALAR);
+
+  if (m_buffer[offset] == '"')
+  {
+    tree.setValue(ScalarValue(decodeString(offset)));
+    return;
+  }
+
+  size_t end = offset;
+  while (not isTokenEnd(m_buffer[end]))
+    ++end;
+  const std::string_view token(m_buffer.data() + offset, end - offset);
+
+  if (token == "true") tree.setValue(ScalarValue(true));
+  else if (token == "false") tree.setValue(ScalarValue(false));
+  else if (token == "null") tree.setGrossType(DataGrossType::NO_DATA);
+  else
+  {
+    bool is_integer = false;
+    if (not isJSONNumber(token, is_integer))
+      parseError(offset, "Invalid value \"" + std::string(token) + "\".");
+
+    int64_t int_value = 0;
+    double float_value = 0.0;
+    // Integers beyond the int64_t range are kept as floats.
+    if (is_integer and string_utils::parseInt64(token, int_value))
+      tree.setValue(ScalarValue(int_value));
+    else if (string_utils::parseDouble(token, float_value))
+      tree.setValue(ScalarValue(float_value));
+    else
+      parseError(offset, "Number out of range \"" + std::string(token) + "\".");
+  }
+}
+
+// ###################################################################
+/**Decodes the string whose opening quote is at `offset`.*/
+std::string JSONInput::decodeString(const uint32_t offset)
+{
+  using namespace JSONInputHelpers;
+  std::string out;
+
+  size_t i = offset + 1;
+  while (true)
+  {
+    // Copy runs of plain characters in one go
+    const size_t run_end = m_buffer.find_first_of("\"\\", i);
+    if (run_end == std::string::npos or run_end >= m_size)
+      parseError(offset, "Unterminated string.");
+    for (size_t j = i; j < run_end; ++j)
+      if (static_cast<unsigned char>(m_buffer[j]) < 0x20)
+        parseError(offset, "Unescaped control character in string.");
+    out.append(m_buffer, i, run_end - i);
+    i = run_end;
+
+    if (m_buffer[i] == '"') return out;
+
+    // Escape sequence
+    const char c = m_buffer[i + 1];
+    i += 2;
+    switch (c)
+    {
+      // clang-format off
+      case '"':  out.push_back('"'); break;
+      case '\\': out.push_back('\\'); break;
+      case '/':  out.push_back('/'); break;
+      case 'b':  out.push_back('\b'); break;
+      case 'f':  out.push_back('\f'); break;
+      case 'n':  out.push_back('\n'); break;
+      case 'r':  out.push_back('\r'); break;
+      case 't':  out.push_back('\t'); break;
+      // clang-format on
+      case 'u':
+      {
+        auto read_hex4 = [this, &i, offset]()
+        {
+          uint32_t value = 0;
+          for (int k = 0; k < 4; ++k)
+          {
+            const int digit = hexValue(m_buffer[i + k]);
+            if (digit < 0)
+              parseError(offset, "Invalid \\u escape in string.");
+            value = value * 16 + digit;
+          }
+          i += 4;
+          return value;
+        };
+        uint32_t code_point = read_hex4();
+        // Surrogate pair
+        if (code_point >= 0xD800 and code_point <= 0xDBFF and
+            m_buffer.compare(i, 2, "\\u") == 0)
+        {
+          i += 2;
+          const uint32_t low = read_hex4();
+          if (low >= 0xDC00 and low <= 0xDFFF)
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                         (low - 0xDC00);
+          else
+          {
+            appendUTF8(out, code_point);
+            code_point = low;
+          }
+        }
+        appendUTF8(out, code_point);
+        break;
+      }
+      default:
+        parseError(offset, "Invalid escape sequence in string.");
+    }
+  }
+}
+
+// ###################################################################
+/**Returns the offset of the next structural character and advances. At
+ * the end of the index the offset of the padding is returned, which does not
+ * match any expected character.*/
+uint32_t JSONInput::nextStructural()
+{
+  if (m_next >= m_structurals.size()) return static_cast<uint32_t>(m_size);
+  return m_structurals[m_next++];
+}
+
+/**Returns the offset of the next structural character.*/
+uint32_t JSONInput::peekStructural() const
+{
+  if (m_next >= m_structurals.size()) return static_cast<uint32_t>(m_size);
+  return m_structurals[m_next];
+}
+
+// ###################################################################
+/**Converts a byte offset into "file line L:C".*/
+std::string JSONInput::markAt(const uint32_t offset) const
+{
+  return m_source->markAt(offset);
+}
+
+// ###################################################################
+/**Throws a parse error for the given offset.*/
+void JSONInput::parseError(const uint32_t offset, const std::string& message)
+{
+  throw std::runtime_error(markAt(offset) + ": " + message);
+}
+
+// ###################################################################
+/**A JSON input deck is an object or an array.*/
+bool JSONInput::canParseContent(const std::string_view head)
+{
+  const size_t start = head.find_first_not_of(" \t\r\n");
+  return start != std::string_view::npos and
+         (head[start] == '{' or head[start] == '[');
+}
+
+} // namespace elke
+
+elkeRegisterInputParser(elke::JSONInput, ".json");
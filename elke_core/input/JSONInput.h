@@ -0,0 +1,79 @@
+#ifndef ELK_E_JSONINPUT_H
+#define ELK_E_JSONINPUT_H
+
+#include "InputParser.h"
+#include "elke_core/data_types/DataTree.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace elke
+{
+class Logger;
+
+/**JSON input processor. Parsing is done in two stages, in the style of
+ * simdjson:
+ * 1. json::buildStructuralIndex locates every operator and scalar with SIMD
+ *    bitmask arithmetic over 64-byte blocks,
+ * 2. a recursive descent over the index builds the DataTree directly.
+ *
+ * Integers become INTEGER scalars, numbers with a fraction or exponent
+ * become FLOAT, strings are always STRING (like quoted YAML scalars) and
+ * `null` produces a NO_DATA tree. The "mark" tag holds the line and column
+ * of each value. Only the byte offset is stored with each value, see
+ * DataTree::setSourceMark, and the line and column are looked up in the
+ * document's line table when a mark is read.*/
+class JSONInput final : public InputParser
+{
+public:
+  explicit JSONInput(elke::Logger& logger);
+
+  /**Returns true if the start of a file looks like a JSON document. Used to
+   * identify input files without an extension.*/
+  static bool canParseContent(std::string_view head);
+
+  /**Parses a document held in memory. `source_name` is used for the root
+   * tree and the mark tags.*/
+  elke::DataTree parseInputContent(std::string_view json,
+                                   const std::string& source_name) override;
+
+  std::string version() const override { return "JSONInput 1"; }
+
+private:
+  /**Parses the value starting at the current structural index into
+   * `tree`.*/
+  void parseValue(elke::DataTree& tree, size_t depth);
+  void parseObject(elke::DataTree& tree, size_t depth);
+  void parseArray(elke::DataTree& tree, size_t depth);
+  void parseScalar(elke::DataTree& tree, uint32_t offset);
+
+  /**Decodes the string whose opening quote is at `offset`.*/
+  std::string decodeString(uint32_t offset);
+
+  /**Returns the offset of the next structural character and advances.*/
+  uint32_t nextStructural();
+  /**Returns the offset of the next structural character.*/
+  uint32_t peekStructural() const;
+
+  /**Converts a byte offset into "file line L:C".*/
+  std::string markAt(uint32_t offset) const;
+
+  /**Throws a parse error for the given offset.*/
+  [[noreturn]] void parseError(uint32_t offset, const std::string& message);
+
+  std::string m_current_file_name;
+
+  // Parse state, valid during a call to parseInputContent.
+  std::string m_buffer;                ///< The document, padded
+  size_t m_size = 0;                   ///< Unpadded size
+  std::vector<uint32_t> m_structurals; ///< Stage-1 index
+  size_t m_next = 0;                   ///< Next entry in m_structurals
+  /// Line table of the document, shared by the marks of its values
+  std::shared_ptr<const DataTreeSource> m_source;
+};
+
+} // namespace elke
+
+#endif // ELK_E_JSONINPUT_H
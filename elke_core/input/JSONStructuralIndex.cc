@@ -0,0 +1,221 @@
+#include "JSONStructuralIndex.h"
+
+#include <limits>
+
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+#include <immintrin.h>
+#endif
+
+namespace elke::json
+{
+
+namespace
+{
+/**Per-block character classes, one bit per byte.*/
+struct BlockMasks
+{
+  uint64_t m_quote = 0;
+  uint64_t m_backslash = 0;
+  uint64_t m_operator = 0;
+  uint64_t m_whitespace = 0;
+};
+
+/**State carried from one block to the next.*/
+struct ScannerState
+{
+  uint64_t m_next_is_escaped = 0;  ///< 1 if the next block's first byte is escaped
+  uint64_t m_prev_in_string = 0;   ///< All ones if the previous block ended in a string
+  uint64_t m_prev_is_scalar = 0;   ///< 1 if the previous block ended in a scalar
+};
+
+int trailingZeros(const uint64_t value)
+{
+#if defined(__GNUC__) or defined(__clang__)
+  return __builtin_ctzll(value);
+#else
+  int count = 0;
+  while (((value >> count) & 1) == 0)
+    ++count;
+  return count;
+#endif
+}
+
+/**Each bit becomes the XOR of itself and all lower bits, i.e., the bits
+ * between an odd and the next even quote are set.*/
+uint64_t prefixXOR(uint64_t bits)
+{
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+// ###################################################################
+BlockMasks classifyBlockScalar(const char* block)
+{
+  BlockMasks masks;
+  for (size_t i = 0; i < STRUCTURAL_BLOCK_SIZE; ++i)
+  {
+    const uint64_t bit = uint64_t{1} << i;
+    switch (block[i])
+    {
+      // clang-format off
+      case '"':  masks.m_quote |= bit; break;
+      case '\\': masks.m_backslash |= bit; break;
+      case '{': case '}': case '[': case ']': case ':': case ',':
+        masks.m_operator |= bit; break;
+      case ' ': case '\t': case '\n': case '\r':
+        masks.m_whitespace |= bit; break;
+      default: break;
+      // clang-format on
+    }
+  }
+  return masks;
+}
+
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+ELKE_TARGET_AVX2
+inline uint64_t equalMask(const __m256i lo, const __m256i hi, const char c)
+{
+  const __m256i vc = _mm256_set1_epi8(c);
+  const auto lo_bits = static_cast<uint32_t>(
+    _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, vc)));
+  const auto hi_bits = static_cast<uint32_t>(
+    _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, vc)));
+  return uint64_t{lo_bits} | (uint64_t{hi_bits} << 32);
+}
+
+ELKE_TARGET_AVX2
+BlockMasks classifyBlockAVX2(const char* block)
+{
+  const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+  const __m256i hi =
+    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+
+  BlockMasks masks;
+  masks.m_quote = equalMask(lo, hi, '"');
+  masks.m_backslash = equalMask(lo, hi, '\\');
+  masks.m_operator = equalMask(lo, hi, '{') | equalMask(lo, hi, '}') |
+                     equalMask(lo, hi, '[') | equalMask(lo, hi, ']') |
+                     equalMask(lo, hi, ':') | equalMask(lo, hi, ',');
+  masks.m_whitespace = equalMask(lo, hi, ' ') | equalMask(lo, hi, '\t') |
+                       equalMask(lo, hi, '\n') | equalMask(lo, hi, '\r');
+  return masks;
+}
+#endif
+
+// ###################################################################
+/**Turns the character classes of a block into structural bits.*/
+uint64_t structuralBits(const BlockMasks& masks, ScannerState& state)
+{
+  //=================================== Escaped characters
+  // Backslashes are rare, so the escapes are resolved sequentially. A
+  // backslash that is itself escaped does not escape the next character.
+  uint64_t escaped = state.m_next_is_escaped;
+  state.m_next_is_escaped = 0;
+  uint64_t backslash = masks.m_backslash;
+  while (backslash != 0)
+  {
+    const int i = trailingZeros(backslash);
+    backslash &= backslash - 1;
+    if ((escaped >> i) & 1) continue;
+    if (i == 63) state.m_next_is_escaped = 1;
+    else escaped |= uint64_t{1} << (i + 1);
+  }
+
+  //=================================== Strings
+  // in_string covers the opening quote up to, not including, the closing
+  // quote. string_tail covers the characters after the opening quote up to
+  // and including the closing quote.
+  const uint64_t quotes = masks.m_quote & ~escaped;
+  const uint64_t in_string = prefixXOR(quotes) ^ state.m_prev_in_string;
+  state.m_prev_in_string = (in_string >> 63) != 0 ? ~uint64_t{0} : 0;
+  const uint64_t string_tail = in_string ^ quotes;
+
+  //=================================== Scalars
+  // A scalar starts at any non-whitespace, non-operator character that does
+  // not follow another such character. Quotes are scalars but do not
+  // continue one, so that text after a closing quote is flagged.
+  const uint64_t scalar = ~(masks.m_operator | masks.m_whitespace);
+  const uint64_t nonquote_scalar = scalar & ~quotes;
+  const uint64_t follows_scalar =
+    (nonquote_scalar << 1) | state.m_prev_is_scalar;
+  state.m_prev_is_scalar = nonquote_scalar >> 63;
+  const uint64_t scalar_start = scalar & ~follows_scalar;
+
+  return (masks.m_operator | scalar_start) & ~string_tail;
+}
+} // namespace
+
+// ###################################################################
+bool buildStructuralIndex(const std::string_view padded_json,
+                          const size_t json_size,
+                          std::vector<uint32_t>& indices,
+                          std::string& error)
+{
+  return buildStructuralIndex(
+    padded_json, json_size, indices, error, math::activeSIMDInstructionSet());
+}
+
+// ###################################################################
+bool buildStructuralIndex(const std::string_view padded_json,
+                          const size_t json_size,
+                          std::vector<uint32_t>& indices,
+                          std::string& error,
+                          [[maybe_unused]] const math::SIMDInstructionSet
+                            instruction_set)
+{
+  indices.clear();
+  if (padded_json.size() % STRUCTURAL_BLOCK_SIZE != 0 or
+      padded_json.size() < json_size)
+  {
+    error = "The JSON buffer is not padded to a multiple of " +
+            std::to_string(STRUCTURAL_BLOCK_SIZE) + " bytes.";
+    return false;
+  }
+  if (json_size > std::numeric_limits<uint32_t>::max())
+  {
+    error = "JSON documents larger than 4 GiB are not supported.";
+    return false;
+  }
+
+  // Most documents have one structural character every few bytes.
+  indices.reserve(json_size / 4);
+
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  const bool use_avx2 =
+    instruction_set == math::SIMDInstructionSet::AVX2 and
+    math::detectSIMDInstructionSet() == math::SIMDInstructionSet::AVX2;
+#endif
+
+  ScannerState state;
+  for (size_t base = 0; base < padded_json.size();
+       base += STRUCTURAL_BLOCK_SIZE)
+  {
+    const char* block = padded_json.data() + base;
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+    const BlockMasks masks =
+      use_avx2 ? classifyBlockAVX2(block) : classifyBlockScalar(block);
+#else
+    const BlockMasks masks = classifyBlockScalar(block);
+#endif
+    uint64_t bits = structuralBits(masks, state);
+    while (bits != 0)
+    {
+      indices.push_back(static_cast<uint32_t>(base + trailingZeros(bits)));
+      bits &= bits - 1;
+    }
+  }
+
+  if (state.m_prev_in_string != 0)
+  {
+    error = "Unterminated string.";
+    return false;
+  }
+  return true;
+}
+
+} // namespace elke::json
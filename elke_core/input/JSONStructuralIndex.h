@@ -0,0 +1,53 @@
+#ifndef ELK_E_JSONSTRUCTURALINDEX_H
+#define ELK_E_JSONSTRUCTURALINDEX_H
+
+#include "elke_core/math/simd_dispatch.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace elke::json
+{
+
+/**The structural index is computed in blocks of this many bytes. Buffers
+ * handed to buildStructuralIndex must be padded with whitespace to a multiple
+ * of this size.*/
+constexpr size_t STRUCTURAL_BLOCK_SIZE = 64;
+
+/**Builds the structural index of a JSON document (stage 1 of a
+ * simdjson-style parser). The index lists, in increasing order, the byte
+ * offsets of
+ * - the operators `{ } [ ] : ,` outside of strings,
+ * - the opening quote of every string,
+ * - the first character of every other scalar (numbers, literals).
+ *
+ * Each 64-byte block is classified into bitmasks (quotes, backslashes,
+ * operators, whitespace) with AVX2 where available. Escaped quotes are
+ * removed and the inside-string mask is obtained with a prefix-XOR over the
+ * remaining quotes, carried across blocks, so that only the final bit
+ * extraction is proportional to the number of structural characters.
+ *
+ * \param padded_json The document followed by whitespace padding up to a
+ *                    multiple of STRUCTURAL_BLOCK_SIZE.
+ * \param json_size   The size of the document without padding.
+ * \param indices     Output offsets. Cleared first.
+ * \param error       Set if the document ends inside a string.
+ * \returns false on error.*/
+bool buildStructuralIndex(std::string_view padded_json,
+                          size_t json_size,
+                          std::vector<uint32_t>& indices,
+                          std::string& error);
+
+/**Same as above with an explicit instruction set, used to compare paths. An
+ * instruction set the CPU does not support falls back to the scalar path.*/
+bool buildStructuralIndex(std::string_view padded_json,
+                          size_t json_size,
+                          std::vector<uint32_t>& indices,
+                          std::string& error,
+                          math::SIMDInstructionSet instruction_set);
+
+} // namespace elke::json
+
+#endif // ELK_E_JSONSTRUCTURALINDEX_H
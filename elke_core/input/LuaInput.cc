@@ -0,0 +1,333 @@
+#include "LuaInput.h"
+
+#include "elke_core/output/Logger.h"
+#include "elke_core/registration/registration.h"
+
+#include <algorithm>
+#include <cctype>
+
+#ifdef LUA_EXISTS
+extern "C"
+{
+#include "lua.h"
+#include "lualib.h"
+#include "lauxlib.h"
+}
+#endif
+
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+
+namespace elke
+{
+
+#ifdef LUA_EXISTS
+namespace LuaInputHelpers
+{
+/**A table key, either from the array part or the hash part.*/
+struct TableKey
+{
+  bool m_is_integer = false;
+  lua_Integer m_integer = 0;
+  std::string m_string;
+
+  /**The name of the child tree for this key.*/
+  std::string name() const
+  {
+    return m_is_integer ? std::to_string(m_integer) : m_string;
+  }
+};
+
+// ###################################################################
+/**Collects the keys of the table at `index`. Returns false, with a message,
+ * if a key is neither a string nor an integer.*/
+bool collectTableKeys(lua_State* L,
+                      const int index,
+                      std::vector<TableKey>& keys,
+                      std::string& error)
+{
+  const int table_index = lua_absindex(L, index);
+  lua_pushnil(L);
+  while (lua_next(L, table_index) != 0)
+  {
+    // Key at -2, value at -1. lua_tolstring must not be called on a number
+    // key here since it would change the key and confuse lua_next.
+    TableKey key;
+    if (lua_type(L, -2) == LUA_TNUMBER and lua_isinteger(L, -2))
+    {
+      key.m_is_integer = true;
+      key.m_integer = lua_tointeger(L, -2);
+    }
+    else if (lua_type(L, -2) == LUA_TSTRING)
+    {
+      size_t length = 0;
+      const char* chars = lua_tolstring(L, -2, &length);
+      key.m_string.assign(chars, length);
+    }
+    else
+    {
+      error = std::string("Table keys must be strings or integers, found a ") +
+              luaL_typename(L, -2) + " key.";
+      lua_pop(L, 2);
+      return false;
+    }
+    keys.push_back(std::move(key));
+    lua_pop(L, 1);
+  }
+  return true;
+}
+
+// ###################################################################
+/**Determines if the keys are exactly the integers 1..n.*/
+bool keysFormASequence(const std::vector<TableKey>& keys)
+{
+  if (keys.empty()) return false;
+
+  std::vector<bool> present(keys.size(), false);
+  for (const auto& key : keys)
+  {
+    if (not key.m_is_integer or key.m_integer < 1 or
+        key.m_integer > static_cast<lua_Integer>(keys.size()))
+      return false;
+    present[key.m_integer - 1] = true;
+  }
+  return std::all_of(present.begin(), present.end(), [](bool p) { return p; });
+}
+} // namespace LuaInputHelpers
+
+// ###################################################################
+/**Converts the value at the top of the Lua stack into `tree`.*/
+void LuaInput::populateTree(lua_State* L, elke::DataTree& tree)
+{
+  tree.setTag("mark", m_current_file_name + " at " + tree.getTag("address"));
+
+  switch (lua_type(L, -1))
+  {
+    case LUA_TBOOLEAN:
+      tree.setGrossType(DataGrossType::SCALAR);
+      tree.setValue(ScalarValue(static_cast<bool>(lua_toboolean(L, -1))));
+      break;
+    case LUA_TNUMBER:
+      tree.setGrossType(DataGrossType::SCALAR);
+      if (lua_isinteger(L, -1))
+        tree.setValue(ScalarValue(static_cast<int64_t>(lua_tointeger(L, -1))));
+      else
+        tree.setValue(ScalarValue(static_cast<double>(lua_tonumber(L, -1))));
+      break;
+    case LUA_TSTRING:
+    {
+      size_t length = 0;
+      const char* chars = lua_tolstring(L, -1, &length);
+      tree.setGrossType(DataGrossType::SCALAR);
+      tree.setValue(ScalarValue(std::string(chars, length)));
+      break;
+    }
+    case LUA_TTABLE:
+      populateTreeFromTable(L, tree);
+      break;
+    default:
+      m_errors.emplace_back("Unsupported Lua value of type " +
+                            std::string(luaL_typename(L, -1)) + " at \"" +
+                            tree.getTag("address") + "\".");
+      tree.setGrossType(DataGrossType::NO_DATA);
+  }
+}
+
+// ###################################################################
+/**Converts the table at the top of the Lua stack into `tree`.*/
+void LuaInput::populateTreeFromTable(lua_State* L, elke::DataTree& tree)
+{
+  using namespace LuaInputHelpers;
+
+  const void* table_id = lua_topointer(L, -1);
+  if (std::find(m_open_tables.begin(), m_open_tables.end(), table_id) !=
+      m_open_tables.end())
+  {
+    m_errors.emplace_back("The Lua table at \"" + tree.getTag("address") +
+                          "\" contains itself.");
+    tree.setGrossType(DataGrossType::NO_DATA);
+    return;
+  }
+
+  // Every nesting level holds the table, a key and a value
+  if (not lua_checkstack(L, 3))
+  {
+    m_errors.emplace_back("Lua tables nested too deeply at \"" +
+                          tree.getTag("address") + "\".");
+    tree.setGrossType(DataGrossType::NO_DATA);
+    return;
+  }
+
+  std::vector<TableKey> keys;
+  std::string error;
+  if (not collectTableKeys(L, -1, keys, error))
+  {
+    m_errors.emplace_back(error + " At \"" + tree.getTag("address") + "\".");
+    tree.setGrossType(DataGrossType::NO_DATA);
+    return;
+  }
+
+  const bool is_sequence = keysFormASequence(keys);
+  if (is_sequence)
+  {
+    tree.setGrossType(DataGrossType::SEQUENCE);
+  }
+  else
+  {
+    tree.setGrossType(DataGrossType::MAP);
+    std::sort(keys.begin(),
+              keys.end(),
+              [](const TableKey& a, const TableKey& b)
+              {
+                if (a.m_is_integer != b.m_is_integer) return a.m_is_integer;
+                if (a.m_is_integer) return a.m_integer < b.m_integer;
+                return a.m_string < b.m_string;
+              });
+  }
+
+  // Lua keys are unique, but the integer key 1 and the string key "1" both
+  // name a child "1".
+  std::unordered_set<std::string_view> string_keys;
+  if (not is_sequence)
+    for (const auto& key : keys)
+      if (not key.m_is_integer) string_keys.insert(key.m_string);
+
+  m_open_tables.push_back(table_id);
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    const auto& key = keys[i];
+    if (key.m_is_integer and string_keys.count(key.name()) != 0)
+    {
+      m_errors.emplace_back("Cannot add child named \"" + key.name() +
+                            "\" to data-tree at \"" + tree.getTag("address") +
+                            "\"");
+      continue;
+    }
+    auto sub_node_ptr =
+      std::make_shared<DataTree>(is_sequence ? std::string() : key.name());
+
+    if (is_sequence)
+      lua_rawgeti(L, -1, static_cast<lua_Integer>(i + 1));
+    else if (key.m_is_integer)
+      lua_rawgeti(L, -1, key.m_integer);
+    else
+    {
+      lua_pushlstring(L, key.m_string.data(), key.m_string.size());
+      lua_rawget(L, -2);
+    }
+
+    try
+    {
+      // Duplicates were ruled out above, checking again here would make
+      // adding the children quadratic.
+      tree.addChild(sub_node_ptr, /*prevent_duplicate=*/false);
+      populateTree(L, *sub_node_ptr);
+    }
+    catch (const std::exception& e)
+    {
+      m_errors.emplace_back(e.what());
+    }
+    lua_pop(L, 1);
+  }
+  m_open_tables.pop_back();
+}
+#endif
+
+// ###################################################################
+LuaInput::LuaInput(Logger& logger) : InputParser(logger) {}
+
+// ###################################################################
+/**Runs the Lua script and converts the table it returns into a data
+ * tree.*/
+elke::DataTree LuaInput::parseInputContent(const std::string_view content,
+                                           const std::string& source_name)
+{
+  elke::DataTree data_tree("");
+
+  m_current_file_name = source_name;
+
+#ifdef LUA_EXISTS
+  m_logger.log() << "Reading Lua-file \"" << source_name << "\"\n";
+
+  const std::unique_ptr<lua_State, decltype(&lua_close)> state(luaL_newstate(),
+                                                               &lua_close);
+  lua_State* L = state.get();
+  if (L == nullptr)
+  {
+    m_errors.emplace_back("Failed to create a Lua state for \"" + source_name +
+                          "\".");
+    return data_tree;
+  }
+  luaL_openlibs(L);
+
+  // Like luaL_loadfile, skip a leading "#!" line but keep its newline so
+  // that line numbers in messages stay correct.
+  std::string_view chunk = content;
+  if (not chunk.empty() and chunk.front() == '#')
+    chunk.remove_prefix(std::min(chunk.find('\n'), chunk.size()));
+
+  const std::string chunk_name = "@" + source_name;
+  if (luaL_loadbuffer(L, chunk.data(), chunk.size(), chunk_name.c_str()) !=
+        LUA_OK or
+      lua_pcall(L, 0, 1, 0) != LUA_OK)
+  {
+    // The error object is not necessarily a string or a number, e.g.
+    // error({}), and luaL_tolstring could itself raise an error from a
+    // __tostring metamethod outside of a protected call.
+    const char* message = lua_tostring(L, -1);
+    if (message != nullptr)
+      m_errors.emplace_back(std::string(message) + "\n");
+    else
+      m_errors.emplace_back("The Lua input script \"" + source_name +
+                            "\" raised an error with a " +
+                            luaL_typename(L, -1) + " instead of a message.\n");
+    return data_tree;
+  }
+
+  if (not lua_istable(L, -1))
+  {
+    m_errors.emplace_back("The Lua input script \"" + source_name +
+                          "\" must return a table, it returned a " +
+                          luaL_typename(L, -1) + ".\n");
+    return data_tree;
+  }
+
+  DataTree root_tree(source_name);
+  try
+  {
+    this->populateTree(L, root_tree);
+  }
+  catch (const std::exception& e)
+  {
+    m_errors.emplace_back(e.what());
+  }
+  data_tree = root_tree;
+  m_logger.log() << "Done reading Lua-file \"" << source_name << "\"\n";
+#else
+  m_errors.emplace_back("Lua input file \"" + source_name +
+                        "\" cannot be read since elk-e was built without "
+                        "Lua.\n");
+#endif
+
+  return data_tree;
+}
+
+// ###################################################################
+/**A Lua input script has to return a table, so it starts, after comments,
+ * with either a `return` or a `local` definition.*/
+bool LuaInput::canParseContent(const std::string_view head)
+{
+  const auto text = skipWhitespaceAndComments(head, "--");
+  for (const std::string_view keyword : {"return", "local"})
+    if (text.substr(0, keyword.size()) == keyword and
+        (text.size() == keyword.size() or
+         std::isspace(static_cast<unsigned char>(text[keyword.size()])) or
+         text[keyword.size()] == '{'))
+      return true;
+  return false;
+}
+
+} // namespace elke
+
+elkeRegisterInputParser(elke::LuaInput, ".lua");
@@ -0,0 +1,63 @@
+#ifndef ELK_E_LUAINPUT_H
+#define ELK_E_LUAINPUT_H
+
+#include "InputParser.h"
+#include "elke_core/data_types/DataTree.h"
+
+#include <vector>
+
+struct lua_State;
+
+namespace elke
+{
+class Logger;
+
+/**Lua input processor. The input file is a Lua script that returns the
+ * input as a table, e.g.,
+ * \code
+ * local components = {}
+ * for i = 1, 1000 do
+ *   components["component_" .. i] = { type = "snglvol", area = 0.25 * i }
+ * end
+ * return { TestSyntaxBlock = { optionA = 12, components = components } }
+ * \endcode
+ * The returned table is converted directly into DataTree nodes, so that
+ * scripted decks do not have to be expanded into text first:
+ * - a table whose keys are exactly 1..n becomes a SEQUENCE,
+ * - any other table becomes a MAP with its keys in sorted order, since Lua
+ *   does not preserve the order in which keys were defined,
+ * - booleans, integers, floats and strings become SCALARs of the matching
+ *   type.*/
+class LuaInput final : public InputParser
+{
+public:
+  explicit LuaInput(elke::Logger& logger);
+
+  elke::DataTree parseInputContent(std::string_view content,
+                                   const std::string& source_name) override;
+
+  /**Scripts can read other files or the environment, so their trees are
+   * never cached.*/
+  std::string version() const override { return ""; }
+
+  /**Returns true if the start of a file looks like a Lua script. Used to
+   * identify input files without an extension.*/
+  static bool canParseContent(std::string_view head);
+
+private:
+#ifdef LUA_EXISTS
+  /**Converts the value at the top of the Lua stack into `tree`.*/
+  void populateTree(lua_State* L, elke::DataTree& tree);
+  /**Converts the table at the top of the Lua stack into `tree`.*/
+  void populateTreeFromTable(lua_State* L, elke::DataTree& tree);
+
+  /**Tables currently being converted, used to detect cycles.*/
+  std::vector<const void*> m_open_tables;
+#endif
+
+  std::string m_current_file_name;
+};
+
+} // namespace elke
+
+#endif // ELK_E_LUAINPUT_H
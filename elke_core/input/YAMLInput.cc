@@ -1,8 +1,18 @@
 #include "YAMLInput.h"
 
 #include "elke_core/output/Logger.h"
+#include "elke_core/registration/registration.h"
+
+#include <algorithm>
+#include <cctype>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <unordered_set>
+#include <vector>
 
 #ifdef YAML_CPP_EXISTS
+#include "yaml-cpp/eventhandler.h"
 #include "yaml-cpp/yaml.h"
 #endif
 
@@ -12,6 +22,242 @@ namespace elke
 #ifdef YAML_CPP_EXISTS
 namespace YAMLInputHelpers
 {
+// ###################################################################
+/**Read-only stream buffer over memory, so that yaml-cpp can parse a mapped
+ * file without copying it into a string first.*/
+class MemoryStreamBuffer final : public std::streambuf
+{
+public:
+  explicit MemoryStreamBuffer(const std::string_view content)
+  {
+    // The get area is never written through.
+    char* begin = const_cast<char*>(content.data());
+    setg(begin, begin, begin + content.size());
+  }
+};
+
+// ###################################################################
+/**A top-level block of a YAML document, i.e., a `key:` line at column 0
+ * and all following lines up to the next such line.*/
+struct TopLevelBlock
+{
+  std::string m_key;
+  size_t m_begin = 0; ///< Offset of the key line
+  size_t m_end = 0;   ///< Offset one past the block's last line
+  size_t m_line = 0;  ///< 0-based line of the key
+  /// MAP or SEQUENCE if the block can be deferred, NO_DATA otherwise.
+  DataGrossType m_lazy_type = DataGrossType::NO_DATA;
+  size_t m_value_line = 0;   ///< 0-based line of the deferred value
+  size_t m_value_column = 0; ///< 0-based column of the deferred value
+};
+
+/**Determines whether a line is a plain `key:` line. On success `key` is
+ * set and `has_value` tells whether a value follows on the same line.*/
+bool isPlainKeyLine(const std::string_view line,
+                    std::string& key,
+                    bool& has_value)
+{
+  size_t i = 0;
+  while (i < line.size() and
+         (std::isalnum(static_cast<unsigned char>(line[i])) or
+          line[i] == '_' or line[i] == '-' or line[i] == '.'))
+    ++i;
+  if (i == 0 or i >= line.size() or line[i] != ':') return false;
+  if (i + 1 < line.size() and line[i + 1] != ' ') return false;
+
+  key.assign(line.substr(0, i));
+  const size_t value_start = line.find_first_not_of(' ', i + 1);
+  has_value = value_start != std::string_view::npos and
+              line[value_start] != '#';
+  return true;
+}
+
+/**Tells whether an indented line starts a sequence entry.*/
+bool isSequenceEntry(const std::string_view text)
+{
+  return text.front() == '-' and (text.size() == 1 or text[1] == ' ');
+}
+
+// ###################################################################
+/**Splits a document into its top-level blocks with a single line scan.
+ * Returns false if the document cannot be split safely, in which case it
+ * must be parsed as a whole.*/
+bool splitTopLevelBlocks(const std::string_view content,
+                         std::vector<TopLevelBlock>& blocks)
+{
+  // Anchors can tie blocks together.
+  if (content.find('&') != std::string_view::npos) return false;
+
+  blocks.clear();
+  bool awaiting_value = false;
+  std::string key;
+  bool has_value = false;
+
+  size_t line_number = 0;
+  for (size_t pos = 0; pos < content.size(); ++line_number)
+  {
+    const size_t eol = std::min(content.find('\n', pos), content.size());
+    std::string_view line = content.substr(pos, eol - pos);
+    if (not line.empty() and line.back() == '\r') line.remove_suffix(1);
+
+    const size_t indent = line.find_first_not_of(' ');
+    const bool is_content =
+      indent != std::string_view::npos and line[indent] != '#';
+
+    if (is_content and line[indent] == '\t') return false;
+
+    if (is_content and indent == 0 and not isSequenceEntry(line))
+    {
+      if (not isPlainKeyLine(line, key, has_value)) return false;
+      if (not blocks.empty()) blocks.back().m_end = pos;
+
+      TopLevelBlock block;
+      block.m_key = key;
+      block.m_begin = pos;
+      block.m_line = line_number;
+      blocks.push_back(std::move(block));
+      awaiting_value = not has_value;
+    }
+    else if (is_content)
+    {
+      if (blocks.empty()) return false;
+      if (awaiting_value)
+      {
+        auto& block = blocks.back();
+        const auto text = line.substr(indent);
+        bool unused = false;
+        if (isSequenceEntry(text))
+          block.m_lazy_type = DataGrossType::SEQUENCE;
+        else if (indent > 0 and isPlainKeyLine(text, key, unused))
+          block.m_lazy_type = DataGrossType::MAP;
+        block.m_value_line = line_number;
+        block.m_value_column = indent;
+        awaiting_value = false;
+      }
+    }
+
+    pos = eol + 1;
+  }
+  if (not blocks.empty()) blocks.back().m_end = content.size();
+
+  return not blocks.empty();
+}
+
+// ###################################################################
+/**Checks the text of a deferred block without building it: yaml-cpp's
+ * event parser finds the syntax errors, and the keys of each map are
+ * compared to find the duplicates that DataTree::addChild would reject.
+ * Errors are worded like those of eager parsing.*/
+class DeferredBlockScanner final : public YAML::EventHandler
+{
+  /**An open map or sequence.*/
+  struct Frame
+  {
+    bool m_is_map = false;
+    bool m_expecting_key = true;
+    std::unordered_set<std::string> m_keys;
+    /// Key, or entry number, of the node being read, for the address.
+    std::string m_current;
+    size_t m_num_entries = 0;
+  };
+
+  const std::string& m_source_name;
+  std::vector<std::string>& m_errors;
+  std::vector<Frame> m_frames;
+
+public:
+  DeferredBlockScanner(const std::string& source_name,
+                       std::vector<std::string>& errors)
+    : m_source_name(source_name), m_errors(errors)
+  {
+  }
+
+  /**Scans `block_text`, which starts at the 0-based line `first_line` of
+   * the source.*/
+  void scan(const std::string_view block_text, const size_t first_line)
+  {
+    MemoryStreamBuffer buffer(block_text);
+    std::istream stream(&buffer);
+    m_frames.clear();
+    try
+    {
+      YAML::Parser parser(stream);
+      while (parser.HandleNextDocument(*this)) {}
+    }
+    catch (const YAML::Exception& e)
+    {
+      m_errors.push_back(m_source_name + " line " +
+                         std::to_string(e.mark.line + 1 + first_line) + ":" +
+                         std::to_string(e.mark.column + 1) + ": " + e.msg);
+    }
+  }
+
+  void OnDocumentStart(const YAML::Mark&) override {}
+  void OnDocumentEnd() override {}
+  void OnNull(const YAML::Mark&, YAML::anchor_t) override { onNode(nullptr); }
+  void OnAlias(const YAML::Mark&, YAML::anchor_t) override { onNode(nullptr); }
+  void OnScalar(const YAML::Mark&,
+                const std::string&,
+                YAML::anchor_t,
+                const std::string& value) override
+  {
+    onNode(&value);
+  }
+  void OnSequenceStart(const YAML::Mark&,
+                       const std::string&,
+                       YAML::anchor_t,
+                       YAML::EmitterStyle::value) override
+  {
+    onNode(nullptr);
+    m_frames.emplace_back();
+  }
+  void OnSequenceEnd() override { m_frames.pop_back(); }
+  void OnMapStart(const YAML::Mark&,
+                  const std::string&,
+                  YAML::anchor_t,
+                  YAML::EmitterStyle::value) override
+  {
+    onNode(nullptr);
+    m_frames.emplace_back().m_is_map = true;
+  }
+  void OnMapEnd() override { m_frames.pop_back(); }
+
+private:
+  /**Called at the start of every node, with the value of scalars.*/
+  void onNode(const std::string* scalar)
+  {
+    if (m_frames.empty()) return;
+    auto& frame = m_frames.back();
+    if (not frame.m_is_map)
+    {
+      frame.m_current = std::to_string(frame.m_num_entries++);
+      return;
+    }
+
+    if (not frame.m_expecting_key) // A value
+    {
+      frame.m_expecting_key = true;
+      return;
+    }
+
+    frame.m_expecting_key = false;
+    frame.m_current = scalar != nullptr ? *scalar : std::string();
+    if (scalar != nullptr and not frame.m_keys.insert(*scalar).second)
+      m_errors.push_back("Cannot add child named \"" + *scalar +
+                         "\" to data-tree at \"" + address() + "\"");
+  }
+
+  /**Returns the address of the innermost open map or sequence. The
+   * outermost frame is the block's `key: value` map.*/
+  std::string address() const
+  {
+    std::string address = m_source_name;
+    for (size_t f = 0; f + 1 < m_frames.size(); ++f)
+      address += "/" + m_frames[f].m_current;
+    return address;
+  }
+};
+
 // ###################################################################
 /**Called when YAML.type() == Scalar.*/
 void populateValue(elke::DataTree& parent_tree,
@@ -102,8 +348,9 @@ void YAMLInput::populateTree(elke::DataTree& tree,
   const auto mark = node.Mark();
 
   tree.setTag("mark",
-              m_current_file_name + " line " + std::to_string(mark.line + 1) +
-                ":" + std::to_string(mark.column + 1));
+              m_current_file_name + " line " +
+                std::to_string(mark.line + 1 + m_line_offset) + ":" +
+                std::to_string(mark.column + 1));
 
   switch (node.Type())
   {
@@ -152,6 +399,21 @@ void YAMLInput::populateTree(elke::DataTree& tree,
       throw std::logic_error("YAML node is not defined");
   }
 }
+
+// ###################################################################
+/**Parses the text of a single top-level block into the tree for its key.*/
+void YAMLInput::populateFromBlockText(elke::DataTree& tree,
+                                      const std::string_view block_text,
+                                      const size_t first_line)
+{
+  YAMLInputHelpers::MemoryStreamBuffer buffer(block_text);
+  std::istream stream(&buffer);
+  const YAML::Node block = YAML::Load(stream);
+
+  m_line_offset = first_line;
+  this->populateTree(tree, block.begin()->second, m_logger, 2, m_test_mode);
+  m_line_offset = 0;
+}
 #endif
 
 // ###################################################################
@@ -162,17 +424,89 @@ YAMLInput::YAMLInput(Logger& logger, const bool test_mode /*=false*/)
 
 // ###################################################################
 /**Parses input files into data trees using a file-appropriate parser.*/
-elke::DataTree YAMLInput::parseInputFile(const std::string file_name)
+elke::DataTree YAMLInput::parseInputContent(const std::string_view content,
+                                            const std::string& source_name)
 {
   elke::DataTree data_tree("");
 
-  m_current_file_name = file_name;
+  m_current_file_name = source_name;
 
 #ifdef YAML_CPP_EXISTS
-  m_logger.log() << "Reading YAML-file \"" << file_name << "\"\n";
-  const YAML::Node root = YAML::LoadFile(file_name);
+  m_logger.log() << "Reading YAML-file \"" << source_name << "\"\n";
 
-  DataTree root_tree(file_name);
+  std::vector<YAMLInputHelpers::TopLevelBlock> blocks;
+  if (m_lazy_parsing and YAMLInputHelpers::splitTopLevelBlocks(content, blocks))
+  {
+    DataTree root_tree(source_name);
+    root_tree.setGrossType(DataGrossType::MAP);
+    root_tree.setTag("mark",
+                     source_name + " line " +
+                       std::to_string(blocks.front().m_line + 1) + ":1");
+
+    YAMLInputHelpers::DeferredBlockScanner scanner(source_name, m_errors);
+    size_t num_deferred = 0;
+    for (const auto& block : blocks)
+    {
+      auto child_ptr = std::make_shared<DataTree>(block.m_key);
+      const auto block_text =
+        content.substr(block.m_begin, block.m_end - block.m_begin);
+      try
+      {
+        root_tree.addChild(child_ptr, /*prevent_duplicate=*/true);
+
+        if (block.m_lazy_type == DataGrossType::NO_DATA)
+        {
+          this->populateFromBlockText(*child_ptr, block_text, block.m_line);
+          continue;
+        }
+
+        child_ptr->setGrossType(block.m_lazy_type);
+        child_ptr->setTag("mark",
+                          source_name + " line " +
+                            std::to_string(block.m_value_line + 1) + ":" +
+                            std::to_string(block.m_value_column + 1));
+
+        scanner.scan(block_text, block.m_line);
+
+        // The content may be a mapped file, so the block text is copied.
+        child_ptr->setMaterializer(
+          [&logger = m_logger,
+           test_mode = m_test_mode,
+           file_name = source_name,
+           text = std::string(block_text),
+           line = block.m_line](DataTree& tree)
+          {
+            YAMLInput parser(logger, test_mode);
+            parser.m_current_file_name = file_name;
+            parser.populateFromBlockText(tree, text, line);
+
+            if (not parser.m_errors.empty())
+            {
+              std::string message;
+              for (const auto& error : parser.m_errors)
+                message += error + "\n";
+              throw std::logic_error(message);
+            }
+          });
+        ++num_deferred;
+      }
+      catch (const std::exception& e)
+      {
+        m_errors.emplace_back(e.what());
+      }
+    }
+
+    m_logger.log() << "Done reading YAML-file \"" << source_name << "\" ("
+                   << num_deferred << " of " << blocks.size()
+                   << " blocks deferred)\n";
+    return root_tree;
+  }
+
+  YAMLInputHelpers::MemoryStreamBuffer buffer(content);
+  std::istream stream(&buffer);
+  const YAML::Node root = YAML::Load(stream);
+
+  DataTree root_tree(source_name);
   try
   {
     this->populateTree(root_tree, root, m_logger, 0, m_test_mode);
@@ -182,10 +516,32 @@ elke::DataTree YAMLInput::parseInputFile(const std::string file_name)
     m_errors.emplace_back(e.what());
   }
   data_tree = root_tree;
-  m_logger.log() << "Done reading YAML-file \"" << file_name << "\"\n";
+  m_logger.log() << "Done reading YAML-file \"" << source_name << "\"\n";
 #endif
 
   return data_tree;
 }
 
+// ###################################################################
+/**A YAML input deck starts with a document marker, a directive, a
+ * sequence entry or a `key:` pair.*/
+bool YAMLInput::canParseContent(const std::string_view head)
+{
+  const auto text = skipWhitespaceAndComments(head, "#");
+  if (text.empty()) return false;
+  if (text.substr(0, 3) == "---" or text.front() == '%') return true;
+  if (text.substr(0, 2) == "- ") return true;
+
+  const size_t line_end = std::min(text.find('\n'), text.size());
+  const size_t colon = text.substr(0, line_end).find(':');
+  if (colon == std::string_view::npos or colon == 0) return false;
+  for (const char c : text.substr(0, colon))
+    if (not(std::isalnum(static_cast<unsigned char>(c)) or c == '_' or
+            c == '-' or c == '.' or c == ' ' or c == '"' or c == '\''))
+      return false;
+  return true;
+}
+
 } // namespace elke
+
+elkeRegisterInputParser(elke::YAMLInput, ".yaml", ".yml");
@@ -11,7 +11,18 @@ namespace YAML
 namespace elke
 {
 class Logger;
-/**YAML input processor.*/
+/**YAML input processor.
+ *
+ * With lazy parsing on, the document is first split into its top-level
+ * blocks with a line scan. Blocks whose value is an indented MAP or
+ * SEQUENCE become placeholder trees that are parsed when first accessed;
+ * all other blocks are parsed immediately. Documents that the scan cannot
+ * split safely (anchors, document markers, flow-style roots, etc.) are
+ * parsed eagerly as a whole.
+ *
+ * The text of each deferred block is still run through yaml-cpp's event
+ * parser, without building nodes, so that syntax errors and duplicate keys
+ * are reported when reading the file, as in eager mode.*/
 class YAMLInput final : public InputParser
 {
   /**Flag to print extra input*/
@@ -19,10 +30,24 @@ class YAMLInput final : public InputParser
 public:
   explicit YAMLInput(elke::Logger& logger, bool test_mode = false);
 
-  elke::DataTree parseInputFile(std::string file_name) override;
+  elke::DataTree parseInputContent(std::string_view content,
+                                   const std::string& source_name) override;
+
+  std::string version() const override { return "YAMLInput 1"; }
+
+  /**Returns true if the start of a file looks like a YAML document. Used to
+   * identify input files without an extension.*/
+  static bool canParseContent(std::string_view head);
 
 private:
 #ifdef YAML_CPP_EXISTS
+  /**Parses the text of a single top-level block, `key: value`, into `tree`,
+   * which is the tree for the key. `first_line` is the 0-based line of the
+   * block in the file.*/
+  void populateFromBlockText(elke::DataTree& tree,
+                             std::string_view block_text,
+                             size_t first_line);
+
   void populateTree(elke::DataTree& tree,
                   const YAML::Node& node,
                   Logger& logger,
@@ -31,6 +56,8 @@ private:
 #endif
 
   std::string m_current_file_name;
+  /**Added to the line numbers of marks when parsing part of a file.*/
+  size_t m_line_offset = 0;
 };
 
 } // namespace elke
@@ -0,0 +1,56 @@
+#ifndef ELK_MATH_ALIGNEDALLOCATOR_H
+#define ELK_MATH_ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+namespace elke::math
+{
+
+/**Minimal standard-conforming allocator that aligns every allocation to
+ * `Alignment` bytes. Used for structure-of-arrays storage so that SIMD
+ * kernels can rely on aligned rows.*/
+template <typename T, size_t Alignment = 64>
+class AlignedAllocator
+{
+public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind
+  {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  explicit AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+  {
+  }
+
+  T* allocate(const size_t n)
+  {
+    return static_cast<T*>(
+      ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T* ptr, size_t) noexcept
+  {
+    ::operator delete(ptr, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+  {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept
+  {
+    return false;
+  }
+};
+
+} // namespace elke::math
+
+#endif // ELK_MATH_ALIGNEDALLOCATOR_H
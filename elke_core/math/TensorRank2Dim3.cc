@@ -0,0 +1,104 @@
+#include "TensorRank2Dim3.h"
+
+#include <cmath>
+
+namespace elke::math
+{
+
+// ###################################################################
+/**Outer product. \f$ W_{ij} = x_i y_j \f$*/
+TensorRank2Dim3 Vec3::OTimes(const Vec3& that) const
+{
+  return {that * this->x, that * this->y, that * this->z};
+}
+
+// ###################################################################
+/**Vector-tensor product. \f$ w_j = x_i T_{ij} \f$*/
+Vec3 Vec3::Dot(const TensorRank2Dim3& that) const
+{
+  return Vec3(this->x * that.t[0].x + this->y * that.t[1].x +
+                this->z * that.t[2].x,
+              this->x * that.t[0].y + this->y * that.t[1].y +
+                this->z * that.t[2].y,
+              this->x * that.t[0].z + this->y * that.t[1].z +
+                this->z * that.t[2].z);
+}
+
+// ###################################################################
+void SymmetricEigenDecomposition(const TensorRank2Dim3& tensor,
+                                 Vec3& eigenvalues,
+                                 TensorRank2Dim3& eigenvectors)
+{
+  //============================================= Symmetrize working copy
+  double a[3][3];
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = i; j < 3; ++j)
+      a[i][j] = a[j][i] = tensor(i, j);
+
+  double v[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+
+  //============================================= Cyclic Jacobi sweeps
+  // Each rotation annihilates one off-diagonal entry. Convergence is
+  // quadratic, a handful of sweeps reach machine precision.
+  const size_t max_sweeps = 50;
+  for (size_t sweep = 0; sweep < max_sweeps; ++sweep)
+  {
+    const double off_diagonal =
+      std::fabs(a[0][1]) + std::fabs(a[0][2]) + std::fabs(a[1][2]);
+    const double diagonal =
+      std::fabs(a[0][0]) + std::fabs(a[1][1]) + std::fabs(a[2][2]);
+    if (off_diagonal == 0.0 or off_diagonal <= 1.0e-15 * diagonal) break;
+
+    for (size_t p = 0; p < 2; ++p)
+      for (size_t q = p + 1; q < 3; ++q)
+      {
+        if (a[p][q] == 0.0) continue;
+
+        // Rotation angle from the (p,q)-subproblem, computed in the stable
+        // form of Numerical Recipes (jacobi).
+        const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+        const double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                         (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+        const double c = 1.0 / std::sqrt(t * t + 1.0);
+        const double s = t * c;
+
+        for (size_t k = 0; k < 3; ++k)
+        {
+          const double akp = a[k][p];
+          const double akq = a[k][q];
+          a[k][p] = c * akp - s * akq;
+          a[k][q] = s * akp + c * akq;
+        }
+        for (size_t k = 0; k < 3; ++k)
+        {
+          const double apk = a[p][k];
+          const double aqk = a[q][k];
+          a[p][k] = c * apk - s * aqk;
+          a[q][k] = s * apk + c * aqk;
+        }
+        for (size_t k = 0; k < 3; ++k)
+        {
+          const double vkp = v[k][p];
+          const double vkq = v[k][q];
+          v[k][p] = c * vkp - s * vkq;
+          v[k][q] = s * vkp + c * vkq;
+        }
+      }
+  }
+
+  //============================================= Sort ascending
+  size_t order[3] = {0, 1, 2};
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = i + 1; j < 3; ++j)
+      if (a[order[j]][order[j]] < a[order[i]][order[i]])
+        std::swap(order[i], order[j]);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    eigenvalues(i) = a[order[i]][order[i]];
+    for (size_t k = 0; k < 3; ++k)
+      eigenvectors(k, i) = v[k][order[i]];
+  }
+}
+
+} // namespace elke::math
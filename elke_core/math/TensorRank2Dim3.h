@@ -0,0 +1,190 @@
+#ifndef ELK_MATH_TENSORRANK2DIM3_H
+#define ELK_MATH_TENSORRANK2DIM3_H
+
+#include "Vec3.h"
+
+#include <string>
+#include <type_traits>
+
+namespace elke::math
+{
+
+//=============================================== Rank-2 tensor in 3D
+/**General 3x3 tensor stored as three row vectors, \f$ T_{ij} = t[i][j] \f$.
+ * Like Vec3 it is constexpr-constructible and trivially copyable.
+ *
+ * The operations fix a specific floating-point evaluation order which the
+ * batch kernels in TensorRank2Dim3Array.h reproduce, exactly unless the
+ * compiler contracts it into FMA.*/
+struct TensorRank2Dim3
+{
+  Vec3 t[3]; ///< Rows
+
+  /**Default constructor. Initialized as all zeros.*/
+  constexpr TensorRank2Dim3() = default;
+
+  /**Constructor from three rows.*/
+  constexpr TensorRank2Dim3(const Vec3& row0, const Vec3& row1, const Vec3& row2)
+    : t{row0, row1, row2}
+  {
+  }
+
+  /**Constructor from the nine entries in row-major order.*/
+  constexpr TensorRank2Dim3(double t00, double t01, double t02,
+                            double t10, double t11, double t12,
+                            double t20, double t21, double t22)
+    : t{Vec3(t00, t01, t02), Vec3(t10, t11, t12), Vec3(t20, t21, t22)}
+  {
+  }
+
+  /**Returns the identity tensor.*/
+  static constexpr TensorRank2Dim3 Identity()
+  {
+    return {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+  }
+
+  /**Returns a diagonal tensor.*/
+  static constexpr TensorRank2Dim3 Diagonal(const Vec3& diagonal)
+  {
+    return {diagonal.x, 0.0, 0.0, 0.0, diagonal.y, 0.0, 0.0, 0.0, diagonal.z};
+  }
+
+  //============================================= Element access
+  /**Returns a copy of the entry \f$ T_{ij} \f$.*/
+  constexpr double operator()(const size_t i, const size_t j) const
+  {
+    return t[i][j];
+  }
+
+  /**Returns a reference to the entry \f$ T_{ij} \f$.*/
+  constexpr double& operator()(const size_t i, const size_t j)
+  {
+    return t[i](j);
+  }
+
+  //============================================= Arithmetic
+  /**Component-wise addition. \f$ W_{ij} = T_{ij} + S_{ij} \f$*/
+  constexpr TensorRank2Dim3 operator+(const TensorRank2Dim3& that) const
+  {
+    return {t[0] + that.t[0], t[1] + that.t[1], t[2] + that.t[2]};
+  }
+
+  /**Component-wise subtraction. \f$ W_{ij} = T_{ij} - S_{ij} \f$*/
+  constexpr TensorRank2Dim3 operator-(const TensorRank2Dim3& that) const
+  {
+    return {t[0] - that.t[0], t[1] - that.t[1], t[2] - that.t[2]};
+  }
+
+  /**Multiplication by scalar. \f$ W_{ij} = T_{ij} \alpha \f$*/
+  constexpr TensorRank2Dim3 operator*(const double value) const
+  {
+    return {t[0] * value, t[1] * value, t[2] * value};
+  }
+
+  /**Division by scalar. \f$ W_{ij} = T_{ij} / \alpha \f$*/
+  constexpr TensorRank2Dim3 operator/(const double value) const
+  {
+    return {t[0] / value, t[1] / value, t[2] / value};
+  }
+
+  //============================================= Products
+  /**Tensor-vector product. \f$ w_i = T_{ij} v_j \f$*/
+  constexpr Vec3 Dot(const Vec3& v) const
+  {
+    return Vec3(t[0].x * v.x + t[0].y * v.y + t[0].z * v.z,
+                t[1].x * v.x + t[1].y * v.y + t[1].z * v.z,
+                t[2].x * v.x + t[2].y * v.y + t[2].z * v.z);
+  }
+
+  /**Tensor-tensor product. \f$ W_{ij} = T_{ik} S_{kj} \f$*/
+  constexpr TensorRank2Dim3 Dot(const TensorRank2Dim3& that) const
+  {
+    TensorRank2Dim3 newTensor;
+    for (size_t i = 0; i < 3; ++i)
+      for (size_t j = 0; j < 3; ++j)
+        newTensor(i, j) = t[i][0] * that.t[0][j] + t[i][1] * that.t[1][j] +
+                          t[i][2] * that.t[2][j];
+
+    return newTensor;
+  }
+
+  /**Returns the transpose. \f$ W_{ij} = T_{ji} \f$*/
+  constexpr TensorRank2Dim3 Transpose() const
+  {
+    return {t[0].x, t[1].x, t[2].x,
+            t[0].y, t[1].y, t[2].y,
+            t[0].z, t[1].z, t[2].z};
+  }
+
+  /**Returns the trace. \f$ T_{ii} \f$*/
+  constexpr double Trace() const { return t[0].x + t[1].y + t[2].z; }
+
+  /**Returns the diagonal as a vector.*/
+  constexpr Vec3 DiagonalVec() const { return Vec3(t[0].x, t[1].y, t[2].z); }
+
+  /**Returns the matrix of cofactors, \f$ C_{ij} = (-1)^{i+j} M_{ij} \f$.*/
+  constexpr TensorRank2Dim3 Cofactors() const
+  {
+    const auto& a = t;
+    return {a[1].y * a[2].z - a[1].z * a[2].y,
+            a[1].z * a[2].x - a[1].x * a[2].z,
+            a[1].x * a[2].y - a[1].y * a[2].x,
+            a[0].z * a[2].y - a[0].y * a[2].z,
+            a[0].x * a[2].z - a[0].z * a[2].x,
+            a[0].y * a[2].x - a[0].x * a[2].y,
+            a[0].y * a[1].z - a[0].z * a[1].y,
+            a[0].z * a[1].x - a[0].x * a[1].z,
+            a[0].x * a[1].y - a[0].y * a[1].x};
+  }
+
+  /**Returns the determinant, expanded along the first row.*/
+  constexpr double Determinant() const
+  {
+    const TensorRank2Dim3 c = Cofactors();
+    return t[0].x * c.t[0].x + t[0].y * c.t[0].y + t[0].z * c.t[0].z;
+  }
+
+  /**Returns the inverse, computed as the adjugate divided by the
+   * determinant. Like Vec3::Inverse there is no check for singularity; the
+   * entries of the inverse of a singular tensor are non-finite.*/
+  constexpr TensorRank2Dim3 Inverse() const
+  {
+    const TensorRank2Dim3 c = Cofactors();
+    const double det =
+      t[0].x * c.t[0].x + t[0].y * c.t[0].y + t[0].z * c.t[0].z;
+    return c.Transpose() / det;
+  }
+
+  /**Solves \f$ T \vec{x} = \vec{b} \f$ by multiplying with the inverse.*/
+  constexpr Vec3 Solve(const Vec3& b) const { return Inverse().Dot(b); }
+
+  /**Prints the tensor to a string and then returns the string.*/
+  std::string toString() const
+  {
+    return "[" + t[0].toString() + " " + t[1].toString() + " " +
+           t[2].toString() + "]";
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<TensorRank2Dim3>,
+              "TensorRank2Dim3 must remain trivially copyable.");
+
+/**Left multiplication by scalar. \f$ W_{ij} = \alpha T_{ij} \f$*/
+constexpr TensorRank2Dim3 operator*(const double value,
+                                    const TensorRank2Dim3& that)
+{
+  return that * value;
+}
+
+/**Eigen-decomposition of a symmetric tensor using cyclic Jacobi rotations.
+ * On return the eigenvalues are sorted in ascending order and the i-th
+ * column of `eigenvectors` is the unit eigenvector of the i-th eigenvalue,
+ * i.e., \f$ T = V \Lambda V^T \f$. Only the upper triangle of `tensor` is
+ * read.*/
+void SymmetricEigenDecomposition(const TensorRank2Dim3& tensor,
+                                 Vec3& eigenvalues,
+                                 TensorRank2Dim3& eigenvectors);
+
+} // namespace elke::math
+
+#endif // ELK_MATH_TENSORRANK2DIM3_H
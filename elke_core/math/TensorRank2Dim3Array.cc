@@ -0,0 +1,348 @@
+#include "TensorRank2Dim3Array.h"
+#include "simd_kernel_utils.h"
+
+#include "elke_core/output/elk_exceptions.h"
+
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+#include <immintrin.h>
+#endif
+
+namespace elke::math
+{
+
+// ###################################################################
+/**Array of `size` zero tensors.*/
+TensorRank2Dim3Array::TensorRank2Dim3Array(const size_t size)
+{
+  resize(size);
+}
+
+// ###################################################################
+/**Array of `size` copies of `value`.*/
+TensorRank2Dim3Array::TensorRank2Dim3Array(const size_t size,
+                                           const TensorRank2Dim3& value)
+{
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      m_entries[3 * i + j].assign(size, value(i, j));
+}
+
+// ###################################################################
+/**Array built from an array-of-structures.*/
+TensorRank2Dim3Array::TensorRank2Dim3Array(
+  const std::vector<TensorRank2Dim3>& tensors)
+{
+  for (auto& row : m_entries)
+    row.reserve(tensors.size());
+  for (const auto& tensor : tensors)
+    push_back(tensor);
+}
+
+// ###################################################################
+void TensorRank2Dim3Array::resize(const size_t size)
+{
+  for (auto& row : m_entries)
+    row.resize(size, 0.0);
+}
+
+// ###################################################################
+void TensorRank2Dim3Array::push_back(const TensorRank2Dim3& value)
+{
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      m_entries[3 * i + j].push_back(value(i, j));
+}
+
+// ###################################################################
+TensorRank2Dim3 TensorRank2Dim3Array::get(const size_t n) const
+{
+  TensorRank2Dim3 tensor;
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      tensor(i, j) = m_entries[3 * i + j][n];
+
+  return tensor;
+}
+
+// ###################################################################
+void TensorRank2Dim3Array::set(const size_t n, const TensorRank2Dim3& value)
+{
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      m_entries[3 * i + j][n] = value(i, j);
+}
+
+// ###################################################################
+std::vector<TensorRank2Dim3> TensorRank2Dim3Array::toTensors() const
+{
+  std::vector<TensorRank2Dim3> tensors;
+  tensors.reserve(size());
+  for (size_t n = 0; n < size(); ++n)
+    tensors.push_back(get(n));
+
+  return tensors;
+}
+
+namespace
+{
+using simd_kernel_utils::assertSameSize;
+using simd_kernel_utils::useAVX2;
+
+/**The nine entry rows of a tensor array, row-major.*/
+struct ConstEntries
+{
+  const double* e[9];
+  explicit ConstEntries(const TensorRank2Dim3Array& a)
+  {
+    for (size_t k = 0; k < 9; ++k)
+      e[k] = a.entry(k / 3, k % 3);
+  }
+};
+
+struct Entries
+{
+  double* e[9];
+  explicit Entries(TensorRank2Dim3Array& a)
+  {
+    for (size_t k = 0; k < 9; ++k)
+      e[k] = a.entry(k / 3, k % 3);
+  }
+};
+
+//################################################################### Scalar
+// The scalar kernels defer to the TensorRank2Dim3 operations so that the
+// batch results agree with them by construction. They handle [begin, end)
+// so that the SIMD kernels can reuse them for the remainder loop.
+void matVecScalar(const TensorRank2Dim3Array& a, const Vec3Array& v,
+                  Vec3Array& out, size_t begin, size_t end)
+{
+  for (size_t n = begin; n < end; ++n)
+    out.set(n, a.get(n).Dot(v.get(n)));
+}
+
+void matMatScalar(const TensorRank2Dim3Array& a, const TensorRank2Dim3Array& b,
+                  TensorRank2Dim3Array& out, size_t begin, size_t end)
+{
+  for (size_t n = begin; n < end; ++n)
+    out.set(n, a.get(n).Dot(b.get(n)));
+}
+
+void determinantScalar(const TensorRank2Dim3Array& a, double* out,
+                       size_t begin, size_t end)
+{
+  for (size_t n = begin; n < end; ++n)
+    out[n] = a.get(n).Determinant();
+}
+
+void inverseScalar(const TensorRank2Dim3Array& a, TensorRank2Dim3Array& out,
+                   size_t begin, size_t end)
+{
+  for (size_t n = begin; n < end; ++n)
+    out.set(n, a.get(n).Inverse());
+}
+
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+//################################################################### AVX2
+// Same evaluation order as TensorRank2Dim3, without FMA, so that the results
+// are bitwise identical to the scalar kernels unless the compiler contracts
+// those into FMA (e.g. with -march=native).
+constexpr size_t W = 4; // doubles per __m256d
+
+ELKE_TARGET_AVX2
+void loadEntries(const ConstEntries& a, size_t n, __m256d (&m)[9])
+{
+  for (size_t k = 0; k < 9; ++k)
+    m[k] = _mm256_loadu_pd(a.e[k] + n);
+}
+
+ELKE_TARGET_AVX2
+inline __m256d m(__m256d x, __m256d y) { return _mm256_mul_pd(x, y); }
+
+/**Cofactor matrix, see TensorRank2Dim3::Cofactors.*/
+ELKE_TARGET_AVX2
+void cofactors(const __m256d (&a)[9], __m256d (&c)[9])
+{
+  // clang-format off
+  c[0] = _mm256_sub_pd(m(a[4], a[8]), m(a[5], a[7]));
+  c[1] = _mm256_sub_pd(m(a[5], a[6]), m(a[3], a[8]));
+  c[2] = _mm256_sub_pd(m(a[3], a[7]), m(a[4], a[6]));
+  c[3] = _mm256_sub_pd(m(a[2], a[7]), m(a[1], a[8]));
+  c[4] = _mm256_sub_pd(m(a[0], a[8]), m(a[2], a[6]));
+  c[5] = _mm256_sub_pd(m(a[1], a[6]), m(a[0], a[7]));
+  c[6] = _mm256_sub_pd(m(a[1], a[5]), m(a[2], a[4]));
+  c[7] = _mm256_sub_pd(m(a[2], a[3]), m(a[0], a[5]));
+  c[8] = _mm256_sub_pd(m(a[0], a[4]), m(a[1], a[3]));
+  // clang-format on
+}
+
+/**First-row expansion, see TensorRank2Dim3::Determinant.*/
+ELKE_TARGET_AVX2
+__m256d determinant4(const __m256d (&a)[9], const __m256d (&c)[9])
+{
+  __m256d det = _mm256_mul_pd(a[0], c[0]);
+  det = _mm256_add_pd(det, _mm256_mul_pd(a[1], c[1]));
+  det = _mm256_add_pd(det, _mm256_mul_pd(a[2], c[2]));
+  return det;
+}
+
+ELKE_TARGET_AVX2
+void matVecAVX2(const TensorRank2Dim3Array& a, const Vec3Array& v,
+                Vec3Array& out, size_t size)
+{
+  const ConstEntries ae(a);
+  const double* vr[3] = {v.x(), v.y(), v.z()};
+  double* wr[3] = {out.x(), out.y(), out.z()};
+
+  size_t n = 0;
+  for (; n + W <= size; n += W)
+  {
+    const __m256d vx = _mm256_loadu_pd(vr[0] + n);
+    const __m256d vy = _mm256_loadu_pd(vr[1] + n);
+    const __m256d vz = _mm256_loadu_pd(vr[2] + n);
+    __m256d w[3];
+    for (size_t i = 0; i < 3; ++i)
+    {
+      w[i] = _mm256_mul_pd(_mm256_loadu_pd(ae.e[3 * i] + n), vx);
+      w[i] = _mm256_add_pd(
+        w[i], _mm256_mul_pd(_mm256_loadu_pd(ae.e[3 * i + 1] + n), vy));
+      w[i] = _mm256_add_pd(
+        w[i], _mm256_mul_pd(_mm256_loadu_pd(ae.e[3 * i + 2] + n), vz));
+    }
+    // Store after all loads since `out` may alias `v`.
+    for (size_t i = 0; i < 3; ++i)
+      _mm256_storeu_pd(wr[i] + n, w[i]);
+  }
+  matVecScalar(a, v, out, n, size);
+}
+
+ELKE_TARGET_AVX2
+void matMatAVX2(const TensorRank2Dim3Array& a, const TensorRank2Dim3Array& b,
+                TensorRank2Dim3Array& out, size_t size)
+{
+  const ConstEntries ae(a), be(b);
+  Entries we(out);
+
+  size_t n = 0;
+  for (; n + W <= size; n += W)
+  {
+    __m256d am[9], bm[9], w[9];
+    loadEntries(ae, n, am);
+    loadEntries(be, n, bm);
+    for (size_t i = 0; i < 3; ++i)
+      for (size_t j = 0; j < 3; ++j)
+      {
+        __m256d value = _mm256_mul_pd(am[3 * i], bm[j]);
+        value = _mm256_add_pd(value, _mm256_mul_pd(am[3 * i + 1], bm[3 + j]));
+        value = _mm256_add_pd(value, _mm256_mul_pd(am[3 * i + 2], bm[6 + j]));
+        w[3 * i + j] = value;
+      }
+    for (size_t k = 0; k < 9; ++k)
+      _mm256_storeu_pd(we.e[k] + n, w[k]);
+  }
+  matMatScalar(a, b, out, n, size);
+}
+
+ELKE_TARGET_AVX2
+void determinantAVX2(const TensorRank2Dim3Array& a, double* out, size_t size)
+{
+  const ConstEntries ae(a);
+
+  size_t n = 0;
+  for (; n + W <= size; n += W)
+  {
+    __m256d am[9], c[9];
+    loadEntries(ae, n, am);
+    cofactors(am, c);
+    _mm256_storeu_pd(out + n, determinant4(am, c));
+  }
+  determinantScalar(a, out, n, size);
+}
+
+ELKE_TARGET_AVX2
+void inverseAVX2(const TensorRank2Dim3Array& a, TensorRank2Dim3Array& out,
+                 size_t size)
+{
+  const ConstEntries ae(a);
+  Entries we(out);
+
+  size_t n = 0;
+  for (; n + W <= size; n += W)
+  {
+    __m256d am[9], c[9];
+    loadEntries(ae, n, am);
+    cofactors(am, c);
+    const __m256d det = determinant4(am, c);
+    // Inverse = transpose(cofactors)/det
+    for (size_t i = 0; i < 3; ++i)
+      for (size_t j = 0; j < 3; ++j)
+        _mm256_storeu_pd(we.e[3 * i + j] + n, _mm256_div_pd(c[3 * j + i], det));
+  }
+  inverseScalar(a, out, n, size);
+}
+#endif // ELKE_SIMD_AVX2_AVAILABLE
+
+} // namespace
+
+// ###################################################################
+void dot(const TensorRank2Dim3Array& a, const Vec3Array& v, Vec3Array& out)
+{
+  assertSameSize(a.size(), v.size());
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2()) return matVecAVX2(a, v, out, a.size());
+#endif
+  matVecScalar(a, v, out, 0, a.size());
+}
+
+// ###################################################################
+void dot(const TensorRank2Dim3Array& a,
+         const TensorRank2Dim3Array& b,
+         TensorRank2Dim3Array& out)
+{
+  assertSameSize(a.size(), b.size());
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2()) return matMatAVX2(a, b, out, a.size());
+#endif
+  matMatScalar(a, b, out, 0, a.size());
+}
+
+// ###################################################################
+void determinant(const TensorRank2Dim3Array& a, std::vector<double>& out)
+{
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2()) return determinantAVX2(a, out.data(), a.size());
+#endif
+  determinantScalar(a, out.data(), 0, a.size());
+}
+
+// ###################################################################
+void inverse(const TensorRank2Dim3Array& a, TensorRank2Dim3Array& out)
+{
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2()) return inverseAVX2(a, out, a.size());
+#endif
+  inverseScalar(a, out, 0, a.size());
+}
+
+// ###################################################################
+void symmetricEigenDecomposition(const TensorRank2Dim3Array& a,
+                                 Vec3Array& eigenvalues,
+                                 TensorRank2Dim3Array& eigenvectors)
+{
+  eigenvalues.resize(a.size());
+  eigenvectors.resize(a.size());
+
+  Vec3 values;
+  TensorRank2Dim3 vectors;
+  for (size_t n = 0; n < a.size(); ++n)
+  {
+    SymmetricEigenDecomposition(a.get(n), values, vectors);
+    eigenvalues.set(n, values);
+    eigenvectors.set(n, vectors);
+  }
+}
+
+} // namespace elke::math
@@ -0,0 +1,94 @@
+#ifndef ELK_MATH_TENSORRANK2DIM3ARRAY_H
+#define ELK_MATH_TENSORRANK2DIM3ARRAY_H
+
+#include "TensorRank2Dim3.h"
+#include "Vec3Array.h"
+
+#include <array>
+#include <vector>
+
+namespace elke::math
+{
+
+/**Structure-of-arrays container of 3x3 tensors. Entry \f$ T_{ij} \f$ of all
+ * tensors is stored contiguously in its own 64-byte aligned row, which is the
+ * layout the batch kernels below vectorize over. See Vec3Array.*/
+class TensorRank2Dim3Array
+{
+public:
+  using Storage = Vec3Array::Storage;
+
+private:
+  std::array<Storage, 9> m_entries;
+
+public:
+  /**Empty array.*/
+  TensorRank2Dim3Array() = default;
+
+  /**Array of `size` zero tensors.*/
+  explicit TensorRank2Dim3Array(size_t size);
+
+  /**Array of `size` copies of `value`.*/
+  TensorRank2Dim3Array(size_t size, const TensorRank2Dim3& value);
+
+  /**Array built from an array-of-structures.*/
+  explicit TensorRank2Dim3Array(const std::vector<TensorRank2Dim3>& tensors);
+
+  /**Returns the number of tensors.*/
+  size_t size() const { return m_entries[0].size(); }
+
+  /**Resizes the array. New entries are zero tensors.*/
+  void resize(size_t size);
+
+  /**Appends a tensor.*/
+  void push_back(const TensorRank2Dim3& value);
+
+  /**Returns a copy of the n-th tensor.*/
+  TensorRank2Dim3 get(size_t n) const;
+
+  /**Assigns the n-th tensor.*/
+  void set(size_t n, const TensorRank2Dim3& value);
+
+  /**Converts back to an array-of-structures.*/
+  std::vector<TensorRank2Dim3> toTensors() const;
+
+  /**Row holding entry \f$ T_{ij} \f$ of every tensor.*/
+  double* entry(size_t i, size_t j) { return m_entries[3 * i + j].data(); }
+  const double* entry(size_t i, size_t j) const
+  {
+    return m_entries[3 * i + j].data();
+  }
+};
+
+//=============================================== Batch kernels
+// Every kernel applies the TensorRank2Dim3 operation of the same meaning to
+// each entry and produces bitwise identical results, up to FMA contraction
+// of the scalar code by the compiler. Output arrays are resized as needed
+// and may alias an input.
+
+/**Tensor-vector products, \f$ \vec{w}_n = T_n \vec{v}_n \f$.
+ * See TensorRank2Dim3::Dot(const Vec3&).*/
+void dot(const TensorRank2Dim3Array& a, const Vec3Array& v, Vec3Array& out);
+
+/**Tensor-tensor products, \f$ W_n = A_n B_n \f$.
+ * See TensorRank2Dim3::Dot(const TensorRank2Dim3&).*/
+void dot(const TensorRank2Dim3Array& a,
+         const TensorRank2Dim3Array& b,
+         TensorRank2Dim3Array& out);
+
+/**Determinants. See TensorRank2Dim3::Determinant.*/
+void determinant(const TensorRank2Dim3Array& a, std::vector<double>& out);
+
+/**Inverses. See TensorRank2Dim3::Inverse.*/
+void inverse(const TensorRank2Dim3Array& a, TensorRank2Dim3Array& out);
+
+/**Eigen-decompositions of symmetric tensors. See
+ * SymmetricEigenDecomposition. The Jacobi iteration is data-dependent and
+ * therefore runs per tensor rather than across SIMD lanes.*/
+void symmetricEigenDecomposition(const TensorRank2Dim3Array& a,
+                                 Vec3Array& eigenvalues,
+                                 TensorRank2Dim3Array& eigenvectors);
+
+} // namespace elke::math
+
+#endif // ELK_MATH_TENSORRANK2DIM3ARRAY_H
@@ -3,103 +3,64 @@
 #define ELK_MATH_VEC3_H
 #include<iostream>
 #include<cmath>
+#include <initializer_list>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 namespace elke::math
 {
+struct TensorRank2Dim3;
+
 //=============================================== General 3D vector structure
 /**General 3 element vector structure.
 */
 struct Vec3
 {
-  double x; ///< Element-0
-  double y; ///< Element-1
-  double z; ///< Element-2
+  double x = 0.0; ///< Element-0
+  double y = 0.0; ///< Element-1
+  double z = 0.0; ///< Element-2
 
   /**Default constructor. Initialized as all zeros.*/
-  Vec3();
+  constexpr Vec3() = default;
 
   /**Constructor where single element is initialized \f$ x[z]=a \f$.*/
-  explicit Vec3(double a);
+  constexpr explicit Vec3(double a) : x(a) {}
 
   /**Constructor where \f$ x=a\f$ and \f$ y=b \f$. */
-  explicit Vec3(double a, double b);
+  constexpr explicit Vec3(double a, double b) : x(a), y(b) {}
 
   /**Constructor where \f$ \vec{x}=[a,b,c] \f$.*/
-  explicit Vec3(double a, double b, double c);
+  constexpr explicit Vec3(double a, double b, double c) : x(a), y(b), z(c) {}
 
-  /**Constructor where \f$ \vec{x}=\{a,b,c\} \f$.*/
-  Vec3(std::initializer_list<double> list)
+  /**Constructor where \f$ \vec{x}=\{a,b,c\} \f$. Entries beyond the third
+   * are ignored.*/
+  constexpr Vec3(std::initializer_list<double> list)
   {
-    if (not empty(list))
-    {
-      std::vector<double> vec = list;
-      for (size_t i=0; ( (i<3) and ( i<vec.size() ) ); ++i)
-      {
-        if (i==0) x = vec[i];
-        if (i==1) y = vec[i];
-        if (i==2) z = vec[i];
-      }
-    }
+    assign(list.begin(), list.size());
   }
 
-  /**Constructor where \f$ \vec{x}=\{a,b,c\} \f$.*/
+  /**Constructor where \f$ \vec{x}=\{a,b,c\} \f$. Entries beyond the third
+   * are ignored.*/
   explicit Vec3(const std::vector<double>& list)
   {
-    if (not empty(list))
-    {
-      std::vector<double> vec = list;
-      for (size_t i=0; ( (i<3) and ( i<vec.size() ) ); ++i)
-      {
-        if (i==0) x = vec[i];
-        if (i==1) y = vec[i];
-        if (i==2) z = vec[i];
-      }
-    }
+    assign(list.data(), list.size());
   }
 
-  /**Copy constructor.*/
-  Vec3(const Vec3& that)
-  {
-    this->x = that.x;
-    this->y = that.y;
-    this->z = that.z;
-  }
-
-  /**Assignment operator.*/
-  Vec3& operator=(const Vec3& that)
-  {
-    this->x = that.x;
-    this->y = that.y;
-    this->z = that.z;
-
-    return *this;
-  }
+  // The copy constructor and assignment operator are implicit so that Vec3
+  // stays trivially copyable, i.e., it can be memcpy'd into byte- and MPI
+  // buffers.
 
-  Vec3& operator=(std::initializer_list<double> list)
+  constexpr Vec3& operator=(std::initializer_list<double> list)
   {
-    if (not empty(list))
-    {
-      std::vector<double> vec = list;
-      for (size_t i=0; ( (i<3) and ( i<vec.size() ) ); ++i)
-      {
-        this->operator()(i) = vec[i];
-      }
-    }
+    assign(list.begin(), list.size());
 
     return *this;
   }
 
   Vec3& operator=(const std::vector<double>& list)
   {
-    if (not empty(list))
-    {
-      std::vector<double> vec = list;
-      for (size_t i=0; ( (i<3) and ( i<vec.size() ) ); ++i)
-      {
-        this->operator()(i) = vec[i];
-      }
-    }
+    assign(list.data(), list.size());
 
     return *this;
   }
@@ -107,7 +68,7 @@ struct Vec3
   //============================================= Addition
   /**Component-wise addition of two vectors.
    * \f$ \vec{w} = \vec{x} + \vec{y} \f$*/
-  Vec3 operator+(const Vec3& that) const
+  constexpr Vec3 operator+(const Vec3& that) const
   {
     Vec3 newVector;
     newVector.x = this->x + that.x;
@@ -119,7 +80,7 @@ struct Vec3
 
   /**In-place component-wise addition of two vectors.
    * \f$ \vec{x} = \vec{x} + \vec{y} \f$*/
-  Vec3& operator+=(const Vec3& that)
+  constexpr Vec3& operator+=(const Vec3& that)
   {
     this->x += that.x;
     this->y += that.y;
@@ -130,7 +91,7 @@ struct Vec3
 
   /**Component-wise shift by scalar-value.
    * \f$ \vec{w} = \vec{x} + \alpha \f$*/
-  Vec3 Shifted(const double value) const
+  constexpr Vec3 Shifted(const double value) const
   {
     Vec3 newVector;
     newVector.x = this->x + value;
@@ -142,7 +103,7 @@ struct Vec3
 
   /**In-place component-wise shift by scalar-value.
    * \f$ \vec{x} = \vec{x} + \alpha \f$*/
-  Vec3& Shift(const double value)
+  constexpr Vec3& Shift(const double value)
   {
     this->x += value;
     this->y += value;
@@ -154,7 +115,7 @@ struct Vec3
   //============================================= Subtraction
   /**Component-wise subtraction.
    * \f$ \vec{w} = \vec{x} - \vec{y} \f$*/
-  Vec3 operator-(const Vec3& that) const
+  constexpr Vec3 operator-(const Vec3& that) const
   {
     Vec3 newVector;
     newVector.x = this->x - that.x;
@@ -166,7 +127,7 @@ struct Vec3
 
   /**In-place component-wise subtraction.
    * \f$ \vec{x} = \vec{x} - \vec{y} \f$*/
-  Vec3& operator-=(const Vec3& that)
+  constexpr Vec3& operator-=(const Vec3& that)
   {
     this->x -= that.x;
     this->y -= that.y;
@@ -175,10 +136,22 @@ struct Vec3
     return *this;
   }
 
+  /**Component-wise negation.
+   * \f$ \vec{w} = -\vec{x} \f$*/
+  constexpr Vec3 operator-() const
+  {
+    Vec3 newVector;
+    newVector.x = -this->x;
+    newVector.y = -this->y;
+    newVector.z = -this->z;
+
+    return newVector;
+  }
+
   //============================================= Multiplication
   /**Vector component-wise multiplication by scalar.
    * \f$ \vec{w} = \vec{x} \alpha \f$*/
-  Vec3 operator*(const double value) const
+  constexpr Vec3 operator*(const double value) const
   {
     Vec3 newVector;
     newVector.x = this->x*value;
@@ -190,7 +163,7 @@ struct Vec3
 
   /**Vector in-place component-wise multiplication by scalar.
    * \f$ \vec{x} = \vec{x} \alpha \f$*/
-  Vec3& operator*=(const double value)
+  constexpr Vec3& operator*=(const double value)
   {
     this->x*=value;
     this->y*=value;
@@ -201,7 +174,7 @@ struct Vec3
 
   /**Vector component-wise multiplication.
    * \f$ w_i = x_i y_i \f$*/
-  Vec3 operator*(const Vec3& that) const
+  constexpr Vec3 operator*(const Vec3& that) const
   {
     Vec3 newVector;
     newVector.x = this->x*that.x;
@@ -213,7 +186,7 @@ struct Vec3
 
   /**Vector in-place component-wise multiplication.
    * \f$ x_i = x_i y_i \f$*/
-  Vec3& operator*=(const Vec3& that)
+  constexpr Vec3& operator*=(const Vec3& that)
   {
     this->x*=that.x;
     this->y*=that.y;
@@ -225,7 +198,7 @@ struct Vec3
   //============================================= Division
   /**Vector component-wise division by scalar.
    * \f$ w_i = \frac{x_i}{\alpha} \f$*/
-  Vec3 operator/(const double value) const
+  constexpr Vec3 operator/(const double value) const
   {
     Vec3 newVector;
     newVector.x = this->x/value;
@@ -237,7 +210,7 @@ struct Vec3
 
   /**Vector in-place component-wise division by scalar.
    * \f$ x_i = \frac{x_i}{\alpha} \f$*/
-  Vec3& operator/=(const double value)
+  constexpr Vec3& operator/=(const double value)
   {
     this->x/=value;
     this->y/=value;
@@ -248,7 +221,7 @@ struct Vec3
 
   /**Vector component-wise division.
    * \f$ w_i = \frac{x_i}{y_i} \f$*/
-  Vec3 operator/(const Vec3& that) const
+  constexpr Vec3 operator/(const Vec3& that) const
   {
     Vec3 newVector;
     newVector.x = this->x/that.x;
@@ -260,7 +233,7 @@ struct Vec3
 
   /**Vector in-place component-wise division.
    * \f$ x_i = \frac{x_i}{y_i} \f$*/
-  Vec3& operator/=(const Vec3& that)
+  constexpr Vec3& operator/=(const Vec3& that)
   {
     this->x/=that.x;
     this->y/=that.y;
@@ -271,7 +244,7 @@ struct Vec3
 
   //============================================= Element access
   /**Returns a copy of the value at the given index.*/
-  double operator[](const size_t i) const
+  constexpr double operator[](const size_t i) const
   {
     if (i==0)      return this->x;
     else if (i==1) return this->y;
@@ -281,7 +254,7 @@ struct Vec3
   }
 
   /**Returns a reference of the value at the given index.*/
-  double& operator()(const size_t i)
+  constexpr double& operator()(const size_t i)
   {
     if (i==0)      return this->x;
     else if (i==1) return this->y;
@@ -290,18 +263,20 @@ struct Vec3
     return this->x;
   }
 
-  // //============================================= Tensor product
-  // //Defined in chi_mesh_utilities.cc
-  // elk::math::TensorRank2Dim3 OTimes(const Vec3& that) const;
+  //============================================= Tensor product
+  /**Outer product. \f$ W_{ij} = x_i y_j \f$.
+   * Defined in TensorRank2Dim3.cc*/
+  TensorRank2Dim3 OTimes(const Vec3& that) const;
 
-  // //============================================= Tensor dot product
-  // //Defined in chi_mesh_utilities.cc
-  // Vec3 Dot(const elk::math::TensorRank2Dim3& that) const;
+  //============================================= Tensor dot product
+  /**Vector-tensor product. \f$ w_j = x_i T_{ij} \f$.
+   * Defined in TensorRank2Dim3.cc*/
+  Vec3 Dot(const TensorRank2Dim3& that) const;
 
   //============================================= Operations
   /**Vector cross-product.
    * \f$ \vec{w} = \vec{x} \times \vec{y} \f$*/
-  Vec3 Cross(const Vec3& that) const
+  constexpr Vec3 Cross(const Vec3& that) const
   {
     Vec3 newVector;
     newVector.x = this->y*that.z - this->z*that.y;
@@ -313,7 +288,7 @@ struct Vec3
 
   /**Vector dot-product.
    * \f$ \vec{w} = \vec{x} \bullet \vec{y} \f$ */
-  double Dot(const Vec3& that) const
+  constexpr double Dot(const Vec3& that) const
   {
     double value = 0.0;
     value += this->x*that.x;
@@ -340,7 +315,7 @@ struct Vec3
   /**Computes the square of the L2-norm of the vector. This eliminates the
    * usage of the square root and is therefore less expensive that a proper
    * L2-norm. Useful if only comparing distances.*/
-  double NormSquare() const
+  constexpr double NormSquare() const
   {
     double value = 0.0;
     value += this->x*this->x;
@@ -406,12 +381,12 @@ struct Vec3
   /**Returns a vector v^* where each element is inverted without any
    * check for division by zero.
    * \f$ w_i = \frac{1.0}{x_i} \f$*/
-  Vec3 Inverse() const
+  constexpr Vec3 Inverse() const
   {
     Vec3 newVector;
-    double dx_inv = 1.0/this->x;
-    double dy_inv = 1.0/this->y;
-    double dz_inv = 1.0/this->z;
+    newVector.x = 1.0/this->x;
+    newVector.y = 1.0/this->y;
+    newVector.z = 1.0/this->z;
 
     return newVector;
   }
@@ -426,17 +401,31 @@ struct Vec3
     return out.str();
   }
 
-  static size_t size()
+  static constexpr size_t size()
   {
     return 3;
   }
+
+private:
+  /**Assigns up to three entries from a contiguous list without allocating.*/
+  constexpr void assign(const double* values, const size_t count)
+  {
+    if (count > 0) x = values[0];
+    if (count > 1) y = values[1];
+    if (count > 2) z = values[2];
+  }
 };
 
-} // namespace elk::math
+static_assert(std::is_trivially_copyable_v<Vec3>,
+              "Vec3 must remain trivially copyable.");
 
-//The following functions are defined in chi_mesh_utilities.cc
-//Left multiplcation by scalar
-elke::math::Vec3 operator*(double value,const elke::math::Vec3& that);
+/**Left multiplication by scalar.
+ * \f$ \vec{w} = \alpha \vec{x} \f$*/
+constexpr Vec3 operator*(const double value, const Vec3& that)
+{
+  return that*value;
+}
 
+} // namespace elk::math
 
 #endif //ELK_MATH_VEC3_H
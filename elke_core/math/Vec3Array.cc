@@ -0,0 +1,394 @@
+#include "Vec3Array.h"
+#include "simd_kernel_utils.h"
+
+#include "elke_core/output/elk_exceptions.h"
+
+#include <cmath>
+
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+#include <immintrin.h>
+#endif
+
+namespace elke::math
+{
+
+// ###################################################################
+/**Array of `size` zero vectors.*/
+Vec3Array::Vec3Array(const size_t size)
+  : m_x(size, 0.0), m_y(size, 0.0), m_z(size, 0.0)
+{
+}
+
+// ###################################################################
+/**Array of `size` copies of `value`.*/
+Vec3Array::Vec3Array(const size_t size, const Vec3& value)
+  : m_x(size, value.x), m_y(size, value.y), m_z(size, value.z)
+{
+}
+
+// ###################################################################
+/**Array built from an array-of-structures.*/
+Vec3Array::Vec3Array(const std::vector<Vec3>& vectors)
+{
+  reserve(vectors.size());
+  for (const auto& vector : vectors)
+    push_back(vector);
+}
+
+// ###################################################################
+void Vec3Array::resize(const size_t size)
+{
+  m_x.resize(size, 0.0);
+  m_y.resize(size, 0.0);
+  m_z.resize(size, 0.0);
+}
+
+// ###################################################################
+void Vec3Array::reserve(const size_t capacity)
+{
+  m_x.reserve(capacity);
+  m_y.reserve(capacity);
+  m_z.reserve(capacity);
+}
+
+// ###################################################################
+void Vec3Array::push_back(const Vec3& value)
+{
+  m_x.push_back(value.x);
+  m_y.push_back(value.y);
+  m_z.push_back(value.z);
+}
+
+// ###################################################################
+void Vec3Array::set(const size_t i, const Vec3& value)
+{
+  m_x[i] = value.x;
+  m_y[i] = value.y;
+  m_z[i] = value.z;
+}
+
+// ###################################################################
+std::vector<Vec3> Vec3Array::toVec3s() const
+{
+  std::vector<Vec3> vectors;
+  vectors.reserve(size());
+  for (size_t i = 0; i < size(); ++i)
+    vectors.push_back(get(i));
+
+  return vectors;
+}
+
+namespace
+{
+using simd_kernel_utils::assertSameSize;
+using simd_kernel_utils::useAVX2;
+
+/**Component rows of an array, used to keep the kernel signatures short.*/
+struct ConstRows
+{
+  const double* x;
+  const double* y;
+  const double* z;
+  explicit ConstRows(const Vec3Array& a) : x(a.x()), y(a.y()), z(a.z()) {}
+};
+
+struct Rows
+{
+  double* x;
+  double* y;
+  double* z;
+  explicit Rows(Vec3Array& a) : x(a.x()), y(a.y()), z(a.z()) {}
+};
+
+// clang-format off
+//################################################################### Scalar
+// The scalar kernels handle [begin, end) so that the SIMD kernels can reuse
+// them for the remainder loop.
+void addScalar(ConstRows a, ConstRows b, Rows w, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    w.x[i] = a.x[i] + b.x[i];
+    w.y[i] = a.y[i] + b.y[i];
+    w.z[i] = a.z[i] + b.z[i];
+  }
+}
+
+void axpyScalar(double alpha, ConstRows x, Rows y, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    y.x[i] += alpha * x.x[i];
+    y.y[i] += alpha * x.y[i];
+    y.z[i] += alpha * x.z[i];
+  }
+}
+
+void dotScalar(ConstRows a, ConstRows b, double* w, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    double value = 0.0;
+    value += a.x[i] * b.x[i];
+    value += a.y[i] * b.y[i];
+    value += a.z[i] * b.z[i];
+    w[i] = value;
+  }
+}
+
+void crossScalar(ConstRows a, ConstRows b, Rows w, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    const double wx = a.y[i] * b.z[i] - a.z[i] * b.y[i];
+    const double wy = a.z[i] * b.x[i] - a.x[i] * b.z[i];
+    const double wz = a.x[i] * b.y[i] - a.y[i] * b.x[i];
+    w.x[i] = wx; w.y[i] = wy; w.z[i] = wz;
+  }
+}
+
+void normScalar(ConstRows a, double* w, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    double value = 0.0;
+    value += a.x[i] * a.x[i];
+    value += a.y[i] * a.y[i];
+    value += a.z[i] * a.z[i];
+    w[i] = std::sqrt(value);
+  }
+}
+
+void normalizeScalar(Rows a, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    double value = 0.0;
+    value += a.x[i] * a.x[i];
+    value += a.y[i] * a.y[i];
+    value += a.z[i] * a.z[i];
+    const double norm = std::sqrt(value);
+    a.x[i] /= norm; a.y[i] /= norm; a.z[i] /= norm;
+  }
+}
+
+void inverseScalar(ConstRows a, double tol, double fallback, Rows w,
+                   size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    w.x[i] = (std::fabs(a.x[i]) > tol) ? 1.0 / a.x[i] : fallback;
+    w.y[i] = (std::fabs(a.y[i]) > tol) ? 1.0 / a.y[i] : fallback;
+    w.z[i] = (std::fabs(a.z[i]) > tol) ? 1.0 / a.z[i] : fallback;
+  }
+}
+
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+//################################################################### AVX2
+// FMA is deliberately not used so that the AVX2 results are bitwise identical
+// to the scalar kernels and to the Vec3 member functions, unless the compiler
+// contracts those into FMA (e.g. with -march=native). They then agree to a
+// few ulps.
+constexpr size_t W = 4; // doubles per __m256d
+
+ELKE_TARGET_AVX2
+void addAVX2(ConstRows a, ConstRows b, Rows w, size_t n)
+{
+  size_t i = 0;
+  for (; i + W <= n; i += W)
+  {
+    _mm256_storeu_pd(w.x + i, _mm256_add_pd(_mm256_loadu_pd(a.x + i), _mm256_loadu_pd(b.x + i)));
+    _mm256_storeu_pd(w.y + i, _mm256_add_pd(_mm256_loadu_pd(a.y + i), _mm256_loadu_pd(b.y + i)));
+    _mm256_storeu_pd(w.z + i, _mm256_add_pd(_mm256_loadu_pd(a.z + i), _mm256_loadu_pd(b.z + i)));
+  }
+  addScalar(a, b, w, i, n);
+}
+
+ELKE_TARGET_AVX2
+void axpyAVX2(double alpha, ConstRows x, Rows y, size_t n)
+{
+  const __m256d va = _mm256_set1_pd(alpha);
+  size_t i = 0;
+  for (; i + W <= n; i += W)
+  {
+    _mm256_storeu_pd(y.x + i, _mm256_add_pd(_mm256_loadu_pd(y.x + i), _mm256_mul_pd(va, _mm256_loadu_pd(x.x + i))));
+    _mm256_storeu_pd(y.y + i, _mm256_add_pd(_mm256_loadu_pd(y.y + i), _mm256_mul_pd(va, _mm256_loadu_pd(x.y + i))));
+    _mm256_storeu_pd(y.z + i, _mm256_add_pd(_mm256_loadu_pd(y.z + i), _mm256_mul_pd(va, _mm256_loadu_pd(x.z + i))));
+  }
+  axpyScalar(alpha, x, y, i, n);
+}
+
+ELKE_TARGET_AVX2
+inline __m256d dot4(const double* ax, const double* ay, const double* az,
+                    const double* bx, const double* by, const double* bz)
+{
+  __m256d value = _mm256_mul_pd(_mm256_loadu_pd(ax), _mm256_loadu_pd(bx));
+  value = _mm256_add_pd(value, _mm256_mul_pd(_mm256_loadu_pd(ay), _mm256_loadu_pd(by)));
+  value = _mm256_add_pd(value, _mm256_mul_pd(_mm256_loadu_pd(az), _mm256_loadu_pd(bz)));
+  return value;
+}
+
+ELKE_TARGET_AVX2
+void dotAVX2(ConstRows a, ConstRows b, double* w, size_t n)
+{
+  size_t i = 0;
+  for (; i + W <= n; i += W)
+    _mm256_storeu_pd(w + i, dot4(a.x + i, a.y + i, a.z + i, b.x + i, b.y + i, b.z + i));
+  dotScalar(a, b, w, i, n);
+}
+
+ELKE_TARGET_AVX2
+void crossAVX2(ConstRows a, ConstRows b, Rows w, size_t n)
+{
+  size_t i = 0;
+  for (; i + W <= n; i += W)
+  {
+    const __m256d ax = _mm256_loadu_pd(a.x + i), ay = _mm256_loadu_pd(a.y + i), az = _mm256_loadu_pd(a.z + i);
+    const __m256d bx = _mm256_loadu_pd(b.x + i), by = _mm256_loadu_pd(b.y + i), bz = _mm256_loadu_pd(b.z + i);
+    _mm256_storeu_pd(w.x + i, _mm256_sub_pd(_mm256_mul_pd(ay, bz), _mm256_mul_pd(az, by)));
+    _mm256_storeu_pd(w.y + i, _mm256_sub_pd(_mm256_mul_pd(az, bx), _mm256_mul_pd(ax, bz)));
+    _mm256_storeu_pd(w.z + i, _mm256_sub_pd(_mm256_mul_pd(ax, by), _mm256_mul_pd(ay, bx)));
+  }
+  crossScalar(a, b, w, i, n);
+}
+
+ELKE_TARGET_AVX2
+void normAVX2(ConstRows a, double* w, size_t n)
+{
+  size_t i = 0;
+  for (; i + W <= n; i += W)
+    _mm256_storeu_pd(w + i, _mm256_sqrt_pd(dot4(a.x + i, a.y + i, a.z + i, a.x + i, a.y + i, a.z + i)));
+  normScalar(a, w, i, n);
+}
+
+ELKE_TARGET_AVX2
+void normalizeAVX2(Rows a, size_t n)
+{
+  size_t i = 0;
+  for (; i + W <= n; i += W)
+  {
+    const __m256d norm = _mm256_sqrt_pd(dot4(a.x + i, a.y + i, a.z + i, a.x + i, a.y + i, a.z + i));
+    _mm256_storeu_pd(a.x + i, _mm256_div_pd(_mm256_loadu_pd(a.x + i), norm));
+    _mm256_storeu_pd(a.y + i, _mm256_div_pd(_mm256_loadu_pd(a.y + i), norm));
+    _mm256_storeu_pd(a.z + i, _mm256_div_pd(_mm256_loadu_pd(a.z + i), norm));
+  }
+  normalizeScalar(a, i, n);
+}
+
+ELKE_TARGET_AVX2
+inline __m256d inverse4(const double* a, __m256d tol, __m256d fallback)
+{
+  const __m256d sign_mask = _mm256_set1_pd(-0.0);
+  const __m256d value = _mm256_loadu_pd(a);
+  const __m256d magnitude = _mm256_andnot_pd(sign_mask, value);
+  const __m256d keep = _mm256_cmp_pd(magnitude, tol, _CMP_GT_OQ);
+  const __m256d inverse = _mm256_div_pd(_mm256_set1_pd(1.0), value);
+  return _mm256_blendv_pd(fallback, inverse, keep);
+}
+
+ELKE_TARGET_AVX2
+void inverseAVX2(ConstRows a, double tol, double fallback, Rows w, size_t n)
+{
+  const __m256d vtol = _mm256_set1_pd(tol);
+  const __m256d vfallback = _mm256_set1_pd(fallback);
+  size_t i = 0;
+  for (; i + W <= n; i += W)
+  {
+    _mm256_storeu_pd(w.x + i, inverse4(a.x + i, vtol, vfallback));
+    _mm256_storeu_pd(w.y + i, inverse4(a.y + i, vtol, vfallback));
+    _mm256_storeu_pd(w.z + i, inverse4(a.z + i, vtol, vfallback));
+  }
+  inverseScalar(a, tol, fallback, w, i, n);
+}
+#endif // ELKE_SIMD_AVX2_AVAILABLE
+// clang-format on
+
+} // namespace
+
+// ###################################################################
+void add(const Vec3Array& a, const Vec3Array& b, Vec3Array& out)
+{
+  assertSameSize(a.size(), b.size());
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2())
+    return addAVX2(ConstRows(a), ConstRows(b), Rows(out), a.size());
+#endif
+  addScalar(ConstRows(a), ConstRows(b), Rows(out), 0, a.size());
+}
+
+// ###################################################################
+void axpy(const double alpha, const Vec3Array& x, Vec3Array& y)
+{
+  assertSameSize(x.size(), y.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2()) return axpyAVX2(alpha, ConstRows(x), Rows(y), x.size());
+#endif
+  axpyScalar(alpha, ConstRows(x), Rows(y), 0, x.size());
+}
+
+// ###################################################################
+void dot(const Vec3Array& a, const Vec3Array& b, std::vector<double>& out)
+{
+  assertSameSize(a.size(), b.size());
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2()) return dotAVX2(ConstRows(a), ConstRows(b), out.data(), a.size());
+#endif
+  dotScalar(ConstRows(a), ConstRows(b), out.data(), 0, a.size());
+}
+
+// ###################################################################
+void cross(const Vec3Array& a, const Vec3Array& b, Vec3Array& out)
+{
+  assertSameSize(a.size(), b.size());
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2())
+    return crossAVX2(ConstRows(a), ConstRows(b), Rows(out), a.size());
+#endif
+  crossScalar(ConstRows(a), ConstRows(b), Rows(out), 0, a.size());
+}
+
+// ###################################################################
+void norm(const Vec3Array& a, std::vector<double>& out)
+{
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2()) return normAVX2(ConstRows(a), out.data(), a.size());
+#endif
+  normScalar(ConstRows(a), out.data(), 0, a.size());
+}
+
+// ###################################################################
+void normalize(Vec3Array& a)
+{
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2()) return normalizeAVX2(Rows(a), a.size());
+#endif
+  normalizeScalar(Rows(a), 0, a.size());
+}
+
+// ###################################################################
+void inverseZeroIfSmaller(const Vec3Array& a, const double tol, Vec3Array& out)
+{
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2())
+    return inverseAVX2(ConstRows(a), tol, 0.0, Rows(out), a.size());
+#endif
+  inverseScalar(ConstRows(a), tol, 0.0, Rows(out), 0, a.size());
+}
+
+// ###################################################################
+void inverseOneIfSmaller(const Vec3Array& a, const double tol, Vec3Array& out)
+{
+  out.resize(a.size());
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  if (useAVX2())
+    return inverseAVX2(ConstRows(a), tol, 1.0, Rows(out), a.size());
+#endif
+  inverseScalar(ConstRows(a), tol, 1.0, Rows(out), 0, a.size());
+}
+
+} // namespace elke::math
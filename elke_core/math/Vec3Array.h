@@ -0,0 +1,111 @@
+#ifndef ELK_MATH_VEC3ARRAY_H
+#define ELK_MATH_VEC3ARRAY_H
+
+#include "Vec3.h"
+#include "AlignedAllocator.h"
+
+#include <vector>
+
+namespace elke::math
+{
+
+/**Structure-of-arrays container of 3D vectors. The components are stored in
+ * three separate 64-byte aligned rows, `x[]`, `y[]` and `z[]`, which is the
+ * layout the batch kernels below vectorize over.
+ *
+ * ```c++
+ * Vec3Array positions(n);
+ * Vec3Array velocities(n);
+ * axpy(dt, velocities, positions);  // positions += dt*velocities
+ * ```
+ */
+class Vec3Array
+{
+public:
+  using Storage = std::vector<double, AlignedAllocator<double, 64>>;
+
+private:
+  Storage m_x;
+  Storage m_y;
+  Storage m_z;
+
+public:
+  /**Empty array.*/
+  Vec3Array() = default;
+
+  /**Array of `size` zero vectors.*/
+  explicit Vec3Array(size_t size);
+
+  /**Array of `size` copies of `value`.*/
+  Vec3Array(size_t size, const Vec3& value);
+
+  /**Array built from an array-of-structures.*/
+  explicit Vec3Array(const std::vector<Vec3>& vectors);
+
+  /**Returns the number of vectors.*/
+  size_t size() const { return m_x.size(); }
+
+  /**Resizes the array. New entries are zero vectors.*/
+  void resize(size_t size);
+
+  /**Reserves capacity.*/
+  void reserve(size_t capacity);
+
+  /**Appends a vector.*/
+  void push_back(const Vec3& value);
+
+  /**Returns a copy of the i-th vector.*/
+  Vec3 get(size_t i) const { return Vec3(m_x[i], m_y[i], m_z[i]); }
+
+  /**Assigns the i-th vector.*/
+  void set(size_t i, const Vec3& value);
+
+  /**Converts back to an array-of-structures.*/
+  std::vector<Vec3> toVec3s() const;
+
+  // clang-format off
+  /**Component rows.*/
+  double* x() { return m_x.data(); }
+  double* y() { return m_y.data(); }
+  double* z() { return m_z.data(); }
+  const double* x() const { return m_x.data(); }
+  const double* y() const { return m_y.data(); }
+  const double* z() const { return m_z.data(); }
+  // clang-format on
+};
+
+//=============================================== Batch kernels
+// Every kernel applies the Vec3 member function of the same meaning to each
+// entry. Output arrays are resized as needed and may alias an input.
+
+/**Component-wise addition, \f$ \vec{w}_i = \vec{a}_i + \vec{b}_i \f$.
+ * See Vec3::operator+.*/
+void add(const Vec3Array& a, const Vec3Array& b, Vec3Array& out);
+
+/**In-place scaled addition, \f$ \vec{y}_i = \vec{y}_i + \alpha \vec{x}_i \f$.*/
+void axpy(double alpha, const Vec3Array& x, Vec3Array& y);
+
+/**Dot-products, \f$ w_i = \vec{a}_i \bullet \vec{b}_i \f$. See Vec3::Dot.*/
+void dot(const Vec3Array& a, const Vec3Array& b, std::vector<double>& out);
+
+/**Cross-products, \f$ \vec{w}_i = \vec{a}_i \times \vec{b}_i \f$.
+ * See Vec3::Cross.*/
+void cross(const Vec3Array& a, const Vec3Array& b, Vec3Array& out);
+
+/**L2-norms, \f$ w_i = ||\vec{a}_i||_2 \f$. See Vec3::Norm.*/
+void norm(const Vec3Array& a, std::vector<double>& out);
+
+/**In-place normalization of every vector. See Vec3::Normalize.*/
+void normalize(Vec3Array& a);
+
+/**Component-wise inversion where entries with magnitude not greater than
+ * `tol` are set to 0.0. See Vec3::InverseZeroIfSmaller.*/
+void inverseZeroIfSmaller(const Vec3Array& a, double tol, Vec3Array& out);
+
+/**Component-wise inversion where entries with magnitude not greater than
+ * `tol` are set to 1.0. See Vec3::InverseOneIfSmaller.*/
+void inverseOneIfSmaller(const Vec3Array& a, double tol, Vec3Array& out);
+
+} // namespace elke::math
+
+#endif // ELK_MATH_VEC3ARRAY_H
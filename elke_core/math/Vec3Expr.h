@@ -0,0 +1,179 @@
+#ifndef ELK_MATH_VEC3EXPR_H
+#define ELK_MATH_VEC3EXPR_H
+
+#include "Vec3.h"
+
+#include <type_traits>
+
+/**Optional expression templates for Vec3.
+ *
+ * The eager Vec3 operators return a new Vec3 for every operation, so a chain
+ * such as `a + b*s - c` creates two temporaries. Wrapping the leaves with
+ * `lazy()` instead builds a small expression tree on the stack that is only
+ * evaluated, component by component, when it is assigned to a Vec3:
+ *
+ * ```c++
+ * using namespace elke::math::expr;
+ * Vec3 w = lazy(a) + lazy(b)*s - lazy(c);
+ * ```
+ *
+ * The per-component operation order matches the eager operators, so both
+ * forms produce bitwise identical results. Leaves hold references, interior
+ * nodes hold their operands by value, so an expression must not outlive the
+ * vectors it refers to (i.e. don't store it with `auto`).*/
+namespace elke::math::expr
+{
+
+/**CRTP base of all Vec3 expressions.*/
+template <class E>
+struct Vec3Expression
+{
+  constexpr const E& self() const { return static_cast<const E&>(*this); }
+
+  /**Evaluates the expression.*/
+  constexpr operator Vec3() const // NOLINT(google-explicit-constructor)
+  {
+    const E& e = self();
+    return Vec3(e.template get<0>(), e.template get<1>(), e.template get<2>());
+  }
+};
+
+/**Leaf referring to an existing vector.*/
+struct Vec3Ref : Vec3Expression<Vec3Ref>
+{
+  const Vec3& m_vec;
+
+  constexpr explicit Vec3Ref(const Vec3& vec) : m_vec(vec) {}
+
+  template <int I>
+  constexpr double get() const
+  {
+    if constexpr (I == 0) return m_vec.x;
+    else if constexpr (I == 1) return m_vec.y;
+    else return m_vec.z;
+  }
+};
+
+/**Component-wise binary operation between two expressions.*/
+template <class L, class R, class Op>
+struct Vec3Binary : Vec3Expression<Vec3Binary<L, R, Op>>
+{
+  L m_left;
+  R m_right;
+
+  constexpr Vec3Binary(const L& left, const R& right)
+    : m_left(left), m_right(right)
+  {
+  }
+
+  template <int I>
+  constexpr double get() const
+  {
+    return Op::apply(m_left.template get<I>(), m_right.template get<I>());
+  }
+};
+
+/**Binary operation between an expression and a scalar.*/
+template <class E, class Op>
+struct Vec3Scalar : Vec3Expression<Vec3Scalar<E, Op>>
+{
+  E m_expr;
+  double m_value;
+
+  constexpr Vec3Scalar(const E& expr, double value)
+    : m_expr(expr), m_value(value)
+  {
+  }
+
+  template <int I>
+  constexpr double get() const
+  {
+    return Op::apply(m_expr.template get<I>(), m_value);
+  }
+};
+
+/**Component-wise negation.*/
+template <class E>
+struct Vec3Negate : Vec3Expression<Vec3Negate<E>>
+{
+  E m_expr;
+
+  constexpr explicit Vec3Negate(const E& expr) : m_expr(expr) {}
+
+  template <int I>
+  constexpr double get() const
+  {
+    return -m_expr.template get<I>();
+  }
+};
+
+// clang-format off
+struct Add { static constexpr double apply(double a, double b) { return a + b; } };
+struct Sub { static constexpr double apply(double a, double b) { return a - b; } };
+struct Mul { static constexpr double apply(double a, double b) { return a * b; } };
+struct Div { static constexpr double apply(double a, double b) { return a / b; } };
+// clang-format on
+
+/**Wraps a vector as the leaf of an expression.*/
+constexpr Vec3Ref lazy(const Vec3& vec) { return Vec3Ref(vec); }
+
+//=============================================== Operators
+template <class L, class R>
+constexpr Vec3Binary<L, R, Add> operator+(const Vec3Expression<L>& left,
+                                          const Vec3Expression<R>& right)
+{
+  return {left.self(), right.self()};
+}
+
+template <class L, class R>
+constexpr Vec3Binary<L, R, Sub> operator-(const Vec3Expression<L>& left,
+                                          const Vec3Expression<R>& right)
+{
+  return {left.self(), right.self()};
+}
+
+/**Component-wise multiplication, see Vec3::operator*(const Vec3&).*/
+template <class L, class R>
+constexpr Vec3Binary<L, R, Mul> operator*(const Vec3Expression<L>& left,
+                                          const Vec3Expression<R>& right)
+{
+  return {left.self(), right.self()};
+}
+
+template <class E>
+constexpr Vec3Scalar<E, Mul> operator*(const Vec3Expression<E>& expr,
+                                       double value)
+{
+  return {expr.self(), value};
+}
+
+template <class E>
+constexpr Vec3Scalar<E, Mul> operator*(double value,
+                                       const Vec3Expression<E>& expr)
+{
+  return {expr.self(), value};
+}
+
+template <class E>
+constexpr Vec3Scalar<E, Div> operator/(const Vec3Expression<E>& expr,
+                                       double value)
+{
+  return {expr.self(), value};
+}
+
+template <class E>
+constexpr Vec3Negate<E> operator-(const Vec3Expression<E>& expr)
+{
+  return Vec3Negate<E>(expr.self());
+}
+
+/**Explicit evaluation, handy where the target type cannot be deduced.*/
+template <class E>
+constexpr Vec3 evaluate(const Vec3Expression<E>& expr)
+{
+  return static_cast<Vec3>(expr);
+}
+
+} // namespace elke::math::expr
+
+#endif // ELK_MATH_VEC3EXPR_H
@@ -0,0 +1,65 @@
+#include "simd_dispatch.h"
+
+#include <atomic>
+
+namespace elke::math
+{
+
+namespace
+{
+std::atomic<int>& activeSetStorage()
+{
+  static std::atomic<int> active_set =
+    static_cast<int>(detectSIMDInstructionSet());
+  return active_set;
+}
+} // namespace
+
+// ###################################################################
+/**Returns the string name of an instruction set.*/
+std::string SIMDInstructionSetName(const SIMDInstructionSet instruction_set)
+{
+  switch (instruction_set)
+  {
+    case SIMDInstructionSet::AVX2:
+      return "AVX2";
+    case SIMDInstructionSet::SCALAR:
+    default:
+      return "SCALAR";
+  }
+}
+
+// ###################################################################
+/**Returns the widest instruction set supported by the running CPU.*/
+SIMDInstructionSet detectSIMDInstructionSet()
+{
+#ifdef ELKE_SIMD_AVX2_AVAILABLE
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  if (has_avx2) return SIMDInstructionSet::AVX2;
+#endif
+  return SIMDInstructionSet::SCALAR;
+}
+
+// ###################################################################
+/**Returns the instruction set used by the batch kernels.*/
+SIMDInstructionSet activeSIMDInstructionSet()
+{
+  return static_cast<SIMDInstructionSet>(
+    activeSetStorage().load(std::memory_order_relaxed));
+}
+
+// ###################################################################
+/**Overrides the instruction set used by the batch kernels.*/
+void setActiveSIMDInstructionSet(const SIMDInstructionSet instruction_set)
+{
+  const auto detected = detectSIMDInstructionSet();
+  const auto allowed = static_cast<int>(instruction_set) <=
+                           static_cast<int>(detected)
+                         ? instruction_set
+                         : detected;
+
+  activeSetStorage().store(static_cast<int>(allowed),
+                           std::memory_order_relaxed);
+}
+
+} // namespace elke::math
@@ -0,0 +1,39 @@
+#ifndef ELK_MATH_SIMD_DISPATCH_H
+#define ELK_MATH_SIMD_DISPATCH_H
+
+#include <string>
+
+/**AVX2 kernels are compiled with a per-function target attribute so that the
+ * rest of the library does not require `-mavx2`. The kernels are only called
+ * when the running CPU reports AVX2 support.*/
+#if defined(__x86_64__) and (defined(__GNUC__) or defined(__clang__))
+#define ELKE_SIMD_AVX2_AVAILABLE
+#define ELKE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace elke::math
+{
+
+enum class SIMDInstructionSet : int
+{
+  SCALAR = 0, ///< Portable scalar loops
+  AVX2 = 1    ///< 256-bit AVX2 kernels
+};
+
+/**Returns the string name of an instruction set.*/
+std::string SIMDInstructionSetName(SIMDInstructionSet instruction_set);
+
+/**Returns the widest instruction set supported by the running CPU.*/
+SIMDInstructionSet detectSIMDInstructionSet();
+
+/**Returns the instruction set used by the batch kernels. Defaults to the
+ * detected instruction set.*/
+SIMDInstructionSet activeSIMDInstructionSet();
+
+/**Overrides the instruction set used by the batch kernels, e.g. to compare
+ * paths. Requests for an unsupported set fall back to the detected one.*/
+void setActiveSIMDInstructionSet(SIMDInstructionSet instruction_set);
+
+} // namespace elke::math
+
+#endif // ELK_MATH_SIMD_DISPATCH_H
@@ -0,0 +1,31 @@
+#ifndef ELK_MATH_SIMD_KERNEL_UTILS_H
+#define ELK_MATH_SIMD_KERNEL_UTILS_H
+
+#include "simd_dispatch.h"
+
+#include "elke_core/output/elk_exceptions.h"
+
+#include <string>
+
+/**Helpers shared by the batch kernel translation units (Vec3Array.cc,
+ * TensorRank2Dim3Array.cc). Not part of the public math interface.*/
+namespace elke::math::simd_kernel_utils
+{
+
+/**Returns true if the batch kernels should take the AVX2 path.*/
+inline bool useAVX2()
+{
+  return activeSIMDInstructionSet() == SIMDInstructionSet::AVX2;
+}
+
+/**Throws an InvalidArgument if the operands of a kernel differ in size.*/
+inline void assertSameSize(const size_t a_size, const size_t b_size)
+{
+  elkInvalidArgumentIf(a_size != b_size,
+                       "Array size mismatch: " + std::to_string(a_size) +
+                         " vs " + std::to_string(b_size) + ".");
+}
+
+} // namespace elke::math::simd_kernel_utils
+
+#endif // ELK_MATH_SIMD_KERNEL_UTILS_H
@@ -0,0 +1,460 @@
+#include "ParameterDiagnostics.h"
+
+#include "elke_core/data_types/DataTree.h"
+#include "elke_core/data_types/DataTreeDedup.h"
+
+#include <sstream>
+
+namespace elke
+{
+
+namespace
+{
+
+/**Writes `text` as a quoted JSON string.*/
+void writeJSONString(std::ostream& out, const std::string_view text)
+{
+  static const char* const HEX_DIGITS = "0123456789abcdef";
+
+  out << '"';
+  for (const char c : text)
+  {
+    switch (c)
+    {
+      // clang-format off
+      case '"':  out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\r': out << "\\r"; break;
+      case '\t': out << "\\t"; break;
+      // clang-format on
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+          out << "\\u00" << HEX_DIGITS[(c >> 4) & 0xF] << HEX_DIGITS[c & 0xF];
+        else
+          out << c;
+    }
+  }
+  out << '"';
+}
+
+/**Returns `text` without leading spaces and trailing newlines.*/
+std::string_view trimMessage(std::string_view text)
+{
+  const size_t begin = text.find_first_not_of(' ');
+  if (begin == std::string_view::npos) return {};
+  text.remove_prefix(begin);
+  while (not text.empty() and text.back() == '\n')
+    text.remove_suffix(1);
+  return text;
+}
+
+} // namespace
+
+// ###################################################################
+/**Generates the string equivalent of a diagnostic code.*/
+// ReSharper disable once CppNotAllPathsReturnValue
+std::string DiagnosticCodeName(const DiagnosticCode code)
+{
+  switch (code)
+  {
+      // clang-format off
+    case DiagnosticCode::INVALID_PARAMETER_NAME:     return "INVALID_PARAMETER_NAME";
+    case DiagnosticCode::REQUIRED_PARAMETER_MISSING: return "REQUIRED_PARAMETER_MISSING";
+    case DiagnosticCode::DEPRECATED_PARAMETER:       return "DEPRECATED_PARAMETER";
+    case DiagnosticCode::GROSS_TYPE_MISMATCH:        return "GROSS_TYPE_MISMATCH";
+    case DiagnosticCode::SCALAR_TYPE_MISMATCH:       return "SCALAR_TYPE_MISMATCH";
+    case DiagnosticCode::SCALAR_TYPE_INCOMPATIBLE:   return "SCALAR_TYPE_INCOMPATIBLE";
+    case DiagnosticCode::ARRAY_ENTRY_NOT_SCALAR:     return "ARRAY_ENTRY_NOT_SCALAR";
+    case DiagnosticCode::ARRAY_ENTRY_TYPE_MISMATCH:  return "ARRAY_ENTRY_TYPE_MISMATCH";
+    case DiagnosticCode::ARRAY_SIZE_MISMATCH:        return "ARRAY_SIZE_MISMATCH";
+    case DiagnosticCode::ADDITIONAL_CHECKS_SKIPPED:  return "ADDITIONAL_CHECKS_SKIPPED";
+    case DiagnosticCode::CUSTOM:                     return "CUSTOM";
+    case DiagnosticCode::ARRAY_SIZE_OUT_OF_BOUNDS:   return "ARRAY_SIZE_OUT_OF_BOUNDS";
+    case DiagnosticCode::VALUE_CHECK_FAILED:         return "VALUE_CHECK_FAILED";
+      // clang-format on
+  }
+}
+
+// ###################################################################
+void ParameterDiagnostics::setMaxDiagnostics(const size_t max_diagnostics)
+{
+  m_max_diagnostics = max_diagnostics;
+}
+
+// ###################################################################
+void ParameterDiagnostics::setMarkTable(const DataTreeMarkTable* marks)
+{
+  m_marks = marks;
+}
+
+// ###################################################################
+const DataTreeMarkTable* ParameterDiagnostics::markTable() const
+{
+  return m_marks;
+}
+
+// ###################################################################
+void ParameterDiagnostics::beginGroup(const std::string_view block_name,
+                                      const ParameterValidationContext& context,
+                                      const DataTree& data)
+{
+  const size_t location = storeLocation(context, data);
+  m_groups.push_back({block_name, &data, m_current_group, location});
+  m_current_group = m_groups.size() - 1;
+}
+
+// ###################################################################
+void ParameterDiagnostics::endGroup()
+{
+  if (m_current_group != Diagnostic::NO_GROUP)
+    m_current_group = m_groups[m_current_group].m_parent;
+}
+
+// ###################################################################
+Diagnostic& ParameterDiagnostics::add(const DiagnosticSeverity severity,
+                                      const DiagnosticCode code,
+                                      const ParameterValidationContext& context,
+                                      const std::string_view name,
+                                      const DataTree& data)
+{
+  const bool is_error = severity == DiagnosticSeverity::ERROR;
+  ++(is_error ? m_num_errors : m_num_warnings);
+
+  Diagnostic* diagnostic_ptr = &m_dropped;
+  if (m_diagnostics.size() < m_max_diagnostics)
+    diagnostic_ptr = &m_diagnostics.emplace_back();
+  else
+    ++(is_error ? m_num_dropped_errors : m_num_dropped_warnings);
+
+  auto& diagnostic = *diagnostic_ptr;
+  diagnostic = Diagnostic();
+  diagnostic.m_code = code;
+  diagnostic.m_severity = severity;
+  diagnostic.m_nest_depth = context.nestDepth();
+  diagnostic.m_group = m_current_group;
+  diagnostic.m_name = name;
+  diagnostic.m_data = &data;
+  if (diagnostic_ptr != &m_dropped)
+    diagnostic.m_location = storeLocation(context, data);
+
+  return diagnostic;
+}
+
+// ###################################################################
+void ParameterDiagnostics::addInvalidName(
+  const ParameterValidationContext& context,
+  const DataTree& data,
+  std::string suggestion)
+{
+  auto& diagnostic = add(DiagnosticSeverity::ERROR,
+                         DiagnosticCode::INVALID_PARAMETER_NAME,
+                         context,
+                         data.name(),
+                         data);
+  if (&diagnostic == &m_dropped) return;
+
+  diagnostic.m_index = m_strings.size();
+  m_strings.push_back(std::move(suggestion));
+}
+
+// ###################################################################
+void ParameterDiagnostics::addMessage(const DiagnosticSeverity severity,
+                                      std::string message)
+{
+  const bool is_error = severity == DiagnosticSeverity::ERROR;
+  ++(is_error ? m_num_errors : m_num_warnings);
+
+  if (m_diagnostics.size() >= m_max_diagnostics)
+  {
+    ++(is_error ? m_num_dropped_errors : m_num_dropped_warnings);
+    return;
+  }
+
+  auto& diagnostic = m_diagnostics.emplace_back();
+  diagnostic.m_code = DiagnosticCode::CUSTOM;
+  diagnostic.m_severity = severity;
+  diagnostic.m_group = m_current_group;
+  diagnostic.m_index = m_strings.size();
+  m_strings.push_back(std::move(message));
+}
+
+// ###################################################################
+const std::vector<Diagnostic>& ParameterDiagnostics::diagnostics() const
+{
+  return m_diagnostics;
+}
+
+bool ParameterDiagnostics::hasErrors() const { return m_num_errors > 0; }
+bool ParameterDiagnostics::hasWarnings() const { return m_num_warnings > 0; }
+size_t ParameterDiagnostics::numErrors() const { return m_num_errors; }
+size_t ParameterDiagnostics::numWarnings() const { return m_num_warnings; }
+
+// ###################################################################
+/**Formats the message of a diagnostic, without indentation.*/
+std::string
+ParameterDiagnostics::formatMessage(const Diagnostic& diagnostic) const
+{
+  const auto& d = diagnostic;
+  const auto expected_gross_type = DataGrossTypeName(d.m_expected_gross_type);
+  const auto expected_scalar_type =
+    scalarTypeStringName(d.m_expected_scalar_type);
+  const std::string name(d.m_name);
+
+  std::stringstream message;
+  // clang-format off
+  switch (d.m_code)
+  {
+    case DiagnosticCode::INVALID_PARAMETER_NAME:
+    {
+      const auto& suggestion = m_strings[d.m_index];
+      message << "The parameter name \"" << name << "\" is invalid.";
+      if (suggestion.empty())
+        message << " No suggested parameter name could be determined.";
+      else
+        message << " Did you mean \"" << suggestion << "\"?";
+      break;
+    }
+    case DiagnosticCode::REQUIRED_PARAMETER_MISSING:
+      message << "Required parameter \"" << name << "\" not supplied.";
+      break;
+    case DiagnosticCode::DEPRECATED_PARAMETER:
+      message << "Parameter \"" << name << "\" is deprecated.";
+      break;
+    case DiagnosticCode::GROSS_TYPE_MISMATCH:
+      message
+        << "Item \"" << name << "\" is required to be of gross-type "
+        << expected_gross_type << ". Supplied gross-type is "
+        << DataGrossTypeName(d.m_data->grossType()) << ".";
+      break;
+    case DiagnosticCode::SCALAR_TYPE_MISMATCH:
+      message
+        << "Item \"" << name << "\" is required to be of specific scalar-type "
+        << expected_scalar_type << ". Supplied scalar-type is "
+        << scalarTypeStringName(d.m_data->value().type()) << " with value "
+        << d.m_data->value().convertToString() << ".";
+      break;
+    case DiagnosticCode::SCALAR_TYPE_INCOMPATIBLE:
+      message
+        << "Item \"" << name << "\" is required to be of scalar-type "
+        << expected_scalar_type << ". Supplied scalar-type is "
+        << scalarTypeStringName(d.m_data->value().type()) << " with value "
+        << d.m_data->value().convertToString() << " which is not compatible with "
+        << "scalar-type " << expected_scalar_type << ".";
+      break;
+    case DiagnosticCode::ARRAY_ENTRY_NOT_SCALAR:
+      message
+        << "Array entry " << d.m_index << " is required to be of gross-type SCALAR. Supplied gross-type is "
+        << DataGrossTypeName(d.m_data->grossType()) << ".";
+      break;
+    case DiagnosticCode::ARRAY_ENTRY_TYPE_MISMATCH:
+      message
+        << "Array entry " << d.m_index << " is required to be of specific scalar-type "
+        << expected_scalar_type << ". Supplied scalar-type is "
+        << scalarTypeStringName(d.m_data->value().type()) << " with value "
+        << d.m_data->value().convertToString() << ".";
+      break;
+    case DiagnosticCode::ARRAY_SIZE_MISMATCH:
+      message
+        << "Item \"" << name << "\" is required to be an array "
+        << "of size " << d.m_index << " but the data provided has "
+        << d.m_data->numChildren() << " entries.";
+      break;
+    case DiagnosticCode::ADDITIONAL_CHECKS_SKIPPED:
+      message << "Additional checks skipped.";
+      break;
+    case DiagnosticCode::CUSTOM:
+      message << m_strings[d.m_index];
+      break;
+    case DiagnosticCode::ARRAY_SIZE_OUT_OF_BOUNDS:
+      message
+        << "Item \"" << name << "\" is required to have " << d.m_requirement
+        << " entries but the data provided has " << d.m_data->numChildren()
+        << " entries.";
+      break;
+    case DiagnosticCode::VALUE_CHECK_FAILED:
+      if (d.m_index == Diagnostic::NO_INDEX)
+        message << "Item \"" << name << "\"";
+      else
+        message << "Array entry " << d.m_index << " of item \"" << name << "\"";
+      message
+        << " with value " << d.m_data->value().convertToString()
+        << " is required to be " << d.m_requirement << ".";
+      break;
+  }
+  // clang-format on
+
+  return message.str();
+}
+
+// ###################################################################
+size_t
+ParameterDiagnostics::storeLocation(const ParameterValidationContext& context,
+                                    const DataTree& data)
+{
+  if (not context.tracksLocations()) return Diagnostic::NO_LOCATION;
+
+  const DataTree* parent = context.data();
+  std::string address;
+  if (&data == parent)
+    address = context.address();
+  else if (parent == nullptr)
+    return Diagnostic::NO_LOCATION;
+  else if (parent->grossType() == DataGrossType::SEQUENCE)
+  {
+    // Entries are usually reported in order, so the search starts after
+    // the last entry located.
+    const size_t num_entries = parent->numChildren();
+    if (parent != m_last_sequence or m_next_entry >= num_entries)
+      m_next_entry = 0;
+    m_last_sequence = parent;
+
+    size_t position = num_entries;
+    for (size_t k = 0; k < num_entries and position == num_entries; ++k)
+    {
+      const size_t i = (m_next_entry + k) % num_entries;
+      if (&parent->childAt(i) == &data) position = i;
+    }
+    if (position == num_entries) return Diagnostic::NO_LOCATION;
+    m_next_entry = position + 1;
+    address = context.address() + "/" + std::to_string(position);
+  }
+  else
+  {
+    bool is_child = false;
+    parent->forEachChildNamed(
+      data.name(),
+      [&](const DataTree& child) { is_child = is_child or &child == &data; });
+    if (not is_child) return Diagnostic::NO_LOCATION;
+    address = context.address() + "/" + data.name();
+  }
+
+  m_strings.push_back(std::move(address));
+  return m_strings.size() - 1;
+}
+
+// ###################################################################
+std::string ParameterDiagnostics::addressOf(const DataTree& data,
+                                            const size_t location) const
+{
+  if (location == Diagnostic::NO_LOCATION) return data.getTag("address");
+  return m_strings[location];
+}
+
+// ###################################################################
+std::string ParameterDiagnostics::markOf(const DataTree& data,
+                                         const std::string& address) const
+{
+  if (m_marks == nullptr) return data.getTag("mark");
+  return m_marks->markOf(data, address);
+}
+
+// ###################################################################
+/**Writes the header of a group.*/
+void ParameterDiagnostics::writeGroupHeader(std::ostream& out,
+                                            const Group& group) const
+{
+  const auto& data = *group.m_data;
+  const auto address = addressOf(data, group.m_location);
+  // clang-format off
+  out << "While checking input parameter validity for block "
+         "\"" << group.m_block_name << "\" from data-tree \"" << address << "\""
+         " parsed from " << markOf(data, address) << ":\n";
+  // clang-format on
+}
+
+// ###################################################################
+void ParameterDiagnostics::writeText(std::ostream& out,
+                                     const DiagnosticSeverity severity) const
+{
+  std::vector<bool> header_written(m_groups.size(), false);
+  std::vector<size_t> pending_headers;
+
+  for (const auto& diagnostic : m_diagnostics)
+  {
+    if (diagnostic.m_severity != severity) continue;
+
+    //============================== Headers of the group and its parents
+    pending_headers.clear();
+    for (size_t g = diagnostic.m_group;
+         g != Diagnostic::NO_GROUP and not header_written[g];
+         g = m_groups[g].m_parent)
+      pending_headers.push_back(g);
+    for (auto it = pending_headers.rbegin(); it != pending_headers.rend(); ++it)
+    {
+      writeGroupHeader(out, m_groups[*it]);
+      header_written[*it] = true;
+    }
+
+    //============================== The message
+    if (diagnostic.m_code == DiagnosticCode::CUSTOM)
+      out << m_strings[diagnostic.m_index];
+    else
+      out << std::string((diagnostic.m_nest_depth + 1) * 2, ' ')
+          << formatMessage(diagnostic) << "\n";
+  }
+
+  const bool errors = severity == DiagnosticSeverity::ERROR;
+  const size_t num_dropped =
+    errors ? m_num_dropped_errors : m_num_dropped_warnings;
+  if (num_dropped > 0)
+    out << "  ... and " << num_dropped << " more "
+        << (errors ? "error(s)" : "warning(s)") << " not shown.\n";
+}
+
+// ###################################################################
+void ParameterDiagnostics::writeJSON(std::ostream& out) const
+{
+  out << "{\n  \"num_errors\": " << m_num_errors
+      << ",\n  \"num_warnings\": " << m_num_warnings
+      << ",\n  \"diagnostics\": [";
+
+  bool first = true;
+  for (const auto& diagnostic : m_diagnostics)
+  {
+    const bool is_error = diagnostic.m_severity == DiagnosticSeverity::ERROR;
+    const auto* data_ptr = diagnostic.m_data;
+    const std::string block =
+      diagnostic.m_group == Diagnostic::NO_GROUP
+        ? std::string()
+        : std::string(m_groups[diagnostic.m_group].m_block_name);
+
+    out << (first ? "\n" : ",\n") << "    {\"severity\": "
+        << (is_error ? "\"error\"" : "\"warning\"") << ", \"code\": ";
+    writeJSONString(out, DiagnosticCodeName(diagnostic.m_code));
+    out << ", \"block\": ";
+    writeJSONString(out, block);
+    out << ", \"parameter\": ";
+    writeJSONString(out, diagnostic.m_name);
+    const std::string address =
+      data_ptr ? addressOf(*data_ptr, diagnostic.m_location) : "";
+    out << ", \"address\": ";
+    writeJSONString(out, address);
+    out << ", \"mark\": ";
+    writeJSONString(out, data_ptr ? markOf(*data_ptr, address) : "");
+    out << ", \"message\": ";
+    writeJSONString(out, trimMessage(formatMessage(diagnostic)));
+    out << "}";
+    first = false;
+  }
+
+  out << (first ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+// ###################################################################
+std::string ParameterDiagnostics::errorsAsString() const
+{
+  std::stringstream out;
+  writeText(out, DiagnosticSeverity::ERROR);
+  return out.str();
+}
+
+// ###################################################################
+std::string ParameterDiagnostics::warningsAsString() const
+{
+  std::stringstream out;
+  writeText(out, DiagnosticSeverity::WARNING);
+  return out.str();
+}
+
+} // namespace elke
@@ -0,0 +1,224 @@
+#ifndef ELK_E_PARAMETERDIAGNOSTICS_H
+#define ELK_E_PARAMETERDIAGNOSTICS_H
+
+#include "ParameterValidationContext.h"
+#include "elke_core/data_types/DataGrossType.h"
+#include "elke_core/data_types/ScalarValue.h"
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace elke
+{
+
+class DataTree;
+class DataTreeMarkTable;
+
+/**What a diagnostic is about. Each code has one message, formatted from the
+ * fields of the Diagnostic when it is printed.*/
+enum class DiagnosticCode : int
+{
+  INVALID_PARAMETER_NAME = 0,     ///< The block has no parameter of the name
+  REQUIRED_PARAMETER_MISSING = 1, ///< m_name is the missing parameter
+  DEPRECATED_PARAMETER = 2,       ///< m_name is the deprecated parameter
+  GROSS_TYPE_MISMATCH = 3,        ///< Expects m_expected_gross_type
+  SCALAR_TYPE_MISMATCH = 4,       ///< Must match m_expected_scalar_type
+  SCALAR_TYPE_INCOMPATIBLE = 5,   ///< Not convertible to the expected type
+  ARRAY_ENTRY_NOT_SCALAR = 6,     ///< Entry m_index is not a SCALAR
+  ARRAY_ENTRY_TYPE_MISMATCH = 7,  ///< Entry m_index must match exactly
+  ARRAY_SIZE_MISMATCH = 8,        ///< Expects m_index entries
+  ADDITIONAL_CHECKS_SKIPPED = 9,  ///< A check stopped the remaining ones
+  CUSTOM = 10,                    ///< A message formatted by the check itself
+  ARRAY_SIZE_OUT_OF_BOUNDS = 11,  ///< Expects m_requirement entries
+  VALUE_CHECK_FAILED = 12         ///< Entry m_index must be m_requirement
+};
+
+/**Generates the string equivalent of a diagnostic code.*/
+std::string DiagnosticCodeName(DiagnosticCode code);
+
+enum class DiagnosticSeverity : int
+{
+  WARNING = 0,
+  ERROR = 1
+};
+
+/**A single finding from checking a DataTree against a ParameterTree. It
+ * refers to the data and names involved instead of holding a message, which
+ * is only formatted when printed.*/
+struct Diagnostic
+{
+  static constexpr size_t NO_GROUP = std::numeric_limits<size_t>::max();
+  /// m_index of a VALUE_CHECK_FAILED about a scalar, not an array entry.
+  static constexpr size_t NO_INDEX = std::numeric_limits<size_t>::max();
+  /// m_location when the data's own tags locate it.
+  static constexpr size_t NO_LOCATION = std::numeric_limits<size_t>::max();
+
+  DiagnosticCode m_code = DiagnosticCode::CUSTOM;
+  DiagnosticSeverity m_severity = DiagnosticSeverity::ERROR;
+  DataGrossType m_expected_gross_type = DataGrossType::NO_DATA;
+  ScalarType m_expected_scalar_type = ScalarType::VOID;
+  /// Nest depth of the check that made it, for indentation.
+  size_t m_nest_depth = 0;
+  /// Block being checked, see ParameterDiagnostics::beginGroup.
+  size_t m_group = NO_GROUP;
+  /// Parameter name, or the invalid name for INVALID_PARAMETER_NAME.
+  std::string_view m_name;
+  /// The data the finding is about.
+  const DataTree* m_data = nullptr;
+  /// Array entry, expected array size, or index of a stored string (the
+  /// suggestion for INVALID_PARAMETER_NAME, the message for CUSTOM).
+  size_t m_index = 0;
+  /// What a built-in check requires, e.g., "within [0, 1]", held by the
+  /// check.
+  std::string_view m_requirement;
+  /// Index of the stored address of m_data, see ParameterDiagnostics'
+  /// locations.
+  size_t m_location = NO_LOCATION;
+};
+
+// ###################################################################
+/**Collects the diagnostics from checking input data against a
+ * ParameterTree. The checks only record what they found; messages are
+ * formatted by `writeText`, `writeJSON`, `errorsAsString`, etc. Since the
+ * records refer to the checked DataTree and to the names held by the
+ * ParameterTree, both must outlive the diagnostics, or at least their
+ * printing.
+ *
+ * Grouping:\n
+ * Each specification block opens a group with `beginGroup`. When printed,
+ * a group's header ("While checking input parameter validity for block
+ * ...") is written once, before the first of its diagnostics, or those of
+ * the groups nested in it.
+ *
+ * Capping:\n
+ * With `setMaxDiagnostics`, diagnostics past the limit are only counted.
+ * The count is printed after the stored diagnostics.
+ *
+ * Locations:\n
+ * The address and mark printed for a diagnostic are the data's own tags,
+ * unless a mark table is set with `setMarkTable`. The data may then be
+ * deduplicated (see deduplicateDataTree), a node shared by several
+ * occurrences carrying the tags of the first. The checks then track the
+ * address of the occurrence being checked (see
+ * ParameterValidationContext::trackLocations), which is stored with each
+ * diagnostic and group, and the mark is looked up in the table by that
+ * address.
+ */
+class ParameterDiagnostics
+{
+  struct Group
+  {
+    std::string_view m_block_name;
+    const DataTree* m_data = nullptr;
+    size_t m_parent = Diagnostic::NO_GROUP;
+    size_t m_location = Diagnostic::NO_LOCATION;
+  };
+
+  std::vector<Diagnostic> m_diagnostics;
+  std::vector<Group> m_groups;
+  /// Suggestions, custom messages and addresses, see Diagnostic::m_index
+  /// and Diagnostic::m_location.
+  std::vector<std::string> m_strings;
+  const DataTreeMarkTable* m_marks = nullptr;
+  /// Sequence an entry was last located in and the position after that
+  /// entry, where storeLocation looks for the next one.
+  const DataTree* m_last_sequence = nullptr;
+  size_t m_next_entry = 0;
+  size_t m_current_group = Diagnostic::NO_GROUP;
+  size_t m_max_diagnostics = std::numeric_limits<size_t>::max();
+  size_t m_num_errors = 0;
+  size_t m_num_warnings = 0;
+  size_t m_num_dropped_errors = 0;
+  size_t m_num_dropped_warnings = 0;
+  /// Receives the fields of dropped diagnostics.
+  Diagnostic m_dropped;
+
+public:
+  ParameterDiagnostics() = default;
+
+  /**Limits the number of stored diagnostics. Those past the limit are
+   * counted but not stored.*/
+  void setMaxDiagnostics(size_t max_diagnostics);
+
+  /**Sets the marks of the deduplicated nodes of the data to be checked,
+   * see the notes on locations. The table must outlive the printing.*/
+  void setMarkTable(const DataTreeMarkTable* marks);
+  /**Returns the mark table, or nullptr.*/
+  const DataTreeMarkTable* markTable() const;
+
+  /**Opens a group for the checks of a specification block. Groups nest.*/
+  void beginGroup(std::string_view block_name,
+                  const ParameterValidationContext& context,
+                  const DataTree& data);
+  /**Closes the group opened last.*/
+  void endGroup();
+
+  /**Adds a diagnostic and returns it, to fill the fields its code uses. If
+   * the limit is reached, the returned diagnostic is discarded.*/
+  Diagnostic& add(DiagnosticSeverity severity,
+                  DiagnosticCode code,
+                  const ParameterValidationContext& context,
+                  std::string_view name,
+                  const DataTree& data);
+
+  /**Adds an INVALID_PARAMETER_NAME error with the suggested name, which may
+   * be empty.*/
+  void addInvalidName(const ParameterValidationContext& context,
+                      const DataTree& data,
+                      std::string suggestion);
+
+  /**Adds a message formatted by the caller, for checks without a code of
+   * their own. The message is printed as is, and should include the
+   * indentation (ParameterValidationContext::indent) and end with a newline.*/
+  void addMessage(DiagnosticSeverity severity, std::string message);
+
+  /**Returns the stored diagnostics, in the order they were added.*/
+  const std::vector<Diagnostic>& diagnostics() const;
+
+  bool hasErrors() const;
+  bool hasWarnings() const;
+  /**Number of errors, including dropped ones.*/
+  size_t numErrors() const;
+  /**Number of warnings, including dropped ones.*/
+  size_t numWarnings() const;
+
+  /**Formats the message of a diagnostic, without indentation.*/
+  std::string formatMessage(const Diagnostic& diagnostic) const;
+
+  /**Writes the diagnostics of one severity as indented text, under the
+   * headers of their groups.*/
+  void writeText(std::ostream& out, DiagnosticSeverity severity) const;
+
+  /**Writes all diagnostics as a JSON object holding the counts and a list
+   * of records with the severity, code, parameter name, data address, file
+   * mark and message.*/
+  void writeJSON(std::ostream& out) const;
+
+  /**Shorthand for writeText to a string, for errors.*/
+  std::string errorsAsString() const;
+  /**Shorthand for writeText to a string, for warnings.*/
+  std::string warningsAsString() const;
+
+private:
+  /**Stores the address of `data`, which is the data being checked or one
+   * of its children, if the context tracks locations. Returns its index,
+   * or Diagnostic::NO_LOCATION. Sequence entries are addressed by their
+   * position, like DataTree::addChild does.*/
+  size_t storeLocation(const ParameterValidationContext& context,
+                       const DataTree& data);
+  /**Returns the address of `data`, stored at `location`.*/
+  std::string addressOf(const DataTree& data, size_t location) const;
+  /**Returns the mark of `data`, found at `address`.*/
+  std::string markOf(const DataTree& data, const std::string& address) const;
+
+  /**Writes the header of a group.*/
+  void writeGroupHeader(std::ostream& out, const Group& group) const;
+};
+
+} // namespace elke
+
+#endif // ELK_E_PARAMETERDIAGNOSTICS_H
@@ -0,0 +1,445 @@
+#include "ParameterProgram.h"
+
+#include "elke_core/output/elk_exceptions.h"
+#include "elke_core/utilities/hash_utils.h"
+
+namespace elke
+{
+
+namespace
+{
+using Opcode = ParameterProgram::Opcode;
+
+/**Picks the opcode of a scalar or array of scalars by its assignment.*/
+Opcode selectOpcode(const param_options::ScalarAssignment assignment,
+                    const Opcode any,
+                    const Opcode exact,
+                    const Opcode compatible)
+{
+  switch (assignment)
+  {
+      // clang-format off
+    case param_options::ScalarAssignment::MUST_MATCH_EXACTLY: return exact;
+    case param_options::ScalarAssignment::MUST_BE_COMPATIBLE: return compatible;
+    case param_options::ScalarAssignment::CAN_BE_ANYTHING:    return any;
+      // clang-format on
+  }
+  return any;
+}
+
+/**Returns the bits `1 << ScalarType` of the scalar types whose values all
+ * convert to `target`, as decided by ScalarValue::isConvertibleToType.
+ * Whether a string converts to a number or a boolean depends on the
+ * string, and whether a float converts to an integer on its value, so only
+ * the string to string conversion is included and floats are left out for
+ * integers.*/
+uint8_t alwaysConvertibleTypes(const ScalarType target)
+{
+  uint8_t bits = 0;
+  for (const auto& value : {ScalarValue(),
+                            ScalarValue(false),
+                            ScalarValue(static_cast<int64_t>(0)),
+                            ScalarValue(0.0)})
+    if (value.isConvertibleToType(target) and
+        not(value.type() == ScalarType::FLOAT and
+            target == ScalarType::INTEGER))
+      bits |= static_cast<uint8_t>(1u << static_cast<int>(value.type()));
+
+  if (target == ScalarType::STRING)
+    bits |= static_cast<uint8_t>(1u << static_cast<int>(ScalarType::STRING));
+
+  return bits;
+}
+} // namespace
+
+// ###################################################################
+ParameterProgram::ParameterProgram(const ParameterTree& specification)
+{
+  elkLogicalErrorIf(not specification.m_is_a_specification_map,
+                    "ParameterProgram: \"" + specification.name() +
+                      "\" is not a specification map.");
+
+  Instruction block;
+  block.m_opcode = Opcode::BLOCK;
+  block.m_gross_type = DataGrossType::MAP;
+  block.m_label = specification.label();
+  block.m_has_additional_checks =
+    not specification.m_additional_input_checks.empty();
+  block.m_name = specification.name();
+  block.m_parameter = &specification;
+  m_instructions.push_back(block);
+
+  compileBlock(0);
+}
+
+// ###################################################################
+/**Returns the compiled instructions.*/
+const std::vector<ParameterProgram::Instruction>&
+ParameterProgram::instructions() const
+{
+  return m_instructions;
+}
+
+// ###################################################################
+/**Compiles the children of the block at `block_index`, then the blocks
+ * among them, so that the children of every block are contiguous.*/
+void ParameterProgram::compileBlock(const uint32_t block_index)
+{
+  const ParameterTree& block = *m_instructions[block_index].m_parameter;
+
+  const auto first_child = static_cast<uint32_t>(m_instructions.size());
+  for (const auto& parameter : block.constIterableParameters())
+    m_instructions.push_back(compileParameter(parameter));
+  const auto num_children =
+    static_cast<uint32_t>(m_instructions.size()) - first_child;
+
+  //=================================== Name table, a power of two at most
+  //                                    half full so that probes stay short
+  uint32_t num_slots = 1;
+  while (num_slots < 2 * num_children)
+    num_slots *= 2;
+  const uint32_t slot_mask = num_slots - 1;
+  const auto first_slot = static_cast<uint32_t>(m_name_slots.size());
+  m_name_slots.resize(m_name_slots.size() + num_slots);
+
+  for (uint32_t i = first_child; i < first_child + num_children; ++i)
+  {
+    const uint64_t hash = hash_utils::fnv1a64(m_instructions[i].m_name);
+    auto slot = static_cast<uint32_t>(hash) & slot_mask;
+    while (m_name_slots[first_slot + slot].m_instruction != NO_INSTRUCTION)
+      slot = (slot + 1) & slot_mask;
+    m_name_slots[first_slot + slot] = {hash, i};
+  }
+
+  auto& instruction = m_instructions[block_index];
+  instruction.m_first_child = first_child;
+  instruction.m_num_children = num_children;
+  instruction.m_first_slot = first_slot;
+  instruction.m_slot_mask = slot_mask;
+
+  for (uint32_t i = first_child; i < first_child + num_children; ++i)
+    if (m_instructions[i].m_opcode == Opcode::BLOCK) compileBlock(i);
+}
+
+// ###################################################################
+/**Sets the opcode and types of a parameter, following the switches of
+ * ParameterTree::checkAndAssignData.*/
+ParameterProgram::Instruction
+ParameterProgram::compileParameter(const ParameterTree& parameter)
+{
+  Instruction instruction;
+  instruction.m_gross_type = parameter.m_gross_type;
+  instruction.m_label = parameter.label();
+  instruction.m_has_additional_checks =
+    not parameter.m_additional_input_checks.empty();
+  instruction.m_name = parameter.name();
+  instruction.m_parameter = &parameter;
+
+  const auto& meta_data = parameter.m_meta_data;
+  switch (parameter.m_gross_type)
+  {
+    case DataGrossType::SCALAR:
+    {
+      const auto& options = meta_data.m_scalar_options;
+      instruction.m_opcode = selectOpcode(options.m_scalar_assignment,
+                                          Opcode::SCALAR,
+                                          Opcode::SCALAR_EXACT,
+                                          Opcode::SCALAR_COMPATIBLE);
+      instruction.m_scalar_type = options.m_scalar_type;
+      instruction.m_integer_range = options.m_integer_range;
+      break;
+    }
+    case DataGrossType::SEQUENCE:
+    {
+      const auto& array_options = meta_data.m_array_options;
+      const auto& options = array_options.m_array_of_scalar_options;
+      if (array_options.m_nature == param_options::ArrayNature::SCALARS)
+      {
+        instruction.m_opcode = selectOpcode(options.m_scalar_assignment,
+                                            Opcode::SCALAR_ARRAY,
+                                            Opcode::SCALAR_ARRAY_EXACT,
+                                            Opcode::SCALAR_ARRAY_COMPATIBLE);
+        instruction.m_scalar_type = options.m_scalar_type;
+        instruction.m_integer_range = options.m_integer_range;
+      }
+      else if (array_options.m_nature == param_options::ArrayNature::ARBITRARY)
+        instruction.m_opcode = Opcode::GROSS_TYPE_ONLY;
+      break;
+    }
+    case DataGrossType::MAP:
+      instruction.m_opcode = parameter.m_is_a_specification_map
+                               ? Opcode::BLOCK
+                               : Opcode::GROSS_TYPE_ONLY;
+      break;
+    default:
+      break;
+  }
+
+  if (not instruction.m_integer_range.isNarrowed())
+    instruction.m_convertible_types =
+      alwaysConvertibleTypes(instruction.m_scalar_type);
+  if (instruction.m_opcode == Opcode::NO_CHECKS)
+    instruction.m_has_additional_checks = false;
+
+  return instruction;
+}
+
+// ###################################################################
+/**Returns the child of a block with the given name, or NO_INSTRUCTION.*/
+uint32_t ParameterProgram::findChild(const Instruction& block,
+                                     const std::string_view name) const
+{
+  const uint64_t hash = hash_utils::fnv1a64(name);
+  auto slot = static_cast<uint32_t>(hash) & block.m_slot_mask;
+  while (true)
+  {
+    const auto& entry = m_name_slots[block.m_first_slot + slot];
+    if (entry.m_instruction == NO_INSTRUCTION) return NO_INSTRUCTION;
+    if (entry.m_hash == hash and m_instructions[entry.m_instruction].m_name == name)
+      return entry.m_instruction;
+    slot = (slot + 1) & block.m_slot_mask;
+  }
+}
+
+// ###################################################################
+void ParameterProgram::validate(ParameterDiagnostics& diagnostics,
+                                const DataTree& data) const
+{
+  ParameterValidationContext context(/*assignment_flag=*/false);
+  if (diagnostics.markTable() != nullptr) context.trackLocations(data);
+  Scratch scratch;
+  scratch.m_first_data.assign(m_instructions.size(), nullptr);
+
+  runBlock(0, diagnostics, data, context, scratch);
+}
+
+// ###################################################################
+/**Checks a block, see ParameterTree::processSpecification.*/
+void ParameterProgram::runBlock(const uint32_t block_index,
+                                ParameterDiagnostics& diagnostics,
+                                const DataTree& data,
+                                ParameterValidationContext& context,
+                                Scratch& scratch) const
+{
+  const auto& block = m_instructions[block_index];
+  diagnostics.beginGroup(block.m_name, context, data);
+
+  //=================================== Look up each data child once. Nested
+  //                                    blocks push their matches after ours.
+  auto& matches = scratch.m_matches;
+  const size_t first_match = matches.size();
+  bool has_invalid_names = false;
+  data.forEachChild(
+    [&](const DataTree& child)
+    {
+      const uint32_t match = findChild(block, child.name());
+      matches.push_back(match);
+      if (match == NO_INSTRUCTION)
+        has_invalid_names = true;
+      else if (scratch.m_first_data[match] == nullptr)
+        scratch.m_first_data[match] = &child;
+    });
+
+  //=================================== Invalid names, with suggestions
+  if (has_invalid_names)
+  {
+    const auto name_index = block.m_parameter->parameterNameIndex();
+    size_t match = first_match;
+    data.forEachChild(
+      [&](const DataTree& child)
+      {
+        if (matches[match++] == NO_INSTRUCTION)
+          diagnostics.addInvalidName(
+            context, child, name_index->findClosest(child.name()));
+      });
+  }
+
+  //=================================== Required and deprecated parameters
+  const uint32_t end_child = block.m_first_child + block.m_num_children;
+  for (uint32_t i = block.m_first_child; i < end_child; ++i)
+  {
+    const auto& parameter = m_instructions[i];
+    const DataTree* first_data = scratch.m_first_data[i];
+    if (parameter.m_label == ParameterLabel::REQUIRED and first_data == nullptr)
+      diagnostics.add(DiagnosticSeverity::ERROR,
+                      DiagnosticCode::REQUIRED_PARAMETER_MISSING,
+                      context,
+                      parameter.m_name,
+                      data);
+    if (parameter.m_label == ParameterLabel::DEPRECATED and first_data != nullptr)
+      diagnostics.add(DiagnosticSeverity::WARNING,
+                      DiagnosticCode::DEPRECATED_PARAMETER,
+                      context,
+                      parameter.m_name,
+                      *first_data);
+    scratch.m_first_data[i] = nullptr;
+  }
+
+  //=================================== The values
+  context.enterNested();
+  size_t match = first_match;
+  data.forEachChild(
+    [&](const DataTree& child)
+    {
+      const uint32_t instruction_index = matches[match++];
+      if (instruction_index == NO_INSTRUCTION) return;
+      const auto position = context.enterData(child);
+      runParameter(instruction_index, diagnostics, child, context, scratch);
+      context.leaveData(position);
+    });
+  context.leaveNested();
+  matches.resize(first_match);
+
+  if (block.m_has_additional_checks)
+    block.m_parameter->performAdditionalChecks(
+      diagnostics, data, context, block.m_parameter->name());
+
+  diagnostics.endGroup();
+}
+
+// ###################################################################
+/**Checks a parameter, see ParameterTree::checkAndAssignData.*/
+void ParameterProgram::runParameter(const uint32_t index,
+                                    ParameterDiagnostics& diagnostics,
+                                    const DataTree& data,
+                                    ParameterValidationContext& context,
+                                    Scratch& scratch) const
+{
+  const auto& instruction = m_instructions[index];
+
+  if (data.grossType() != instruction.m_gross_type)
+  {
+    diagnostics
+      .add(DiagnosticSeverity::ERROR,
+           DiagnosticCode::GROSS_TYPE_MISMATCH,
+           context,
+           instruction.m_name,
+           data)
+      .m_expected_gross_type = instruction.m_gross_type;
+    return;
+  }
+
+  switch (instruction.m_opcode)
+  {
+    case Opcode::BLOCK:
+      runBlock(index, diagnostics, data, context, scratch);
+      return;
+    case Opcode::SCALAR_EXACT:
+      if (data.value().type() != instruction.m_scalar_type)
+      {
+        diagnostics
+          .add(DiagnosticSeverity::ERROR,
+               DiagnosticCode::SCALAR_TYPE_MISMATCH,
+               context,
+               instruction.m_name,
+               data)
+          .m_expected_scalar_type = instruction.m_scalar_type;
+        return;
+      }
+      [[fallthrough]];
+    case Opcode::SCALAR_COMPATIBLE:
+      if (not isConvertible(instruction, data.value()))
+      {
+        diagnostics
+          .add(DiagnosticSeverity::ERROR,
+               DiagnosticCode::SCALAR_TYPE_INCOMPATIBLE,
+               context,
+               instruction.m_name,
+               data)
+          .m_expected_scalar_type = instruction.m_scalar_type;
+        return;
+      }
+      [[fallthrough]];
+    case Opcode::SCALAR:
+    case Opcode::GROSS_TYPE_ONLY:
+      break;
+    case Opcode::SCALAR_ARRAY:
+    case Opcode::SCALAR_ARRAY_EXACT:
+    case Opcode::SCALAR_ARRAY_COMPATIBLE:
+      runScalarArray(instruction, diagnostics, data, context);
+      break;
+    case Opcode::NO_CHECKS:
+      return;
+  }
+
+  if (instruction.m_has_additional_checks)
+    instruction.m_parameter->performAdditionalChecks(
+      diagnostics, data, context, instruction.m_parameter->name());
+}
+
+// ###################################################################
+/**Checks the entries of an array of scalars, see
+ * ParameterTree::checkAndAssignArrayOfScalars.*/
+void ParameterProgram::runScalarArray(const Instruction& instruction,
+                                      ParameterDiagnostics& diagnostics,
+                                      const DataTree& data,
+                                      const ParameterValidationContext& context)
+{
+  size_t id = 0;
+  data.forEachChild(
+    [&](const DataTree& entry)
+    {
+      const size_t entry_id = id++;
+      if (entry.grossType() != DataGrossType::SCALAR)
+      {
+        diagnostics
+          .add(DiagnosticSeverity::ERROR,
+               DiagnosticCode::ARRAY_ENTRY_NOT_SCALAR,
+               context,
+               instruction.m_name,
+               entry)
+          .m_index = entry_id;
+        return;
+      }
+
+      const auto& value = entry.value();
+      switch (instruction.m_opcode)
+      {
+        case Opcode::SCALAR_ARRAY_EXACT:
+          if (value.type() != instruction.m_scalar_type)
+          {
+            auto& diagnostic =
+              diagnostics.add(DiagnosticSeverity::ERROR,
+                              DiagnosticCode::ARRAY_ENTRY_TYPE_MISMATCH,
+                              context,
+                              instruction.m_name,
+                              entry);
+            diagnostic.m_expected_scalar_type = instruction.m_scalar_type;
+            diagnostic.m_index = entry_id;
+            return;
+          }
+          [[fallthrough]];
+        case Opcode::SCALAR_ARRAY_COMPATIBLE:
+          if (not isConvertible(instruction, value))
+          {
+            diagnostics
+              .add(DiagnosticSeverity::ERROR,
+                   DiagnosticCode::SCALAR_TYPE_INCOMPATIBLE,
+                   context,
+                   instruction.m_name,
+                   entry)
+              .m_expected_scalar_type = instruction.m_scalar_type;
+            return;
+          }
+          [[fallthrough]];
+        default:
+          break;
+      }
+    });
+}
+
+// ###################################################################
+/**Returns true if the value is convertible to the instruction's type and
+ * fits its integer range.*/
+bool ParameterProgram::isConvertible(const Instruction& instruction,
+                                     const ScalarValue& value)
+{
+  const auto type = value.type();
+  if (instruction.m_convertible_types & (1u << static_cast<int>(type)))
+    return true;
+
+  return isCompatibleScalar(
+    value, instruction.m_scalar_type, instruction.m_integer_range);
+}
+
+} // namespace elke
@@ -0,0 +1,148 @@
+#ifndef ELK_E_PARAMETERPROGRAM_H
+#define ELK_E_PARAMETERPROGRAM_H
+
+#include "ParameterTree.h"
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace elke
+{
+
+/**A ParameterTree specification lowered into a flat array of instructions,
+ * for validating many data-trees against the same specification. Checking
+ * with the program finds the same errors and warnings as
+ * ParameterTree::processSpecification, in the same order, but:
+ * - each data name is hashed once and looked up in an open-addressing table
+ *   of its block, instead of searching the children of both trees,
+ * - the checks of a parameter are chosen by one opcode instead of the
+ *   switches over gross-type, ArrayNature and ScalarAssignment,
+ * - whether a scalar type converts to the expected type is looked up,
+ *   only strings still being tested by value,
+ * - additional input checks are only visited by parameters that have them.
+ *
+ * The program refers to the names, additional checks and name suggestions
+ * of the specification, which must therefore outlive it and not be
+ * modified after compiling. The program never assigns data; use
+ * ParameterTree::processSpecification with the assignment flag for that.
+ */
+class ParameterProgram
+{
+public:
+  enum class Opcode : uint8_t
+  {
+    BLOCK = 0,                   ///< A specification map
+    SCALAR = 1,                  ///< Any scalar
+    SCALAR_EXACT = 2,            ///< A scalar of exactly m_scalar_type
+    SCALAR_COMPATIBLE = 3,       ///< A scalar convertible to m_scalar_type
+    SCALAR_ARRAY = 4,            ///< A sequence of any scalars
+    SCALAR_ARRAY_EXACT = 5,      ///< A sequence of exactly m_scalar_type
+    SCALAR_ARRAY_COMPATIBLE = 6, ///< A sequence convertible to m_scalar_type
+    GROSS_TYPE_ONLY = 7,         ///< Generic arrays and maps
+    NO_CHECKS = 8                ///< Only the gross-type, not even additional
+  };
+
+  static constexpr uint32_t NO_INSTRUCTION =
+    std::numeric_limits<uint32_t>::max();
+
+  /**One parameter of the specification.*/
+  struct Instruction
+  {
+    Opcode m_opcode = Opcode::NO_CHECKS;
+    DataGrossType m_gross_type = DataGrossType::NO_DATA;
+    ScalarType m_scalar_type = ScalarType::VOID;
+    ParameterLabel m_label = ParameterLabel::OPTIONAL;
+    /// Bit `1 << ScalarType` is set for the scalar types that are always
+    /// convertible to m_scalar_type. Strings are otherwise tested by value,
+    /// and so is everything for integers with a narrowed m_integer_range.
+    uint8_t m_convertible_types = 0;
+    param_options::IntegerRange m_integer_range;
+    bool m_has_additional_checks = false;
+    /// BLOCK only: the children are the instructions
+    /// [m_first_child, m_first_child + m_num_children).
+    uint32_t m_first_child = 0;
+    uint32_t m_num_children = 0;
+    /// BLOCK only: the name table is the slots
+    /// [m_first_slot, m_first_slot + m_slot_mask + 1).
+    uint32_t m_first_slot = 0;
+    uint32_t m_slot_mask = 0;
+    std::string_view m_name;
+    /// The parameter compiled, for its additional checks and names.
+    const ParameterTree* m_parameter = nullptr;
+  };
+
+  /**Entry of a block's name table.*/
+  struct NameSlot
+  {
+    uint64_t m_hash = 0;
+    uint32_t m_instruction = NO_INSTRUCTION;
+  };
+
+private:
+  /// Instruction 0 is the specification's block. The children of each
+  /// block are contiguous.
+  std::vector<Instruction> m_instructions;
+  /// The name tables of all the blocks.
+  std::vector<NameSlot> m_name_slots;
+
+  /**Per validation state, see validate.*/
+  struct Scratch
+  {
+    /// Instruction matched by each data child, for the blocks being checked.
+    std::vector<uint32_t> m_matches;
+    /// First data child matched by each instruction, while checking the
+    /// required and deprecated parameters of a block.
+    std::vector<const DataTree*> m_first_data;
+  };
+
+public:
+  /**Compiles a specification, which must be a specification map (i.e., a
+   * block created with ParameterTree(name, description)). Throws
+   * a LogicError otherwise.*/
+  explicit ParameterProgram(const ParameterTree& specification);
+
+  /**Checks the parameters of a block, recording errors and warnings in
+   * `diagnostics` like ParameterTree::processSpecification would. Does not
+   * modify the program, so that one program can check several data-trees
+   * at once.*/
+  void validate(ParameterDiagnostics& diagnostics, const DataTree& data) const;
+
+  /**Returns the compiled instructions.*/
+  const std::vector<Instruction>& instructions() const;
+
+private:
+  /**Compiles the children of the block at `block_index`, then the blocks
+   * among them.*/
+  void compileBlock(uint32_t block_index);
+  /**Sets the opcode and types of a parameter.*/
+  static Instruction compileParameter(const ParameterTree& parameter);
+
+  /**Returns the child of a block with the given name, or NO_INSTRUCTION.*/
+  uint32_t findChild(const Instruction& block, std::string_view name) const;
+
+  void runBlock(uint32_t block_index,
+                ParameterDiagnostics& diagnostics,
+                const DataTree& data,
+                ParameterValidationContext& context,
+                Scratch& scratch) const;
+  void runParameter(uint32_t index,
+                    ParameterDiagnostics& diagnostics,
+                    const DataTree& data,
+                    ParameterValidationContext& context,
+                    Scratch& scratch) const;
+  static void runScalarArray(const Instruction& instruction,
+                             ParameterDiagnostics& diagnostics,
+                             const DataTree& data,
+                             const ParameterValidationContext& context);
+
+  /**Returns true if the value is convertible to the instruction's type and
+   * fits its integer range.*/
+  static bool isConvertible(const Instruction& instruction,
+                            const ScalarValue& value);
+};
+
+} // namespace elke
+
+#endif // ELK_E_PARAMETERPROGRAM_H
@@ -1,9 +1,8 @@
 #include "ParameterTree.h"
 
 #include "elke_core/output/elk_exceptions.h"
-#include "elke_core/utilities/string_utils.h"
 
-#include <unordered_set>
+#include <memory>
 #include <sstream>
 #include <iostream>
 #include <utility>
@@ -71,21 +70,26 @@ void ParameterTree::addAdditionalInputCheck(
 
 // ###################################################################
 /**Perform all additional checks.*/
-bool ParameterTree::performAdditionalChecks(StatusStrings& status_strings,
-                                            const DataTree& data,
-                                            const std::string& prefix,
-                                            const std::string& name_or_id) const
+bool ParameterTree::performAdditionalChecks(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context,
+  const std::string& name_or_id) const
 {
   bool passed = true;
   for (const auto& check : m_additional_input_checks)
   {
     const auto& check_obj = check.m_check;
     const bool check_passed =
-      check_obj->performCheck(status_strings, data, prefix, name_or_id);
+      check_obj->performCheck(diagnostics, data, context, name_or_id);
 
     if (not check_passed and not check.m_allow_subsequent_checks)
     {
-      status_strings.m_errors += prefix + "Additional checks skipped.\n";
+      diagnostics.add(DiagnosticSeverity::ERROR,
+                      DiagnosticCode::ADDITIONAL_CHECKS_SKIPPED,
+                      context,
+                      name_or_id,
+                      data);
       return false;
     }
 
@@ -99,67 +103,71 @@ bool ParameterTree::performAdditionalChecks(StatusStrings& status_strings,
 /**Checks whether the parameter with the given name is present.*/
 bool ParameterTree::hasParameter(const std::string& name) const
 {
-  // clang-format off
-  for (const auto& parameter : this->constIterableParameters()) // NOLINT(*-use-anyofallof)
-    if (parameter.name() == name) return true;
-
-  return false;
-  // clang-format on
+  return findParameter(name, hash_utils::fnv1a64(name)) != nullptr;
 }
 
 // ###################################################################
 /**Obtains const-reference to a parameter by name.*/
 const ParameterTree& ParameterTree::getParameter(const std::string& name) const
 {
-  for (const auto& parameter : this->constIterableParameters())
-    if (parameter.name() == name) return parameter;
+  const auto* parameter_ptr = findParameter(name, hash_utils::fnv1a64(name));
+  if (parameter_ptr == nullptr) throwNoParameterError(name);
 
-  elkLogicalError("ParameterTree has no parameter named \"" + name + "\"");
+  return *parameter_ptr;
 }
 
 // ###################################################################
 /**Obtains a non-const-reference to a parameter by name.*/
 ParameterTree& ParameterTree::getParameter(const std::string& name)
 {
-  for (auto& parameter : this->iterableParameters())
-    if (parameter.name() == name) return parameter;
+  const auto* parameter_ptr = findParameter(name, hash_utils::fnv1a64(name));
+  if (parameter_ptr == nullptr) throwNoParameterError(name);
 
-  elkLogicalError("ParameterTree has no parameter named \"" + name + "\"");
+  return const_cast<ParameterTree&>(*parameter_ptr);
 }
 
 // ###################################################################
-void ParameterTree::checkAndAssignData(StatusStrings& status_strings,
+/**Returns whether this parameter has a value.*/
+bool ParameterTree::hasValue() const { return m_value.has_value(); }
+
+// ###################################################################
+void ParameterTree::checkAndAssignData(ParameterDiagnostics& diagnostics,
                                        const DataTree& data)
 {
+  ParameterValidationContext context(m_assignment_flag);
+  if (diagnostics.markTable() != nullptr) context.trackLocations(data);
+  checkAndAssignData(diagnostics, data, context);
+}
 
+// ###################################################################
+void ParameterTree::checkAndAssignData(ParameterDiagnostics& diagnostics,
+                                       const DataTree& data,
+                                       ParameterValidationContext& context)
+{
   // std::cout << "Master checkAndAssignData " << this->name() << " "
   //           << DataGrossTypeName(m_gross_type) << " " << data.name() << " "
   //           << DataGrossTypeName(data.grossType()) << "\n"; // TODO: Remove
-  m_assignment_flag = getRecursiveParentAssignmentFlag();
-  m_nest_depth = getRecursiveNestDepth();
-
-  if (not grossTypeMatches(status_strings.m_errors, data)) return;
+  if (not grossTypeMatches(diagnostics, data, context)) return;
 
   // clang-format off
   switch (m_gross_type)
   {
-    case DataGrossType::SCALAR: checkAndAssignScalarData(status_strings, data); break;
-    case DataGrossType::SEQUENCE: checkAndAssignSequenceData(status_strings, data); break;
+    case DataGrossType::SCALAR: checkAndAssignScalarData(diagnostics, data, context); break;
+    case DataGrossType::SEQUENCE: checkAndAssignSequenceData(diagnostics, data, context); break;
     case DataGrossType::MAP:
-      if (m_is_a_specification_map) processSpecification(status_strings, data);
-      else checkAndAssignArbitraryMap(status_strings, data);
+      if (m_is_a_specification_map) processSpecification(diagnostics, data, context);
+      else checkAndAssignArbitraryMap(diagnostics, data, context);
     default: break;
   }
   // clang-format on
 }
 
 // ###################################################################
-void ParameterTree::checkAndAssignScalarData(StatusStrings& status_strings,
-                                             const DataTree& data)
+void ParameterTree::checkAndAssignScalarData(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context)
 {
-  // std::cout << "checkAndAssignScalarData " << m_nest_depth << "\n";
-  const auto indent = std::string((m_nest_depth + 1) * 2, ' ');
-
   const auto target_type = m_meta_data.m_scalar_options.m_scalar_type;
   const auto& data_scalar_value = data.value();
   const auto& options = m_meta_data.m_scalar_options;
@@ -169,33 +177,27 @@ void ParameterTree::checkAndAssignScalarData(StatusStrings& status_strings,
     case param_options::ScalarAssignment::MUST_MATCH_EXACTLY:
       if (data_scalar_value.type() != target_type)
       {
-        std::stringstream error_message;
-        // clang-format off
-        error_message
-          << indent << "Item \"" << this->name() << "\" is required to be of specific scalar-type "
-          << scalarTypeStringName(target_type) << ". Supplied scalar-type is "
-          << scalarTypeStringName(data_scalar_value.type()) << " with value "
-          << data_scalar_value.convertToString() << ".\n";
-        // clang-format on
-
-        status_strings.m_errors.append(error_message.str());
+        diagnostics
+          .add(DiagnosticSeverity::ERROR,
+               DiagnosticCode::SCALAR_TYPE_MISMATCH,
+               context,
+               this->name(),
+               data)
+          .m_expected_scalar_type = target_type;
         return;
       }
     case param_options::ScalarAssignment::MUST_BE_COMPATIBLE:
-      if (not data_scalar_value.isConvertibleToType(target_type))
+      if (not isCompatibleScalar(data_scalar_value,
+                                 target_type,
+                                 options.m_integer_range))
       {
-        std::stringstream error_message;
-        // clang-format off
-        error_message
-          << indent << "Item \"" << this->name() << "\" is required to be of scalar-type "
-          << scalarTypeStringName(target_type) << ". Supplied scalar-type is "
-          << scalarTypeStringName(data_scalar_value.type()) << " with value "
-          << data_scalar_value.convertToString() << " which is not compatible with "
-          << "scalar-type " << scalarTypeStringName(target_type)
-          << ".\n";
-        // clang-format on
-
-        status_strings.m_errors.append(error_message.str());
+        diagnostics
+          .add(DiagnosticSeverity::ERROR,
+               DiagnosticCode::SCALAR_TYPE_INCOMPATIBLE,
+               context,
+               this->name(),
+               data)
+          .m_expected_scalar_type = target_type;
         return;
       }
     case param_options::ScalarAssignment::CAN_BE_ANYTHING:
@@ -203,197 +205,198 @@ void ParameterTree::checkAndAssignScalarData(StatusStrings& status_strings,
   }
 
   const bool checks_passed =
-    performAdditionalChecks(status_strings, data, indent, this->name());
+    performAdditionalChecks(diagnostics, data, context, this->name());
 
-  if (m_assignment_flag == true and checks_passed)
-    m_assigned_data_tree = std::make_shared<DataTree>(data);
+  if (context.assignmentFlag() and checks_passed)
+    assignData(data);
 }
 
 // ###################################################################
-void ParameterTree::checkAndAssignSequenceData(StatusStrings& status_strings,
-                                               const DataTree& data)
+void ParameterTree::checkAndAssignSequenceData(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context)
 {
   // clang-format off
   switch (m_meta_data.m_array_options.m_nature)
   {
     case param_options::ArrayNature::SCALARS:
-      checkAndAssignArrayOfScalars(status_strings, data); break;
+      checkAndAssignArrayOfScalars(diagnostics, data, context); break;
     case param_options::ArrayNature::ARBITRARY:
-      checkAndAssignArrayOfArbs(status_strings, data); break;
+      checkAndAssignArrayOfArbs(diagnostics, data, context); break;
     default: break;
   }
   // clang-format on
 }
 
 // ###################################################################
-void ParameterTree::checkAndAssignArrayOfScalars(StatusStrings& status_strings,
-                                                 const DataTree& data)
+void ParameterTree::checkAndAssignArrayOfScalars(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context)
 {
-  const auto indent = std::string((m_nest_depth + 1) * 2, ' ');
+  const auto& options = m_meta_data.m_array_options.m_array_of_scalar_options;
+  const auto target_type = options.m_scalar_type;
 
   size_t id = 0;
-  for (const auto& child_ptr : data.constChildren())
-  {
-    const auto child_gross_type = child_ptr->grossType();
-    if (child_gross_type != DataGrossType::SCALAR)
+  data.forEachChild(
+    [&](const DataTree& entry)
     {
-      std::stringstream error_message;
-      // clang-format off
-      error_message
-        << indent << "Array entry " << id << " is required to be of gross-type SCALAR. Supplied gross-type is "
-        << DataGrossTypeName(child_gross_type) << ".\n";
-      // clang-format on
-      status_strings.m_errors.append(error_message.str());
-      ++id;
-      continue;
-    }
-
-    const auto& data_scalar_value = child_ptr->value();
-
-    auto& options = m_meta_data.m_array_options.m_array_of_scalar_options;
-    const auto target_type = options.m_scalar_type;
+      const size_t entry_id = id++;
+      if (entry.grossType() != DataGrossType::SCALAR)
+      {
+        diagnostics
+          .add(DiagnosticSeverity::ERROR,
+               DiagnosticCode::ARRAY_ENTRY_NOT_SCALAR,
+               context,
+               this->name(),
+               entry)
+          .m_index = entry_id;
+        return;
+      }
 
-    switch (options.m_scalar_assignment)
-    {
-      case param_options::ScalarAssignment::MUST_MATCH_EXACTLY:
-        if (data_scalar_value.type() != target_type)
-        {
-          std::stringstream error_message;
-          // clang-format off
-          error_message
-            << indent << "Array entry " << id << " is required to be of specific scalar-type "
-            << scalarTypeStringName(target_type) << ". Supplied scalar-type is "
-            << scalarTypeStringName(data_scalar_value.type()) << " with value "
-            << data_scalar_value.convertToString() << ".\n";
-          // clang-format on
-
-          status_strings.m_errors.append(error_message.str());
-          ++id;
-          continue;
-        }
-      case param_options::ScalarAssignment::MUST_BE_COMPATIBLE:
-        if (not data_scalar_value.isConvertibleToType(target_type))
-        {
-          std::stringstream error_message;
-          // clang-format off
-          error_message
-            << indent << "Item \"" << this->name() << "\" is required to be of scalar-type "
-            << scalarTypeStringName(target_type) << ". Supplied scalar-type is "
-            << scalarTypeStringName(data_scalar_value.type()) << " with value "
-            << data_scalar_value.convertToString() << " which is not compatible with "
-            << "scalar-type " << scalarTypeStringName(target_type)
-            << ".\n";
-          // clang-format on
-
-          status_strings.m_errors.append(error_message.str());
-          ++id;
-          continue;
-        }
-      case param_options::ScalarAssignment::CAN_BE_ANYTHING:
-        break;
-    }
+      const auto& data_scalar_value = entry.value();
 
-    ++id;
-  } // for (const auto& child_ptr
+      switch (options.m_scalar_assignment)
+      {
+        case param_options::ScalarAssignment::MUST_MATCH_EXACTLY:
+          if (data_scalar_value.type() != target_type)
+          {
+            auto& diagnostic =
+              diagnostics.add(DiagnosticSeverity::ERROR,
+                              DiagnosticCode::ARRAY_ENTRY_TYPE_MISMATCH,
+                              context,
+                              this->name(),
+                              entry);
+            diagnostic.m_expected_scalar_type = target_type;
+            diagnostic.m_index = entry_id;
+            return;
+          }
+        case param_options::ScalarAssignment::MUST_BE_COMPATIBLE:
+          if (not isCompatibleScalar(data_scalar_value,
+                                     target_type,
+                                     options.m_integer_range))
+          {
+            diagnostics
+              .add(DiagnosticSeverity::ERROR,
+                   DiagnosticCode::SCALAR_TYPE_INCOMPATIBLE,
+                   context,
+                   this->name(),
+                   entry)
+              .m_expected_scalar_type = target_type;
+            return;
+          }
+        case param_options::ScalarAssignment::CAN_BE_ANYTHING:
+          break;
+      }
+    });
 
   const bool checks_passed =
-    performAdditionalChecks(status_strings, data, indent, this->name());
+    performAdditionalChecks(diagnostics, data, context, this->name());
 
-  if (m_assignment_flag == true and checks_passed)
-    m_assigned_data_tree = std::make_shared<DataTree>(data);
+  if (context.assignmentFlag() and checks_passed)
+    assignData(data);
 }
 
-void ParameterTree::checkAndAssignArrayOfArbs(StatusStrings& status_strings,
-                                              const DataTree& data)
+void ParameterTree::checkAndAssignArrayOfArbs(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context)
 {
-  const auto indent = std::string((m_nest_depth + 1) * 2, ' ');
   // Gross-type already checked
 
   const bool checks_passed =
-    performAdditionalChecks(status_strings, data, indent, this->name());
+    performAdditionalChecks(diagnostics, data, context, this->name());
 
-  if (m_assignment_flag == true and checks_passed)
-    m_assigned_data_tree = std::make_shared<DataTree>(data);
+  if (context.assignmentFlag() and checks_passed)
+    assignData(data);
 }
 
 // ###################################################################
-void ParameterTree::checkAndAssignArbitraryMap(StatusStrings& status_strings,
-                                               const DataTree& data)
+void ParameterTree::checkAndAssignArbitraryMap(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context)
 {
-  const auto indent = std::string((m_nest_depth + 1) * 2, ' ');
   // Gross-type already checked
 
   const bool checks_passed =
-    performAdditionalChecks(status_strings, data, indent, this->name());
+    performAdditionalChecks(diagnostics, data, context, this->name());
 
-  if (m_assignment_flag == true and checks_passed)
-    m_assigned_data_tree = std::make_shared<DataTree>(data);
+  if (context.assignmentFlag() and checks_passed)
+    assignData(data);
 }
 
 // ###################################################################
-void ParameterTree::processSpecification(StatusStrings& output_status_strings,
+void ParameterTree::processSpecification(ParameterDiagnostics& diagnostics,
                                          const DataTree& data)
+{
+  ParameterValidationContext context(m_assignment_flag);
+  if (diagnostics.markTable() != nullptr) context.trackLocations(data);
+  processSpecification(diagnostics, data, context);
+}
+
+// ###################################################################
+void ParameterTree::processSpecification(ParameterDiagnostics& diagnostics,
+                                         const DataTree& data,
+                                         ParameterValidationContext& context)
 {
   // std::cout << "checkAndAssignMapData " << this->name() << " " << data.name()
   //           << "\n";
-  const auto indent = std::string((m_nest_depth + 1) * 2, ' ');
 
-  StatusStrings this_status_strings;
+  // Everything found below is printed under a header naming this block.
+  diagnostics.beginGroup(this->name(), context, data);
 
   //=================================== First we check if the data is actually
   //                                    valid, if not we mark them to be skipped
   //                                    because we provide an error for them
   //                                    once
-  std::vector<std::string> invalid_param_names;
+  std::vector<DataTreeConstPtr> invalid_data_children;
   std::vector<DataTreeConstPtr> valid_data_children;
 
   for (const auto& child_ptr : data.constChildren())
     if (not this->hasParameter(child_ptr->name()))
-      invalid_param_names.emplace_back(child_ptr->name());
+      invalid_data_children.emplace_back(child_ptr);
     else
       valid_data_children.emplace_back(child_ptr);
 
   //=================================== For each of the invalid parameters
   //                                    check if we have a suggestion.
-  if (not invalid_param_names.empty())
+  if (not invalid_data_children.empty())
   {
-    const auto valid_param_names = this->validParameterNames();
-
-    for (const auto& invalid_param_name : invalid_param_names)
-    {
-      const auto suggestion = string_utils::findClosestMatchingString(
-        invalid_param_name, valid_param_names);
+    const auto name_index = this->parameterNameIndex();
 
-      const std::string suggestion_str =
-        suggestion.empty()
-          ? " No suggested parameter name could be determined.\n"
-          : " Did you mean \"" + suggestion + "\"?\n";
-
-      this_status_strings.m_errors.append(indent + "The parameter name \"" +
-                                          invalid_param_name +
-                                          "\" is invalid." + suggestion_str);
-    } // for invalid_param_name
-  } // if (not invalid_param_names.empty())
+    for (const auto& invalid_child_ptr : invalid_data_children)
+      diagnostics.addInvalidName(
+        context,
+        *invalid_child_ptr,
+        name_index->findClosest(invalid_child_ptr->name()));
+  } // if (not invalid_data_children.empty())
 
   //=================================== Now we check if required parameters
   //                                    have been supplied
-  for (const auto& parameter : this->iterableParameters())
+  for (const auto& parameter : this->constIterableParameters())
   {
     const bool is_required = parameter.label() == ParameterLabel::REQUIRED;
     const bool is_deprecated = parameter.label() == ParameterLabel::DEPRECATED;
     const bool in_data_list = data.hasChild(parameter.name());
     if (is_required and not in_data_list)
-      this_status_strings.m_errors.append(indent + "Required parameter \"" +
-                                          parameter.name() +
-                                          "\" not supplied.\n");
+      diagnostics.add(DiagnosticSeverity::ERROR,
+                      DiagnosticCode::REQUIRED_PARAMETER_MISSING,
+                      context,
+                      parameter.name(),
+                      data);
     if (is_deprecated and in_data_list)
-      this_status_strings.m_warnings.append(
-        indent + "Parameter \"" + parameter.name() + "\" is deprecated.");
+      diagnostics.add(DiagnosticSeverity::WARNING,
+                      DiagnosticCode::DEPRECATED_PARAMETER,
+                      context,
+                      parameter.name(),
+                      data.child(parameter.name()));
   }
 
   //=================================== Now for each data entry, if not skipped,
   //                                    check whether the value is valid.
-  StatusStrings child_status_strings;
+  context.enterNested();
   for (const auto& child_ptr : valid_data_children)
   {
     const auto& child = *child_ptr;
@@ -402,49 +405,119 @@ void ParameterTree::processSpecification(StatusStrings& output_status_strings,
 
     //***********************
     // Individual parameter check
-    input_parameter.checkAndAssignData(child_status_strings, child);
+    const auto position = context.enterData(child);
+    input_parameter.checkAndAssignData(diagnostics, child, context);
+    context.leaveData(position);
     //***********************
   } // for child
-  this_status_strings += child_status_strings;
+  context.leaveNested();
 
-  //=================================== Format final error strings
-  // clang-format off
-  const std::string context =
-    "While checking input parameter validity for block "
-    "\"" + this->name() + "\" from data-tree \"" + data.getTag("address") + "\""
-    " parsed from " + data.getTag("mark") + ":\n";
-  // clang-format on
+  const bool checks_passed =
+    performAdditionalChecks(diagnostics, data, context, this->name());
 
-  auto& output = output_status_strings;
-  if (not this_status_strings.m_errors.empty())
-    output.m_errors.append(context + this_status_strings.m_errors);
-  if (not this_status_strings.m_warnings.empty())
-    output.m_warnings.append(context + this_status_strings.m_warnings);
+  diagnostics.endGroup();
 
-  const bool checks_passed =
-    performAdditionalChecks(this_status_strings, data, indent, this->name());
+  if (context.assignmentFlag() and checks_passed)
+    assignData(data);
+}
 
-  if (m_assignment_flag == true and checks_passed)
-    m_assigned_data_tree = std::make_shared<DataTree>(data);
-  m_assigned_data_tree = std::make_shared<DataTree>(data);
+// ###################################################################
+/**Adds a parameter to the children, updating the name lookups.*/
+ParameterTree&
+ParameterTree::appendParameter(const ParameterTreePtr& parameter_ptr)
+{
+  // On a hash collision the first parameter keeps the entry and the others
+  // are found by findParameter's search.
+  m_parameter_positions.emplace(hash_utils::fnv1a64(parameter_ptr->name()),
+                                m_children.size());
+  m_children.emplace_back(parameter_ptr);
+  std::atomic_store(&m_parameter_name_index,
+                    std::shared_ptr<const string_utils::BKTree>());
+
+  return *parameter_ptr;
 }
 
 // ###################################################################
-/**Creates a sorted list of all the children names.*/
-std::vector<std::string> ParameterTree::validParameterNames() const
+/**Returns the child with the given name and name hash, or nullptr.*/
+const ParameterTree*
+ParameterTree::findParameter(const std::string_view name,
+                             const uint64_t name_hash) const
 {
-  std::unordered_set<std::string> valid_param_names_set;
+  const auto position = m_parameter_positions.find(name_hash);
+  if (position == m_parameter_positions.end()) return nullptr;
+
+  const auto& parameter = *m_children[position->second];
+  if (parameter.name() == name) return &parameter;
+
   for (const auto& child : this->constIterableParameters())
-    valid_param_names_set.insert(child.name());
+    if (child.name() == name) return &child;
+
+  return nullptr;
+}
+
+// ###################################################################
+/**Stores checked data and its converted value.*/
+void ParameterTree::assignData(const DataTree& data)
+{
+  m_assigned_data_tree = std::make_shared<DataTree>(data);
+  if (not m_value_converter) return;
+
+  // Data that is not convertible (e.g., with ScalarAssignment::CAN_BE_ANYTHING)
+  // leaves the default value, if any.
+  auto value = m_value_converter(data);
+  if (value.has_value()) m_value = std::move(value);
+}
 
+// ###################################################################
+void ParameterTree::throwValueAccessError(const char* type_name) const
+{
+  if (not m_value.has_value())
+    elkLogicalError("Parameter \"" + this->name() +
+                    "\" has no value. It has no default and no data has "
+                    "been assigned to it.");
+
+  elkLogicalError("Parameter \"" + this->name() + "\" holds a value of type " +
+                  m_value.type().name() + " which was requested as type " +
+                  type_name + ".");
+}
+
+// ###################################################################
+void ParameterTree::throwNoParameterError(const std::string_view name) const
+{
+  elkLogicalError("ParameterTree has no parameter named \"" +
+                  std::string(name) + "\"");
+}
+
+// ###################################################################
+/**Creates a list of all the children names in declaration order.*/
+std::vector<std::string> ParameterTree::validParameterNames() const
+{
   std::vector<std::string> vec_of_names;
-  vec_of_names.reserve(valid_param_names_set.size());
-  for (const auto& name : valid_param_names_set)
-    vec_of_names.emplace_back(name);
+  vec_of_names.reserve(m_children.size());
+  for (const auto& child : this->constIterableParameters())
+    vec_of_names.emplace_back(child.name());
 
   return vec_of_names;
 }
 
+// ###################################################################
+/**Returns the index of the children names, building it if needed.*/
+std::shared_ptr<const string_utils::BKTree>
+ParameterTree::parameterNameIndex() const
+{
+  auto index = std::atomic_load(&m_parameter_name_index);
+  if (index) return index;
+
+  // Concurrent checks may each build one; only the first is published, and
+  // the others use it instead of their own.
+  auto built =
+    std::make_shared<const string_utils::BKTree>(validParameterNames());
+  if (std::atomic_compare_exchange_strong(
+        &m_parameter_name_index, &index, built))
+    return built;
+  return index;
+}
+
 // ###################################################################
 /**If the new parameter name is already in the list of children, a
  * std::logic_error is thrown. */
@@ -459,43 +532,22 @@ void ParameterTree::assertAndThrowIfDuplicate(
 
 // ##################################################################
 /**Checks if gross type matches.*/
-bool ParameterTree::grossTypeMatches(std::string& error_string,
-                                     const DataTree& data) const
+bool ParameterTree::grossTypeMatches(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context) const
 {
   if (m_gross_type == data.grossType()) return true;
 
-  const auto indent = std::string((m_nest_depth + 1) * 2, ' ');
-
-  std::stringstream error_message;
-  // clang-format off
-  error_message
-    << indent << "Item \"" << this->name()
-    << "\" is required to be of gross-type "
-    << DataGrossTypeName(m_gross_type) << ". Supplied gross-type is "
-    << DataGrossTypeName(data.grossType()) << ".\n";
-  // clang-format on
-
-  error_string.append(error_message.str());
+  diagnostics
+    .add(DiagnosticSeverity::ERROR,
+         DiagnosticCode::GROSS_TYPE_MISMATCH,
+         context,
+         this->name(),
+         data)
+    .m_expected_gross_type = m_gross_type;
 
   return false;
 }
 
-// ##################################################################
-/**Get assignment flag. This is recursive on the parent of this tree.*/
-bool ParameterTree::getRecursiveParentAssignmentFlag() const
-{
-  if (m_parent_tree_ptr == nullptr) return m_assignment_flag;
-
-  return m_parent_tree_ptr->getRecursiveParentAssignmentFlag();
-}
-
-// ##################################################################
-/**Recursively determines the current nesting depth.*/
-size_t ParameterTree::getRecursiveNestDepth() const
-{
-  if (m_parent_tree_ptr == nullptr) return 0;
-
-  return m_parent_tree_ptr->getRecursiveNestDepth() + 1;
-}
-
 } // namespace elke
@@ -7,10 +7,14 @@
 #include "elke_core/data_types/ScalarValue.h"
 #include "elke_core/utilities/general_utils.h"
 #include "elke_core/utilities/special_iterators.h"
+#include "elke_core/utilities/BKTree.h"
 #include "ParameterTree_helpers.h"
 
+#include <any>
+#include <functional>
 #include <utility>
 #include <iostream>
+#include <unordered_map>
 
 namespace elke
 {
@@ -31,12 +35,24 @@ std::string ParameterLabelToString(ParameterLabel label);
  * leaf and a branch is still a Tree, so it is a recurrence relation. With
  * a ParameterTree each level of assignment undergoes checking, i.e.,
  * - a scalar parameter requires that a compatible scalar be assigned to it.
+ *
+ * Values:\n
+ * Each parameter holds its value as the type it was declared with, e.g.,
+ * `double`, `int` or `std::string` for scalars, `std::vector<T>` for
+ * vectors and `DataTree` for generic arrays and maps. Optional parameters
+ * start with their default value. Data assigned by a check (see
+ * setAssignmentFlag) is converted once, when it is assigned, so that
+ * `getParameterValue<T>(name)` only finds the parameter and returns a
+ * reference. With a ParameterKey the name hash is computed at compile time.
  */
 class ParameterTree
 {
   using ParameterTreePtr = std::shared_ptr<ParameterTree>;
   using DataTreeConstPtr = std::shared_ptr<const DataTree>;
 
+  /// Compiles the private metadata of a specification, see ParameterProgram.
+  friend class ParameterProgram;
+
   const std::string m_name;         /// Name of the tree.
   const std::string m_description;  /// Description to provide queries.
   const ParameterLabel m_label;     /// Label, optional/required/deprecated
@@ -59,15 +75,26 @@ class ParameterTree
   /// Raw assigned DataTree data.
   std::shared_ptr<const DataTree> m_assigned_data_tree = nullptr;
 
-  // Runtime attributes BEGIN
-  /**Nest depth. Set when called in recursive methods and a child has a
-   * parent.*/
-  size_t m_nest_depth = 0;
-
-  /**Controls the skipping of assignment. If true, value assignment will
-   * occur.*/
+  /// Positions of the children in m_children, by the hash of their name.
+  std::unordered_map<uint64_t, size_t> m_parameter_positions;
+
+  /// Converts assigned data to the declared value type. Set when a scalar,
+  /// vector or generic parameter is added.
+  std::function<std::any(const DataTree&)> m_value_converter;
+  /// The value as the declared type, see "Values" above. Empty for
+  /// specification maps and required parameters without data.
+  std::any m_value;
+
+  /// Index of the children names used to suggest corrections for invalid
+  /// parameter names. Built on first use, reset when a parameter is added.
+  /// Mutable, and accessed atomically, so that concurrent checks can build it.
+  mutable std::shared_ptr<const string_utils::BKTree> m_parameter_name_index =
+    nullptr;
+
+  /**Controls the skipping of assignment when checking starts at this tree.
+   * If true, value assignment will occur. Nested parameters follow the tree
+   * the check started at, see ParameterValidationContext.*/
   bool m_assignment_flag = false;
-  // Runtime attributes END
 
 public:
   /**Deleted Default constructor.*/
@@ -179,12 +206,21 @@ protected:
       options.m_scalar_options.m_default_value = ScalarValue(proxy_value);
     }
 
+    if constexpr (IsInteger<T>::value)
+      options.m_scalar_options.m_integer_range =
+        param_options::IntegerRange::of<T>();
+
+    using ValueType = ParameterValueType<T>;
     const auto parameter_ptr = std::make_shared<ParameterTree>(
       *this, name, description, label, DataGrossType::SCALAR, options);
 
-    m_children.emplace_back(parameter_ptr);
+    parameter_ptr->m_value_converter = [](const DataTree& data)
+    { return makeScalarParameterValue<ValueType>(data.value()); };
+    if (label != ParameterLabel::REQUIRED)
+      parameter_ptr->m_value = makeScalarParameterValue<ValueType>(
+        options.m_scalar_options.m_default_value);
 
-    return *parameter_ptr;
+    return appendParameter(parameter_ptr);
   }
 
   /**Adds a Vector parameter (array of scalar).*/
@@ -215,12 +251,21 @@ protected:
         default_values.emplace_back(proxy_value);
     }
 
+    if constexpr (IsInteger<U>::value)
+      options.m_array_options.m_array_of_scalar_options.m_integer_range =
+        param_options::IntegerRange::of<U>();
+
+    using ValueType = ParameterValueType<U>;
     const auto parameter_ptr = std::make_shared<ParameterTree>(
       *this, name, description, label, DataGrossType::SEQUENCE, options);
 
-    m_children.emplace_back(parameter_ptr);
+    parameter_ptr->m_value_converter = [](const DataTree& data)
+    { return makeVectorParameterValue<ValueType>(data); };
+    if (label != ParameterLabel::REQUIRED)
+      parameter_ptr->m_value = makeVectorParameterValue<ValueType>(
+        options.m_array_options.m_array_of_scalar_options.m_default_values);
 
-    return *parameter_ptr;
+    return appendParameter(parameter_ptr);
   }
 
   /**Adds a generic array parameter.*/
@@ -249,9 +294,19 @@ protected:
     const auto parameter_ptr = std::make_shared<ParameterTree>(
       *this, name, description, label, DataGrossType::SEQUENCE, options);
 
-    m_children.emplace_back(parameter_ptr);
+    parameter_ptr->m_value_converter = [](const DataTree& data)
+    { return std::any(data); };
+    if (label != ParameterLabel::REQUIRED)
+    {
+      DataTree default_value(name);
+      default_value.setGrossType(DataGrossType::SEQUENCE);
+      for (const auto& value :
+           options.m_array_options.m_array_of_arbs_options.m_default_values)
+        default_value.addChild(std::make_shared<DataTree>(value));
+      parameter_ptr->m_value = default_value;
+    }
 
-    return *parameter_ptr;
+    return appendParameter(parameter_ptr);
   }
 
   /**Adds a generic map parameter.*/
@@ -274,9 +329,12 @@ protected:
     const auto parameter_ptr = std::make_shared<ParameterTree>(
       *this, name, description, label, DataGrossType::MAP, options);
 
-    m_children.emplace_back(parameter_ptr);
+    parameter_ptr->m_value_converter = [](const DataTree& data)
+    { return std::any(data); };
+    if (label != ParameterLabel::REQUIRED)
+      parameter_ptr->m_value = options.m_map_options.m_default_value;
 
-    return *parameter_ptr;
+    return appendParameter(parameter_ptr);
   }
 
 public:
@@ -302,9 +360,9 @@ public:
                           bool allow_subsequent_checks = true);
 
   /**Perform all additional checks.*/
-  bool performAdditionalChecks(StatusStrings& status_strings,
+  bool performAdditionalChecks(ParameterDiagnostics& diagnostics,
                                const DataTree& data,
-                               const std::string& prefix,
+                               const ParameterValidationContext& context,
                                const std::string& name_or_id) const;
 
   /**Checks whether the parameter with the given name is present.*/
@@ -316,45 +374,110 @@ public:
   /**Obtains a non-const-reference to a parameter by name.*/
   ParameterTree& getParameter(const std::string& name);
 
+  /**Returns whether this parameter has a value, either assigned or the
+   * default.*/
+  bool hasValue() const;
+
+  /**Returns the value of this parameter. `T` must be the type the
+   * parameter was declared with, see "Values" above. Throws
+   * std::logic_error if there is no value or `T` is another type.*/
+  template <typename T>
+  const T& getValue() const
+  {
+    const auto* value_ptr = std::any_cast<T>(&m_value);
+    if (value_ptr == nullptr) throwValueAccessError(typeid(T).name());
+    return *value_ptr;
+  }
+
+  /**Returns the value of the named parameter, see getValue.*/
+  template <typename T>
+  const T& getParameterValue(const std::string& name) const
+  {
+    return getParameter(name).template getValue<T>();
+  }
+
+  /**Returns the value of the parameter named by the key, see getValue.*/
+  template <typename T>
+  const T& getParameterValue(const ParameterKey<T>& key) const
+  {
+    const auto* parameter_ptr = findParameter(key.name(), key.hash());
+    if (parameter_ptr == nullptr) throwNoParameterError(key.name());
+    return parameter_ptr->template getValue<T>();
+  }
+
   /**Entry point for checking a parameter tree. This routines will check the
-   * gross-type is correct then specialize into specific types.
-   * \param status_strings A reference to a StatusString data-structure where
-   *                       error/warnings messages can be dumped.
+   * gross-type is correct then specialize into specific types. This tree is
+   * treated as the top of the check, i.e., messages are indented for depth
+   * 0 and its assignment flag applies to all nested parameters. Unless the
+   * assignment flag is set the trees are not modified, so that a tree can
+   * be used to check several data-trees at once.
+   * \param diagnostics A reference to a ParameterDiagnostics buffer where
+   *                    errors and warnings are recorded.
    * \param data A reference to the data-tree item that is to be assigned to the
    *             parameter.
    */
-  void checkAndAssignData(StatusStrings& status_strings, const DataTree& data);
+  void checkAndAssignData(ParameterDiagnostics& diagnostics, const DataTree& data);
+
+  /**Checks a parameter as part of an ongoing check.*/
+  void checkAndAssignData(ParameterDiagnostics& diagnostics,
+                          const DataTree& data,
+                          ParameterValidationContext& context);
+
+  void checkAndAssignScalarData(ParameterDiagnostics& diagnostics,
+                                const DataTree& data,
+                                const ParameterValidationContext& context);
+
+  void checkAndAssignSequenceData(ParameterDiagnostics& diagnostics,
+                                  const DataTree& data,
+                                  const ParameterValidationContext& context);
+  void checkAndAssignArrayOfScalars(ParameterDiagnostics& diagnostics,
+                                    const DataTree& data,
+                                    const ParameterValidationContext& context);
+  void checkAndAssignArrayOfArbs(ParameterDiagnostics& diagnostics,
+                                 const DataTree& data,
+                                 const ParameterValidationContext& context);
+  void checkAndAssignArbitraryMap(ParameterDiagnostics& diagnostics,
+                                  const DataTree& data,
+                                  const ParameterValidationContext& context);
+
+  /**Entry point for checking the parameters of a block. Same conventions as
+   * the checkAndAssignData entry point.*/
+  void processSpecification(ParameterDiagnostics& diagnostics,
+                            const DataTree& data);
 
-  void checkAndAssignScalarData(StatusStrings& status_strings,
-                                const DataTree& data);
+  /**Checks the parameters of a block as part of an ongoing check.*/
+  void processSpecification(ParameterDiagnostics& diagnostics,
+                            const DataTree& data,
+                            ParameterValidationContext& context);
 
-  void checkAndAssignSequenceData(StatusStrings& status_strings,
-                                  const DataTree& data);
-  void checkAndAssignArrayOfScalars(StatusStrings& status_strings,
-                                    const DataTree& data);
-  void checkAndAssignArrayOfArbs(StatusStrings& status_strings,
-                                 const DataTree& data);
-  void checkAndAssignArbitraryMap(StatusStrings& status_strings,
-                                  const DataTree& data);
+private:
+  /**Adds a parameter to the children, updating the name lookups.*/
+  ParameterTree& appendParameter(const ParameterTreePtr& parameter_ptr);
 
-  void processSpecification(StatusStrings& output_status_strings,
-                            const DataTree& data);
+  /**Returns the child with the given name and name hash, or nullptr.*/
+  const ParameterTree* findParameter(std::string_view name,
+                                     uint64_t name_hash) const;
 
-private:
-  /**Creates a sorted list of all the children names.*/
+  /**Stores checked data and its converted value.*/
+  void assignData(const DataTree& data);
+
+  [[noreturn]] void throwValueAccessError(const char* type_name) const;
+  [[noreturn]] void throwNoParameterError(std::string_view name) const;
+
+  /**Creates a list of all the children names in declaration order.*/
   std::vector<std::string> validParameterNames() const;
+  /**Returns the index of the children names, building it if needed. Thread
+   * safe. The caller shares ownership, so the index stays valid while it is
+   * used even if a parameter is added meanwhile.*/
+  std::shared_ptr<const string_utils::BKTree> parameterNameIndex() const;
   /**If the new parameter name is already in the list of children, a
    * std::logic_error is thrown. */
   void assertAndThrowIfDuplicate(const std::string& new_parameter_name) const;
 
   /**Checks if gross type matches.*/
-  bool grossTypeMatches(std::string& error_string, const DataTree& data) const;
-
-  /**Get assignment flag. This is recursive on the parent of this tree.*/
-  bool getRecursiveParentAssignmentFlag() const;
-
-  /**Recursively determines the current nesting depth.*/
-  size_t getRecursiveNestDepth() const;
+  bool grossTypeMatches(ParameterDiagnostics& diagnostics,
+                        const DataTree& data,
+                        const ParameterValidationContext& context) const;
 
   /**Assigns a parent.*/
   void setParent(const ParameterTree* const parent)
@@ -5,6 +5,7 @@
 #include "elke_core/data_types/DataTree.h"
 
 #include <cstdint>
+#include <limits>
 
 namespace elke::param_options
 {
@@ -17,12 +18,60 @@ enum class ScalarAssignment : uint32_t
   MUST_BE_COMPATIBLE = 1,
   CAN_BE_ANYTHING = 2
 };
+// clang-format on
+
+/**The values that fit the integer type a parameter is held as. Integers
+ * are read as int64_t, so only parameters declared with a narrower type
+ * (e.g., int) restrict them.*/
+struct IntegerRange
+{
+  int64_t m_min = std::numeric_limits<int64_t>::min();
+  int64_t m_max = std::numeric_limits<int64_t>::max();
+
+  /**Returns the range of the integer type `T`.*/
+  template <typename T>
+  static IntegerRange of()
+  {
+    constexpr auto int64_max = std::numeric_limits<int64_t>::max();
+    constexpr auto t_max = std::numeric_limits<T>::max();
+    IntegerRange range;
+    range.m_min = static_cast<int64_t>(std::numeric_limits<T>::min());
+    if (static_cast<uint64_t>(t_max) < static_cast<uint64_t>(int64_max))
+      range.m_max = static_cast<int64_t>(t_max);
+    return range;
+  }
 
+  /**Returns true if the range excludes some int64_t values.*/
+  bool isNarrowed() const
+  {
+    return m_min != std::numeric_limits<int64_t>::min() or
+           m_max != std::numeric_limits<int64_t>::max();
+  }
+
+  /**Returns true if a value converts to an integer within the range, see
+   * ScalarValue::tryConvertToType. Values that are not integers are
+   * truncated, and fail if they are NaN, infinite or outside the range of
+   * int64_t, whether the range is narrowed or not.*/
+  bool contains(const ScalarValue& value) const
+  {
+    if (value.type() != ScalarType::INTEGER)
+    {
+      ScalarValue integer;
+      return value.tryConvertToType(ScalarType::INTEGER, integer) and
+             contains(integer);
+    }
+    const auto integer = value.getValue<int64_t>();
+    return integer >= m_min and integer <= m_max;
+  }
+};
+
+// clang-format off
 struct ScalarOptions
 {
   ScalarType m_scalar_type = ScalarType::VOID;
   ScalarAssignment m_scalar_assignment = ScalarAssignment::MUST_BE_COMPATIBLE;
   ScalarValue m_default_value;
+  IntegerRange m_integer_range;
 };
 
 //################################################################### ARRAY
@@ -38,6 +87,7 @@ struct ArrayOfScalarsOptions
   ScalarType m_scalar_type = ScalarType::VOID;
   ScalarAssignment m_scalar_assignment = ScalarAssignment::MUST_BE_COMPATIBLE;
   std::vector<ScalarValue> m_default_values;
+  IntegerRange m_integer_range;
 };
 
 //============================================= ARRAY OF ARBS
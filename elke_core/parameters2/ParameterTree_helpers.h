@@ -57,6 +57,115 @@ struct AdditionalInputCheckEntry
   }
 };
 
+/**The type a parameter declared with `T` holds its value as, i.e., `T`,
+ * except for C-strings which are held as std::string.*/
+template <typename T>
+using ParameterValueType =
+  std::conditional_t<IsString<T>::value, std::string, T>;
+
+/**Returns true if a scalar is convertible to `target_type`. Values for an
+ * INTEGER target must also convert to an integer within `range`.*/
+inline bool isCompatibleScalar(const ScalarValue& value,
+                               const ScalarType target_type,
+                               const param_options::IntegerRange& range)
+{
+  if (target_type == ScalarType::INTEGER) return range.contains(value);
+  return value.isConvertibleToType(target_type);
+}
+
+/**Converts a scalar to `T`. Returns false, leaving `output` unchanged, if
+ * the scalar is not convertible, including numbers that do not fit `T`.*/
+template <typename T>
+bool convertScalarValue(const ScalarValue& value, T& output)
+{
+  constexpr auto target_type = ScalarTypeEvaluation<T>::type;
+  ScalarValue converted;
+  if (not value.tryConvertToType(target_type, converted)) return false;
+
+  if constexpr (IsString<T>::value)
+    output = converted.template getValue<std::string>();
+  else if constexpr (IsBool<T>::value)
+    output = converted.template getValue<bool>();
+  else if constexpr (IsInteger<T>::value)
+  {
+    if (not param_options::IntegerRange::of<T>().contains(converted))
+      return false;
+    output = static_cast<T>(converted.template getValue<int64_t>());
+  }
+  else
+    output = static_cast<T>(converted.template getValue<double>());
+  return true;
+}
+
+/**Converts a scalar to a `T` held by a std::any, which is empty if the
+ * scalar is not convertible.*/
+template <typename T>
+std::any makeScalarParameterValue(const ScalarValue& value)
+{
+  T output{};
+  if (not convertScalarValue(value, output)) return {};
+  return output;
+}
+
+/**Converts scalars to a `std::vector<T>` held by a std::any, which is empty
+ * if any of them is not convertible.*/
+template <typename T>
+std::any makeVectorParameterValue(const std::vector<ScalarValue>& values)
+{
+  std::vector<T> output;
+  output.reserve(values.size());
+  for (const auto& value : values)
+  {
+    T converted_value{};
+    if (not convertScalarValue(value, converted_value)) return {};
+    output.push_back(converted_value);
+  }
+  return output;
+}
+
+/**Converts the entries of a sequence to a `std::vector<T>` held by a
+ * std::any, which is empty if any of them is not convertible.*/
+template <typename T>
+std::any makeVectorParameterValue(const DataTree& data)
+{
+  std::vector<T> output;
+  output.reserve(data.numChildren());
+  bool converted = true;
+  data.forEachChild(
+    [&](const DataTree& entry)
+    {
+      T value{};
+      converted = converted and convertScalarValue(entry.value(), value);
+      output.push_back(value);
+    });
+  if (not converted) return {};
+  return output;
+}
+
+/**A parameter name together with the type of its value, for typed access
+ * with ParameterTree::getParameterValue. The name is hashed when the key is
+ * constructed, at compile time for keys declared `constexpr`, e.g.,
+ * \code
+ * constexpr ParameterKey<double> SCALE_KEY("scale");
+ * const double scale = params.getParameterValue(SCALE_KEY);
+ * \endcode
+ * which finds the parameter without hashing or comparing other names.*/
+template <typename T>
+class ParameterKey
+{
+  std::string_view m_name;
+  uint64_t m_hash;
+
+public:
+  constexpr explicit ParameterKey(const std::string_view name)
+    : m_name(name), m_hash(hash_utils::fnv1a64(name))
+  {
+  }
+
+  constexpr std::string_view name() const { return m_name; }
+  constexpr uint64_t hash() const { return m_hash; }
+};
+
 } // namespace elke
 
 #endif // ELK_E_PARAMETERTREE_HELPERS_H
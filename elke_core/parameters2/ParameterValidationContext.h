@@ -0,0 +1,101 @@
+#ifndef ELK_E_PARAMETERVALIDATIONCONTEXT_H
+#define ELK_E_PARAMETERVALIDATIONCONTEXT_H
+
+#include "elke_core/data_types/DataTree.h"
+
+#include <cstddef>
+#include <string>
+
+namespace elke
+{
+
+/**State of a single validation pass over a ParameterTree. It is handed down
+ * the recursion instead of being kept in the trees, so that the depth and
+ * the message indentation are not re-derived at every level, and so that
+ * passes that do not assign values leave the trees untouched.*/
+class ParameterValidationContext
+{
+  size_t m_nest_depth = 0;
+  bool m_assignment_flag = false;
+  /// Indentation of messages at the current depth, (depth + 1) * 2 spaces.
+  std::string m_indent = "  ";
+  /// Data being checked and its address in the input, see trackLocations.
+  bool m_tracks_locations = false;
+  const DataTree* m_data = nullptr;
+  std::string m_address;
+
+public:
+  /**Where the check was before enterData.*/
+  struct DataPosition
+  {
+    const DataTree* m_data = nullptr;
+    size_t m_address_size = 0;
+  };
+
+  explicit ParameterValidationContext(const bool assignment_flag)
+    : m_assignment_flag(assignment_flag)
+  {
+  }
+
+  /**Returns the nesting depth of the parameter being checked.*/
+  size_t nestDepth() const { return m_nest_depth; }
+  /**If true, checked values are assigned to the parameters.*/
+  bool assignmentFlag() const { return m_assignment_flag; }
+  /**Returns the indentation for messages at the current depth.*/
+  const std::string& indent() const { return m_indent; }
+
+  /**Moves one level down, into a child parameter.*/
+  void enterNested()
+  {
+    ++m_nest_depth;
+    m_indent.append(2, ' ');
+  }
+  /**Moves back up after enterNested.*/
+  void leaveNested()
+  {
+    --m_nest_depth;
+    m_indent.resize(m_indent.size() - 2);
+  }
+
+  /**Starts tracking the address of the data being checked, from `data`,
+   * the tree the check starts at, whose "address" tag must be its own.
+   * The addresses below it are derived from the names of the data entered,
+   * since nodes shared by deduplicateDataTree carry the tags of the
+   * occurrence they were parsed from.*/
+  void trackLocations(const DataTree& data)
+  {
+    m_tracks_locations = true;
+    m_data = &data;
+    m_address = data.getTag("address");
+  }
+  /**Returns true if trackLocations was called.*/
+  bool tracksLocations() const { return m_tracks_locations; }
+  /**Returns the data being checked, if locations are tracked.*/
+  const DataTree* data() const { return m_data; }
+  /**Returns the address of the data being checked, if locations are
+   * tracked.*/
+  const std::string& address() const { return m_address; }
+
+  /**Moves to `child`, a child of the data being checked. Returns the
+   * position to restore with leaveData.*/
+  DataPosition enterData(const DataTree& child)
+  {
+    if (not m_tracks_locations) return {};
+    const DataPosition previous{m_data, m_address.size()};
+    m_data = &child;
+    m_address += '/';
+    m_address += child.name();
+    return previous;
+  }
+  /**Moves back up after enterData.*/
+  void leaveData(const DataPosition& previous)
+  {
+    if (not m_tracks_locations) return;
+    m_data = previous.m_data;
+    m_address.resize(previous.m_address_size);
+  }
+};
+
+} // namespace elke
+
+#endif // ELK_E_PARAMETERVALIDATIONCONTEXT_H
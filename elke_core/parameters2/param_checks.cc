@@ -1,31 +1,485 @@
 #include "param_checks.h"
 
+#include "elke_core/output/elk_exceptions.h"
+#include "elke_core/utilities/string_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <regex>
 #include <sstream>
+#include <unordered_set>
 
 namespace elke::param_checks
 {
 
-bool ArraySizeCheck::performCheck(StatusStrings& status_strings,
+namespace
+{
+constexpr double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+
+/**Sets `number` to the value of a scalar item as a double and returns
+ * true, or sets it to NaN and returns false if the item is not a number.
+ * Numbers can themselves be NaN, e.g., `.nan` in YAML.*/
+bool numericValue(const DataTree& item, double& number)
+{
+  number = NOT_A_NUMBER;
+  if (item.grossType() != DataGrossType::SCALAR) return false;
+
+  const auto& value = item.value();
+  switch (value.type())
+  {
+    case ScalarType::INTEGER:
+      number = static_cast<double>(value.getValue<int64_t>());
+      return true;
+    case ScalarType::FLOAT:
+      number = value.getValue<double>();
+      return true;
+    case ScalarType::STRING:
+      if (string_utils::parseDouble(value.getValue<std::string>(), number))
+        return true;
+      number = NOT_A_NUMBER;
+      return false;
+    default:
+      return false;
+  }
+}
+
+/**Returns true if the item is a number whose value is NaN. Such values are
+ * packed like the entries that are not numbers, but fail the checks.*/
+bool isNaNNumber(const DataTree& item)
+{
+  double number;
+  return numericValue(item, number) and std::isnan(number);
+}
+
+/**Sets `integer` to the value of a number item, of value `number` (see
+ * numericValue), and returns true if it is an integer, i.e., an INTEGER, a
+ * string holding one, or a float with an integral value within the range
+ * of int64_t.*/
+bool integerValue(const DataTree& item, const double number, int64_t& integer)
+{
+  const auto& value = item.value();
+  if (value.type() == ScalarType::INTEGER)
+  {
+    integer = value.getValue<int64_t>();
+    return true;
+  }
+  if (value.type() == ScalarType::STRING and
+      string_utils::parseInt64(value.getValue<std::string>(), integer))
+    return true;
+
+  constexpr double int64_limit = 9223372036854775808.0; // 2^63
+  if (not(number >= -int64_limit and number < int64_limit) or
+      std::trunc(number) != number)
+    return false;
+  integer = static_cast<int64_t>(number);
+  return true;
+}
+
+/**Packs the values of a scalar, or of the entries of an array, into
+ * `values`, see the notes on the built-in checks in the header.
+ * `has_nan_number` is set if any of them is a number with the value NaN.*/
+std::vector<double> packNumericValues(const DataTree& data,
+                                      bool& has_nan_number)
+{
+  has_nan_number = false;
+  std::vector<double> values;
+  auto pack = [&values, &has_nan_number](const DataTree& item)
+  {
+    double number;
+    if (numericValue(item, number) and std::isnan(number))
+      has_nan_number = true;
+    values.push_back(number);
+  };
+
+  if (data.grossType() == DataGrossType::SCALAR)
+    pack(data);
+  else if (data.grossType() == DataGrossType::SEQUENCE)
+  {
+    values.reserve(data.numChildren());
+    data.forEachChild(pack);
+  }
+  return values;
+}
+
+/**Calls `function(item, index)` for a scalar, with index
+ * Diagnostic::NO_INDEX, or for each scalar entry of an array with its entry
+ * number.*/
+template <typename F>
+void forEachScalar(const DataTree& data, F&& function)
+{
+  if (data.grossType() == DataGrossType::SCALAR)
+    function(data, Diagnostic::NO_INDEX);
+  else if (data.grossType() == DataGrossType::SEQUENCE)
+  {
+    size_t index = 0;
+    data.forEachChild(
+      [&](const DataTree& entry)
+      {
+        if (entry.grossType() == DataGrossType::SCALAR) function(entry, index);
+        ++index;
+      });
+  }
+}
+
+/**Returns the string representation of a scalar.*/
+std::string stringValue(const ScalarValue& value)
+{
+  if (value.type() == ScalarType::STRING)
+    return value.getValue<std::string>();
+  return value.convertToString();
+}
+
+/**Records a VALUE_CHECK_FAILED error.*/
+void addValueCheckFailure(ParameterDiagnostics& diagnostics,
+                          const ParameterValidationContext& context,
+                          const std::string& name_or_id,
+                          const DataTree& item,
+                          const size_t index,
+                          const std::string_view requirement)
+{
+  auto& diagnostic = diagnostics.add(DiagnosticSeverity::ERROR,
+                                     DiagnosticCode::VALUE_CHECK_FAILED,
+                                     context,
+                                     name_or_id,
+                                     item);
+  diagnostic.m_index = index;
+  diagnostic.m_requirement = requirement;
+}
+} // namespace
+
+// ###################################################################
+bool ArraySizeCheck::performCheck(ParameterDiagnostics& diagnostics,
                                   const DataTree& data,
-                                  const std::string& prefix,
+                                  const ParameterValidationContext& context,
                                   const std::string& name_or_id) const
 {
-  const size_t data_num_children = data.numChildren();
-  if (data_num_children != m_size)
+  if (data.numChildren() != m_size)
   {
-    std::stringstream error_message;
-    // clang-format off
-    error_message
-      << prefix << "Item \"" << name_or_id << "\" is required to be an array "
-      << "of size " << m_size << " but the data provided has "
-      << data_num_children << " entries.\n";
-    // clang-format on
+    diagnostics
+      .add(DiagnosticSeverity::ERROR,
+           DiagnosticCode::ARRAY_SIZE_MISMATCH,
+           context,
+           name_or_id,
+           data)
+      .m_index = m_size;
+    return false;
+  }
+
+  return true;
+}
+
+// ###################################################################
+ArraySizeBoundsCheck::ArraySizeBoundsCheck(const size_t min_size,
+                                           const size_t max_size)
+  : m_min_size(min_size), m_max_size(max_size)
+{
+  elkLogicalErrorIf(min_size > max_size,
+                    "Minimum size " + std::to_string(min_size) +
+                      " is greater than maximum size " +
+                      std::to_string(max_size) + ".");
 
-    status_strings.m_errors.append(error_message.str());
+  if (max_size == std::numeric_limits<size_t>::max())
+    m_requirement = "at least " + std::to_string(min_size);
+  else if (min_size == 0)
+    m_requirement = "at most " + std::to_string(max_size);
+  else
+    m_requirement = "between " + std::to_string(min_size) + " and " +
+                    std::to_string(max_size);
+}
+
+bool ArraySizeBoundsCheck::performCheck(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context,
+  const std::string& name_or_id) const
+{
+  const size_t size = data.numChildren();
+  if (size < m_min_size or size > m_max_size)
+  {
+    diagnostics
+      .add(DiagnosticSeverity::ERROR,
+           DiagnosticCode::ARRAY_SIZE_OUT_OF_BOUNDS,
+           context,
+           name_or_id,
+           data)
+      .m_requirement = m_requirement;
     return false;
   }
 
   return true;
 }
 
-} // namespace elke::param_checks
\ No newline at end of file
+// ###################################################################
+RangeCheck::RangeCheck(const double min, const double max)
+  : m_min(min), m_max(max)
+{
+  elkLogicalErrorIf(not(min <= max),
+                    "Invalid range [" + std::to_string(min) + ", " +
+                      std::to_string(max) + "].");
+
+  std::stringstream requirement;
+  if (std::isinf(min))
+    requirement << "at most " << max;
+  else if (std::isinf(max))
+    requirement << "at least " << min;
+  else
+    requirement << "within [" << min << ", " << max << "]";
+  m_requirement = requirement.str();
+}
+
+/**Returns true if all the values, except NaN, are within the range.*/
+bool RangeCheck::passes(const double* values, const size_t size) const
+{
+  // Counts instead of returning at the first failure, and counts in a
+  // double, so that the loop vectorizes without AVX. NaN compares false
+  // both ways and is not counted.
+  // The bounds are copied since `values` could alias them.
+  const double min = m_min;
+  const double max = m_max;
+  double num_outside = 0.0;
+  for (size_t i = 0; i < size; ++i)
+    num_outside += (values[i] < min or values[i] > max) ? 1.0 : 0.0;
+  return num_outside == 0.0;
+}
+
+bool RangeCheck::performCheck(ParameterDiagnostics& diagnostics,
+                              const DataTree& data,
+                              const ParameterValidationContext& context,
+                              const std::string& name_or_id) const
+{
+  bool has_nan_number;
+  const auto values = packNumericValues(data, has_nan_number);
+  if (not has_nan_number and passes(values.data(), values.size()))
+    return true;
+
+  forEachScalar(data,
+                [&](const DataTree& item, const size_t index)
+                {
+                  const double value =
+                    values[index == Diagnostic::NO_INDEX ? 0 : index];
+                  const bool outside = std::isnan(value)
+                                         ? isNaNNumber(item)
+                                         : value < m_min or value > m_max;
+                  if (outside)
+                    addValueCheckFailure(diagnostics,
+                                         context,
+                                         name_or_id,
+                                         item,
+                                         index,
+                                         m_requirement);
+                });
+  return false;
+}
+
+// ###################################################################
+/**Returns true if each value is greater than the one before it.*/
+bool StrictlyIncreasingCheck::passes(const double* values, const size_t size)
+{
+  // See RangeCheck::passes
+  double num_not_increasing = 0.0;
+  for (size_t i = 1; i < size; ++i)
+    num_not_increasing += values[i] <= values[i - 1] ? 1.0 : 0.0;
+  return num_not_increasing == 0.0;
+}
+
+bool StrictlyIncreasingCheck::performCheck(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context,
+  const std::string& name_or_id) const
+{
+  if (data.grossType() != DataGrossType::SEQUENCE) return true;
+
+  bool has_nan_number;
+  const auto values = packNumericValues(data, has_nan_number);
+  if (not has_nan_number and passes(values.data(), values.size()))
+    return true;
+
+  forEachScalar(data,
+                [&](const DataTree& item, const size_t index)
+                {
+                  const bool not_increasing =
+                    std::isnan(values[index])
+                      ? isNaNNumber(item)
+                      : index > 0 and values[index] <= values[index - 1];
+                  if (not_increasing)
+                    addValueCheckFailure(diagnostics,
+                                         context,
+                                         name_or_id,
+                                         item,
+                                         index,
+                                         "greater than the entry before it");
+                });
+  return false;
+}
+
+// ###################################################################
+/**Returns true if no two values, except NaN, are equal.*/
+bool UniqueEntriesCheck::passes(const double* values, const size_t size)
+{
+  std::vector<double> sorted;
+  sorted.reserve(size);
+  for (size_t i = 0; i < size; ++i)
+    if (not std::isnan(values[i])) sorted.push_back(values[i]);
+
+  std::sort(sorted.begin(), sorted.end());
+  return std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+}
+
+bool UniqueEntriesCheck::performCheck(ParameterDiagnostics& diagnostics,
+                                      const DataTree& data,
+                                      const ParameterValidationContext& context,
+                                      const std::string& name_or_id) const
+{
+  if (data.grossType() != DataGrossType::SEQUENCE) return true;
+
+  // Lists of integers, e.g., IDs, are compared as int64_t since doubles
+  // hold integers exactly only up to 2^53.
+  constexpr double max_exact_integer = 9007199254740992.0; // 2^53
+  std::vector<int64_t> integers;
+  integers.reserve(data.numChildren());
+  bool all_integers = true;
+  data.forEachChild(
+    [&](const DataTree& entry)
+    {
+      all_integers = all_integers and
+                     entry.grossType() == DataGrossType::SCALAR and
+                     entry.value().type() == ScalarType::INTEGER;
+      if (all_integers) integers.push_back(entry.value().getValue<int64_t>());
+    });
+  if (all_integers)
+  {
+    std::sort(integers.begin(), integers.end());
+    if (std::adjacent_find(integers.begin(), integers.end()) == integers.end())
+      return true;
+  }
+  else
+  {
+    // Other numbers are compared as doubles if they are all within 2^53,
+    // i.e., not NaN and such that integers among them are exact.
+    bool has_nan_number;
+    const auto values = packNumericValues(data, has_nan_number);
+    const bool all_exact =
+      std::all_of(values.begin(),
+                  values.end(),
+                  [](const double value)
+                  { return std::abs(value) <= max_exact_integer; });
+    if (all_exact and passes(values.data(), values.size())) return true;
+  }
+
+  //=================================== Other scalars, or duplicates, are
+  //                                    found entry by entry. Integers are
+  //                                    compared exactly, numbers that are
+  //                                    NaN by their string representation.
+  bool passed = true;
+  std::unordered_set<int64_t> integer_values;
+  std::unordered_set<double> float_values;
+  std::unordered_set<std::string> strings;
+  forEachScalar(data,
+                [&](const DataTree& item, const size_t index)
+                {
+                  double number;
+                  int64_t integer;
+                  bool is_new;
+                  if (not numericValue(item, number) or std::isnan(number))
+                    is_new = strings.insert(stringValue(item.value())).second;
+                  else if (integerValue(item, number, integer))
+                    is_new = integer_values.insert(integer).second;
+                  else
+                    is_new = float_values.insert(number).second;
+                  if (is_new) return;
+
+                  addValueCheckFailure(diagnostics,
+                                       context,
+                                       name_or_id,
+                                       item,
+                                       index,
+                                       "different from the entries before it");
+                  passed = false;
+                });
+  return passed;
+}
+
+// ###################################################################
+EnumeratedStringCheck::EnumeratedStringCheck(
+  std::vector<std::string> allowed_values)
+  : m_allowed_values(std::move(allowed_values))
+{
+  m_requirement = "one of";
+  for (size_t i = 0; i < m_allowed_values.size(); ++i)
+    m_requirement += (i == 0 ? " \"" : ", \"") + m_allowed_values[i] + "\"";
+}
+
+bool EnumeratedStringCheck::performCheck(
+  ParameterDiagnostics& diagnostics,
+  const DataTree& data,
+  const ParameterValidationContext& context,
+  const std::string& name_or_id) const
+{
+  bool passed = true;
+  forEachScalar(data,
+                [&](const DataTree& item, const size_t index)
+                {
+                  const auto value = stringValue(item.value());
+                  if (std::find(m_allowed_values.begin(),
+                                m_allowed_values.end(),
+                                value) != m_allowed_values.end())
+                    return;
+
+                  addValueCheckFailure(diagnostics,
+                                       context,
+                                       name_or_id,
+                                       item,
+                                       index,
+                                       m_requirement);
+                  passed = false;
+                });
+  return passed;
+}
+
+// ###################################################################
+struct RegexCheck::CompiledPattern
+{
+  std::regex m_regex;
+};
+
+RegexCheck::RegexCheck(const std::string& pattern)
+{
+  try
+  {
+    m_pattern = std::make_shared<const CompiledPattern>(
+      CompiledPattern{std::regex(pattern, std::regex::ECMAScript)});
+  }
+  catch (const std::regex_error& error)
+  {
+    elkLogicalError("Invalid pattern \"" + pattern + "\": " + error.what());
+  }
+  m_requirement = "a match of the pattern \"" + pattern + "\"";
+}
+
+bool RegexCheck::performCheck(ParameterDiagnostics& diagnostics,
+                              const DataTree& data,
+                              const ParameterValidationContext& context,
+                              const std::string& name_or_id) const
+{
+  bool passed = true;
+  forEachScalar(data,
+                [&](const DataTree& item, const size_t index)
+                {
+                  if (std::regex_match(stringValue(item.value()),
+                                       m_pattern->m_regex))
+                    return;
+
+                  addValueCheckFailure(diagnostics,
+                                       context,
+                                       name_or_id,
+                                       item,
+                                       index,
+                                       m_requirement);
+                  passed = false;
+                });
+  return passed;
+}
+
+} // namespace elke::param_checks
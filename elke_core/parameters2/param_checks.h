@@ -1,6 +1,8 @@
 #ifndef ELK_E_PARAM_CHECKS_H
 #define ELK_E_PARAM_CHECKS_H
 
+#include "ParameterDiagnostics.h"
+#include "ParameterValidationContext.h"
 #include "elke_core/utilities/general_utils.h"
 #include "elke_core/data_types/DataTree.h"
 #include "elke_core/utilities/template_helpers.h"
@@ -8,7 +10,10 @@
 namespace elke::param_checks
 {
 
-/**Base class helper object to define custom checking routines.*/
+/**Base class helper object to define custom checking routines. Checks report
+ * what they find to the ParameterDiagnostics, either with one of the
+ * DiagnosticCode values or, for anything else, with a message of their own
+ * (ParameterDiagnostics::addMessage) indented by `context.indent()`.*/
 class InputCheck
 {
   InputCheck() = default;
@@ -18,9 +23,9 @@ public:
   virtual ~InputCheck() = default;
 
   virtual std::unique_ptr<InputCheck> clone() const = 0;
-  virtual bool performCheck(StatusStrings& status_strings,
+  virtual bool performCheck(ParameterDiagnostics& diagnostics,
                             const DataTree& data,
-                            const std::string& prefix,
+                            const ParameterValidationContext& context,
                             const std::string& name_or_id) const = 0;
 };
 
@@ -45,9 +50,133 @@ class ArraySizeCheck final : public InputCheckCloneAble<ArraySizeCheck>
 public:
   explicit ArraySizeCheck(const size_t size) : m_size(size) {}
 
-  bool performCheck(StatusStrings& status_strings,
+  bool performCheck(ParameterDiagnostics& diagnostics,
                     const DataTree& data,
-                    const std::string& prefix,
+                    const ParameterValidationContext& context,
+                    const std::string& name_or_id) const override;
+};
+
+// ###################################################################
+// Built-in checks
+//
+// The checks below apply to a scalar or to each entry of an array. The
+// numeric ones first pack the values into a contiguous array, entries that
+// are not numbers being packed as NaN so that each value keeps its entry
+// number, and check them in one pass with `passes`. Only if that fails are
+// the offending entries located and reported, as VALUE_CHECK_FAILED. Entries
+// of the wrong type are left to the type checks of the parameter, but
+// numbers that are NaN, e.g., `.nan` in YAML, fail the range and ordering
+// checks.
+//
+// `passes` can be called directly on packed arrays, e.g., on tables read
+// from files, and is written without early exits so that compilers
+// vectorize it.
+
+/**Check that the number of children is within [min_size, max_size].*/
+class ArraySizeBoundsCheck final
+  : public InputCheckCloneAble<ArraySizeBoundsCheck>
+{
+  size_t m_min_size;
+  size_t m_max_size;
+  std::string m_requirement;
+
+public:
+  /**Use std::numeric_limits<size_t>::max() as `max_size` for no upper
+   * bound.*/
+  ArraySizeBoundsCheck(size_t min_size, size_t max_size);
+
+  bool performCheck(ParameterDiagnostics& diagnostics,
+                    const DataTree& data,
+                    const ParameterValidationContext& context,
+                    const std::string& name_or_id) const override;
+};
+
+/**Check that numeric values are within [min, max]. Use infinities for
+ * one-sided ranges.*/
+class RangeCheck final : public InputCheckCloneAble<RangeCheck>
+{
+  double m_min;
+  double m_max;
+  std::string m_requirement;
+
+public:
+  RangeCheck(double min, double max);
+
+  /**Returns true if all the values, except NaN, are within the range.*/
+  bool passes(const double* values, size_t size) const;
+
+  bool performCheck(ParameterDiagnostics& diagnostics,
+                    const DataTree& data,
+                    const ParameterValidationContext& context,
+                    const std::string& name_or_id) const override;
+};
+
+/**Check that each array entry is greater than the one before it.*/
+class StrictlyIncreasingCheck final
+  : public InputCheckCloneAble<StrictlyIncreasingCheck>
+{
+public:
+  /**Returns true if each value is greater than the one before it. NaN
+   * values never fail here, see the notes above.*/
+  static bool passes(const double* values, size_t size);
+
+  bool performCheck(ParameterDiagnostics& diagnostics,
+                    const DataTree& data,
+                    const ParameterValidationContext& context,
+                    const std::string& name_or_id) const override;
+};
+
+/**Check that no two array entries are equal. Numbers are compared by value
+ * (1 equals 1.0), integers exactly as int64_t, other scalars by their
+ * string representation.*/
+class UniqueEntriesCheck final
+  : public InputCheckCloneAble<UniqueEntriesCheck>
+{
+public:
+  /**Returns true if no two values, except NaN, are equal. Sorts a copy of
+   * the values. Integers beyond 2^53 are not exact as doubles, for those
+   * performCheck compares the entries as int64_t.*/
+  static bool passes(const double* values, size_t size);
+
+  bool performCheck(ParameterDiagnostics& diagnostics,
+                    const DataTree& data,
+                    const ParameterValidationContext& context,
+                    const std::string& name_or_id) const override;
+};
+
+/**Check that values, as strings, are one of a list of allowed values.*/
+class EnumeratedStringCheck final
+  : public InputCheckCloneAble<EnumeratedStringCheck>
+{
+  std::vector<std::string> m_allowed_values;
+  std::string m_requirement;
+
+public:
+  explicit EnumeratedStringCheck(std::vector<std::string> allowed_values);
+
+  bool performCheck(ParameterDiagnostics& diagnostics,
+                    const DataTree& data,
+                    const ParameterValidationContext& context,
+                    const std::string& name_or_id) const override;
+};
+
+/**Check that values, as strings, fully match a regular expression
+ * (ECMAScript grammar). Throws a LogicError if the pattern is invalid.*/
+class RegexCheck final : public InputCheckCloneAble<RegexCheck>
+{
+  /// Holds the compiled std::regex, shared by clones, so that <regex> is
+  /// not included everywhere ParameterTree is.
+  struct CompiledPattern;
+
+  std::shared_ptr<const CompiledPattern> m_pattern;
+  std::string m_requirement;
+
+public:
+  explicit RegexCheck(const std::string& pattern);
+
+  bool performCheck(ParameterDiagnostics& diagnostics,
+                    const DataTree& data,
+                    const ParameterValidationContext& context,
                     const std::string& name_or_id) const override;
 };
 
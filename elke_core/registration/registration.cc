@@ -56,4 +56,12 @@ StaticRegister::getInputParameterBlockRegistry()
   return registry.m_input_blocks_register;
 }
 
+// ###################################################################
+const std::map<std::string, InputParserRegisterEntry>&
+StaticRegister::getInputParserRegister()
+{
+  auto& registry = getInstance();
+  return registry.m_input_parser_register;
+}
+
 } // namespace elke
@@ -4,9 +4,13 @@
 #include "elke_core/parameters2/ParameterTree.h"
 #include "elke_core/syntax_blocks/SyntaxBlock.h"
 #include "elke_core/factory/FactoryObject.h"
+#include "elke_core/input/InputParser.h"
 
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 /**Small utility macro for joining two words.*/
 #define RJoinWordsA(x, y) x##y
@@ -32,8 +36,19 @@
     elke::StaticRegister::registerNamedParameterTree<class_name>(            \
       #class_name)
 
+/**Macro for registering an input parser for one or more file extensions,
+ * e.g., `elkeRegisterInputParser(elke::YAMLInput, ".yaml", ".yml");`. The
+ * class must be constructible from an `elke::Logger&` and provide
+ * `static bool canParseContent(std::string_view head)`, which is used to
+ * identify files without an extension.*/
+#define elkeRegisterInputParser(class_name, ...)                               \
+  static char RJoinWordsB(unique_var_name3_, __COUNTER__) =                    \
+    elke::StaticRegister::registerInputParser<class_name>(#class_name,         \
+                                                          {__VA_ARGS__})
+
 namespace elke
 {
+class Logger;
 
 // ###################################################################
 //  Helpers
@@ -67,6 +82,18 @@ struct NamedParameterTreeRegistryEntry
   GetParametersFunction m_parameter_function = nullptr;
 };
 
+using InputParserPtr = std::unique_ptr<InputParser>;
+using InputParserConstructionFunction = InputParserPtr (*)(elke::Logger&);
+using InputContentSniffFunction = bool (*)(std::string_view);
+
+struct InputParserRegisterEntry
+{
+  /**Extensions including the leading dot, e.g., ".yaml".*/
+  std::vector<std::string> m_extensions;
+  InputContentSniffFunction m_sniff_function = nullptr;
+  InputParserConstructionFunction m_constructor_function = nullptr;
+};
+
 // ###################################################################
 /**A singleton for static registration.*/
 class StaticRegister
@@ -76,6 +103,7 @@ class StaticRegister
   std::map<std::string, FactoryObjectRegisterEntry> m_factory_object_register;
   std::map<std::string, NamedParameterTreeRegistryEntry>
     m_input_blocks_register;
+  std::map<std::string, InputParserRegisterEntry> m_input_parser_register;
 
 public:
   static StaticRegister& getInstance();
@@ -90,6 +118,9 @@ public:
   /**Returns the input block register.*/
   static const std::map<std::string, NamedParameterTreeRegistryEntry>&
   getInputParameterBlockRegistry();
+  /**Returns the input parser register.*/
+  static const std::map<std::string, InputParserRegisterEntry>&
+  getInputParserRegister();
 
   static char registerNullaryFunction(const std::string& function_name,
                                       NullaryFunction function);
@@ -144,6 +175,24 @@ public:
     return 0;
   }
 
+  template <typename TargetType>
+  static char registerInputParser(const std::string& parser_name,
+                                  std::vector<std::string> extensions)
+  {
+    auto& registry = getInstance();
+
+    InputParserRegisterEntry new_entry;
+
+    new_entry.m_extensions = std::move(extensions);
+    new_entry.m_sniff_function = TargetType::canParseContent;
+    new_entry.m_constructor_function =
+      ProxyInputParserConstructor<TargetType, InputParser>;
+
+    registry.m_input_parser_register[parser_name] = new_entry;
+
+    return 0;
+  }
+
   ///@{ Delete all copy/move/assignment methods.
   StaticRegister(StaticRegister const&) = delete;            // copy constructor
   StaticRegister(StaticRegister&&) = delete;                 // move constructor
@@ -166,6 +215,11 @@ private:
   {
     return std::make_shared<TargetType>(params);
   }
+  template <typename TargetType, typename BaseType>
+  static std::unique_ptr<BaseType> ProxyInputParserConstructor(Logger& logger)
+  {
+    return std::make_unique<TargetType>(logger);
+  }
 };
 } // namespace elke
 
@@ -9,6 +9,12 @@ elkeRegisterSyntaxBlock(/*class_name=*/elke::SimulationBlock,
 namespace elke
 {
 
+namespace
+{
+constexpr ParameterKey<double> SCALE_KEY("scale");
+constexpr ParameterKey<double> OFFSET_KEY("offset");
+} // namespace
+
 ParameterTree SimulationBlock::getInputParameters()
 {
   auto params = ParameterTree(
@@ -23,10 +29,9 @@ ParameterTree SimulationBlock::getInputParameters()
 }
 
 SimulationBlock::SimulationBlock(const ParameterTree& params)
-  : SyntaxBlock(params)
-// ,
-//     m_scale(params.getParameterValue<double>("scale")),
-//     m_delta(params.getParameterValue<double>("offset"))
+  : SyntaxBlock(params),
+    m_scale(params.getParameterValue(SCALE_KEY)),
+    m_delta(params.getParameterValue(OFFSET_KEY))
 {
 }
 
@@ -0,0 +1,110 @@
+#include "BKTree.h"
+#include "string_utils.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace elke::string_utils
+{
+
+// ###################################################################
+/**Creates a tree from a list of words.*/
+BKTree::BKTree(const std::vector<std::string>& words)
+{
+  m_nodes.reserve(words.size());
+  for (const auto& word : words)
+    insert(word);
+}
+
+// ###################################################################
+/**Inserts a word. Duplicates are ignored.*/
+void BKTree::insert(const std::string& word)
+{
+  const size_t order = m_nodes.size();
+  if (m_nodes.empty())
+  {
+    m_nodes.push_back({word, order, 0, {}});
+    return;
+  }
+
+  size_t node_index = 0;
+  while (true)
+  {
+    const unsigned int dist =
+      computeLevenshteinDistance(word, m_nodes[node_index].m_word);
+    if (dist == 0) return;
+
+    auto& children = m_nodes[node_index].m_children;
+    const auto it = std::find_if(children.begin(),
+                                 children.end(),
+                                 [dist](const auto& child)
+                                 { return child.first == dist; });
+    if (it != children.end())
+    {
+      node_index = it->second;
+      continue;
+    }
+
+    children.emplace_back(dist, m_nodes.size());
+    auto& max_child_distance = m_nodes[node_index].m_max_child_distance;
+    max_child_distance = std::max(max_child_distance, dist);
+    m_nodes.push_back({word, order, 0, {}});
+    return;
+  }
+}
+
+// ###################################################################
+/**Returns the word closest to `input` within `distance_threshold`.*/
+std::string BKTree::findClosest(const std::string& input,
+                                const unsigned int distance_threshold) const
+{
+  if (m_nodes.empty()) return {};
+
+  auto lengthDifference = [&input](const std::string& word)
+  {
+    return input.size() > word.size() ? input.size() - word.size()
+                                      : word.size() - input.size();
+  };
+
+  // The search radius shrinks to the best distance found so far. Equal
+  // distances are kept so that the tie-break can be applied.
+  unsigned int radius = distance_threshold;
+  const Node* best = nullptr;
+  auto bestKey = [&lengthDifference](unsigned int dist, const Node& node)
+  { return std::make_tuple(dist, lengthDifference(node.m_word), node.m_order); };
+  std::tuple<unsigned int, size_t, size_t> best_key;
+
+  std::vector<size_t> stack = {0};
+  while (not stack.empty())
+  {
+    const Node& node = m_nodes[stack.back()];
+    stack.pop_back();
+
+    // Children are only reachable when their key is within the radius of
+    // the distance, so the distance is only needed up to
+    // radius + max_child_distance.
+    const unsigned int bound = radius + node.m_max_child_distance;
+    const unsigned int dist =
+      computeLevenshteinDistance(input, node.m_word, bound);
+
+    if (dist <= radius)
+    {
+      const auto key = bestKey(dist, node);
+      if (best == nullptr or key < best_key)
+      {
+        best = &node;
+        best_key = key;
+        radius = dist;
+      }
+    }
+
+    if (dist > bound) continue;
+    for (const auto& [child_dist, child_index] : node.m_children)
+      if (child_dist + radius >= dist and child_dist <= dist + radius)
+        stack.push_back(child_index);
+  }
+
+  return best == nullptr ? std::string{} : best->m_word;
+}
+
+} // namespace elke::string_utils
@@ -0,0 +1,54 @@
+#ifndef ELKE_CORE_UTILITIES_BKTREE_H
+#define ELKE_CORE_UTILITIES_BKTREE_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace elke::string_utils
+{
+
+// ###################################################################
+/**Burkhard-Keller tree over a set of words with the Levenshtein distance as
+ * metric. Every child of a node is keyed by its distance to the node, so a
+ * lookup with radius r only descends into children whose key lies within r
+ * of the distance between the query and the node (triangle inequality).
+ * Building is done once per word list; a lookup then typically visits a
+ * small fraction of the words instead of all of them.*/
+class BKTree
+{
+  struct Node
+  {
+    std::string m_word;
+    size_t m_order; ///< Insertion order, used to break ties.
+    unsigned int m_max_child_distance = 0;
+    /// Pairs of (distance, node index).
+    std::vector<std::pair<unsigned int, size_t>> m_children;
+  };
+
+  std::vector<Node> m_nodes;
+
+public:
+  /**Creates an empty tree.*/
+  BKTree() = default;
+
+  /**Creates a tree from a list of words.*/
+  explicit BKTree(const std::vector<std::string>& words);
+
+  /**Inserts a word. Duplicates are ignored.*/
+  void insert(const std::string& word);
+
+  /**Returns the number of words in the tree.*/
+  size_t size() const { return m_nodes.size(); }
+
+  /**Returns the word closest to `input` within `distance_threshold`, or an
+   * empty string if there is none. Ties are broken by the smallest
+   * difference in length (a substitution is preferred over an insertion or
+   * deletion), then by insertion order.*/
+  std::string findClosest(const std::string& input,
+                          unsigned int distance_threshold = 4) const;
+};
+
+} // namespace elke::string_utils
+
+#endif // ELKE_CORE_UTILITIES_BKTREE_H
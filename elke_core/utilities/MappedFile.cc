@@ -0,0 +1,98 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) or defined(__APPLE__)
+#define ELKE_MMAP_AVAILABLE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace elke
+{
+
+// ###################################################################
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+#ifdef ELKE_MMAP_AVAILABLE
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    struct stat file_stat{};
+    if (::fstat(fd, &file_stat) == 0 and S_ISREG(file_stat.st_mode))
+    {
+      const auto size = static_cast<size_t>(file_stat.st_size);
+      // Empty files cannot be mapped; they simply have an empty view.
+      if (size == 0) m_is_open = true;
+      else
+      {
+        void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED)
+        {
+          // Parsers read the file front to back.
+          ::madvise(address, size, MADV_SEQUENTIAL);
+          m_mapped_address = address;
+          m_mapped_size = size;
+          m_view = std::string_view(static_cast<const char*>(address), size);
+          m_is_open = true;
+        }
+      }
+    }
+    ::close(fd);
+    if (m_is_open) return;
+  }
+#endif
+
+  //=================================== Fallback, read into a buffer
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (not file.is_open())
+  {
+    m_is_open = false;
+    return;
+  }
+  using iterator = std::istreambuf_iterator<char>;
+  m_buffer.assign(iterator(file), iterator());
+  m_view = m_buffer;
+  m_is_open = true;
+}
+
+// ###################################################################
+MappedFile::~MappedFile() { release(); }
+
+// ###################################################################
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+// ###################################################################
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this == &other) return *this;
+  release();
+
+  m_is_open = std::exchange(other.m_is_open, false);
+  m_mapped_address = std::exchange(other.m_mapped_address, nullptr);
+  m_mapped_size = std::exchange(other.m_mapped_size, 0);
+  const bool owns_buffer = m_mapped_address == nullptr;
+  m_buffer = std::move(other.m_buffer);
+  m_view = owns_buffer ? std::string_view(m_buffer) : other.m_view;
+  other.m_view = {};
+
+  return *this;
+}
+
+// ###################################################################
+void MappedFile::release() noexcept
+{
+#ifdef ELKE_MMAP_AVAILABLE
+  if (m_mapped_address != nullptr) ::munmap(m_mapped_address, m_mapped_size);
+#endif
+  m_mapped_address = nullptr;
+  m_mapped_size = 0;
+  m_buffer.clear();
+  m_view = {};
+  m_is_open = false;
+}
+
+} // namespace elke
@@ -0,0 +1,50 @@
+#ifndef ELKE_CORE_UTILITIES_MAPPEDFILE_H
+#define ELKE_CORE_UTILITIES_MAPPEDFILE_H
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace elke
+{
+
+// ###################################################################
+/**Read-only view of a whole file. On POSIX systems the file is memory
+ * mapped, so that the pages are read lazily by the OS and the same bytes can
+ * be shared by everything that needs the file's content (echoing, content
+ * sniffing, parsing) without copies. Elsewhere, or if mapping fails, the
+ * file is read into an owned buffer once.*/
+class MappedFile
+{
+public:
+  /**Opens and maps the file. Check isOpen() afterwards.*/
+  explicit MappedFile(const std::filesystem::path& path);
+  ~MappedFile();
+
+  ///@{ Non-copyable, movable.
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  ///@}
+
+  /**True if the file could be opened.*/
+  bool isOpen() const { return m_is_open; }
+  /**The file's content. Valid for the lifetime of this object.*/
+  std::string_view view() const { return m_view; }
+  /**True if the content is memory mapped rather than read.*/
+  bool isMapped() const { return m_mapped_address != nullptr; }
+
+private:
+  void release() noexcept;
+
+  bool m_is_open = false;
+  void* m_mapped_address = nullptr;
+  size_t m_mapped_size = 0;
+  std::string m_buffer; ///< Fallback storage when not mapped
+  std::string_view m_view;
+};
+
+} // namespace elke
+
+#endif // ELKE_CORE_UTILITIES_MAPPEDFILE_H
@@ -0,0 +1,157 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+namespace elke
+{
+
+namespace
+{
+/**Identifies the pool and deque of worker threads.*/
+thread_local const WorkStealingPool* t_worker_pool = nullptr;
+thread_local size_t t_worker_deque_index = 0;
+} // namespace
+
+// ###################################################################
+WorkStealingPool::WorkStealingPool(const size_t num_workers)
+{
+  for (size_t d = 0; d <= num_workers; ++d)
+    m_deques.push_back(std::make_unique<TaskDeque>());
+
+  m_threads.reserve(num_workers);
+  for (size_t w = 0; w < num_workers; ++w)
+    m_threads.emplace_back([this, w] { workerLoop(w); });
+}
+
+// ###################################################################
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    std::lock_guard lock(m_idle_mutex);
+    m_stopping = true;
+  }
+  m_idle_condition.notify_all();
+
+  for (auto& thread : m_threads)
+    thread.join();
+}
+
+// ###################################################################
+WorkStealingPool& WorkStealingPool::getGlobalPool()
+{
+  static WorkStealingPool pool(
+    std::max(std::thread::hardware_concurrency(), 1u) - 1);
+  return pool;
+}
+
+// ###################################################################
+size_t WorkStealingPool::callerDequeIndex() const
+{
+  return t_worker_pool == this ? t_worker_deque_index : m_threads.size();
+}
+
+// ###################################################################
+void WorkStealingPool::submit(Task task)
+{
+  {
+    auto& deque = *m_deques[callerDequeIndex()];
+    std::lock_guard lock(deque.m_mutex);
+    deque.m_tasks.push_back(std::move(task));
+  }
+  m_num_queued.fetch_add(1);
+
+  // Taking the mutex orders the increment before a worker's predicate
+  // check, so that the notification cannot be lost.
+  {
+    std::lock_guard lock(m_idle_mutex);
+  }
+  m_idle_condition.notify_one();
+}
+
+// ###################################################################
+bool WorkStealingPool::tryRunOneTask()
+{
+  if (m_num_queued.load() == 0) return false;
+
+  const size_t own_index = callerDequeIndex();
+  const size_t num_deques = m_deques.size();
+  Task task;
+
+  //=================================== Own deque, newest first
+  {
+    auto& deque = *m_deques[own_index];
+    std::lock_guard lock(deque.m_mutex);
+    if (not deque.m_tasks.empty())
+    {
+      task = std::move(deque.m_tasks.back());
+      deque.m_tasks.pop_back();
+    }
+  }
+
+  //=================================== Steal, oldest first
+  for (size_t k = 1; k < num_deques and not task; ++k)
+  {
+    auto& deque = *m_deques[(own_index + k) % num_deques];
+    std::lock_guard lock(deque.m_mutex);
+    if (not deque.m_tasks.empty())
+    {
+      task = std::move(deque.m_tasks.front());
+      deque.m_tasks.pop_front();
+    }
+  }
+
+  if (not task) return false;
+
+  m_num_queued.fetch_sub(1);
+  task();
+  return true;
+}
+
+// ###################################################################
+void WorkStealingPool::workerLoop(const size_t deque_index)
+{
+  t_worker_pool = this;
+  t_worker_deque_index = deque_index;
+
+  while (true)
+  {
+    if (tryRunOneTask()) continue;
+
+    std::unique_lock lock(m_idle_mutex);
+    m_idle_condition.wait(
+      lock, [this] { return m_stopping or m_num_queued.load() > 0; });
+    if (m_stopping and m_num_queued.load() == 0) return;
+  }
+}
+
+// ###################################################################
+TaskGroup::~TaskGroup() { helpUntilDone(); }
+
+// ###################################################################
+void TaskGroup::wait()
+{
+  helpUntilDone();
+
+  std::exception_ptr exception;
+  {
+    std::lock_guard lock(m_exception_mutex);
+    std::swap(exception, m_exception);
+  }
+  if (exception) std::rethrow_exception(exception);
+}
+
+// ###################################################################
+void TaskGroup::helpUntilDone()
+{
+  while (m_num_pending.load(std::memory_order_acquire) > 0)
+    if (not m_pool.tryRunOneTask()) std::this_thread::yield();
+}
+
+// ###################################################################
+void TaskGroup::recordException(std::exception_ptr exception)
+{
+  std::lock_guard lock(m_exception_mutex);
+  if (not m_exception) m_exception = std::move(exception);
+}
+
+} // namespace elke
@@ -0,0 +1,134 @@
+#ifndef ELKE_CORE_UTILITIES_WORKSTEALINGPOOL_H
+#define ELKE_CORE_UTILITIES_WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace elke
+{
+
+// ###################################################################
+/**Thread pool for fork-join parallelism. Every worker has its own task
+ * deque: it pushes and pops its own tasks at the back (depth first, cache
+ * friendly) while idle workers steal from the front of the others' deques
+ * (the oldest, typically largest, tasks). Threads that are not workers
+ * submit to a shared deque.
+ *
+ * Tasks are normally not submitted directly but through a TaskGroup, whose
+ * wait() runs pending tasks instead of blocking, so that tasks may
+ * themselves fork and wait without deadlocking the pool.*/
+class WorkStealingPool
+{
+public:
+  using Task = std::function<void()>;
+
+  /**Starts `num_workers` threads. With zero workers every task is run by
+   * the thread waiting for it.*/
+  explicit WorkStealingPool(size_t num_workers);
+  /**Runs the remaining tasks and joins the workers.*/
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  /**The process-wide pool, started on first use with one worker less than
+   * the number of hardware threads (the waiting thread is the last one).*/
+  static WorkStealingPool& getGlobalPool();
+
+  /**Number of worker threads.*/
+  size_t numWorkers() const { return m_threads.size(); }
+
+  /**Queues a task.*/
+  void submit(Task task);
+
+  /**Runs one queued task, preferring the calling worker's own deque.
+   * Returns false if no task was found.*/
+  bool tryRunOneTask();
+
+private:
+  struct TaskDeque
+  {
+    std::mutex m_mutex;
+    std::deque<Task> m_tasks;
+  };
+
+  void workerLoop(size_t deque_index);
+  /**Index of the caller's deque: its own for workers of this pool, the
+   * shared one for everybody else.*/
+  size_t callerDequeIndex() const;
+
+  /// One deque per worker, the last one is shared by other threads.
+  std::vector<std::unique_ptr<TaskDeque>> m_deques;
+  std::vector<std::thread> m_threads;
+  std::atomic<size_t> m_num_queued = 0;
+  std::atomic<bool> m_stopping = false;
+  std::mutex m_idle_mutex;
+  std::condition_variable m_idle_condition;
+};
+
+// ###################################################################
+/**A set of tasks that is waited for together. Exceptions thrown by the
+ * tasks are captured and the first one is rethrown by wait().
+ * ```c++
+ * TaskGroup group(WorkStealingPool::getGlobalPool());
+ * group.run([&] { left_result = solve(left); });
+ * right_result = solve(right);
+ * group.wait();
+ * ```
+ * The destructor waits as well, so that tasks referring to the caller's
+ * stack never outlive it, e.g., if the caller's own work throws.*/
+class TaskGroup
+{
+public:
+  explicit TaskGroup(WorkStealingPool& pool) : m_pool(pool) {}
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  /**Queues `function` on the pool.*/
+  template <typename F>
+  void run(F&& function)
+  {
+    m_num_pending.fetch_add(1, std::memory_order_relaxed);
+    m_pool.submit(
+      [this, function = std::forward<F>(function)]() mutable
+      {
+        try
+        {
+          function();
+        }
+        catch (...)
+        {
+          recordException(std::current_exception());
+        }
+        // Last access to the group, which may be destroyed right after.
+        m_num_pending.fetch_sub(1, std::memory_order_release);
+      });
+  }
+
+  /**Runs pending tasks of the pool until all tasks of this group are done,
+   * then rethrows the first exception thrown by any of them.*/
+  void wait();
+
+private:
+  void helpUntilDone();
+  void recordException(std::exception_ptr exception);
+
+  WorkStealingPool& m_pool;
+  std::atomic<size_t> m_num_pending = 0;
+  std::mutex m_exception_mutex;
+  std::exception_ptr m_exception;
+};
+
+} // namespace elke
+
+#endif // ELKE_CORE_UTILITIES_WORKSTEALINGPOOL_H
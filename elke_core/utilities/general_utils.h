@@ -1,7 +1,12 @@
 #ifndef ELKE_CORE_UTILITIES_GENERAL_UTILS_H
 #define ELKE_CORE_UTILITIES_GENERAL_UTILS_H
 
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace elke
@@ -13,18 +18,6 @@ struct WarningsAndErrorsData
   std::vector<std::string> m_errors;
 };
 
-struct StatusStrings
-{
-  std::string m_errors;
-  std::string m_warnings;
-
-  void operator+=(const StatusStrings& other)
-  {
-    m_errors += other.m_errors;
-    m_warnings += other.m_warnings;
-  }
-};
-
 void Abort(const std::string& program_phase);
 
 /**Makes a deep copy of a vector of unique pointers. Requires that the
@@ -0,0 +1,134 @@
+#include "hash_utils.h"
+
+namespace elke::hash_utils
+{
+
+namespace
+{
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t rotateLeft(const uint64_t value, const int bits)
+{
+  return (value << bits) | (value >> (64 - bits));
+}
+
+/**Little-endian loads, independent of the host byte order.*/
+uint64_t read64(const unsigned char* p)
+{
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; --i)
+    value = (value << 8) | p[i];
+  return value;
+}
+
+uint64_t read32(const unsigned char* p)
+{
+  return uint64_t{p[0]} | (uint64_t{p[1]} << 8) | (uint64_t{p[2]} << 16) |
+         (uint64_t{p[3]} << 24);
+}
+
+uint64_t round(uint64_t accumulator, const uint64_t input)
+{
+  accumulator += input * PRIME64_2;
+  accumulator = rotateLeft(accumulator, 31);
+  return accumulator * PRIME64_1;
+}
+
+uint64_t mergeRound(uint64_t accumulator, const uint64_t value)
+{
+  accumulator ^= round(0, value);
+  return accumulator * PRIME64_1 + PRIME64_4;
+}
+} // namespace
+
+// ###################################################################
+uint64_t xxHash64(const std::string_view data, const uint64_t seed /*=0*/)
+{
+  const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  const unsigned char* const end = p + data.size();
+  uint64_t hash = 0;
+
+  //=================================== Stripes of 32 bytes
+  if (data.size() >= 32)
+  {
+    uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+    uint64_t v2 = seed + PRIME64_2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - PRIME64_1;
+
+    const unsigned char* const limit = end - 32;
+    do {
+      v1 = round(v1, read64(p));
+      v2 = round(v2, read64(p + 8));
+      v3 = round(v3, read64(p + 16));
+      v4 = round(v4, read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+
+    hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) +
+           rotateLeft(v4, 18);
+    hash = mergeRound(hash, v1);
+    hash = mergeRound(hash, v2);
+    hash = mergeRound(hash, v3);
+    hash = mergeRound(hash, v4);
+  }
+  else
+    hash = seed + PRIME64_5;
+
+  hash += static_cast<uint64_t>(data.size());
+
+  //=================================== Remaining bytes
+  for (; p + 8 <= end; p += 8)
+  {
+    hash ^= round(0, read64(p));
+    hash = rotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+  }
+  if (p + 4 <= end)
+  {
+    hash ^= read32(p) * PRIME64_1;
+    hash = rotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+    p += 4;
+  }
+  for (; p < end; ++p)
+  {
+    hash ^= (*p) * PRIME64_5;
+    hash = rotateLeft(hash, 11) * PRIME64_1;
+  }
+
+  //=================================== Avalanche
+  hash ^= hash >> 33;
+  hash *= PRIME64_2;
+  hash ^= hash >> 29;
+  hash *= PRIME64_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+// ###################################################################
+Hash128 hash128(const std::string_view data)
+{
+  // The second seed is arbitrary, it only has to differ from the first.
+  return {xxHash64(data, 0), xxHash64(data, PRIME64_3)};
+}
+
+// ###################################################################
+std::string toHexString(uint64_t hash)
+{
+  constexpr char DIGITS[] = "0123456789abcdef";
+  std::string hex(16, '0');
+  for (int i = 15; i >= 0; --i, hash >>= 4)
+    hex[i] = DIGITS[hash & 0xF];
+  return hex;
+}
+
+// ###################################################################
+std::string toHexString(const Hash128& hash)
+{
+  return toHexString(hash.m_high) + toHexString(hash.m_low);
+}
+
+} // namespace elke::hash_utils
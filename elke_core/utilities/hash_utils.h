@@ -0,0 +1,69 @@
+#ifndef ELKE_CORE_UTILITIES_HASH_UTILS_H
+#define ELKE_CORE_UTILITIES_HASH_UTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace elke::hash_utils
+{
+
+/**Computes the 64-bit xxHash (XXH64) of `data`. This is a fast,
+ * non-cryptographic hash, suitable for identifying content (e.g., input
+ * files) but not for anything security related.*/
+uint64_t xxHash64(std::string_view data, uint64_t seed = 0);
+
+/**Computes the 64-bit FNV-1a hash of `data`. Slower than xxHash64 on long
+ * inputs but usable at compile time, e.g., for hashing names used as
+ * lookup keys.*/
+constexpr uint64_t fnv1a64(const std::string_view data)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char c : data)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**A 128-bit hash, for identifying many items (e.g., every subtree of a
+ * large input) where 64-bit collisions can no longer be ruled out.*/
+struct Hash128
+{
+  uint64_t m_low = 0;
+  uint64_t m_high = 0;
+
+  bool operator==(const Hash128& other) const
+  {
+    return m_low == other.m_low and m_high == other.m_high;
+  }
+  bool operator!=(const Hash128& other) const { return not(*this == other); }
+};
+
+/**Hash function object for using Hash128 as a key of unordered
+ * containers.*/
+struct Hash128Hasher
+{
+  size_t operator()(const Hash128& hash) const
+  {
+    return static_cast<size_t>(hash.m_low);
+  }
+};
+
+/**Computes a 128-bit hash of `data` from two independently seeded XXH64
+ * hashes. Same caveats as xxHash64.*/
+Hash128 hash128(std::string_view data);
+
+/**Returns the 16-digit, zero padded, lowercase hexadecimal representation
+ * of a hash.*/
+std::string toHexString(uint64_t hash);
+
+/**Returns the 32-digit hexadecimal representation of a 128-bit hash, high
+ * half first.*/
+std::string toHexString(const Hash128& hash);
+
+} // namespace elke::hash_utils
+
+#endif // ELKE_CORE_UTILITIES_HASH_UTILS_H
@@ -1,5 +1,10 @@
 #include "string_utils.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+
 namespace elke::string_utils
 {
 
@@ -10,71 +15,60 @@ splitString(const std::string& input,
             const std::string& delimiter /* = " " */,
             const bool treat_consecutive_delimiters_as_one /* = true */)
 {
-  std::vector<std::string> output;
-  const size_t input_len = input.size();
-  const size_t delimiter_len = delimiter.size();
-  typedef std::pair<size_t, size_t> DelimiterCoord;
-  constexpr size_t infty = std::string::npos;
+  std::vector<std::string_view> words;
+  splitStringView(input, delimiter, treat_consecutive_delimiters_as_one, words);
 
-  //============================================= Establish delimiters
-  // First we find and store other the delimiter locations
-  std::vector<DelimiterCoord> delimiter_locations;
-  size_t last_pos = 0;
-  while (true)
+  return {words.begin(), words.end()};
+}
+
+// ###################################################################
+/**Split a string given a delimiter without copying the words.*/
+std::vector<std::string_view>
+splitStringView(const std::string_view input,
+                const std::string_view delimiter /* = " " */,
+                const bool treat_consecutive_delimiters_as_one /* = true */)
+{
+  std::vector<std::string_view> words;
+  splitStringView(input, delimiter, treat_consecutive_delimiters_as_one, words);
+  return words;
+}
+
+// ###################################################################
+/**Split a string given a delimiter into a caller-provided buffer.
+ *
+ * Empty words at the start and end of the input are never produced. Empty
+ * words between consecutive delimiters are only produced when
+ * `treat_consecutive_delimiters_as_one` is false.*/
+void splitStringView(const std::string_view input,
+                     const std::string_view delimiter,
+                     const bool treat_consecutive_delimiters_as_one,
+                     std::vector<std::string_view>& words)
+{
+  words.clear();
+  if (input.empty()) return;
+  if (delimiter.empty())
   {
-    size_t find_pos = input.find(delimiter, last_pos);
-    if (find_pos == infty) break;
-    // else
-    last_pos = find_pos + delimiter_len;
-    delimiter_locations.emplace_back(find_pos, last_pos);
+    words.push_back(input);
+    return;
   }
 
-  //============================================= Merge delimiters (if needed)
-  if (treat_consecutive_delimiters_as_one)
+  size_t last_pos = 0;
+  while (true)
   {
-    const auto original_delimiter_locations = delimiter_locations;
-    delimiter_locations.clear();
-    DelimiterCoord last_delimiter_location = {infty, infty};
-    for (const auto& delimiter_location : original_delimiter_locations)
+    const size_t find_pos = input.find(delimiter, last_pos);
+    if (find_pos == std::string_view::npos)
     {
-      const auto& [del_begin, del_end] = delimiter_location;
-      const auto& [last_del_begin, last_del_end] = last_delimiter_location;
-
-      if (del_begin != last_del_end)
-      {
-        delimiter_locations.emplace_back(del_begin, del_end);
-        last_delimiter_location = {del_begin, del_end};
-      }
-      else
-      {
-        delimiter_locations.back().second = del_end;
-        last_delimiter_location = {last_del_begin, del_end};
-      }
+      if (last_pos < input.size()) words.push_back(input.substr(last_pos));
+      return;
     }
-  } // if (treat_consecutive_delimiters_as_one)
 
-  //============================================= Extract words
-  last_pos = 0;
-  for (const auto& delimiter_location : delimiter_locations)
-  {
-    const auto& [del_start, del_end] = delimiter_location;
+    const auto word = input.substr(last_pos, find_pos - last_pos);
+    const bool keep_empty =
+      not treat_consecutive_delimiters_as_one and last_pos != 0;
+    if (not word.empty() or keep_empty) words.push_back(word);
 
-    const size_t word_length = del_start - last_pos;
-    if (last_pos == 0 and word_length == 0) /*pass*/ {}
-    else
-      output.push_back(input.substr(last_pos, word_length));
-    last_pos = del_end;
-
-    if (delimiter_location == delimiter_locations.back())
-      if (del_end != input_len)
-        output.push_back(input.substr(del_end, input_len - del_end));
+    last_pos = find_pos + delimiter.size();
   }
-
-  //============================================= Special case
-  // Case where no delimiters are found
-  if (delimiter_locations.empty() and input_len > 0) output.push_back(input);
-
-  return output;
 }
 
 // ###################################################################
@@ -95,17 +89,19 @@ findClosestMatchingString(const std::string& input,
                           const std::vector<std::string>& list,
                           const unsigned int distance_threshold /*=4*/)
 {
-  unsigned int min_dist = 1000000; // Large number
+  unsigned int bound = distance_threshold;
   std::string suggestion;
 
   for (const std::string& word : list)
   {
-    const unsigned int dist = computeLevenshteinDistance(input, word);
-    // Only consider words within a threshold
-    if (dist <= distance_threshold && dist < min_dist)
+    const unsigned int dist = computeLevenshteinDistance(input, word, bound);
+    // Only consider words within the bound. Once a word is found, only
+    // strictly closer words can replace it, so the bound tightens.
+    if (dist <= bound)
     {
-      min_dist = dist;
       suggestion = word;
+      if (dist == 0) break;
+      bound = dist - 1;
     }
   }
   return suggestion;
@@ -117,85 +113,166 @@ findClosestMatchingString(const std::string& input,
  * between two sequences. */
 unsigned int computeLevenshteinDistance(const std::string& s1,
                                         const std::string& s2)
+{
+  // The distance can never exceed the length of the longer string.
+  const auto max_distance =
+    static_cast<unsigned int>(std::max(s1.length(), s2.length()));
+  return computeLevenshteinDistance(s1, s2, max_distance);
+}
+
+// ###################################################################
+/**Bounded Levenshtein distance (Ukkonen's cut-off).
+ *
+ * Only the band of the dynamic-programming matrix within `max_distance` of
+ * the diagonal is evaluated, since any cell outside it already exceeds the
+ * bound. Two rows are kept instead of the full matrix and the computation
+ * stops as soon as every cell of a row exceeds the bound, because the row
+ * minimum never decreases from one row to the next.*/
+unsigned int computeLevenshteinDistance(const std::string& s1,
+                                        const std::string& s2,
+                                        const unsigned int max_distance)
 {
   using uint = unsigned int;
   const uint m = s1.length();
   const uint n = s2.length();
+  const uint k = max_distance;
+  const uint too_far = k + 1;
+
+  //=================================== Trivial cases
+  if ((m > n ? m - n : n - m) > k) return too_far;
+  if (m == 0) return n;
+  if (n == 0) return m;
+
+  //=================================== Initialize the first row
+  // The distance from an empty prefix of s1 to a prefix of length j of s2 is
+  // j (j insertions). Cells outside the band are held at too_far.
+  std::vector<uint> prev(n + 1, too_far);
+  std::vector<uint> curr(n + 1, too_far);
+  for (uint j = 0; j <= std::min(n, k); ++j)
+    prev[j] = j;
 
-  // Create a 2D vector (matrix) to store the distances
-  // The matrix size is (m+1) x (n+1)
-  using RowOfUInt = std::vector<uint>;
-  using MatrixOfUInt = std::vector<RowOfUInt>;
-  MatrixOfUInt dp(m + 1, RowOfUInt(n + 1));
-
-  //=================================== Initialize the first row and column
-  // The distance from an empty string to a prefix of length i is i (i
-  // insertions)
-  for (int i = 0; i <= m; ++i)
-    dp[i][0] = i;
-
-  // The distance from a prefix of length j to an empty string is j (j
-  // deletions)
-  for (int j = 0; j <= n; ++j)
-    dp[0][j] = j;
-
-  //===================================  Fill the matrix
-  for (int i = 1; i <= m; ++i)
+  //===================================  Fill the band
+  for (uint i = 1; i <= m; ++i)
   {
-    for (int j = 1; j <= n; ++j)
+    const uint j_begin = i > k ? i - k : 1;
+    const uint j_end = std::min(n, i + k);
+
+    curr[j_begin - 1] = j_begin == 1 and i <= k ? i : too_far;
+    uint row_min = curr[j_begin - 1];
+    for (uint j = j_begin; j <= j_end; ++j)
     {
-      // Calculate the cost of substitution
       // Cost is 0 if characters are the same, 1 if different
       const uint cost = s1[i - 1] == s2[j - 1] ? 0 : 1;
 
-      // The value at dp[i][j] is the minimum of:
-      // 1. Deletion: dp[i - 1][j] + 1
-      // 2. Insertion: dp[i][j - 1] + 1
-      // 3. Substitution: dp[i - 1][j - 1] + cost
-      dp[i][j] = std::min({
-        dp[i - 1][j] + 1,       // Deletion
-        dp[i][j - 1] + 1,       // Insertion
-        dp[i - 1][j - 1] + cost // Substitution
+      // Minimum of deletion, insertion and substitution
+      const uint value = std::min({
+        prev[j] + 1,        // Deletion
+        curr[j - 1] + 1,    // Insertion
+        prev[j - 1] + cost  // Substitution
       });
+      curr[j] = std::min(value, too_far);
+      row_min = std::min(row_min, curr[j]);
     } // for j
+    if (j_end < n) curr[j_end + 1] = too_far;
+
+    if (row_min > k) return too_far;
+    std::swap(prev, curr);
   } // for i
 
-  // The bottom-right cell contains the final Levenshtein distance
-  return dp[m][n];
+  return std::min(prev[n], too_far);
 }
 
 // ###################################################################
 /**Determines if a string is a number.*/
-bool isStringANumber(const std::string& input)
+bool isStringANumber(const std::string_view input)
 {
-  try
-  {
-    // Attempt to convert the string to an integer
-    std::size_t pos;
-    std::stod(input, &pos);
-    // Check if the entire string was consumed during conversion
-    return pos == input.length();
-  }
-  catch (std::out_of_range const& ex)
-  {
-    // Number out of range for double
-    return false;
-  }
-  catch (std::invalid_argument const& ex)
-  {
-    // String does not contain a valid number
+  double value;
+  return parseDouble(input, value);
+}
+
+namespace
+{
+/**Drops the leading whitespace and a single leading '+', which
+ * std::from_chars does not accept but the stream-based parsing did.*/
+std::string_view trimNumberPrefix(std::string_view input)
+{
+  const size_t first = input.find_first_not_of(" \t\n\v\f\r");
+  if (first == std::string_view::npos) return {};
+  input.remove_prefix(first);
+  if (input.size() > 1 and input.front() == '+' and input[1] != '-')
+    input.remove_prefix(1);
+  return input;
+}
+} // namespace
+
+// ###################################################################
+/**Validates and converts a string to int64_t in one pass.*/
+bool parseInt64(const std::string_view input, int64_t& value)
+{
+  const auto text = trimNumberPrefix(input);
+  const char* const end = text.data() + text.size();
+
+  int64_t result;
+  const auto [ptr, ec] = std::from_chars(text.data(), end, result);
+  if (ec != std::errc() or ptr != end or text.empty()) return false;
+
+  value = result;
+  return true;
+}
+
+// ###################################################################
+/**Validates and converts a string to double in one pass.*/
+bool parseDouble(const std::string_view input, double& value)
+{
+  const auto text = trimNumberPrefix(input);
+  if (text.empty()) return false;
+
+#if defined(__cpp_lib_to_chars)
+  const char* const end = text.data() + text.size();
+
+  double result;
+  const auto [ptr, ec] = std::from_chars(text.data(), end, result);
+  if (ec != std::errc() or ptr != end) return false;
+#else
+  // Standard libraries without floating-point from_chars
+  const std::string buffer(text);
+  char* end = nullptr;
+  errno = 0;
+  const double result = std::strtod(buffer.c_str(), &end);
+  if (errno == ERANGE or end != buffer.c_str() + buffer.size()) return false;
+#endif
+
+  value = result;
+  return true;
+}
+
+// ###################################################################
+/**Validates and converts a number string to int64_t in one pass.*/
+bool parseNumberAsInt64(const std::string_view input, int64_t& value)
+{
+  if (parseInt64(input, value)) return true;
+
+  double float_value;
+  if (not parseDouble(input, float_value)) return false;
+  // Also rejects NaN
+  constexpr double int64_limit = 9223372036854775808.0; // 2^63
+  if (not(float_value >= -int64_limit and float_value < int64_limit))
     return false;
-  }
+
+  value = static_cast<int64_t>(float_value);
+  return true;
 }
 
 // ###################################################################
 /**Convert a string to int64_t.
  *
- * \warning The convertibility should be checked with isStringANumber.
+ * \warning The convertibility should be checked with parseNumberAsInt64.
  */
-int64_t convertStringToInt64_t(const std::string& input)
+int64_t convertStringToInt64_t(const std::string_view input)
 {
-  return std::stoll(input);
+  int64_t int_value = 0;
+  parseNumberAsInt64(input, int_value);
+  return int_value;
 }
 
 // ###################################################################
@@ -203,9 +280,11 @@ int64_t convertStringToInt64_t(const std::string& input)
  *
 \warning The convertibility should be checked with isStringANumber.
  */
-int64_t convertStringToDouble(const std::string& input)
+double convertStringToDouble(const std::string_view input)
 {
-  return std::stod(input);
+  double float_value = 0.0;
+  parseDouble(input, float_value);
+  return float_value;
 }
 
 } // namespace elke::string_utils
@@ -1,7 +1,9 @@
 #ifndef ELKE_CORE_UTILITIES_STRING_UTILS_H
 #define ELKE_CORE_UTILITIES_STRING_UTILS_H
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_set>
 
@@ -14,6 +16,20 @@ splitString(const std::string& input,
             const std::string& delimiter = " ",
             bool treat_consecutive_delimiters_as_one = true);
 
+/**Split a string given a delimiter without copying the words. The views
+ * refer into `input` which must outlive them.*/
+std::vector<std::string_view>
+splitStringView(std::string_view input,
+                std::string_view delimiter = " ",
+                bool treat_consecutive_delimiters_as_one = true);
+
+/**Same as above but fills a caller-provided buffer, which is cleared first,
+ * so that its capacity can be reused across calls.*/
+void splitStringView(std::string_view input,
+                     std::string_view delimiter,
+                     bool treat_consecutive_delimiters_as_one,
+                     std::vector<std::string_view>& words);
+
 /**Determines if a vector of strings has a particular string.*/
 bool stringListHasString(const std::vector<std::string>& string_list,
                          const std::string& target_string);
@@ -28,20 +44,45 @@ findClosestMatchingString(const std::string& input,
 unsigned int computeLevenshteinDistance(const std::string& s1,
                                         const std::string& s2);
 
+/**Bounded Levenshtein distance. Returns the distance if it is at most
+ * `max_distance`, otherwise returns `max_distance + 1` as soon as the
+ * distance is known to exceed the bound.*/
+unsigned int computeLevenshteinDistance(const std::string& s1,
+                                        const std::string& s2,
+                                        unsigned int max_distance);
+
 /**Determines if a string is a number.*/
-bool isStringANumber(const std::string& input);
+bool isStringANumber(std::string_view input);
+
+/**Validates and converts a string to int64_t in one pass. Leading
+ * whitespace and a leading '+' are accepted, otherwise the entire string must
+ * be a base-10 integer within range. Returns false, leaving `value`
+ * untouched, if it is not.*/
+bool parseInt64(std::string_view input, int64_t& value);
+
+/**Validates and converts a string to double in one pass, with the same
+ * rules as parseInt64 for decimal or scientific notation, "inf" and
+ * "nan".*/
+bool parseDouble(std::string_view input, double& value);
+
+/**Validates and converts a number string to int64_t in one pass. Numbers
+ * that are not integers are truncated toward zero. Returns false, leaving
+ * `value` untouched, if the string is not a number or if the number is NaN,
+ * infinite or outside the range of int64_t.*/
+bool parseNumberAsInt64(std::string_view input, int64_t& value);
 
-/**Convert a string to int64_t.
+/**Convert a string to int64_t, see parseNumberAsInt64. Returns 0 if the
+ * string is not convertible.
  *
- * \warning The convertibility should be checked with isStringANumber.
+ * \warning The convertibility should be checked with parseNumberAsInt64.
  */
-int64_t convertStringToInt64_t(const std::string& input);
+int64_t convertStringToInt64_t(std::string_view input);
 
 /**Convert a string to double.
  *
 \warning The convertibility should be checked with isStringANumber.
  */
-int64_t convertStringToDouble(const std::string& input);
+double convertStringToDouble(std::string_view input);
 
 } // namespace elke::string_utils
 
@@ -44,6 +44,39 @@ class ElkeDataTree:
             raise RuntimeError("Error")
 
 
+    def release(self):
+        """Releases the underlying data-tree from the warehouse. The tree can
+        no longer be used afterwards."""
+        error = ctypes.c_int()
+        self.__dll.elke_DataTree_release(ctypes.byref(error),
+                                         ctypes.c_int(self.__handle))
+
+        if error.value:
+            raise RuntimeError("Error"+str(error.value))
+
+    def count_matches(self, query: str) -> int:
+        """Returns the number of subtrees matching a path query such as
+        "components/*/initial_conditions/pressure" or "blocks/[3]". The path
+        is relative to this tree."""
+        error = ctypes.c_int()
+        count = self.__dll.elke_DataTree_countQueryMatches(
+            ctypes.byref(error), ctypes.c_int(self.__handle),
+            query.encode("utf-8"))
+
+        if error.value:
+            raise RuntimeError("Error"+str(error.value))
+        return count
+
+    def print_matches(self, query: str):
+        """Prints every subtree matching a path query in YAML format."""
+        error = ctypes.c_int()
+        self.__dll.elke_DataTree_printQueryMatchesYAML(
+            ctypes.byref(error), ctypes.c_int(self.__handle),
+            query.encode("utf-8"))
+
+        if error.value:
+            raise RuntimeError("Error"+str(error.value))
+
     def add_sub_tree(self, node_address: str, name, tree_type: int):
         handle = self.__handle
         dll = self.__dll
@@ -26,10 +26,9 @@ ParameterTree TestSyntaxBlock::getInputParameters()
 }
 
 TestSyntaxBlock::TestSyntaxBlock(const ParameterTree& params)
-  : SyntaxBlock(params)
-// ,
-//     m_scale(params.getParameterValue<double>("scale")),
-//     m_delta(params.getParameterValue<double>("offset"))
+  : SyntaxBlock(params),
+    m_scale(params.getParameterValue<double>("scale")),
+    m_delta(params.getParameterValue<double>("offset"))
 {
 }
 
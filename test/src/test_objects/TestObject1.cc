@@ -27,10 +27,9 @@ ParameterTree TestObject1::getInputParameters()
 }
 
 TestObject1::TestObject1(const ParameterTree& input_parameters)
-  : FactoryObject(input_parameters)
-// ,
-//     m_num_refinements(
-//       input_parameters.getParameterValue<int>("num_refinements"))
+  : FactoryObject(input_parameters),
+    m_num_refinements(
+      input_parameters.getParameterValue<int>("num_refinements"))
 {
 }
 
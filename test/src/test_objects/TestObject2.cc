@@ -28,10 +28,9 @@ ParameterTree TestObject2::getInputParameters()
 }
 
 TestObject2::TestObject2(const ParameterTree& input_parameters)
-  : FactoryObject(input_parameters)
-// ,
-//     m_num_refinements(
-//       input_parameters.getParameterValue<int>("num_refinements"))
+  : FactoryObject(input_parameters),
+    m_num_refinements(
+      input_parameters.getParameterValue<int>("num_refinements"))
 {
 }
 
@@ -0,0 +1,58 @@
+#include "TestDataTrees.h"
+
+namespace elke::unit_tests
+{
+
+std::shared_ptr<DataTree>
+addTree(DataTree& parent, const std::string& name, const DataGrossType type)
+{
+  auto child = std::make_shared<DataTree>(name);
+  child->setGrossType(type);
+  parent.addChild(child);
+  return child;
+}
+
+std::shared_ptr<DataTree> addSequence(DataTree& parent,
+                                      const std::string& name,
+                                      const std::vector<ScalarValue>& values)
+{
+  auto sequence = addTree(parent, name, DataGrossType::SEQUENCE);
+  for (const auto& value : values)
+    addScalar(*sequence, "", value);
+  return sequence;
+}
+
+DataTree makeSequence(const std::string& name,
+                      const std::vector<ScalarValue>& values)
+{
+  DataTree sequence(name);
+  sequence.setGrossType(DataGrossType::SEQUENCE);
+  for (const auto& value : values)
+    addScalar(sequence, "", value);
+  return sequence;
+}
+
+DataTree makeBlock(const std::string& name)
+{
+  DataTree block(name);
+  block.setGrossType(DataGrossType::MAP);
+  block.setTag("address", "deck/" + name);
+  block.setTag("mark", "deck line 1");
+  return block;
+}
+
+void setLocationTags(DataTree& tree, const std::string& address, size_t& line)
+{
+  tree.setTag("address", address);
+  tree.setTag("mark", "deck line " + std::to_string(++line));
+  size_t position = 0;
+  tree.forEachChild(
+    [&](DataTree& child)
+    {
+      const bool is_entry = tree.grossType() == DataGrossType::SEQUENCE;
+      const auto key = is_entry ? std::to_string(position++) : child.name();
+      setLocationTags(child, address + "/" + key, line);
+    });
+}
+
+} // namespace elke::unit_tests
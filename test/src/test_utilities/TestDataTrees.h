@@ -0,0 +1,48 @@
+#ifndef ELK_E_TESTDATATREES_H
+#define ELK_E_TESTDATATREES_H
+
+#include "elke_core/data_types/DataTree.h"
+
+#include <string>
+#include <vector>
+
+namespace elke::unit_tests
+{
+
+/**Adds an empty child of gross-type `type` to `parent` and returns it.*/
+std::shared_ptr<DataTree>
+addTree(DataTree& parent, const std::string& name, DataGrossType type);
+
+/**Adds a scalar child holding `ScalarValue(value)` to `parent` and returns
+ * it.*/
+template <typename T>
+std::shared_ptr<DataTree>
+addScalar(DataTree& parent, const std::string& name, const T value)
+{
+  auto child = addTree(parent, name, DataGrossType::SCALAR);
+  child->setValue(ScalarValue(value));
+  return child;
+}
+
+/**Adds a sequence of scalars to `parent` and returns it. The entries are
+ * unnamed, as parsed from YAML.*/
+std::shared_ptr<DataTree> addSequence(DataTree& parent,
+                                      const std::string& name,
+                                      const std::vector<ScalarValue>& values);
+
+/**Makes a sequence of scalars, see addSequence.*/
+DataTree makeSequence(const std::string& name,
+                      const std::vector<ScalarValue>& values);
+
+/**Makes an empty map tagged as if parsed from line 1 of a deck, i.e., with
+ * the address "deck/<name>" and the mark "deck line 1".*/
+DataTree makeBlock(const std::string& name = "Block");
+
+/**Sets the "address" and "mark" tags of `tree` and its descendants as if
+ * each node had been parsed from the next line of the deck, after `line`.
+ * Sequence entries are addressed by position.*/
+void setLocationTags(DataTree& tree, const std::string& address, size_t& line);
+
+} // namespace elke::unit_tests
+
+#endif // ELK_E_TESTDATATREES_H
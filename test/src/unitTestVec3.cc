@@ -1,11 +1,67 @@
 #include "elke_core/math/Vec3.h"
+#include "elke_core/math/Vec3Expr.h"
+#include "elke_core/utilities/general_utils.h"
 #include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
 
 namespace elke::unit_tests
 {
 
+namespace
+{
+using elke::math::Vec3;
+
+//=============================================== Compile-time checks
+static_assert(std::is_trivially_copyable_v<Vec3>);
+static_assert(Vec3{1.0, 2.0}.y == 2.0 and Vec3{1.0, 2.0}.z == 0.0);
+static_assert((Vec3(1.0, 2.0, 3.0) + Vec3(1.0)).x == 2.0);
+static_assert((2.0 * Vec3(1.0, 2.0, 3.0)).z == 6.0);
+static_assert(Vec3(1.0, 0.0, 0.0).Cross(Vec3(0.0, 1.0, 0.0)).z == 1.0);
+static_assert(Vec3(2.0, 4.0, 8.0).Inverse().z == 0.125);
+
+bool differs(const Vec3& a, const Vec3& b)
+{
+  return a.x != b.x or a.y != b.y or a.z != b.z;
+}
+
+} // namespace
+
 /**Routine to test basic functionality of Vec3 */
-void unitTestVec3() { std::cout << "Hello from unitTestVec3\n"; }
+void unitTestVec3()
+{
+  std::cout << "Hello from unitTestVec3\n";
+
+  const Vec3 a(0.1, -2.3, 4.5);
+  const Vec3 b(1.7, 0.3, -0.9);
+  const Vec3 c(-3.3, 2.2, 1.1);
+  const double s = 0.7;
+
+  //=============================================== Constructors
+  elkLogicalErrorIf(differs(Vec3({1.0, 2.0, 3.0, 4.0}), Vec3(1.0, 2.0, 3.0)),
+                    "Initializer-list constructor failed.");
+  elkLogicalErrorIf(differs(Vec3(std::vector<double>{5.0}), Vec3(5.0)),
+                    "Vector constructor failed.");
+  elkLogicalErrorIf(differs(a.Inverse(), Vec3(1.0 / a.x, 1.0 / a.y, 1.0 / a.z)),
+                    "Inverse failed.");
+
+  //=============================================== Byte round trip
+  elkLogicalErrorIf(differs(from_bytes<Vec3>(toBytes(a)), a),
+                    "Byte round trip failed.");
+
+  //=============================================== Expression templates
+  using namespace elke::math::expr;
+  const Vec3 eager = a + b * s - c;
+  const Vec3 lazy_result = lazy(a) + lazy(b) * s - lazy(c);
+  elkLogicalErrorIf(differs(eager, lazy_result),
+                    "Expression template result differs from eager result.");
+
+  const Vec3 eager2 = -(a * b) / s + s * c;
+  const Vec3 lazy_result2 = evaluate(-(lazy(a) * lazy(b)) / s + s * lazy(c));
+  elkLogicalErrorIf(differs(eager2, lazy_result2),
+                    "Expression template result differs from eager result.");
+
+  std::cout << "Vec3 checks passed.\n";
+}
 
 } // namespace elke::unit_tests
 
@@ -0,0 +1,65 @@
+#include "elke_core/data_types/DataTree.h"
+#include "test_utilities/TestDataTrees.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+int64_t intValue(const DataTree& tree, const std::string& name)
+{
+  return tree.child(name).value().getValue<int64_t>();
+}
+} // namespace
+
+void unitTestDataTreeCopy()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  DataTree original("root");
+  original.setGrossType(DataGrossType::MAP);
+  auto block = addTree(original, "block", DataGrossType::MAP);
+  addScalar(*block, "x", 1);
+  auto other_block = addTree(original, "other_block", DataGrossType::MAP);
+  addScalar(*other_block, "y", 2);
+
+  //======================================================= Sharing
+  DataTree copy = original;
+  const DataTree& const_copy = copy;
+  const DataTree& const_original = original;
+  elkLogicalErrorIf(&const_copy.child("block") !=
+                      &const_original.child("block"),
+                    "A copy should share its children until modified");
+
+  //======================================================= Path copying
+  copy.child("block").child("x").setValue(ScalarValue(10));
+  elkLogicalErrorIf(intValue(const_original.child("block"), "x") != 1,
+                    "Modifying a copy changed the original");
+  elkLogicalErrorIf(intValue(const_copy.child("block"), "x") != 10,
+                    "Modifying a copy had no effect on it");
+  elkLogicalErrorIf(&const_copy.child("other_block").child("y") !=
+                      &const_original.child("other_block").child("y"),
+                    "Subtrees off the modified path should stay shared");
+
+  //======================================================= Original
+  addScalar(original.child("other_block"), "z", 3);
+  elkLogicalErrorIf(const_copy.child("other_block").hasChild("z"),
+                    "Modifying the original changed the copy");
+  elkLogicalErrorIf(const_original.child("other_block").numChildren() != 2,
+                    "Child not added to the original");
+
+  //======================================================= Assignment
+  DataTree assigned("assigned");
+  assigned = copy;
+  assigned.child("block").child("x").setValue(ScalarValue(20));
+  elkLogicalErrorIf(intValue(const_copy.child("block"), "x") != 10,
+                    "Modifying an assigned tree changed its source");
+
+  logger.log() << "DataTree copy checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestDataTreeCopy);
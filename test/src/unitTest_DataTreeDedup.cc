@@ -0,0 +1,81 @@
+#include "elke_core/data_types/DataTreeDedup.h"
+#include "test_utilities/TestDataTrees.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+/**Components that all use the same material block, each marked with the
+ * line it would have been parsed from.*/
+DataTree makeTestTree(const size_t num_components)
+{
+  DataTree root("deck");
+  root.setGrossType(DataGrossType::MAP);
+  for (size_t c = 0; c < num_components; ++c)
+  {
+    auto component =
+      addTree(root, "pipe" + std::to_string(c), DataGrossType::MAP);
+    addScalar(*component, "length", 1.0 + static_cast<double>(c));
+    auto material = addTree(*component, "material", DataGrossType::MAP);
+    addScalar(*material, "density", 7800.0);
+    addScalar(*material, "conductivity", 16.2);
+  }
+  size_t line = 0;
+  setLocationTags(root, "deck", line);
+  return root;
+}
+} // namespace
+
+void unitTestDataTreeDedup()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  DataTree tree = makeTestTree(4);
+  const std::string yaml_before = tree.toStringAsYAML("", {"type"});
+  const auto hash_before = tree.structuralHash();
+
+  //======================================================= Sharing
+  DataTreeMarkTable marks;
+  const size_t num_nodes_saved = deduplicateDataTree(tree, marks);
+  elkLogicalErrorIf(num_nodes_saved != 6 or marks.size() != 6,
+                    "Expected the material blocks of 3 pipes to be shared");
+
+  const DataTree& const_tree = tree;
+  elkLogicalErrorIf(
+    &const_tree.child("pipe3").child("material").child("density") !=
+      &const_tree.child("pipe0").child("material").child("density"),
+    "Repeated material blocks should share their children");
+  elkLogicalErrorIf(tree.toStringAsYAML("", {"type"}) != yaml_before or
+                      tree.structuralHash() != hash_before,
+                    "Deduplication changed the content of the tree");
+
+  //======================================================= Marks
+  // The deck takes line 1 and each pipe 5 lines, the density of pipe2 is at
+  // line 15.
+  const auto& shared_density =
+    const_tree.child("pipe2").child("material").child("density");
+  const std::string address = "deck/pipe2/material/density";
+  elkLogicalErrorIf(marks.markOf(shared_density, address) != "deck line 15",
+                    "Wrong mark for a deduplicated node");
+  elkLogicalErrorIf(marks.markOf(shared_density,
+                                 "deck/pipe0/material/density") != "deck line 5",
+                    "Wrong mark for the first occurrence");
+
+  //======================================================= Copy on write
+  tree.child("pipe1").child("material").child("density").setValue(
+    ScalarValue(8000.0));
+  elkLogicalErrorIf(
+    const_tree.child("pipe0").child("material").child("density")
+        .value()
+        .getValue<double>() != 7800.0,
+    "Modifying one occurrence changed another");
+
+  logger.log() << "DataTree deduplication checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestDataTreeDedup);
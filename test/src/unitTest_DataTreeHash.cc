@@ -0,0 +1,76 @@
+#include "elke_core/data_types/DataTreeDiff.h"
+#include "test_utilities/TestDataTrees.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+/**A map holding two identical component definitions and a sequence.*/
+DataTree makeTestTree()
+{
+  DataTree root("root");
+  root.setGrossType(DataGrossType::MAP);
+  for (const char* component_name : {"pipe1", "pipe2"})
+  {
+    auto component = addTree(root, component_name, DataGrossType::MAP);
+    auto geometry = addTree(*component, "geometry", DataGrossType::MAP);
+    addScalar(*geometry, "area", 0.25);
+    addScalar(*geometry, "length", 1.0);
+    addScalar(*component, "type", "snglvol");
+  }
+  auto list = addTree(root, "list", DataGrossType::SEQUENCE);
+  for (int i = 0; i < 3; ++i)
+    addScalar(*list, "", i);
+  return root;
+}
+} // namespace
+
+void unitTestDataTreeHash()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  const DataTree tree = makeTestTree();
+  const DataTree rebuilt = makeTestTree();
+
+  //======================================================= Equality
+  elkLogicalErrorIf(not tree.structurallyEquals(rebuilt),
+                    "Identically built trees should be equal");
+  elkLogicalErrorIf(
+    not tree.child("pipe1").structurallyEquals(tree.child("pipe2")),
+    "Identical subtrees at different addresses should be equal");
+  elkLogicalErrorIf(
+    tree.child("pipe1").structurallyEquals(tree.child("pipe1").child("geometry")),
+    "Different subtrees should not be equal");
+
+  //======================================================= Invalidation
+  DataTree modified = tree;
+  elkLogicalErrorIf(modified.structuralHash() != tree.structuralHash(),
+                    "A copy should have the same hash");
+  modified.child("pipe2").child("geometry").child("area").setValue(
+    ScalarValue(0.5));
+  elkLogicalErrorIf(modified.structurallyEquals(tree),
+                    "Modifying a node should change the root hash");
+  elkLogicalErrorIf(
+    not modified.child("pipe1").structurallyEquals(tree.child("pipe1")),
+    "An unmodified subtree should keep its hash");
+
+  //======================================================= Change detection
+  modified.child("list").child("").rename("renamed");
+  addTree(modified, "extra", DataGrossType::NO_DATA);
+
+  const auto changes = findChangedSubtrees(tree, modified);
+  const std::vector<std::string> expected = {
+    "root/pipe2/geometry/area", "root/list/0", "root/extra"};
+  elkLogicalErrorIf(changes != expected, "Unexpected changed subtrees");
+  elkLogicalErrorIf(not findChangedSubtrees(tree, rebuilt).empty(),
+                    "Equal trees should have no changes");
+
+  logger.log() << "DataTree hash checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestDataTreeHash);
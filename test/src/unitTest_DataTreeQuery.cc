@@ -0,0 +1,124 @@
+#include "elke_core/data_types/DataTreeQuery.h"
+#include "test_utilities/TestDataTrees.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+/**Three components with initial conditions and a sequence of blocks.*/
+DataTree makeTestTree()
+{
+  DataTree root("input");
+  root.setGrossType(DataGrossType::MAP);
+
+  auto components = addTree(root, "components", DataGrossType::MAP);
+  for (int c = 0; c < 3; ++c)
+  {
+    auto component =
+      addTree(*components, "pipe" + std::to_string(c), DataGrossType::MAP);
+    auto conditions =
+      addTree(*component, "initial_conditions", DataGrossType::MAP);
+    addScalar(*conditions, "pressure", 1.0e5 * (c + 1));
+  }
+
+  auto mesh = addTree(root, "mesh", DataGrossType::MAP);
+  auto blocks = addTree(*mesh, "blocks", DataGrossType::SEQUENCE);
+  for (int b = 0; b < 5; ++b)
+    addScalar(*blocks, "", b);
+  return root;
+}
+} // namespace
+
+void unitTestDataTreeQuery()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+  const DataTree tree = makeTestTree();
+
+  //======================================================= Wildcards
+  const DataTreeQuery pressures("components/*/initial_conditions/pressure");
+  elkLogicalErrorIf(pressures.steps().size() != 4,
+                    "Unexpected number of compiled steps");
+  double total = 0.0;
+  for (const DataTree* pressure : pressures.run(tree))
+    total += pressure->value().getValue<double>();
+  elkLogicalErrorIf(total != 6.0e5, "Wildcard query missed components");
+
+  //======================================================= Indices
+  const DataTree* block = DataTreeQuery("/mesh/blocks/[3]/").first(tree);
+  elkLogicalErrorIf(block == nullptr or
+                      block->value().getValue<int64_t>() != 3,
+                    "Index query returned the wrong entry");
+  elkLogicalErrorIf(DataTreeQuery("mesh/blocks/[5]").first(tree) != nullptr,
+                    "Out of range index should not match");
+  elkLogicalErrorIf(DataTreeQuery("mesh/*/*").run(tree).size() != 5,
+                    "Wildcards should match sequence entries");
+  elkLogicalErrorIf(DataTreeQuery("").first(tree) != &tree,
+                    "An empty query should match the tree itself");
+  elkLogicalErrorIf(not DataTreeQuery("components/pipe9/*").run(tree).empty(),
+                    "Missing names should not match");
+
+  //======================================================= Many children
+  // Names are found through the child name index, which must keep
+  // duplicates in order and follow modifications.
+  DataTree wide("wide");
+  wide.setGrossType(DataGrossType::MAP);
+  for (int i = 0; i < 100; ++i)
+  {
+    auto child = std::make_shared<DataTree>("child" + std::to_string(i % 50));
+    child->setGrossType(DataGrossType::SCALAR);
+    child->setValue(ScalarValue(i));
+    wide.addChild(child, /*prevent_duplicate=*/false);
+  }
+  const DataTreeQuery child7("child7");
+  const auto matches = child7.run(std::as_const(wide));
+  elkLogicalErrorIf(matches.size() != 2 or
+                      matches[0]->value().getValue<int64_t>() != 7 or
+                      matches[1]->value().getValue<int64_t>() != 57,
+                    "Indexed name lookup returned the wrong children");
+  elkLogicalErrorIf(
+    child7.first(std::as_const(wide))->value().getValue<int64_t>() != 7,
+    "Indexed first match is not the first child");
+
+  wide.childAt(7).rename("renamed");
+  elkLogicalErrorIf(child7.run(std::as_const(wide)).size() != 1,
+                    "The name index was not cleared by a modification");
+  const DataTree wide_copy = wide;
+  elkLogicalErrorIf(
+    DataTreeQuery("renamed").first(wide_copy) != &wide_copy.childAt(7),
+    "Copies should find the same children");
+
+  //======================================================= Modification
+  DataTree copy = tree;
+  for (DataTree* pressure : pressures.run(copy))
+    pressure->setValue(ScalarValue(0.0));
+  elkLogicalErrorIf(pressures.first(tree)->value().getValue<double>() != 1.0e5,
+                    "Modifying query matches of a copy changed the original");
+
+  //======================================================= Errors
+  for (const char* bad_path : {"mesh//blocks", "mesh/blocks/[x]", "[-1]"})
+  {
+    bool thrown = false;
+    try
+    {
+      DataTreeQuery query(bad_path);
+    }
+    catch (const std::invalid_argument&)
+    {
+      thrown = true;
+    }
+    elkLogicalErrorIf(not thrown,
+                      std::string("Malformed query accepted: ") + bad_path);
+  }
+
+  logger.log() << "DataTree query checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestDataTreeQuery);
@@ -0,0 +1,156 @@
+#include "elke_core/data_types/DataTreeTraversal.h"
+#include "test_utilities/TestDataTrees.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+/**A tree with a wide map, nested sequences and values of very different
+ * magnitudes, so that sums depend on the order of the additions.*/
+DataTree makeTestTree()
+{
+  DataTree root("root");
+  root.setGrossType(DataGrossType::MAP);
+  size_t count = 0;
+
+  auto addValue = [&](DataTree& parent, const std::string& name)
+  {
+    const double magnitude = (count % 7 == 0) ? 1.0e8 : 1.0;
+    addScalar(parent, name, magnitude / static_cast<double>(++count));
+  };
+
+  auto wide = addTree(root, "wide", DataGrossType::MAP);
+  for (int i = 0; i < 3000; ++i)
+    addValue(*wide, "param_" + std::to_string(i));
+
+  auto blocks = addTree(root, "blocks", DataGrossType::SEQUENCE);
+  for (int b = 0; b < 20; ++b)
+  {
+    auto block = addTree(*blocks, "", DataGrossType::MAP);
+    for (int c = 0; c < 100; ++c)
+    {
+      auto component =
+        addTree(*block, "c" + std::to_string(c), DataGrossType::MAP);
+      for (const char* name : {"x", "y", "z"})
+        addValue(*component, name);
+    }
+  }
+  return root;
+}
+
+double nodeValue(const DataTree& node)
+{
+  return node.grossType() == DataGrossType::SCALAR
+           ? node.value().getValue<double>()
+           : 0.0;
+}
+} // namespace
+
+void unitTestDataTreeTraversal()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+  auto tree = makeTestTree();
+
+  //======================================================= Reference
+  std::vector<std::string> reference_addresses;
+  tree.traverseWithCallback("",
+                            [&](const std::string& address, DataTree&)
+                            { reference_addresses.push_back(address); });
+
+  //======================================================= Serial
+  {
+    std::vector<std::string> addresses;
+    forEachDataTreeNode(tree,
+                        [&](const std::string& address, DataTree&)
+                        { addresses.push_back(address); });
+    elkLogicalErrorIf(addresses != reference_addresses,
+                      "Serial traversal differs from traverseWithCallback");
+  }
+
+  //======================================================= Parallel
+  // Small grains so that even this tree is split into many tasks.
+  WorkStealingPool pool(4);
+  const DataTreeTraversalOptions options{/*grain_size=*/64, &pool};
+
+  {
+    std::mutex mutex;
+    std::atomic<size_t> order = 0;
+    std::map<std::string, size_t> visit_order;
+    parallelForEachDataTreeNode(
+      tree,
+      [&](const std::string& address, DataTree&)
+      {
+        const size_t my_order = order++;
+        std::lock_guard lock(mutex);
+        visit_order[address] = my_order;
+      },
+      options);
+
+    std::vector<std::string> addresses;
+    for (const auto& [address, node_order] : visit_order)
+    {
+      addresses.push_back(address);
+      // Parents are visited before their children.
+      const auto parent_end = address.rfind('/', address.size() - 2);
+      if (parent_end != std::string::npos)
+        elkLogicalErrorIf(
+          visit_order.at(address.substr(0, parent_end + 1)) > node_order,
+          "Child visited before its parent: " + address);
+    }
+    auto sorted_reference = reference_addresses;
+    std::sort(sorted_reference.begin(), sorted_reference.end());
+    elkLogicalErrorIf(addresses != sorted_reference,
+                      "Parallel traversal did not visit every node once");
+  }
+
+  //======================================================= Ordered reduction
+  WorkStealingPool serial_pool(0);
+  const auto sum = [](const double a, const double b) { return a + b; };
+  const double serial_sum = parallelTransformReduceDataTree(
+    tree, 0.0, nodeValue, sum, {64, &serial_pool});
+
+  for (const size_t num_workers : {1, 2, 4, 7})
+  {
+    WorkStealingPool trial_pool(num_workers);
+    for (int trial = 0; trial < 10; ++trial)
+    {
+      const double parallel_sum = parallelTransformReduceDataTree(
+        tree, 0.0, nodeValue, sum, {64, &trial_pool});
+      elkLogicalErrorIf(parallel_sum != serial_sum,
+                        "Parallel reduction is not deterministic");
+    }
+  }
+
+  //======================================================= Exceptions
+  bool caught = false;
+  try
+  {
+    parallelForEachDataTreeNode(
+      tree,
+      [](const std::string& address, DataTree&)
+      {
+        if (address == "root/blocks/13/c42/y/")
+          throw std::logic_error("visitor failed");
+      },
+      options);
+  }
+  catch (const std::logic_error& error)
+  {
+    caught = std::string(error.what()) == "visitor failed";
+  }
+  elkLogicalErrorIf(not caught, "Visitor exception was not rethrown");
+
+  logger.log() << "Parallel traversals match the serial traversal.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestDataTreeTraversal);
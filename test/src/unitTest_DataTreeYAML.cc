@@ -0,0 +1,96 @@
+#include "elke_core/data_types/DataTreeYAML.h"
+#include "elke_core/input/YAMLInput.h"
+#include "test_utilities/TestDataTrees.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <cstdio>
+#include <sstream>
+
+namespace elke::unit_tests
+{
+
+void unitTestDataTreeYAML()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  //======================================================= Exact format
+  DataTree tree("root");
+  tree.setGrossType(DataGrossType::MAP);
+  {
+    addScalar(tree, "text", "abc");
+    addScalar(tree, "flag", false);
+    addScalar(tree, "count", -12);
+    addScalar(tree, "pressure", 1.0e6);
+    addScalar(tree, "ratio", 0.1234567);
+    tree.addChild(std::make_shared<DataTree>("nothing"));
+
+    auto list = addTree(tree, "list", DataGrossType::SEQUENCE);
+    addScalar(*list, "", 1);
+    auto entry = addTree(*list, "", DataGrossType::MAP);
+    addScalar(*entry, "type", "objA");
+  }
+
+  const std::string expected = "root: # type=MAP \n"
+                               "  text: \"abc\" # type=STRING \n"
+                               "  flag: false # type=BOOL \n"
+                               "  count: -12 # type=INTEGER \n"
+                               "  pressure: 1e+06 # type=FLOAT \n"
+                               "  ratio: 0.123457 # type=FLOAT \n"
+                               "  nothing: null # \n"
+                               "  list: # type=SEQUENCE \n"
+                               "    - 1 # type=INTEGER \n"
+                               "    - # type=MAP \n"
+                               "      type: \"objA\" # type=STRING \n";
+  const std::string yaml = tree.toStringAsYAML("", {"type"});
+  elkLogicalErrorIf(yaml != expected, "Unexpected YAML:\n" + yaml);
+
+  //======================================================= Chunked output
+  YAMLInput parser(logger);
+  const auto input_tree = parser.parseInputFile("YAMLInput.yaml");
+  const std::vector<std::string> tags = {"type", "address"};
+  const std::string reference = input_tree.toStringAsYAML("", tags);
+
+  std::string chunked;
+  size_t num_chunks = 0;
+  {
+    DataTreeYAMLEmitter emitter(
+      [&](const std::string_view chunk)
+      {
+        elkLogicalErrorIf(chunk.empty() or chunk.back() != '\n',
+                          "Chunk does not end with a complete line");
+        chunked.append(chunk);
+        ++num_chunks;
+      },
+      /*chunk_size=*/100);
+    emitter.emit(input_tree, "", tags);
+  }
+  elkLogicalErrorIf(chunked != reference or num_chunks < 2,
+                    "Chunked output differs from toStringAsYAML");
+
+  std::ostringstream stream;
+  writeDataTreeYAML(input_tree, stream, "", tags);
+  elkLogicalErrorIf(stream.str() != reference,
+                    "Stream output differs from toStringAsYAML");
+
+  //======================================================= File descriptor
+#if defined(__unix__) or defined(__APPLE__)
+  std::FILE* file = std::tmpfile();
+  elkLogicalErrorIf(file == nullptr, "Failed to create a temporary file");
+  const bool written =
+    writeDataTreeYAML(input_tree, fileno(file), "", tags);
+  std::rewind(file);
+  std::string file_content;
+  for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file))
+    file_content.push_back(static_cast<char>(c));
+  std::fclose(file);
+  elkLogicalErrorIf(not written or file_content != reference,
+                    "File descriptor output differs from toStringAsYAML");
+#endif
+
+  logger.log() << "YAML emitter checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestDataTreeYAML);
@@ -0,0 +1,115 @@
+#include "elke_core/input/InputCache.h"
+#include "elke_core/input/JSONInput.h"
+#include "elke_core/input/YAMLInput.h"
+#include "elke_core/data_types/DataTreeBinary.h"
+#include "elke_core/utilities/hash_utils.h"
+#include "elke_core/utilities/MappedFile.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <fstream>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+/**Compares everything, tags included.*/
+bool treesAreIdentical(const DataTree& a, const DataTree& b)
+{
+  if (a.name() != b.name() or a.grossType() != b.grossType() or
+      a.tags() != b.tags() or a.value().type() != b.value().type() or
+      a.value().convertToString() != b.value().convertToString())
+    return false;
+
+  const auto a_children = a.constChildren();
+  const auto b_children = b.constChildren();
+  if (a_children.size() != b_children.size()) return false;
+  for (size_t c = 0; c < a_children.size(); ++c)
+    if (not treesAreIdentical(*a_children[c], *b_children[c])) return false;
+
+  return true;
+}
+} // namespace
+
+void unitTestInputCache()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  //======================================================= xxHash64
+  // Reference values of the xxHash project.
+  elkLogicalErrorIf(hash_utils::xxHash64("") != 0xEF46DB3751D8E999ULL or
+                      hash_utils::xxHash64("abc") != 0x44BC2CF5AD770999ULL or
+                      hash_utils::xxHash64(
+                        "Nobody inspects the spammish repetition") !=
+                        0xFBCEA83C8A378BF1ULL,
+                    "xxHash64 does not match the reference values");
+
+  //======================================================= Binary round trip
+  YAMLInput yaml_parser(logger);
+  JSONInput json_parser(logger);
+  const auto yaml_tree = yaml_parser.parseInputFile("YAMLInput.yaml");
+  const auto json_tree = json_parser.parseInputFile("JSONInput.json");
+
+  for (const auto* tree : {&yaml_tree, &json_tree})
+  {
+    std::string buffer;
+    writeDataTreeBinary(*tree, buffer);
+
+    const auto read_tree = readDataTreeBinary(buffer);
+    elkLogicalErrorIf(read_tree == nullptr or
+                        not treesAreIdentical(*tree, *read_tree),
+                      "Binary round trip changed " + tree->name());
+
+    // Every truncation must be detected.
+    for (size_t size = 0; size < buffer.size(); ++size)
+      elkLogicalErrorIf(
+        readDataTreeBinary(std::string_view(buffer).substr(0, size)) !=
+          nullptr,
+        "Truncated binary tree accepted");
+  }
+
+  //======================================================= Cache entries
+  const auto directory =
+    std::filesystem::temp_directory_path() / "elke_unit_test_input_cache";
+  std::filesystem::remove_all(directory);
+
+  const InputCache cache(directory);
+  const MappedFile file("YAMLInput.yaml");
+  const auto key =
+    InputCache::makeKey(file.view(), "YAMLInput.yaml", yaml_parser.version());
+
+  elkLogicalErrorIf(cache.load(key) != nullptr, "Hit in an empty cache");
+  elkLogicalErrorIf(not cache.store(key, yaml_tree), "Failed to store");
+
+  const auto cached_tree = cache.load(key);
+  elkLogicalErrorIf(cached_tree == nullptr or
+                      not treesAreIdentical(yaml_tree, *cached_tree),
+                    "Cached tree differs from the parsed tree");
+
+  // Another parser version, file name or content must miss.
+  auto other_key = key;
+  other_key.m_parser_version = "YAMLInput 0";
+  elkLogicalErrorIf(cache.load(other_key) != nullptr,
+                    "Hit for another parser version");
+  other_key = key;
+  other_key.m_source_name = "other.yaml";
+  elkLogicalErrorIf(cache.load(other_key) != nullptr,
+                    "Hit for another file name");
+  other_key = InputCache::makeKey(
+    std::string(file.view()) + " ", "YAMLInput.yaml", yaml_parser.version());
+  elkLogicalErrorIf(cache.load(other_key) != nullptr,
+                    "Hit for other content");
+
+  // A damaged entry is a miss.
+  std::filesystem::resize_file(
+    cache.entryPath(key), std::filesystem::file_size(cache.entryPath(key)) - 1);
+  elkLogicalErrorIf(cache.load(key) != nullptr, "Hit for a damaged entry");
+
+  std::filesystem::remove_all(directory);
+  logger.log() << "Input cache checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestInputCache);
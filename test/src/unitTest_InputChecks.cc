@@ -0,0 +1,229 @@
+#include "elke_core/parameters2/ParameterTree.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+#include "test_utilities/TestDataTrees.h"
+
+#include <limits>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+/**Makes the sequence "values" of scalars.*/
+DataTree makeSequence(const std::vector<ScalarValue>& values)
+{
+  return unit_tests::makeSequence("values", values);
+}
+
+/**Makes a scalar.*/
+DataTree makeScalar(const ScalarValue& value)
+{
+  DataTree scalar("value");
+  scalar.setGrossType(DataGrossType::SCALAR);
+  scalar.setValue(value);
+  return scalar;
+}
+
+/**Runs a check and returns the messages of its errors.*/
+std::vector<std::string> runCheck(const param_checks::InputCheck& check,
+                                  const DataTree& data)
+{
+  ParameterDiagnostics diagnostics;
+  const ParameterValidationContext context(/*assignment_flag=*/false);
+  const std::string name = "values";
+  const bool passed = check.performCheck(diagnostics, data, context, name);
+
+  std::vector<std::string> messages;
+  for (const auto& diagnostic : diagnostics.diagnostics())
+    messages.push_back(diagnostics.formatMessage(diagnostic));
+
+  elkLogicalErrorIf(passed != messages.empty(),
+                    "A check should fail exactly when it reports errors");
+  return messages;
+}
+
+ScalarValue integer(const int64_t value) { return ScalarValue(value); }
+ScalarValue real(const double value) { return ScalarValue(value); }
+ScalarValue text(const char* value) { return ScalarValue(value); }
+} // namespace
+
+void unitTestInputChecks()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+  using namespace param_checks;
+
+  //======================================================= Size bounds
+  {
+    const ArraySizeBoundsCheck check(2, 3);
+    elkLogicalErrorIf(
+      not runCheck(check, makeSequence({integer(1), integer(2)})).empty(),
+      "2 entries are within the bounds");
+    const auto messages = runCheck(check, makeSequence({integer(1)}));
+    elkLogicalErrorIf(messages.size() != 1 or
+                        messages[0] != "Item \"values\" is required to have "
+                                       "between 2 and 3 entries but the data "
+                                       "provided has 1 entries.",
+                      "Wrong size bounds message");
+  }
+
+  //======================================================= Range
+  {
+    const RangeCheck check(0.0, 10.0);
+    const auto messages = runCheck(
+      check,
+      makeSequence(
+        {integer(0), real(10.5), text("5"), text("abc"), integer(-1)}));
+    elkLogicalErrorIf(messages.size() != 2, "Expected 2 values out of range");
+    elkLogicalErrorIf(messages[0] != "Array entry 1 of item \"values\" with "
+                                     "value 10.5 is required to be within "
+                                     "[0, 10].",
+                      "Wrong range message: " + messages[0]);
+
+    const auto scalar_messages = runCheck(check, makeScalar(real(11.0)));
+    elkLogicalErrorIf(
+      scalar_messages.size() != 1 or
+        scalar_messages[0].find("Item \"values\" with value") != 0,
+      "Scalars are reported without an entry number");
+
+    const RangeCheck at_least(1.0, std::numeric_limits<double>::infinity());
+    elkLogicalErrorIf(
+      runCheck(at_least, makeScalar(integer(0)))[0].find("at least 1") ==
+        std::string::npos,
+      "One-sided ranges should be described as such");
+
+    // NaN is a number, but not within any range
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const RangeCheck unit(0.0, 1.0);
+    elkLogicalErrorIf(runCheck(unit, makeScalar(real(nan))).size() != 1,
+                      "NaN is not within [0, 1]");
+    elkLogicalErrorIf(
+      runCheck(unit, makeSequence({real(0.5), text("nan"), text("abc")}))
+          .size() != 1,
+      "Only the NaN string is out of range");
+
+    // Packed values
+    std::vector<double> values(1000000, 5.0);
+    elkLogicalErrorIf(not check.passes(values.data(), values.size()),
+                      "Packed values are within range");
+    values[999999] = 11.0;
+    elkLogicalErrorIf(check.passes(values.data(), values.size()),
+                      "The last packed value is out of range");
+  }
+
+  //======================================================= Increasing
+  {
+    const StrictlyIncreasingCheck check;
+    elkLogicalErrorIf(
+      not runCheck(check, makeSequence({integer(1), real(1.5), integer(2)}))
+            .empty(),
+      "1, 1.5, 2 is strictly increasing");
+    const auto messages = runCheck(
+      check, makeSequence({integer(1), integer(2), integer(2), integer(1)}));
+    elkLogicalErrorIf(messages.size() != 2, "Entries 2 and 3 do not increase");
+
+    const auto nan_messages = runCheck(
+      check,
+      makeSequence({integer(1),
+                    real(std::numeric_limits<double>::quiet_NaN()),
+                    integer(0)}));
+    elkLogicalErrorIf(nan_messages.size() != 1 or
+                        nan_messages[0].find("Array entry 1") != 0,
+                      "1, NaN, 0 is not increasing");
+
+    const std::vector<double> values = {1.0, 2.0, 3.0};
+    elkLogicalErrorIf(not StrictlyIncreasingCheck::passes(values.data(), 3),
+                      "Packed values are increasing");
+  }
+
+  //======================================================= Unique
+  {
+    const UniqueEntriesCheck check;
+    elkLogicalErrorIf(
+      not runCheck(check, makeSequence({integer(3), integer(1), integer(2)}))
+            .empty(),
+      "3, 1, 2 are unique");
+    const auto messages = runCheck(
+      check,
+      makeSequence(
+        {integer(1), real(2.0), real(1.0), text("a"), text("a")}));
+    elkLogicalErrorIf(messages.size() != 2, "Expected 2 duplicates");
+    elkLogicalErrorIf(messages[0].find("Array entry 2") != 0,
+                      "1.0 repeats 1: " + messages[0]);
+
+    // Integers beyond 2^53 are distinct even if their doubles are not
+    const int64_t large = int64_t(1) << 53;
+    elkLogicalErrorIf(
+      not runCheck(check, makeSequence({integer(large), integer(large + 1)}))
+            .empty(),
+      "2^53 and 2^53 + 1 are unique");
+    elkLogicalErrorIf(
+      runCheck(check,
+               makeSequence({integer(large + 1),
+                             real(9007199254740992.0),
+                             text("9007199254740993")}))
+          .size() != 1,
+      "Only the string repeats 2^53 + 1");
+    elkLogicalErrorIf(
+      runCheck(check, makeSequence({integer(large + 1), integer(large + 1)}))
+          .size() != 1,
+      "2^53 + 1 repeats itself");
+  }
+
+  //======================================================= Enumerated
+  {
+    const EnumeratedStringCheck check({"linear", "quadratic"});
+    elkLogicalErrorIf(not runCheck(check, makeScalar(text("linear"))).empty(),
+                      "\"linear\" is allowed");
+    const auto messages = runCheck(check, makeScalar(text("cubic")));
+    elkLogicalErrorIf(messages.size() != 1 or
+                        messages[0] != "Item \"values\" with value cubic is "
+                                       "required to be one of \"linear\", "
+                                       "\"quadratic\".",
+                      "Wrong enumerated message");
+  }
+
+  //======================================================= Regex
+  {
+    const RegexCheck check("[a-z]+_[0-9]+");
+    const auto messages = runCheck(
+      check,
+      makeSequence({text("block_1"), text("Block_1"), text("block_")}));
+    elkLogicalErrorIf(messages.size() != 2, "Expected 2 mismatches");
+
+    bool threw = false;
+    try
+    {
+      RegexCheck invalid("[a-z");
+    }
+    catch (const std::runtime_error&)
+    {
+      threw = true;
+    }
+    elkLogicalErrorIf(not threw, "An invalid pattern should throw");
+  }
+
+  //======================================================= In a tree
+  {
+    auto params = ParameterTree("Block", "Description");
+    auto& values =
+      params.addOptionalParameter("values", "", std::vector<double>{});
+    values.addAdditionalInputCheck(std::make_unique<RangeCheck>(0.0, 1.0));
+    values.addAdditionalInputCheck(
+      std::make_unique<StrictlyIncreasingCheck>());
+
+    DataTree block = makeBlock();
+    addSequence(block, "values", {real(0.5), real(0.25), real(2.0)});
+
+    ParameterDiagnostics diagnostics;
+    params.processSpecification(diagnostics, block);
+    elkLogicalErrorIf(diagnostics.numErrors() != 2,
+                      "Expected 2 errors:\n" + diagnostics.errorsAsString());
+  }
+
+  logger.log() << "InputChecks checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestInputChecks);
@@ -0,0 +1,96 @@
+#include "elke_core/base/ItemStorage.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <atomic>
+#include <thread>
+
+namespace elke::unit_tests
+{
+
+/**Routine to test the slot-map behavior of ItemStorage.*/
+void unitTestItemStorage()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  //======================================================= Handle lifetime
+  {
+    ItemStorage<int> storage;
+
+    const size_t handle_a = storage.depositItem(std::make_shared<int>(1));
+    const size_t handle_b = storage.depositItem(std::make_shared<int>(2));
+
+    elkLogicalErrorIf(handle_a == 0 or handle_b == 0, "Zero handle issued.");
+    elkLogicalErrorIf(storage.getItemReference(handle_b) != 2,
+                      "Lookup returned the wrong item.");
+
+    storage.releaseItem(handle_a);
+    elkLogicalErrorIf(storage.hasItem(handle_a), "Released handle still live.");
+
+    bool stale_handle_threw = false;
+    try { storage.getItemReference(handle_a); }
+    catch (const std::logic_error&) { stale_handle_threw = true; }
+    elkLogicalErrorIf(not stale_handle_threw, "Stale handle was accepted.");
+
+    // Fill every shard once so that the released slot gets reused.
+    std::vector<size_t> handles;
+    for (int i = 0; i < 16; ++i)
+      handles.push_back(storage.depositItem(std::make_shared<int>(i)));
+
+    elkLogicalErrorIf(storage.hasItem(handle_a),
+                      "Reused slot accepted the stale handle.");
+    elkLogicalErrorIf(storage.size() != 17, "Wrong number of live items.");
+
+    logger.log() << "Handle lifetime checks passed.";
+  }
+
+  //======================================================= Concurrency
+  {
+    ItemStorage<int> storage;
+
+    constexpr int num_threads = 8;
+    constexpr int num_items_per_thread = 10000;
+
+    // Exceptions cannot leave a thread, so mismatches are only flagged
+    // there and reported after joining.
+    std::atomic<bool> lookup_mismatch = false;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+      threads.emplace_back(
+        [&storage, &lookup_mismatch, t]
+        {
+          std::vector<size_t> my_handles;
+          for (int i = 0; i < num_items_per_thread; ++i)
+            my_handles.push_back(
+              storage.depositItem(std::make_shared<int>(t * 100000 + i)));
+
+          try
+          {
+            for (int i = 0; i < num_items_per_thread; ++i)
+              if (storage.getItemReference(my_handles[i]) != t * 100000 + i)
+                lookup_mismatch = true;
+          }
+          catch (const std::exception&)
+          {
+            lookup_mismatch = true;
+          }
+
+          for (size_t i = 0; i < my_handles.size(); i += 2)
+            storage.releaseItem(my_handles[i]);
+        });
+
+    for (auto& thread : threads)
+      thread.join();
+
+    elkLogicalErrorIf(lookup_mismatch, "Concurrent lookup mismatch.");
+    elkLogicalErrorIf(storage.size() != num_threads * num_items_per_thread / 2,
+                      "Wrong number of live items after concurrent use.");
+
+    logger.log() << "Concurrency checks passed.";
+  }
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestItemStorage);
@@ -0,0 +1,91 @@
+#include "elke_core/input/JSONInput.h"
+#include "elke_core/input/JSONStructuralIndex.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <random>
+
+namespace elke::unit_tests
+{
+
+void unitTestJSONInput()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  //======================================================= File parsing
+  {
+    JSONInput input_processor(logger);
+
+    const auto data_tree = input_processor.parseInputFile("JSONInput.json");
+    elkLogicalErrorIf(not input_processor.errors().empty(),
+                      input_processor.errors().front());
+    logger.log() << data_tree.toStringAsYAML("", {"type", "address", "mark"});
+  }
+
+  //======================================================= Stage 1 paths agree
+  // Random documents built from fragments that stress block boundaries:
+  // escaped quotes, runs of backslashes and strings spanning blocks.
+  {
+    const std::vector<std::string> fragments = {
+      "{", "}", "[", "]", ":", ",", " ", "\n", "\"a\"", "\"\\\"\"",
+      "\"\\\\\"", "\"\\\\\\\"x\"", "123", "-4.5e6", "true", "null",
+      "\"long string with spaces and : , { } [ ] inside it\""};
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<size_t> pick(0, fragments.size() - 1);
+
+    for (int trial = 0; trial < 500; ++trial)
+    {
+      std::string document;
+      while (document.size() < 300)
+        document += fragments[pick(rng)];
+      const size_t size = document.size();
+      document.resize(
+        (size / json::STRUCTURAL_BLOCK_SIZE + 1) * json::STRUCTURAL_BLOCK_SIZE,
+        ' ');
+
+      std::vector<uint32_t> scalar_index, avx2_index;
+      std::string scalar_error, avx2_error;
+      const bool scalar_ok =
+        json::buildStructuralIndex(document,
+                                   size,
+                                   scalar_index,
+                                   scalar_error,
+                                   math::SIMDInstructionSet::SCALAR);
+      const bool avx2_ok = json::buildStructuralIndex(
+        document, size, avx2_index, avx2_error, math::SIMDInstructionSet::AVX2);
+
+      elkLogicalErrorIf(scalar_ok != avx2_ok or scalar_index != avx2_index,
+                        "Structural index mismatch for: " + document);
+    }
+    logger.log() << "Structural index paths agree.";
+  }
+
+  //======================================================= Errors
+  {
+    const std::vector<std::pair<std::string, std::string>> bad_documents = {
+      {"{\"a\": 1,}", "line 1:9: Expected a string as object key."},
+      {"{\"a\" 1}", "line 1:6: Expected ':' after object key."},
+      {"[1, 2\n  3]", "line 2:3: Expected ',' or ']' in array."},
+      {"{\"a\": 01}", "line 1:7: Invalid value \"01\"."},
+      {"{\"a\": \"open}", "Unterminated string."},
+      {"[1] 2", "line 1:5: Unexpected content after the root value."},
+      {"{\"a\": 1, \"b\": 2, \"a\": 3}",
+       "Cannot add child named \"a\" to data-tree at \"doc\"\n"}};
+
+    for (const auto& [document, expected] : bad_documents)
+    {
+      JSONInput input_processor(logger);
+      input_processor.parseInputContent(document, "doc");
+      const auto& errors = input_processor.errors();
+      elkLogicalErrorIf(errors.empty() or
+                          errors.front().find(expected) == std::string::npos,
+                        "Expected error \"" + expected + "\" for " + document +
+                          (errors.empty() ? "" : " got " + errors.front()));
+    }
+    logger.log() << "JSON error checks passed.";
+  }
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestJSONInput);
@@ -0,0 +1,197 @@
+#include "elke_core/parameters2/ParameterTree.h"
+#include "elke_core/parameters2/ParameterProgram.h"
+#include "elke_core/data_types/DataTreeDedup.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+#include "test_utilities/TestDataTrees.h"
+
+#include <sstream>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+/**A block with an integer array of `num_entries` strings, i.e., one error
+ * per entry, and a misspelled parameter name. The entries are unnamed, as
+ * parsed from YAML.*/
+DataTree makeTestBlock(const size_t num_entries)
+{
+  DataTree block = makeBlock();
+  addSequence(block,
+              "values",
+              std::vector<ScalarValue>(num_entries,
+                                       ScalarValue("a \"quoted\" string")));
+  addScalar(block, "scael", 1.0);
+  return block;
+}
+
+/**A deck of two pipes, of different lengths, with the same test block.*/
+DataTree makeTestDeck()
+{
+  DataTree deck("deck");
+  deck.setGrossType(DataGrossType::MAP);
+  for (const double length : {1.0, 2.0})
+  {
+    auto pipe = addTree(
+      deck, "pipe" + std::to_string(deck.numChildren()), DataGrossType::MAP);
+    addScalar(*pipe, "length", length);
+    pipe->addChild(std::make_shared<DataTree>(makeTestBlock(2)));
+  }
+  size_t line = 0;
+  setLocationTags(deck, "deck", line);
+  return deck;
+}
+} // namespace
+
+void unitTestParameterDiagnostics()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  auto params = ParameterTree("Block", "Description");
+  params.addOptionalParameter("values", "", std::vector<int>{});
+  params.addOptionalParameter("scale", "", 1.0);
+  params.addRequiredParameter<int>("count", "");
+
+  const DataTree block = makeTestBlock(5);
+
+  //======================================================= Records
+  ParameterDiagnostics diagnostics;
+  params.processSpecification(diagnostics, block);
+
+  elkLogicalErrorIf(diagnostics.numErrors() != 7,
+                    "Expected 7 errors, got " +
+                      std::to_string(diagnostics.numErrors()));
+  elkLogicalErrorIf(diagnostics.hasWarnings(), "Unexpected warnings");
+
+  const auto& records = diagnostics.diagnostics();
+  elkLogicalErrorIf(records[0].m_code != DiagnosticCode::INVALID_PARAMETER_NAME,
+                    "Invalid names are reported first");
+  elkLogicalErrorIf(records[1].m_code !=
+                      DiagnosticCode::REQUIRED_PARAMETER_MISSING,
+                    "Missing parameters are reported second");
+  for (size_t i = 2; i < records.size(); ++i)
+  {
+    elkLogicalErrorIf(records[i].m_code !=
+                        DiagnosticCode::SCALAR_TYPE_INCOMPATIBLE,
+                      "Array entries should be incompatible");
+    elkLogicalErrorIf(records[i].m_nest_depth != 1,
+                      "Array entries are one level down");
+    elkLogicalErrorIf(records[i].m_data != &block.child("values").childAt(i - 2),
+                      "Records should refer to the checked data");
+  }
+
+  //======================================================= Text
+  const std::string text = diagnostics.errorsAsString();
+  const std::string header =
+    "While checking input parameter validity for block \"Block\" from "
+    "data-tree \"deck/Block\" parsed from deck line 1:\n";
+  elkLogicalErrorIf(text.find(header) != 0, "Text should start with header");
+  elkLogicalErrorIf(text.find(header, 1) != std::string::npos,
+                    "The header should be written once");
+  elkLogicalErrorIf(
+    text.find("  The parameter name \"scael\" is invalid. Did you mean "
+              "\"scale\"?\n") == std::string::npos,
+    "Missing suggestion in:\n" + text);
+  elkLogicalErrorIf(
+    text.find("    Item \"values\" is required to be of scalar-type INTEGER.") ==
+      std::string::npos,
+    "Missing indented array error in:\n" + text);
+
+  //======================================================= Capping
+  ParameterDiagnostics capped;
+  capped.setMaxDiagnostics(3);
+  params.processSpecification(capped, block);
+
+  elkLogicalErrorIf(capped.diagnostics().size() != 3,
+                    "Only 3 diagnostics should be stored");
+  elkLogicalErrorIf(capped.numErrors() != 7,
+                    "Dropped errors should still be counted");
+  elkLogicalErrorIf(capped.errorsAsString().find(
+                      "  ... and 4 more error(s) not shown.\n") ==
+                      std::string::npos,
+                    "Missing dropped count");
+
+  //======================================================= JSON
+  std::stringstream json;
+  diagnostics.writeJSON(json);
+  const std::string json_str = json.str();
+
+  elkLogicalErrorIf(json_str.find("\"num_errors\": 7") == std::string::npos,
+                    "Missing error count in:\n" + json_str);
+  elkLogicalErrorIf(
+    json_str.find("\"code\": \"INVALID_PARAMETER_NAME\"") == std::string::npos,
+    "Missing code in:\n" + json_str);
+  elkLogicalErrorIf(
+    json_str.find("with value a \\\"quoted\\\" string") == std::string::npos,
+    "Quotes should be escaped in:\n" + json_str);
+
+  //======================================================= Large count
+  // Checking only records the errors, so many errors stay cheap.
+  const DataTree large_block = makeTestBlock(100000);
+  ParameterDiagnostics large;
+  params.processSpecification(large, large_block);
+  elkLogicalErrorIf(large.numErrors() != 100002, "Expected 100002 errors");
+
+  //======================================================= Deduplicated
+  // The second block shares its children with the first one, errors in it
+  // must still be located in the second block.
+  {
+    DataTree deck = makeTestDeck();
+    const auto& const_deck = deck;
+    const auto& second_block = const_deck.child("pipe1").child("Block");
+    const std::string block_mark = second_block.getTag("mark");
+    const std::string name_mark = second_block.child("scael").getTag("mark");
+    const std::string entry_mark =
+      second_block.child("values").childAt(1).getTag("mark");
+
+    DataTreeMarkTable marks;
+    deduplicateDataTree(deck, marks);
+    const auto& first_block = const_deck.child("pipe0").child("Block");
+    elkLogicalErrorIf(&second_block.child("scael") !=
+                          &first_block.child("scael") or
+                        &second_block.child("values").childAt(1) !=
+                          &first_block.child("values").childAt(1),
+                      "The blocks should share their children");
+
+    const ParameterProgram program(params);
+    for (const bool compiled : {false, true})
+    {
+      ParameterDiagnostics located;
+      located.setMarkTable(&marks);
+      if (compiled) program.validate(located, second_block);
+      else params.processSpecification(located, second_block);
+
+      const std::string located_text = located.errorsAsString();
+      elkLogicalErrorIf(
+        located_text.find("from data-tree \"deck/pipe1/Block\" parsed from " +
+                          block_mark + ":\n") == std::string::npos,
+        "The header should locate the second block in:\n" + located_text);
+
+      std::stringstream located_json;
+      located.writeJSON(located_json);
+      const std::string located_json_str = located_json.str();
+      elkLogicalErrorIf(
+        located_json_str.find("\"address\": \"deck/pipe1/Block/scael\", "
+                              "\"mark\": \"" +
+                              name_mark + "\"") == std::string::npos,
+        "The invalid name should be located in the second block in:\n" +
+          located_json_str);
+      elkLogicalErrorIf(
+        located_json_str.find("\"address\": \"deck/pipe1/Block/values/1\", "
+                              "\"mark\": \"" +
+                              entry_mark + "\"") == std::string::npos,
+        "Array entries should be located in the second block in:\n" +
+          located_json_str);
+      elkLogicalErrorIf(located_json_str.find("pipe0") != std::string::npos,
+                        "Nothing should be located in the first block in:\n" +
+                          located_json_str);
+    }
+  }
+
+  logger.log() << "ParameterDiagnostics checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestParameterDiagnostics);
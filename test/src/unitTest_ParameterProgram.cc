@@ -0,0 +1,152 @@
+#include "elke_core/parameters2/ParameterProgram.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+#include "test_utilities/TestDataTrees.h"
+
+#include <limits>
+#include <sstream>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+/**Returns the diagnostics as JSON, which includes every record.*/
+std::string asJSON(const ParameterDiagnostics& diagnostics)
+{
+  std::stringstream json;
+  diagnostics.writeJSON(json);
+  return json.str();
+}
+} // namespace
+
+void unitTestParameterProgram()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  auto params = ParameterTree("Block", "Description");
+  params.addOptionalParameter("scale", "", 1.0);
+  params.addOptionalParameter("name", "", std::string("default"));
+  params.addOptionalParameter("flag", "", false);
+  params.addRequiredParameter<int>("count", "");
+  params.addOptionalParameter("components", "", GenericParameterMap());
+  auto& values = params.addOptionalParameter("values", "", std::vector<int>{});
+  values.addAdditionalInputCheck(
+    std::make_unique<param_checks::ArraySizeCheck>(3));
+
+  const ParameterProgram program(params);
+
+  elkLogicalErrorIf(program.instructions().size() != 7,
+                    "Expected one instruction per parameter and the block");
+  elkLogicalErrorIf(program.instructions()[0].m_opcode !=
+                      ParameterProgram::Opcode::BLOCK,
+                    "The first instruction should be the block");
+
+  //======================================================= Blocks
+  std::vector<DataTree> blocks;
+
+  // Valid
+  blocks.push_back(makeBlock());
+  addScalar(blocks.back(), "count", ScalarValue(int64_t(2)));
+  addScalar(blocks.back(), "scale", ScalarValue("2.5"));
+  addSequence(blocks.back(),
+              "values",
+              {ScalarValue(int64_t(1)), ScalarValue(2.0), ScalarValue("3")});
+
+  // Invalid names and a missing required parameter
+  blocks.push_back(makeBlock());
+  addScalar(blocks.back(), "scael", ScalarValue(1.0));
+  addScalar(blocks.back(), "nmae", ScalarValue("a"));
+
+  // Wrong types
+  blocks.push_back(makeBlock());
+  addScalar(blocks.back(), "count", ScalarValue("not a number"));
+  addScalar(blocks.back(), "flag", ScalarValue("yes"));
+  addScalar(blocks.back(), "components", ScalarValue(1.0));
+  addSequence(blocks.back(), "scale", {ScalarValue(1.0)});
+
+  // Array entries and the additional check
+  blocks.push_back(makeBlock());
+  addScalar(blocks.back(), "count", ScalarValue(int64_t(2)));
+  addSequence(blocks.back(), "values", {ScalarValue("a"), ScalarValue(1.0)});
+  addTree(blocks.back().child("values"), "", DataGrossType::NO_DATA);
+
+  // Integers that do not fit an int
+  blocks.push_back(makeBlock());
+  addScalar(blocks.back(), "count", ScalarValue("3000000000"));
+  addSequence(blocks.back(),
+              "values",
+              {ScalarValue(int64_t(-3000000000)),
+               ScalarValue(1e10),
+               ScalarValue(int64_t(1))});
+
+  //======================================================= Same findings
+  for (const auto& block : blocks)
+  {
+    ParameterDiagnostics expected;
+    params.processSpecification(expected, block);
+
+    ParameterDiagnostics found;
+    program.validate(found, block);
+
+    elkLogicalErrorIf(found.errorsAsString() != expected.errorsAsString(),
+                      "Errors differ. Expected:\n" + expected.errorsAsString() +
+                        "Found:\n" + found.errorsAsString());
+    elkLogicalErrorIf(asJSON(found) != asJSON(expected),
+                      "Records differ. Expected:\n" + asJSON(expected) +
+                        "Found:\n" + asJSON(found));
+  }
+
+  ParameterDiagnostics valid;
+  program.validate(valid, blocks[0]);
+  elkLogicalErrorIf(valid.hasErrors(),
+                    "Unexpected errors:\n" + valid.errorsAsString());
+
+  ParameterDiagnostics out_of_range;
+  program.validate(out_of_range, blocks.back());
+  elkLogicalErrorIf(out_of_range.numErrors() != 3,
+                    "Expected 3 integers out of range:\n" +
+                      out_of_range.errorsAsString());
+
+  // Numbers that do not fit an int64_t, for int64_t parameters
+  auto wide_params = ParameterTree("Block", "Description");
+  wide_params.addOptionalParameter("id", "", int64_t(0));
+  wide_params.addOptionalParameter("ids", "", std::vector<int64_t>{});
+  const ParameterProgram wide_program(wide_params);
+
+  DataTree unfit = makeBlock();
+  addScalar(unfit, "id", ScalarValue("nan"));
+  addSequence(unfit,
+              "ids",
+              {ScalarValue(1e30),
+               ScalarValue(std::numeric_limits<double>::quiet_NaN()),
+               ScalarValue("1e30"),
+               ScalarValue(1.0)});
+
+  ParameterDiagnostics unfit_expected;
+  wide_params.processSpecification(unfit_expected, unfit);
+  ParameterDiagnostics unfit_found;
+  wide_program.validate(unfit_found, unfit);
+  elkLogicalErrorIf(unfit_found.numErrors() != 4 or
+                      asJSON(unfit_found) != asJSON(unfit_expected),
+                    "Expected 4 numbers that do not fit an int64_t:\n" +
+                      unfit_found.errorsAsString());
+
+  //======================================================= Not a block
+  bool threw = false;
+  try
+  {
+    ParameterProgram not_a_block(params.getParameter("scale"));
+  }
+  catch (const std::runtime_error&)
+  {
+    threw = true;
+  }
+  elkLogicalErrorIf(not threw, "Compiling a non-block should throw");
+
+  logger.log() << "ParameterProgram checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestParameterProgram);
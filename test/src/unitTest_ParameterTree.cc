@@ -36,11 +36,11 @@ void unitTestParameterTree()
     for (const auto& check_data_ptr : check.constChildren())
     {
       const auto& check_data = *check_data_ptr;
-      StatusStrings status_strings;
+      ParameterDiagnostics diagnostics;
 
-      input_tree.checkAndAssignData(status_strings, check_data);
+      input_tree.checkAndAssignData(diagnostics, check_data);
 
-      const bool has_errors = not status_strings.m_errors.empty();
+      const bool has_errors = diagnostics.hasErrors();
 
       const std::string status =
         has_errors ? "Error(s) produced." : "No error.";
@@ -51,7 +51,8 @@ void unitTestParameterTree()
       if (verbose and has_errors)
       {
         WarningsAndErrorsData warnings_and_errors_data;
-        warnings_and_errors_data.m_errors.emplace_back(status_strings.m_errors);
+        warnings_and_errors_data.m_errors.emplace_back(
+          diagnostics.errorsAsString());
         input_processor.postWarningsAndErrors(warnings_and_errors_data);
       }
     } // for check_data
@@ -119,16 +120,18 @@ void unitTestParameterTree()
     class CustomCheck : public param_checks::InputCheckCloneAble<CustomCheck>
     {
     public:
-      bool performCheck(StatusStrings& status_strings,
+      bool performCheck(ParameterDiagnostics& diagnostics,
                         const DataTree& data,
-                        const std::string& prefix,
+                        const ParameterValidationContext& context,
                         const std::string& name_or_id) const override
       {
         bool has_errors = false;
 
         if (data.numChildren() != 5)
         {
-          status_strings.m_errors += prefix + "Bad error in CustomCheck\n";
+          diagnostics.addMessage(DiagnosticSeverity::ERROR,
+                                 context.indent() +
+                                   "Bad error in CustomCheck\n");
           return false;
         }
 
@@ -145,11 +148,12 @@ void unitTestParameterTree()
           std::stringstream error_message;
           const auto data_typenames = DataGrossTypeNames(data_gross_types);
           const auto reqr_typenames = DataGrossTypeNames(reqr_gross_types);
-          error_message << prefix << "The entries for item " << name_or_id
+          error_message << context.indent() << "The entries for item " << name_or_id
                         << " are required to follow the gross-type sequence "
                         << reqr_typenames << " but the supplied types are "
                         << data_typenames << ".\n";
-          status_strings.m_errors += error_message.str();
+          diagnostics.addMessage(DiagnosticSeverity::ERROR,
+                                 error_message.str());
           has_errors = true;
         }
 
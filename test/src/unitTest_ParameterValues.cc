@@ -0,0 +1,154 @@
+#include "elke_core/parameters2/ParameterTree.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+#include "test_utilities/TestDataTrees.h"
+
+#include <limits>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+constexpr ParameterKey<double> SCALE_KEY("scale");
+constexpr ParameterKey<std::vector<int>> VALUES_KEY("values");
+
+/**Returns true if the function throws.*/
+template <typename F>
+bool throws(F function)
+{
+  try
+  {
+    function();
+  }
+  catch (const std::exception&)
+  {
+    return true;
+  }
+  return false;
+}
+} // namespace
+
+void unitTestParameterValues()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  auto params = ParameterTree("Block", "Description");
+  params.addOptionalParameter("scale", "", 2.0);
+  params.addOptionalParameter("name", "", std::string("default"));
+  params.addOptionalParameter("values", "", std::vector<int>{1, 2});
+  params.addRequiredParameter<int>("count", "");
+
+  //======================================================= Defaults
+  elkLogicalErrorIf(params.getParameterValue<double>("scale") != 2.0,
+                    "Wrong default scale");
+  elkLogicalErrorIf(params.getParameterValue(SCALE_KEY) != 2.0,
+                    "Wrong default scale by key");
+  elkLogicalErrorIf(params.getParameterValue<std::string>("name") != "default",
+                    "Wrong default name");
+  elkLogicalErrorIf((params.getParameterValue(VALUES_KEY) !=
+                     std::vector<int>{1, 2}),
+                    "Wrong default values");
+  elkLogicalErrorIf(params.getParameter("count").hasValue(),
+                    "Required parameters have no default");
+
+  //======================================================= Assigned
+  DataTree block = makeBlock();
+  addScalar(block, "scale", ScalarValue(3.5));
+  addScalar(block, "count", ScalarValue(int64_t(7)));
+
+  addSequence(block,
+              "values",
+              {ScalarValue(int64_t(0)),
+               ScalarValue(int64_t(10)),
+               ScalarValue(int64_t(20))});
+
+  params.setAssignmentFlag(true);
+  ParameterDiagnostics diagnostics;
+  params.processSpecification(diagnostics, block);
+  elkLogicalErrorIf(diagnostics.hasErrors(),
+                    "Unexpected errors:\n" + diagnostics.errorsAsString());
+
+  elkLogicalErrorIf(params.getParameterValue(SCALE_KEY) != 3.5,
+                    "Wrong assigned scale");
+  elkLogicalErrorIf(params.getParameterValue<int>("count") != 7,
+                    "Wrong assigned count");
+  elkLogicalErrorIf((params.getParameterValue(VALUES_KEY) !=
+                     std::vector<int>{0, 10, 20}),
+                    "Wrong assigned values");
+  elkLogicalErrorIf(params.getParameterValue<std::string>("name") != "default",
+                    "Unassigned parameters keep their default");
+
+  // The value is converted once, so repeated access returns the same object.
+  elkLogicalErrorIf(&params.getParameterValue(VALUES_KEY) !=
+                      &params.getParameterValue<std::vector<int>>("values"),
+                    "Values should be cached");
+
+  //======================================================= Out of range
+  // Integers that do not fit the parameter's type are incompatible, not
+  // wrapped.
+  DataTree too_large = makeBlock();
+  addScalar(too_large, "count", ScalarValue(int64_t(3000000000)));
+  addScalar(too_large, "scale", ScalarValue(1.0));
+
+  ParameterDiagnostics range_diagnostics;
+  params.processSpecification(range_diagnostics, too_large);
+  elkLogicalErrorIf(range_diagnostics.numErrors() != 1 or
+                      range_diagnostics.diagnostics()[0].m_code !=
+                        DiagnosticCode::SCALAR_TYPE_INCOMPATIBLE,
+                    "3000000000 does not fit an int:\n" +
+                      range_diagnostics.errorsAsString());
+
+  int converted = 0;
+  elkLogicalErrorIf(
+    convertScalarValue(ScalarValue(int64_t(-3000000000)), converted) or
+      not convertScalarValue(ScalarValue("2147483647"), converted) or
+      converted != 2147483647,
+    "Conversions to int should be range-checked");
+
+  // Numbers that do not fit an int64_t at all are incompatible too, and
+  // leave the default value.
+  auto wide = ParameterTree("Block", "Description");
+  wide.addOptionalParameter("id", "", int64_t(5));
+  wide.setAssignmentFlag(true);
+  for (const auto& value :
+       {ScalarValue("nan"),
+        ScalarValue("1e30"),
+        ScalarValue(std::numeric_limits<double>::quiet_NaN()),
+        ScalarValue(1e30)})
+  {
+    DataTree unfit = makeBlock();
+    addScalar(unfit, "id", value);
+
+    ParameterDiagnostics unfit_diagnostics;
+    elkLogicalErrorIf(
+      throws([&] { wide.processSpecification(unfit_diagnostics, unfit); }),
+      value.convertToString() + " should be diagnosed, not throw");
+    elkLogicalErrorIf(unfit_diagnostics.numErrors() != 1 or
+                        unfit_diagnostics.diagnostics()[0].m_code !=
+                          DiagnosticCode::SCALAR_TYPE_INCOMPATIBLE,
+                      value.convertToString() + " does not fit an int64_t:\n" +
+                        unfit_diagnostics.errorsAsString());
+    elkLogicalErrorIf(wide.getParameterValue<int64_t>("id") != 5,
+                      "Unfit values should leave the default");
+  }
+
+  //======================================================= Errors
+  elkLogicalErrorIf(not throws([&] { params.getParameterValue<int>("scale"); }),
+                    "Requesting the wrong type should throw");
+  elkLogicalErrorIf(
+    not throws([&] { params.getParameterValue<double>("nonexistent"); }),
+    "Requesting a nonexistent parameter should throw");
+
+  auto unassigned = ParameterTree("Block", "Description");
+  unassigned.addRequiredParameter<int>("count", "");
+  elkLogicalErrorIf(
+    not throws([&] { unassigned.getParameterValue<int>("count"); }),
+    "Requesting an unassigned required parameter should throw");
+
+  logger.log() << "ParameterValues checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestParameterValues);
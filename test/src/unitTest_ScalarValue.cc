@@ -1,6 +1,9 @@
 #include <elke_core/FrameworkCore.h>
 
 #include "elke_core/data_types/ScalarValue.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <limits>
 
 namespace elke::unit_tests
 {
@@ -41,6 +44,35 @@ void unitTestScalarValue()
     val += "2";
     logger.log() << "str_ref=" << str_ref.getValue<std::string>();
   }
+
+  //======================================================= Conversions
+  {
+    logger.log() << "------------------------------ Conversions.";
+    ScalarValue converted;
+    elkLogicalErrorIf(
+      not ScalarValue("1e3").tryConvertToType(ScalarType::INTEGER,
+                                              converted) or
+        converted.getValue<int64_t>() != 1000,
+      "\"1e3\" should convert to INTEGER");
+
+    // Values that do not fit an int64_t are not convertible to INTEGER, and
+    // both ways of checking agree.
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (const auto& value : {ScalarValue("nan"),
+                              ScalarValue("1e30"),
+                              ScalarValue("-inf"),
+                              ScalarValue(nan),
+                              ScalarValue(1e30)})
+    {
+      elkLogicalErrorIf(value.isConvertibleToType(ScalarType::INTEGER) or
+                          value.tryConvertToType(ScalarType::INTEGER,
+                                                 converted),
+                        value.convertToString() +
+                          " should not convert to INTEGER");
+      elkLogicalErrorIf(not value.isConvertibleToType(ScalarType::FLOAT),
+                        value.convertToString() + " should convert to FLOAT");
+    }
+  }
 }
 
 } // namespace elke::unit_tests
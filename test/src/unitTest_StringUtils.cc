@@ -0,0 +1,176 @@
+#include "elke_core/utilities/string_utils.h"
+#include "elke_core/utilities/BKTree.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <algorithm>
+#include <random>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+/**Reference full-matrix Levenshtein distance.*/
+unsigned int referenceDistance(const std::string& s1, const std::string& s2)
+{
+  const size_t m = s1.size();
+  const size_t n = s2.size();
+  std::vector<std::vector<unsigned int>> dp(
+    m + 1, std::vector<unsigned int>(n + 1));
+  for (size_t i = 0; i <= m; ++i)
+    dp[i][0] = i;
+  for (size_t j = 0; j <= n; ++j)
+    dp[0][j] = j;
+  for (size_t i = 1; i <= m; ++i)
+    for (size_t j = 1; j <= n; ++j)
+      dp[i][j] = std::min({dp[i - 1][j] + 1,
+                           dp[i][j - 1] + 1,
+                           dp[i - 1][j - 1] + (s1[i - 1] == s2[j - 1] ? 0 : 1)});
+  return dp[m][n];
+}
+
+std::string randomWord(std::mt19937& rng, size_t max_length)
+{
+  std::uniform_int_distribution<size_t> length_dist(1, max_length);
+  std::uniform_int_distribution<int> char_dist('a', 'e');
+  std::string word(length_dist(rng), ' ');
+  for (auto& c : word)
+    c = static_cast<char>(char_dist(rng));
+  return word;
+}
+} // namespace
+
+/**Routine to test the Levenshtein distance and the closest-match lookups.*/
+void unitTestStringUtils()
+{
+  auto& logger = FrameworkCore::getInstance().getLogger();
+  std::mt19937 rng(7);
+
+  //======================================================= Distances
+  elkLogicalErrorIf(
+    string_utils::computeLevenshteinDistance("kitten", "sitting") != 3,
+    "Wrong distance kitten/sitting.");
+  for (int trial = 0; trial < 5000; ++trial)
+  {
+    const auto a = randomWord(rng, 10);
+    const auto b = randomWord(rng, 10);
+    const unsigned int exact = referenceDistance(a, b);
+    elkLogicalErrorIf(string_utils::computeLevenshteinDistance(a, b) != exact,
+                      "Unbounded distance mismatch for \"" + a + "\", \"" +
+                        b + "\".");
+    for (unsigned int bound = 0; bound <= 6; ++bound)
+    {
+      const unsigned int expected = std::min(exact, bound + 1);
+      elkLogicalErrorIf(
+        string_utils::computeLevenshteinDistance(a, b, bound) != expected,
+        "Bounded distance mismatch for \"" + a + "\", \"" + b + "\".");
+    }
+  }
+  logger.log() << "Distance checks passed.";
+
+  //======================================================= Closest match
+  for (int trial = 0; trial < 200; ++trial)
+  {
+    std::vector<std::string> words;
+    for (int w = 0; w < 50; ++w)
+      words.push_back(randomWord(rng, 8));
+    const string_utils::BKTree tree(words);
+
+    for (int q = 0; q < 20; ++q)
+    {
+      const auto query = randomWord(rng, 8);
+
+      // Brute force with the documented tie-break.
+      std::string expected;
+      auto best = std::make_tuple(5u, size_t{0}, size_t{0});
+      for (size_t w = 0; w < words.size(); ++w)
+      {
+        const auto& word = words[w];
+        const unsigned int dist = referenceDistance(query, word);
+        const size_t len_diff = std::max(query.size(), word.size()) -
+                                std::min(query.size(), word.size());
+        const auto key = std::make_tuple(dist, len_diff, w);
+        if (dist <= 4 and key < best)
+        {
+          best = key;
+          expected = word;
+        }
+      }
+
+      elkLogicalErrorIf(tree.findClosest(query) != expected,
+                        "BKTree lookup mismatch for \"" + query + "\".");
+
+      const auto linear = string_utils::findClosestMatchingString(query, words);
+      elkLogicalErrorIf(
+        linear.empty() != expected.empty() or
+          (not linear.empty() and referenceDistance(query, linear) !=
+                                    referenceDistance(query, expected)),
+        "Linear lookup mismatch for \"" + query + "\".");
+    }
+  }
+
+  //======================================================= Splitting
+  using Words = std::vector<std::string>;
+  elkLogicalErrorIf(string_utils::splitString("  call  a b ") !=
+                      Words({"call", "a", "b"}),
+                    "Merged split failed.");
+  elkLogicalErrorIf(string_utils::splitString(",a,,b,", ",", false) !=
+                      Words({"a", "", "b"}),
+                    "Unmerged split failed.");
+  elkLogicalErrorIf(string_utils::splitString("a::b", "::") != Words({"a", "b"}),
+                    "Multi-character delimiter split failed.");
+  elkLogicalErrorIf(not string_utils::splitString("").empty(),
+                    "Split of empty string failed.");
+
+  std::vector<std::string_view> views;
+  const std::string command = "call elke::unit_tests::unitTestStringUtils";
+  string_utils::splitStringView(command, " ", true, views);
+  elkLogicalErrorIf(views.size() != 2 or views[1].data() != command.data() + 5,
+                    "splitStringView does not refer into the input.");
+  logger.log() << "Split checks passed.";
+
+  //======================================================= Numbers
+  int64_t int_value = 0;
+  double float_value = 0.0;
+  elkLogicalErrorIf(not string_utils::parseInt64("-42", int_value) or
+                      int_value != -42,
+                    "parseInt64 failed.");
+  elkLogicalErrorIf(not string_utils::parseInt64(" +7", int_value) or
+                      int_value != 7,
+                    "parseInt64 with prefix failed.");
+  elkLogicalErrorIf(string_utils::parseInt64("1.5", int_value) or
+                      string_utils::parseInt64("12a", int_value) or
+                      string_utils::parseInt64("99999999999999999999",
+                                               int_value),
+                    "parseInt64 accepted an invalid string.");
+  elkLogicalErrorIf(not string_utils::parseDouble("-1.25e2", float_value) or
+                      float_value != -125.0,
+                    "parseDouble failed.");
+  for (const char* invalid : {"", " ", "abc", "1.0x", "+-1", "1e400", "--1"})
+    elkLogicalErrorIf(string_utils::isStringANumber(invalid),
+                      "\"" + std::string(invalid) + "\" taken as a number.");
+  elkLogicalErrorIf(string_utils::convertStringToDouble("0.5") != 0.5,
+                    "convertStringToDouble failed.");
+  elkLogicalErrorIf(string_utils::convertStringToInt64_t("1e3") != 1000,
+                    "convertStringToInt64_t failed.");
+  elkLogicalErrorIf(not string_utils::parseNumberAsInt64("-2.5", int_value) or
+                      int_value != -2,
+                    "parseNumberAsInt64 should truncate toward zero.");
+  for (const char* invalid : {"nan", "inf", "-inf", "1e30", "abc"})
+    elkLogicalErrorIf(string_utils::parseNumberAsInt64(invalid, int_value) or
+                        string_utils::convertStringToInt64_t(invalid) != 0,
+                      "\"" + std::string(invalid) + "\" taken as an int64_t.");
+  logger.log() << "Number checks passed.";
+
+  const string_utils::BKTree tree({"scale", "offset", "scale2", "optionA"});
+  elkLogicalErrorIf(tree.findClosest("scalex") != "scale2",
+                    "Substitution not preferred on a tie.");
+  elkLogicalErrorIf(not tree.findClosest("array_of_objects").empty(),
+                    "Suggestion beyond the threshold.");
+  logger.log() << "Closest match checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestStringUtils);
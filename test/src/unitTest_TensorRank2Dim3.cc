@@ -0,0 +1,203 @@
+#include "elke_core/math/TensorRank2Dim3Array.h"
+#include "elke_core/math/simd_dispatch.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <cmath>
+#include <limits>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+using elke::math::TensorRank2Dim3;
+using elke::math::Vec3;
+
+//=============================================== Compile-time checks
+static_assert(TensorRank2Dim3::Identity().Determinant() == 1.0);
+static_assert(TensorRank2Dim3::Diagonal(Vec3(2.0, 4.0, 8.0)).Inverse()(2, 2) ==
+              0.125);
+static_assert(TensorRank2Dim3(1, 2, 3, 4, 5, 6, 7, 8, 10).Determinant() == -3.0);
+
+/**True if `a` and `b` differ by more than a few ulps of `scale`. The
+ * compiler may contract the scalar operations into FMA (e.g. with
+ * -march=native), which the AVX2 kernels don't use.*/
+bool differs(const double a, const double b, const double scale)
+{
+  constexpr double tolerance = 8.0 * std::numeric_limits<double>::epsilon();
+  return std::fabs(a - b) > tolerance * scale;
+}
+
+bool differs(const TensorRank2Dim3& a,
+             const TensorRank2Dim3& b,
+             const double scale)
+{
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      if (differs(a(i, j), b(i, j), scale)) return true;
+  return false;
+}
+
+bool differs(const Vec3& a, const Vec3& b, const double scale)
+{
+  return differs(a.x, b.x, scale) or differs(a.y, b.y, scale) or
+         differs(a.z, b.z, scale);
+}
+
+/**Frobenius norm.*/
+double norm(const TensorRank2Dim3& a)
+{
+  return std::sqrt(a.t[0].NormSquare() + a.t[1].NormSquare() +
+                   a.t[2].NormSquare());
+}
+
+double maxDifference(const TensorRank2Dim3& a, const TensorRank2Dim3& b)
+{
+  double max_diff = 0.0;
+  for (size_t i = 0; i < 3; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      max_diff = std::max(max_diff, std::fabs(a(i, j) - b(i, j)));
+  return max_diff;
+}
+
+/**Runs the batch kernels and compares them with the single-tensor
+ * operations, within a tolerance relative to the magnitude of the
+ * operands.*/
+void checkBatchKernels(const std::vector<TensorRank2Dim3>& a_tensors,
+                       const std::vector<TensorRank2Dim3>& b_tensors,
+                       const std::vector<Vec3>& vectors)
+{
+  using namespace elke::math;
+  const TensorRank2Dim3Array a(a_tensors), b(b_tensors);
+  const Vec3Array v(vectors);
+
+  Vec3Array mat_vec;
+  dot(a, v, mat_vec);
+  TensorRank2Dim3Array mat_mat, inverses;
+  dot(a, b, mat_mat);
+  inverse(a, inverses);
+  std::vector<double> determinants;
+  determinant(a, determinants);
+
+  const std::string set_name =
+    SIMDInstructionSetName(activeSIMDInstructionSet());
+  for (size_t n = 0; n < a.size(); ++n)
+  {
+    const auto& an = a_tensors[n];
+    const auto an_inverse = an.Inverse();
+    const double na = norm(an);
+    const double na_inverse = norm(an_inverse);
+    elkLogicalErrorIf(
+      differs(mat_vec.get(n), an.Dot(vectors[n]), na * vectors[n].Norm()),
+      set_name + " mat-vec mismatch.");
+    elkLogicalErrorIf(
+      differs(mat_mat.get(n), an.Dot(b_tensors[n]), na * norm(b_tensors[n])),
+      set_name + " mat-mat mismatch.");
+    // Rounding errors of the inverse grow with the condition number
+    elkLogicalErrorIf(
+      differs(inverses.get(n), an_inverse, na * na_inverse * na_inverse),
+      set_name + " inverse mismatch.");
+    elkLogicalErrorIf(
+      differs(determinants[n], an.Determinant(), na * na * na),
+      set_name + " determinant mismatch.");
+  }
+}
+
+} // namespace
+
+/**Routine to test TensorRank2Dim3 and its structure-of-arrays batch
+ * kernels.*/
+void unitTestTensorRank2Dim3()
+{
+  using namespace elke::math;
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  //=============================================== Products and inverse
+  const TensorRank2Dim3 a(4.0, -2.0, 1.0, 3.0, 6.0, -4.0, 2.0, 1.0, 8.0);
+  elkLogicalErrorIf(maxDifference(a.Dot(a.Inverse()),
+                                  TensorRank2Dim3::Identity()) > 1.0e-14,
+                    "A*inv(A) is not the identity.");
+
+  const Vec3 b(1.0, -2.0, 0.5);
+  elkLogicalErrorIf((a.Dot(a.Solve(b)) - b).Norm() > 1.0e-14,
+                    "Solve failed.");
+
+  const Vec3 u(1.0, 2.0, 3.0);
+  elkLogicalErrorIf(
+    differs(u.OTimes(b).Dot(u), u * b.Dot(u), u.NormSquare() * b.Norm()),
+    "Outer product failed.");
+  elkLogicalErrorIf(
+    differs(u.Dot(a), a.Transpose().Dot(u), u.Norm() * norm(a)),
+    "Vector-tensor product failed.");
+
+  //=============================================== Eigen-decomposition
+  {
+    // Q diag(-1,2,5) Q^T with Q a rotation about (1,1,1)
+    const double c = std::cos(0.3), s = std::sin(0.3), k = (1.0 - c) / 3.0;
+    const double r = s / std::sqrt(3.0);
+    const TensorRank2Dim3 q(c + k, k - r, k + r,
+                            k + r, c + k, k - r,
+                            k - r, k + r, c + k);
+    const TensorRank2Dim3 t =
+      q.Dot(TensorRank2Dim3::Diagonal(Vec3(5.0, -1.0, 2.0))).Dot(q.Transpose());
+
+    Vec3 values;
+    TensorRank2Dim3 vectors;
+    SymmetricEigenDecomposition(t, values, vectors);
+
+    elkLogicalErrorIf((values - Vec3(-1.0, 2.0, 5.0)).Norm() > 1.0e-12,
+                      "Wrong eigenvalues " + values.toString());
+    const auto reconstructed =
+      vectors.Dot(TensorRank2Dim3::Diagonal(values)).Dot(vectors.Transpose());
+    elkLogicalErrorIf(maxDifference(reconstructed, t) > 1.0e-12,
+                      "Eigen-decomposition does not reconstruct the tensor.");
+    elkLogicalErrorIf(maxDifference(vectors.Transpose().Dot(vectors),
+                                    TensorRank2Dim3::Identity()) > 1.0e-12,
+                      "Eigenvectors are not orthonormal.");
+  }
+
+  //=============================================== Batch kernels
+  std::vector<TensorRank2Dim3> a_tensors, b_tensors;
+  std::vector<Vec3> vectors;
+  for (int n = 0; n < 11; ++n)
+  {
+    const double t = 0.3 * n - 1.7;
+    a_tensors.emplace_back(4.0 + t, -2.0, 1.0 / (n + 1.0), 3.0, 6.0 * t, -4.0,
+                           2.0, t * t, 8.0);
+    b_tensors.push_back(a_tensors.back().Transpose() * 0.5);
+    vectors.emplace_back(t, 1.0 - t, 2.0 * t);
+  }
+
+  const auto detected = detectSIMDInstructionSet();
+  for (int set = 0; set <= static_cast<int>(detected); ++set)
+  {
+    setActiveSIMDInstructionSet(static_cast<SIMDInstructionSet>(set));
+    checkBatchKernels(a_tensors, b_tensors, vectors);
+  }
+  setActiveSIMDInstructionSet(detected);
+
+  {
+    std::vector<TensorRank2Dim3> symmetric;
+    for (const auto& tensor : a_tensors)
+      symmetric.push_back(tensor + tensor.Transpose());
+    Vec3Array values;
+    TensorRank2Dim3Array eigenvectors;
+    symmetricEigenDecomposition(
+      TensorRank2Dim3Array(symmetric), values, eigenvectors);
+    for (size_t n = 0; n < symmetric.size(); ++n)
+    {
+      const auto v = eigenvectors.get(n);
+      const auto reconstructed =
+        v.Dot(TensorRank2Dim3::Diagonal(values.get(n))).Dot(v.Transpose());
+      elkLogicalErrorIf(maxDifference(reconstructed, symmetric[n]) > 1.0e-11,
+                        "Batch eigen-decomposition failed.");
+    }
+  }
+
+  logger.log() << "TensorRank2Dim3 checks passed.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestTensorRank2Dim3);
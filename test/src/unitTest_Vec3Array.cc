@@ -0,0 +1,126 @@
+#include "elke_core/math/Vec3Array.h"
+#include "elke_core/math/simd_dispatch.h"
+#include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
+
+#include <cmath>
+#include <limits>
+
+namespace elke::unit_tests
+{
+
+namespace
+{
+
+/**True if `a` and `b` differ by more than a few ulps of `scale`. The
+ * compiler may contract the scalar kernels and Vec3 into FMA (e.g. with
+ * -march=native), which the AVX2 kernels don't use.*/
+bool differs(const double a, const double b, const double scale)
+{
+  constexpr double tolerance = 4.0 * std::numeric_limits<double>::epsilon();
+  return std::fabs(a - b) > tolerance * scale;
+}
+
+bool differs(const math::Vec3& a, const math::Vec3& b, const double scale)
+{
+  return differs(a.x, b.x, scale) or differs(a.y, b.y, scale) or
+         differs(a.z, b.z, scale);
+}
+
+/**Runs every batch kernel on the given input and checks the result, entry by
+ * entry, against the Vec3 member function of the same meaning. The
+ * tolerance is relative to the magnitude of the operands.*/
+void checkVec3ArrayKernels(const std::vector<math::Vec3>& a_vecs,
+                           const std::vector<math::Vec3>& b_vecs)
+{
+  using namespace elke::math;
+  const size_t n = a_vecs.size();
+  const Vec3Array a(a_vecs);
+  const Vec3Array b(b_vecs);
+
+  Vec3Array sum;
+  add(a, b, sum);
+  Vec3Array axpy_result(b_vecs);
+  axpy(0.5, a, axpy_result);
+  std::vector<double> dots, norms;
+  dot(a, b, dots);
+  norm(a, norms);
+  Vec3Array crosses;
+  cross(a, b, crosses);
+  Vec3Array normalized(a_vecs);
+  normalize(normalized);
+  Vec3Array inv_zero, inv_one;
+  inverseZeroIfSmaller(a, 1.0e-2, inv_zero);
+  inverseOneIfSmaller(a, 1.0e-2, inv_one);
+
+  const std::string set_name =
+    SIMDInstructionSetName(activeSIMDInstructionSet());
+  auto check = [&set_name](bool mismatch, const std::string& kernel, size_t i)
+  {
+    elkLogicalErrorIf(mismatch,
+                      set_name + " " + kernel + " mismatch at entry " +
+                        std::to_string(i) + ".");
+  };
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    const Vec3& va = a_vecs[i];
+    const Vec3& vb = b_vecs[i];
+    const double na = va.Norm();
+    const double nb = vb.Norm();
+    const auto inv_zero_expected = va.InverseZeroIfSmaller(1.0e-2);
+    const auto inv_one_expected = va.InverseOneIfSmaller(1.0e-2);
+    check(differs(sum.get(i), va + vb, na + nb), "add", i);
+    check(differs(axpy_result.get(i), vb + va * 0.5, nb + 0.5 * na), "axpy", i);
+    check(differs(dots[i], va.Dot(vb), na * nb), "dot", i);
+    check(differs(norms[i], na, na), "norm", i);
+    check(differs(crosses.get(i), va.Cross(vb), na * nb), "cross", i);
+    check(differs(normalized.get(i), va.Normalized(), 1.0), "normalize", i);
+    check(differs(inv_zero.get(i), inv_zero_expected, inv_zero_expected.Norm()),
+          "inverseZeroIfSmaller", i);
+    check(differs(inv_one.get(i), inv_one_expected, inv_one_expected.Norm()),
+          "inverseOneIfSmaller", i);
+  }
+}
+
+} // namespace
+
+/**Routine to test the structure-of-arrays Vec3 container and its batch
+ * kernels on every instruction set available on the host.*/
+void unitTestVec3Array()
+{
+  using namespace elke::math;
+  auto& logger = FrameworkCore::getInstance().getLogger();
+
+  // 19 entries so that the SIMD kernels also exercise the remainder loop.
+  std::vector<Vec3> a_vecs, b_vecs;
+  for (int i = 0; i < 19; ++i)
+  {
+    const double t = 0.37 * i - 3.1;
+    a_vecs.emplace_back(t, 1.0 / (1.0 + i), (i % 5 == 0) ? 0.001 : -2.0 * t);
+    b_vecs.emplace_back(0.5 - t, 3.0 * t, 1.25 + i);
+  }
+
+  const auto detected = detectSIMDInstructionSet();
+  for (int set = 0; set <= static_cast<int>(detected); ++set)
+  {
+    setActiveSIMDInstructionSet(static_cast<SIMDInstructionSet>(set));
+    checkVec3ArrayKernels(a_vecs, b_vecs);
+  }
+  setActiveSIMDInstructionSet(detected);
+
+  bool size_mismatch_threw = false;
+  try
+  {
+    Vec3Array out;
+    add(Vec3Array(3), Vec3Array(4), out);
+  }
+  catch (const std::runtime_error&) { size_mismatch_threw = true; }
+  elkLogicalErrorIf(not size_mismatch_threw, "Size mismatch was accepted.");
+
+  logger.log() << "Vec3Array kernels agree with Vec3.";
+}
+
+} // namespace elke::unit_tests
+
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestVec3Array);
@@ -1,5 +1,6 @@
 #include "elke_core/input/YAMLInput.h"
 #include "elke_core/FrameworkCore.h"
+#include "elke_core/output/elk_exceptions.h"
 
 namespace elke::unit_tests
 {
@@ -12,8 +13,47 @@ void unitTestYAMLInput()
 
   const auto data_tree = input_processor.parseInputFile("YAMLInput.yaml");
   logger.log() << data_tree.toStringAsYAML("", {"type", "address", "mark"});
+
+  //======================================================= Lazy parsing
+  // Deferred blocks must produce the same tree, tags included.
+  YAMLInput lazy_processor(logger);
+  lazy_processor.setLazyParsing(true);
+
+  auto lazy_tree = lazy_processor.parseInputFile("YAMLInput.yaml");
+  size_t num_deferred = 0;
+  for (const auto& block_ptr : lazy_tree.children())
+    if (not block_ptr->isMaterialized()) ++num_deferred;
+
+  elkLogicalErrorIf(num_deferred != 2,
+                    "Expected 2 deferred blocks, got " +
+                      std::to_string(num_deferred));
+
+  const std::vector<std::string> tags = {"type", "address", "mark"};
+  elkLogicalErrorIf(lazy_tree.toStringAsYAML("", tags) !=
+                      data_tree.toStringAsYAML("", tags),
+                    "Lazy and eager trees differ:\n" +
+                      lazy_tree.toStringAsYAML("", tags));
+  logger.log() << "Lazy and eager trees match.";
+
+  //======================================================= Deferred errors
+  // Syntax errors in deferred blocks are reported when reading the file.
+  YAMLInput checking_processor(logger);
+  checking_processor.setLazyParsing(true);
+  checking_processor.parseInputContent("Used:\n"
+                                       "  a: 1\n"
+                                       "Unused:\n"
+                                       "  b: 1\n"
+                                       "  - 2\n"
+                                       "  c: 3\n",
+                                       "deck");
+  const auto& errors = checking_processor.errors();
+  elkLogicalErrorIf(errors.size() != 1 or
+                      errors[0].find("deck line 5:") != 0,
+                    "Expected a syntax error on line 5, got " +
+                      std::to_string(errors.size()) + " errors" +
+                      (errors.empty() ? "" : ": " + errors[0]));
 }
 
 } // namespace elke::unit_tests
 
-elkeRegisterNullaryFunction(elke::unit_tests::unitTestYAMLInput);
\ No newline at end of file
+elkeRegisterNullaryFunction(elke::unit_tests::unitTestYAMLInput);
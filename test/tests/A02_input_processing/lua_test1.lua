@@ -0,0 +1,21 @@
+-- Scripted equivalent of input_for_TestSyntaxBlock.yaml with a generated
+-- components map.
+local components = {}
+for i = 1, 3 do
+  components["component_" .. i] = {
+    type = "snglvol",
+    area = 0.25 * i,
+    initial_conditions = { pressure = 1.0e6, temperature = 300.0 },
+    values = { i, i + 1, i + 2 },
+  }
+end
+
+return {
+  TestSyntaxBlock = {
+    scale = 1.0,
+    offset = 1.0,
+    scale2 = 1.0,
+    optionA = 12,
+    components = components,
+  }
+}
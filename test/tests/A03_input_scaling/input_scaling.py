@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""
+Input-pipeline scaling test. Generates a deck with tools/generate_input_deck.py
+and a reference deck with fewer nodes, runs the test executable on both at
+verbosity 2 and converts the logged task timings of `input_parsing`
+(InputProcessor::parseInputFiles) and `input_checking`
+(InputProcessor::checkInputDataForSyntaxBlocks) into a cost per data-tree node.
+
+The test fails when the cost per node of a task grows by more than the factor
+given in scaling_limits.yaml from the reference deck to the tested deck.
+Both decks are timed in the same run, the best of --repeat runs, so the test
+does not depend on the speed of the machine. The executable defaults to
+bin/elke_test and can be overridden with the ELKE_TEST_EXE environment variable.
+"""
+
+import argparse
+import os
+import pathlib
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+import yaml
+
+script_dir = pathlib.Path(__file__).parent.resolve()
+project_root = script_dir.parent.parent.parent
+sys.path.append(str(project_root / "tools"))
+
+from generate_input_deck import generate_deck  # noqa: E402
+
+TASKS = ["input_parsing", "input_checking"]
+
+
+def time_deck(executable: str, work_dir: str, num_nodes: int, args) -> dict:
+    """Returns the shortest time of each task over args.repeat runs on a
+    generated deck, or None if the executable failed."""
+    deck = os.path.join(work_dir, f"deck_{num_nodes}.yaml")
+    generate_deck(deck, num_nodes, args.depth, args.width, args.scalar_mix)
+
+    timings = {}
+    for _ in range(args.repeat):
+        result = subprocess.run([executable, "-i", deck, "-v", "2", "--nocolor"],
+                                capture_output=True, text=True)
+        if result.returncode != 0:
+            print(result.stdout)
+            print(result.stderr)
+            print(f"Executable failed with exit code {result.returncode}.")
+            return None
+
+        for task in TASKS:
+            match = re.search(r'Task "' + task + r'" took ([0-9.eE+-]+) s',
+                              result.stdout)
+            if match is None:
+                print(result.stdout)
+                print(f'No timing found for task "{task}".')
+                return None
+            seconds = max(float(match.group(1)), 1.0e-9)
+            timings[task] = min(timings.get(task, seconds), seconds)
+
+    os.remove(deck)
+    return timings
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--nodes", type=float, required=True)
+    parser.add_argument("--reference-nodes", type=float, default=None,
+                        help="Nodes of the reference deck, defaults to a "
+                             "tenth of --nodes")
+    parser.add_argument("--depth", type=int, default=4)
+    parser.add_argument("--width", type=int, default=8)
+    parser.add_argument("--scalar-mix", default="string=1,integer=1,float=1,bool=1,sequence=1")
+    parser.add_argument("--repeat", type=int, default=3,
+                        help="Runs per deck, the shortest time is compared")
+    parser.add_argument("--limits", default=str(script_dir / "scaling_limits.yaml"))
+    args = parser.parse_args()
+
+    num_nodes = int(args.nodes)
+    reference_nodes = int(args.reference_nodes or num_nodes / 10)
+    executable = os.environ.get("ELKE_TEST_EXE",
+                                str(project_root / "bin" / "elke_test"))
+
+    with open(args.limits) as file:
+        limits = yaml.safe_load(file)
+    min_compared_seconds = float(limits["min_compared_seconds"])
+
+    work_dir = tempfile.mkdtemp(prefix="elke_scaling_")
+    try:
+        reference = time_deck(executable, work_dir, reference_nodes, args)
+        timings = time_deck(executable, work_dir, num_nodes, args)
+    finally:
+        shutil.rmtree(work_dir, ignore_errors=True)
+    if reference is None or timings is None:
+        return 1
+
+    passed = True
+    for task in TASKS:
+        reference_cost = reference[task] / reference_nodes
+        cost = timings[task] / num_nodes
+        growth = cost / reference_cost
+        max_growth = float(limits["max_cost_growth"][task])
+        ok = growth <= max_growth
+        # Below a millisecond the timing is dominated by one-off costs such
+        # as the allocator consolidating memory freed by the previous task.
+        too_short = min(reference[task], timings[task]) < min_compared_seconds
+        passed = passed and (ok or too_short)
+        verdict = "OK" if ok else ("not compared, too short" if too_short
+                                   else "TOO SLOW")
+        print(f"{task}: {reference_nodes} nodes in {reference[task]:.6f} s, "
+              f"{num_nodes} nodes in {timings[task]:.6f} s, cost per node "
+              f"grew {growth:.3g}x (limit {max_growth:.3g}x) {verdict}")
+
+    print("Scaling check passed." if passed else "Scaling check FAILED.")
+    return 0 if passed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
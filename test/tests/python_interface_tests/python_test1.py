@@ -20,3 +20,7 @@ input_data = dict(
 )
 
 tree = elke_lib.make_data_tree("MainInput", input_data)
+
+if tree.count_matches("*/initial_conditions/pressure") != 1:
+    raise RuntimeError("Path query did not find the pressure")
+tree.print_matches("component_100/param3/[1]")
@@ -0,0 +1,75 @@
+"""
+Compares two elke_bench JSON result files, e.g. from two commits, and reports
+the relative change of every benchmark present in both.
+
+Usage:
+  bin/elke_bench --benchmark_out=base.json
+  (checkout and build the other commit)
+  bin/elke_bench --benchmark_out=new.json
+  python tools/compare_benchmarks.py base.json new.json --threshold 0.10
+
+The exit code is 1 if any benchmark got slower than the threshold allows.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(file_name: str, metric: str) -> dict:
+    """Maps benchmark name to its timing. Aggregates are used if present,
+    preferring the median."""
+    with open(file_name) as file:
+        data = json.load(file)
+
+    results = {}
+    medians = {}
+    for entry in data["benchmarks"]:
+        if entry.get("error_occurred", False):
+            continue
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                medians[entry["run_name"]] = entry[metric]
+            continue
+        results.setdefault(entry["run_name"], entry[metric])
+
+    results.update(medians)
+    return results
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="JSON file of the reference run")
+    parser.add_argument("contender", help="JSON file of the run to check")
+    parser.add_argument("--metric", default="real_time", choices=["real_time", "cpu_time"])
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="Relative slow-down flagged as a regression (default 0.10)")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline, args.metric)
+    contender = load_results(args.contender, args.metric)
+
+    common = [name for name in baseline if name in contender]
+    if not common:
+        print("No benchmarks in common.")
+        return 1
+
+    width = max(len(name) for name in common) + 2
+    print(f"{'Benchmark':<{width}}{'baseline':>14}{'contender':>14}{'change':>10}")
+    regressions = 0
+    for name in common:
+        base, new = baseline[name], contender[name]
+        change = (new - base) / base if base > 0.0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<{width}}{base:>14.1f}{new:>14.1f}{change:>+10.1%}{flag}")
+
+    print(f"{regressions} regression(s) above {args.threshold:.0%}.")
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,135 @@
+"""
+Generates synthetic YAML input decks for scaling studies of the input
+pipeline (parsing and syntax-block checking).
+
+The deck consists of a single TestSyntaxBlock (registered by the test
+executable) whose `components` parameter, a generic map, holds the bulk of the
+nodes. Below `components` the tree is built depth-first with maps of `width`
+children down to `depth` levels, with scalar (or short sequence) leaves drawn
+from the requested scalar mix. Generation stops when the requested number of
+data-tree nodes has been written.
+
+Examples:
+  python tools/generate_input_deck.py --nodes 100000 -o deck.yaml
+  python tools/generate_input_deck.py --nodes 1e6 --depth 6 --width 4 \\
+      --scalar-mix string=1,integer=2,float=4,bool=1,sequence=1 -o deck.yaml
+"""
+
+import argparse
+import random
+import sys
+
+SCALAR_KINDS = ["string", "integer", "float", "bool", "sequence"]
+
+# Nodes contributed by one leaf of each kind. A sequence leaf is the sequence
+# node plus its three entries.
+NODES_PER_LEAF = {"string": 1, "integer": 1, "float": 1, "bool": 1, "sequence": 4}
+
+# The file's root node, the TestSyntaxBlock node, its three scalar parameters
+# and `components`
+HEADER_NODES = 6
+
+
+def parse_scalar_mix(text: str) -> dict:
+    """Parses "kind=weight,kind=weight" into normalized weights."""
+    weights = {kind: 0.0 for kind in SCALAR_KINDS}
+    for item in text.split(","):
+        kind, _, weight = item.partition("=")
+        kind = kind.strip()
+        if kind not in weights:
+            raise ValueError(f'Unknown scalar kind "{kind}". Choose from {SCALAR_KINDS}.')
+        weights[kind] = float(weight) if weight else 1.0
+    total = sum(weights.values())
+    if total <= 0.0:
+        raise ValueError("The scalar mix must have a positive total weight.")
+    return {kind: weight / total for kind, weight in weights.items()}
+
+
+class DeckWriter:
+    """Streams a deck to a file object, counting data-tree nodes."""
+
+    def __init__(self, out, num_nodes: int, depth: int, width: int,
+                 scalar_mix: dict, seed: int):
+        self.out = out
+        self.remaining = num_nodes - HEADER_NODES
+        self.depth = max(3, depth)
+        self.width = max(1, width)
+        self.rng = random.Random(seed)
+        self.kinds = list(scalar_mix.keys())
+        self.weights = list(scalar_mix.values())
+        self.counter = 0
+
+    def scalar(self, kind: str) -> str:
+        self.counter += 1
+        c = self.counter
+        if kind == "string":
+            return f'"value_{c}"'
+        if kind == "integer":
+            return str(c)
+        if kind == "float":
+            return repr(self.rng.uniform(-1.0e3, 1.0e3))
+        if kind == "bool":
+            return "true" if c % 2 == 0 else "false"
+        return f"[{c}, {c + 1}, {c + 2}]"
+
+    def write_level(self, indent: str, level: int):
+        for k in range(self.width):
+            if self.remaining <= 0:
+                return
+            if level < self.depth and self.remaining > 1:
+                self.out.write(f"{indent}node_{level}_{k}:\n")
+                self.remaining -= 1
+                self.write_level(indent + "  ", level + 1)
+            else:
+                kind = self.rng.choices(self.kinds, self.weights)[0]
+                if NODES_PER_LEAF[kind] > self.remaining:
+                    kind = "integer"
+                self.out.write(f"{indent}leaf_{k}: {self.scalar(kind)}\n")
+                self.remaining -= NODES_PER_LEAF[kind]
+
+    def write(self):
+        self.out.write("TestSyntaxBlock:\n")
+        self.out.write("  scale: 1.0\n")
+        self.out.write("  offset: 1.0\n")
+        self.out.write("  optionA: 12\n")
+        self.out.write("  components:\n")
+        component = 0
+        while self.remaining > 0:
+            self.out.write(f"    component_{component}:\n")
+            self.remaining -= 1
+            component += 1
+            self.write_level("      ", 3)
+
+
+def generate_deck(file_name: str, num_nodes: int, depth: int = 4, width: int = 8,
+                  scalar_mix: str = "string=1,integer=1,float=1,bool=1,sequence=1",
+                  seed: int = 0):
+    """Writes a deck with `num_nodes` data-tree nodes to `file_name`."""
+    with open(file_name, "w") as out:
+        DeckWriter(out, int(num_nodes), depth, width,
+                   parse_scalar_mix(scalar_mix), seed).write()
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--nodes", type=float, required=True,
+                        help="Number of data-tree nodes, e.g. 1e6")
+    parser.add_argument("--depth", type=int, default=4,
+                        help="Nesting depth below the syntax block, "
+                             "at least 3 (default 4)")
+    parser.add_argument("--width", type=int, default=8,
+                        help="Number of children per map (default 8)")
+    parser.add_argument("--scalar-mix", default="string=1,integer=1,float=1,bool=1,sequence=1",
+                        help="Relative weights of the leaf kinds " + str(SCALAR_KINDS))
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("-o", "--output", required=True, help="Output file name")
+    args = parser.parse_args()
+
+    generate_deck(args.output, int(args.nodes), args.depth, args.width,
+                  args.scalar_mix, args.seed)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())